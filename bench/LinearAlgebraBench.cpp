@@ -0,0 +1,257 @@
+#include <benchmark/benchmark.h>
+#include <LinearAlgebra.hpp>
+
+#include <cstddef>
+#include <vector>
+
+namespace
+{
+    // Tridiagonal (-1, 2, -1) matrix: nonsingular and well conditioned for every
+    // element type, with entries that stay small under integer products and
+    // Bareiss elimination.
+    template <typename T>
+    LinAlg::Matrix<T> make_matrix(std::size_t size)
+    {
+        LinAlg::Matrix<T> matrix(size, size);
+        for (std::size_t i = 0; i < size; ++i) {
+            matrix(i, i) = T(2);
+            if (i > 0) { matrix(i, i - 1) = T(-1); }
+            if (i + 1 < size) { matrix(i, i + 1) = T(-1); }
+        }
+        return matrix;
+    }
+
+    // flops and bytes are per iteration. Bytes count every operand read and the
+    // result written once, the traffic an ideal cache would leave.
+    void set_counters(benchmark::State& state, std::size_t size, double flops, double bytes)
+    {
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * bytes));
+        state.counters["bytes/element"] = bytes / static_cast<double>(size * size);
+        if (flops > 0.0) {
+            state.counters["FLOPS"] = benchmark::Counter(flops, benchmark::Counter::kIsIterationInvariantRate, benchmark::Counter::kIs1000);
+        }
+    }
+
+    template <typename T>
+    void BM_Multiply(benchmark::State& state)
+    {
+        const std::size_t size = static_cast<std::size_t>(state.range(0));
+        const LinAlg::Matrix<T> lhs = make_matrix<T>(size);
+        const LinAlg::Matrix<T> rhs = make_matrix<T>(size);
+        for (auto _ : state) {
+            LinAlg::Matrix<T> product = lhs * rhs;
+            benchmark::DoNotOptimize(product.data());
+        }
+        const double n = static_cast<double>(size);
+        set_counters(state, size, 2.0 * n * n * n, 3.0 * n * n * sizeof(T));
+    }
+
+    // Products with the Strassen-Winograd crossover given by the second
+    // argument; FLOPS reports the classical count so rates are comparable.
+    template <typename T>
+    void BM_MultiplyStrassen(benchmark::State& state)
+    {
+        const std::size_t size = static_cast<std::size_t>(state.range(0));
+        const LinAlg::Matrix<T> lhs = make_matrix<T>(size);
+        const LinAlg::Matrix<T> rhs = make_matrix<T>(size);
+        const std::size_t savedCrossover = LinAlg::strassen_crossover();
+        LinAlg::set_strassen_crossover(static_cast<std::size_t>(state.range(1)));
+        for (auto _ : state) {
+            LinAlg::Matrix<T> product = lhs * rhs;
+            benchmark::DoNotOptimize(product.data());
+        }
+        LinAlg::set_strassen_crossover(savedCrossover);
+        const double n = static_cast<double>(size);
+        set_counters(state, size, 2.0 * n * n * n, 3.0 * n * n * sizeof(T));
+    }
+
+    template <typename T>
+    void BM_Determinant(benchmark::State& state)
+    {
+        const std::size_t size = static_cast<std::size_t>(state.range(0));
+        LinAlg::Matrix<T> matrix = make_matrix<T>(size);
+        for (auto _ : state) {
+            T determinant = matrix.determinant();
+            benchmark::DoNotOptimize(determinant);
+        }
+        const double n = static_cast<double>(size);
+        set_counters(state, size, 2.0 * n * n * n / 3.0, n * n * sizeof(T));
+    }
+
+    template <typename T>
+    void BM_Inverse(benchmark::State& state)
+    {
+        const std::size_t size = static_cast<std::size_t>(state.range(0));
+        LinAlg::Matrix<T> matrix = make_matrix<T>(size);
+        for (auto _ : state) {
+            LinAlg::Matrix<T> inverseMatrix = matrix.inverse();
+            benchmark::DoNotOptimize(inverseMatrix.data());
+        }
+        const double n = static_cast<double>(size);
+        set_counters(state, size, 2.0 * n * n * n, 2.0 * n * n * sizeof(T));
+    }
+
+    template <typename T>
+    void BM_Transpose(benchmark::State& state)
+    {
+        const std::size_t size = static_cast<std::size_t>(state.range(0));
+        LinAlg::Matrix<T> matrix(size, size + 1);
+        for (auto _ : state) {
+            matrix.transpose();
+            benchmark::DoNotOptimize(matrix.data());
+        }
+        set_counters(state, size, 0.0, 2.0 * static_cast<double>(size * (size + 1)) * sizeof(T));
+    }
+
+    // pow(5) takes three products: two squarings and one multiplication. The copy
+    // of the base is included in the timing and is O(n^2) against O(n^3).
+    template <typename T>
+    void BM_Pow(benchmark::State& state)
+    {
+        const std::size_t size = static_cast<std::size_t>(state.range(0));
+        const LinAlg::Matrix<T> base = make_matrix<T>(size);
+        for (auto _ : state) {
+            LinAlg::Matrix<T> power(base);
+            power.pow(5);
+            benchmark::DoNotOptimize(power.data());
+        }
+        const double n = static_cast<double>(size);
+        set_counters(state, size, 3.0 * 2.0 * n * n * n, 2.0 * n * n * sizeof(T));
+    }
+
+    // Factorization and one solve, the unit of work solve_mixed_precision is
+    // meant to speed up.
+    template <typename T>
+    void BM_SolveLU(benchmark::State& state)
+    {
+        const std::size_t size = static_cast<std::size_t>(state.range(0));
+        const LinAlg::Matrix<T> matrix = make_matrix<T>(size);
+        const std::vector<T> b(size, T(1));
+        for (auto _ : state) {
+            std::vector<T> x = LinAlg::solve_lu(matrix, b);
+            benchmark::DoNotOptimize(x.data());
+        }
+        const double n = static_cast<double>(size);
+        set_counters(state, size, 2.0 * n * n * n / 3.0, n * n * sizeof(T));
+    }
+
+    template <typename T>
+    void BM_SolveMixedPrecision(benchmark::State& state)
+    {
+        const std::size_t size = static_cast<std::size_t>(state.range(0));
+        const LinAlg::Matrix<T> matrix = make_matrix<T>(size);
+        const std::vector<T> b(size, T(1));
+        for (auto _ : state) {
+            std::vector<T> x = LinAlg::solve_mixed_precision(matrix, b);
+            benchmark::DoNotOptimize(x.data());
+        }
+        const double n = static_cast<double>(size);
+        set_counters(state, size, 2.0 * n * n * n / 3.0, n * n * sizeof(T));
+    }
+
+    // The iterative phases of both decompositions take a data-dependent number
+    // of steps, so no flop count is reported.
+    template <typename T>
+    void BM_SymmetricEigen(benchmark::State& state)
+    {
+        const std::size_t size = static_cast<std::size_t>(state.range(0));
+        LinAlg::Matrix<T> matrix = make_matrix<T>(size);
+        for (std::size_t i = 0; i < size; ++i) { matrix(i, (i * 7) % size) = matrix((i * 7) % size, i) = T(1); }
+        for (auto _ : state) {
+            LinAlg::SymmetricEigenDecomposition<T> eigen(matrix, state.range(1) != 0);
+            benchmark::DoNotOptimize(eigen.values().data());
+        }
+        set_counters(state, size, 0.0, static_cast<double>(size * size * sizeof(T)));
+    }
+
+    template <typename T>
+    void BM_SingularValueDecomposition(benchmark::State& state)
+    {
+        const std::size_t size = static_cast<std::size_t>(state.range(0));
+        LinAlg::Matrix<T> matrix = make_matrix<T>(size);
+        for (std::size_t i = 0; i < size; ++i) { matrix(i, (i * 7) % size) += T(1); }
+        for (auto _ : state) {
+            LinAlg::SingularValueDecomposition<T> svd(matrix);
+            benchmark::DoNotOptimize(svd.values().data());
+        }
+        set_counters(state, size, 0.0, static_cast<double>(size * size * sizeof(T)));
+    }
+
+    // Tall rows x cols system with a dominant leading diagonal: full column rank
+    // and well conditioned, so QR and TSQR time the same factorization.
+    template <typename T>
+    LinAlg::Matrix<T> make_tall_matrix(std::size_t rows, std::size_t cols)
+    {
+        LinAlg::Matrix<T> matrix(rows, cols);
+        for (std::size_t i = 0; i < rows; ++i) {
+            for (std::size_t j = 0; j < cols; ++j) { matrix(i, j) = (i == j) ? T(cols) : T((i * 7 + j * 13) % 17) / T(17); }
+        }
+        return matrix;
+    }
+
+    template <typename T, bool Tsqr>
+    void BM_SolveLeastSquares(benchmark::State& state)
+    {
+        const std::size_t rows = static_cast<std::size_t>(state.range(0)), cols = static_cast<std::size_t>(state.range(1));
+        const LinAlg::Matrix<T> matrix = make_tall_matrix<T>(rows, cols);
+        const std::vector<T> b(rows, T(1));
+        for (auto _ : state) {
+            std::vector<T> x = Tsqr ? LinAlg::solve_least_squares_tsqr(matrix, b) : LinAlg::solve_least_squares(matrix, b);
+            benchmark::DoNotOptimize(x.data());
+        }
+        const double m = static_cast<double>(rows), n = static_cast<double>(cols);
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * m * n * sizeof(T)));
+        state.counters["FLOPS"] = benchmark::Counter(2.0 * n * n * (m - n / 3.0), benchmark::Counter::kIsIterationInvariantRate, benchmark::Counter::kIs1000);
+    }
+
+    // range(0) independent solves A x = A b of order 4 through a TaskGraph,
+    // each waiting on its product; range(1) is the batch size, 1 for no batching.
+    template <typename T>
+    void BM_TaskGraph(benchmark::State& state)
+    {
+        const std::size_t count = static_cast<std::size_t>(state.range(0));
+        const LinAlg::Matrix<T> matrix = make_matrix<T>(4);
+        const LinAlg::Matrix<T> b(4, 1, T(1));
+        for (auto _ : state) {
+            LinAlg::TaskGraph<T> graph(LinAlg::execution_policy(), static_cast<std::size_t>(state.range(1)));
+            const LinAlg::MatrixFuture<T> a = graph.value(matrix);
+            const LinAlg::MatrixFuture<T> rhs = graph.value(b);
+            for (std::size_t i = 0; i < count; ++i) { graph.solve(a, graph.multiply(a, rhs)); }
+            graph.wait();
+        }
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * count));
+    }
+}
+
+BENCHMARK_TEMPLATE(BM_Multiply, int)->RangeMultiplier(2)->Range(8, 512);
+BENCHMARK_TEMPLATE(BM_Multiply, float)->RangeMultiplier(2)->Range(8, 1024);
+BENCHMARK_TEMPLATE(BM_Multiply, double)->RangeMultiplier(2)->Range(8, 1024);
+BENCHMARK_TEMPLATE(BM_MultiplyStrassen, float)->ArgsProduct({ { 1024, 2048, 4096 }, { 0, 256, 512 } });
+BENCHMARK_TEMPLATE(BM_MultiplyStrassen, double)->ArgsProduct({ { 1024, 2048, 4096 }, { 0, 256, 512 } });
+
+BENCHMARK_TEMPLATE(BM_Determinant, int)->RangeMultiplier(2)->Range(8, 256);
+BENCHMARK_TEMPLATE(BM_Determinant, float)->RangeMultiplier(2)->Range(8, 1024);
+BENCHMARK_TEMPLATE(BM_Determinant, double)->RangeMultiplier(2)->Range(8, 1024);
+
+// Integral inverses go through the adjoint and are only practical for small orders.
+BENCHMARK_TEMPLATE(BM_Inverse, int)->RangeMultiplier(2)->Range(2, 16);
+BENCHMARK_TEMPLATE(BM_Inverse, float)->RangeMultiplier(2)->Range(8, 1024);
+BENCHMARK_TEMPLATE(BM_Inverse, double)->RangeMultiplier(2)->Range(8, 1024);
+
+BENCHMARK_TEMPLATE(BM_Transpose, int)->RangeMultiplier(4)->Range(16, 4096);
+BENCHMARK_TEMPLATE(BM_Transpose, float)->RangeMultiplier(4)->Range(16, 4096);
+BENCHMARK_TEMPLATE(BM_Transpose, double)->RangeMultiplier(4)->Range(16, 4096);
+
+BENCHMARK_TEMPLATE(BM_Pow, int)->RangeMultiplier(2)->Range(8, 256);
+BENCHMARK_TEMPLATE(BM_Pow, float)->RangeMultiplier(2)->Range(8, 512);
+BENCHMARK_TEMPLATE(BM_Pow, double)->RangeMultiplier(2)->Range(8, 512);
+
+BENCHMARK_TEMPLATE(BM_SolveLU, double)->RangeMultiplier(2)->Range(64, 2048);
+BENCHMARK_TEMPLATE(BM_SolveMixedPrecision, double)->RangeMultiplier(2)->Range(64, 2048);
+BENCHMARK_TEMPLATE(BM_SolveLeastSquares, double, false)->ArgsProduct({ { 20000, 200000 }, { 50, 200 } });
+BENCHMARK_TEMPLATE(BM_SolveLeastSquares, double, true)->ArgsProduct({ { 20000, 200000 }, { 50, 200 } });
+BENCHMARK_TEMPLATE(BM_SymmetricEigen, double)->ArgsProduct({ { 64, 256, 1024 }, { 0, 1 } });
+BENCHMARK_TEMPLATE(BM_SingularValueDecomposition, double)->RangeMultiplier(4)->Range(64, 1024);
+BENCHMARK_TEMPLATE(BM_TaskGraph, double)->ArgsProduct({ { 1024, 16384 }, { 1, 64 } });
+
+BENCHMARK_MAIN();
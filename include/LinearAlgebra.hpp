@@ -2,6 +2,14 @@
 #define LINEAR_ALGEBRA_HPP
 
 #include "LinearAlgebra/Matrix.hpp"
+#include "LinearAlgebra/FixedMatrix.hpp"
+#include "LinearAlgebra/MatrixBatch.hpp"
+#include "LinearAlgebra/MatrixVector.hpp"
+#include "LinearAlgebra/Serialization.hpp"
+#include "LinearAlgebra/SparseMatrix.hpp"
+#include "LinearAlgebra/StructuredMatrix.hpp"
+#include "LinearAlgebra/TaskGraph.hpp"
+#include "LinearAlgebra/TiledMatrix.hpp"
 #include "LinearAlgebra/SolutionSLE.hpp"
 
 #endif // LINEAR_ALGEBRA_HPP
@@ -0,0 +1,331 @@
+#ifndef ALLOCATOR_HPP
+#define ALLOCATOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Instrumentation.hpp"
+
+namespace LinAlg
+{
+    namespace Detail
+    {
+        // Alignment of Matrix storage: one cache line, and a full AVX-512 register.
+        const std::size_t storage_alignment = 64;
+
+        void* aligned_allocate(std::size_t bytes, std::size_t alignment);
+        void aligned_deallocate(void* pointer) noexcept;
+
+        // While a scope is active on a thread, the library allocators
+        // default-initialize elements constructed without a value, leaving
+        // arithmetic elements unwritten. Only the uninitialized constructors
+        // open one; every other sized construction or resize value-initializes.
+        class DefaultInitializationScope
+        {
+        public:
+            DefaultInitializationScope() : _previous(active()) { active() = true; }
+            DefaultInitializationScope(const DefaultInitializationScope&) = delete;
+            DefaultInitializationScope& operator= (const DefaultInitializationScope&) = delete;
+            ~DefaultInitializationScope() { active() = _previous; }
+
+            static bool& active();
+
+        private:
+            bool _previous;
+        };
+
+        template <typename U>
+        void construct_default(U* pointer);
+
+        template <typename T>
+        std::size_t allocation_bytes(std::size_t count);
+    }
+
+    // Heap allocator returning storage aligned to Alignment bytes. It is the
+    // default allocator of Matrix.
+    template <typename T, std::size_t Alignment = Detail::storage_alignment>
+    class AlignedAllocator
+    {
+        static_assert((Alignment & (Alignment - 1)) == 0, "alignment must be a power of two");
+        static_assert(Alignment >= alignof(T), "alignment must not be weaker than the alignment of T");
+
+    public:
+        typedef T value_type;
+        typedef std::true_type propagate_on_container_move_assignment;
+        typedef std::true_type is_always_equal;
+
+        template <typename U>
+        struct rebind
+        {
+            typedef AlignedAllocator<U, Alignment> other;
+        };
+
+        AlignedAllocator() noexcept = default;
+        template <typename U>
+        AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+        T* allocate(std::size_t count)
+        {
+            return static_cast<T*>(LinAlg::Detail::aligned_allocate(LinAlg::Detail::allocation_bytes<T>(count), Alignment));
+        }
+        void deallocate(T* pointer, std::size_t) noexcept { LinAlg::Detail::aligned_deallocate(pointer); }
+
+        template <typename U>
+        void construct(U* pointer) { LinAlg::Detail::construct_default(pointer); }
+        template <typename U, typename... Args>
+        void construct(U* pointer, Args&&... args) { ::new (static_cast<void*>(pointer)) U(std::forward<Args>(args)...); }
+    };
+
+    template <typename T, typename U, std::size_t Alignment>
+    bool operator== (const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&) { return true; }
+
+    template <typename T, typename U, std::size_t Alignment>
+    bool operator!= (const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>&) { return false; }
+
+    // Size-class pool for short-lived matrices. Blocks are powers of two of at
+    // least storage_alignment bytes carved from large aligned chunks; freed
+    // blocks go to a free list of their class and are reused by the next
+    // allocation of that class. reset() makes every chunk available again
+    // without returning it to the heap, so a workload that is reset between
+    // requests stops allocating once the arena has grown to its peak.
+    //
+    // An arena is not synchronized: blocks must be allocated and freed on the
+    // thread that owns it, and nothing allocated from it may be used after reset().
+    class MatrixArena
+    {
+    public:
+        static const std::size_t default_chunk_size = std::size_t(1) << 20;
+
+        explicit MatrixArena(std::size_t chunkSize = default_chunk_size);
+        MatrixArena(const MatrixArena&) = delete;
+        MatrixArena& operator= (const MatrixArena&) = delete;
+        ~MatrixArena();
+
+        // Arena of the calling thread, used by default constructed ArenaAllocators.
+        static MatrixArena& local();
+
+        void* allocate(std::size_t bytes);
+        void deallocate(void* pointer, std::size_t bytes) noexcept;
+
+        void reset() noexcept;
+        void release() noexcept;
+
+        std::size_t used_bytes() const { return _used; }
+        std::size_t reserved_bytes() const { return _reserved; }
+
+    private:
+        static const std::size_t size_classes = 48;
+
+        struct Chunk
+        {
+            char* data;
+            std::size_t size;
+        };
+
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        std::vector<Chunk> _chunks;
+        FreeBlock* _freeLists[size_classes];
+        std::size_t _chunkSize;
+        std::size_t _current;
+        std::size_t _offset;
+        std::size_t _used;
+        std::size_t _reserved;
+
+        static std::size_t size_class(std::size_t bytes);
+    };
+
+    // Allocator drawing from a MatrixArena, by default the arena of the thread
+    // that constructs it. Containers carry the allocator along on copy, move and
+    // swap, so storage is always returned to the arena it came from.
+    template <typename T>
+    class ArenaAllocator
+    {
+        static_assert(alignof(T) <= Detail::storage_alignment, "over-aligned types are not supported");
+
+    public:
+        typedef T value_type;
+        typedef std::true_type propagate_on_container_copy_assignment;
+        typedef std::true_type propagate_on_container_move_assignment;
+        typedef std::true_type propagate_on_container_swap;
+
+        template <typename U>
+        struct rebind
+        {
+            typedef ArenaAllocator<U> other;
+        };
+
+        ArenaAllocator() noexcept : _arena(&MatrixArena::local()) {}
+        explicit ArenaAllocator(MatrixArena& arena) noexcept : _arena(&arena) {}
+        template <typename U>
+        ArenaAllocator(const ArenaAllocator<U>& other) noexcept : _arena(other.arena()) {}
+
+        T* allocate(std::size_t count)
+        {
+            return static_cast<T*>(_arena->allocate(LinAlg::Detail::allocation_bytes<T>(count)));
+        }
+        void deallocate(T* pointer, std::size_t count) noexcept { _arena->deallocate(pointer, count * sizeof(T)); }
+
+        template <typename U>
+        void construct(U* pointer) { LinAlg::Detail::construct_default(pointer); }
+        template <typename U, typename... Args>
+        void construct(U* pointer, Args&&... args) { ::new (static_cast<void*>(pointer)) U(std::forward<Args>(args)...); }
+
+        MatrixArena* arena() const noexcept { return _arena; }
+
+    private:
+        MatrixArena* _arena;
+    };
+
+    template <typename T, typename U>
+    bool operator== (const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) { return lhs.arena() == rhs.arena(); }
+
+    template <typename T, typename U>
+    bool operator!= (const ArenaAllocator<T>& lhs, const ArenaAllocator<U>& rhs) { return lhs.arena() != rhs.arena(); }
+}
+
+inline bool& LinAlg::Detail::DefaultInitializationScope::active()
+{
+    thread_local bool active = false;
+    return active;
+}
+
+template <typename U>
+inline void LinAlg::Detail::construct_default(U* pointer)
+{
+    if (DefaultInitializationScope::active()) {
+        ::new (static_cast<void*>(pointer)) U;
+    } else {
+        ::new (static_cast<void*>(pointer)) U();
+    }
+}
+
+template <typename T>
+inline std::size_t LinAlg::Detail::allocation_bytes(std::size_t count)
+{
+    if (count > std::numeric_limits<std::size_t>::max() / sizeof(T)) { throw std::bad_alloc(); }
+    return count * sizeof(T);
+}
+
+// The block is over-allocated and the pointer returned by operator new is kept
+// in the word right before the aligned address.
+inline void* LinAlg::Detail::aligned_allocate(std::size_t bytes, std::size_t alignment)
+{
+    const std::size_t padding = alignment - 1 + sizeof(void*);
+    if (bytes > std::numeric_limits<std::size_t>::max() - padding) { throw std::bad_alloc(); }
+    LINALG_INSTRUMENT_ALLOCATION(bytes);
+
+    void* raw = ::operator new(bytes + padding);
+    const std::uintptr_t address = (reinterpret_cast<std::uintptr_t>(raw) + padding) & ~static_cast<std::uintptr_t>(alignment - 1);
+    void** aligned = reinterpret_cast<void**>(address);
+    aligned[-1] = raw;
+    return aligned;
+}
+
+inline void LinAlg::Detail::aligned_deallocate(void* pointer) noexcept
+{
+    if (pointer != nullptr) { ::operator delete(static_cast<void**>(pointer)[-1]); }
+}
+
+inline LinAlg::MatrixArena::MatrixArena(std::size_t chunkSize)
+    : _chunks(), _freeLists(), _chunkSize(std::max(chunkSize, Detail::storage_alignment)),
+      _current(0), _offset(0), _used(0), _reserved(0)
+{
+}
+
+inline LinAlg::MatrixArena::~MatrixArena()
+{
+    release();
+}
+
+inline LinAlg::MatrixArena& LinAlg::MatrixArena::local()
+{
+    static thread_local MatrixArena arena;
+    return arena;
+}
+
+inline std::size_t LinAlg::MatrixArena::size_class(std::size_t bytes)
+{
+    std::size_t sizeClass = 0;
+    std::size_t blockSize = Detail::storage_alignment;
+    while (blockSize < bytes) {
+        blockSize <<= 1;
+        ++sizeClass;
+    }
+    if (sizeClass >= size_classes) { throw std::bad_alloc(); }
+    return sizeClass;
+}
+
+inline void* LinAlg::MatrixArena::allocate(std::size_t bytes)
+{
+    const std::size_t sizeClass = size_class(bytes);
+    const std::size_t blockSize = Detail::storage_alignment << sizeClass;
+
+    if (FreeBlock* block = _freeLists[sizeClass]) {
+        _freeLists[sizeClass] = block->next;
+        _used += blockSize;
+        return block;
+    }
+
+    while (_current < _chunks.size() && _chunks[_current].size - _offset < blockSize) {
+        ++_current;
+        _offset = 0;
+    }
+    if (_current == _chunks.size()) {
+        const std::size_t chunkSize = std::max(_chunkSize, blockSize);
+        Chunk chunk = { static_cast<char*>(Detail::aligned_allocate(chunkSize, Detail::storage_alignment)), chunkSize };
+        try {
+            _chunks.push_back(chunk);
+        } catch (...) {
+            Detail::aligned_deallocate(chunk.data);
+            throw;
+        }
+        _reserved += chunkSize;
+        _offset = 0;
+    }
+
+    void* block = _chunks[_current].data + _offset;
+    _offset += blockSize;
+    _used += blockSize;
+    return block;
+}
+
+inline void LinAlg::MatrixArena::deallocate(void* pointer, std::size_t bytes) noexcept
+{
+    if (pointer == nullptr) { return; }
+
+    std::size_t sizeClass = 0;
+    while ((Detail::storage_alignment << sizeClass) < bytes) { ++sizeClass; }
+
+    FreeBlock* block = static_cast<FreeBlock*>(pointer);
+    block->next = _freeLists[sizeClass];
+    _freeLists[sizeClass] = block;
+    _used -= Detail::storage_alignment << sizeClass;
+}
+
+inline void LinAlg::MatrixArena::reset() noexcept
+{
+    std::fill(_freeLists, _freeLists + size_classes, nullptr);
+    _current = 0;
+    _offset = 0;
+    _used = 0;
+}
+
+inline void LinAlg::MatrixArena::release() noexcept
+{
+    for (const Chunk& chunk : _chunks) { Detail::aligned_deallocate(chunk.data); }
+    _chunks.clear();
+    _reserved = 0;
+    reset();
+}
+
+#endif // ALLOCATOR_HPP
@@ -0,0 +1,415 @@
+#ifndef EXECUTION_POLICY_HPP
+#define EXECUTION_POLICY_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace LinAlg
+{
+    class ExecutionPolicy
+    {
+    public:
+        virtual ~ExecutionPolicy() = default;
+
+        // Number of threads, including the caller, that parallel_for may run on.
+        virtual std::size_t concurrency() const = 0;
+
+        // Invokes body(first, last) over consecutive subranges of [begin, end),
+        // each at most grain long, and returns once all of them have completed.
+        // The first exception thrown by body is rethrown to the caller.
+        virtual void parallel_for(std::size_t begin, std::size_t end, std::size_t grain,
+                                  const std::function<void(std::size_t, std::size_t)>& body) = 0;
+    };
+
+    class SequentialPolicy : public ExecutionPolicy
+    {
+    public:
+        std::size_t concurrency() const override { return 1; }
+        void parallel_for(std::size_t begin, std::size_t end, std::size_t grain,
+                          const std::function<void(std::size_t, std::size_t)>& body) override;
+    };
+
+    class ThreadPool : public ExecutionPolicy
+    {
+    public:
+        explicit ThreadPool(std::size_t threads = std::thread::hardware_concurrency());
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator= (const ThreadPool&) = delete;
+        ~ThreadPool();
+
+        std::size_t concurrency() const override { return _workers.size() + 1; }
+        void parallel_for(std::size_t begin, std::size_t end, std::size_t grain,
+                          const std::function<void(std::size_t, std::size_t)>& body) override;
+
+        // Queues task for a worker. The ScopedExecutionPolicy active on the
+        // submitting thread, if any, is also active while the task runs.
+        void submit(std::function<void()> task);
+
+    private:
+        struct WorkQueue
+        {
+            std::mutex mutex;
+            std::deque< std::function<void()> > tasks;
+        };
+
+        struct WorkerIdentity
+        {
+            const ThreadPool* pool;
+            std::size_t index;
+        };
+
+        std::vector< std::unique_ptr<WorkQueue> > _queues;
+        std::vector<std::thread> _workers;
+        std::mutex _sleepMutex;
+        std::condition_variable _wakeUp;
+        std::atomic<std::size_t> _pending;
+        std::atomic<std::size_t> _nextQueue;
+        bool _stop;
+
+        bool try_pop(std::size_t queue, std::function<void()>& task);
+        bool try_steal(std::size_t thief, std::function<void()>& task);
+        void worker_loop(std::size_t index);
+        static WorkerIdentity& worker_identity();
+    };
+
+#ifdef _OPENMP
+    class OpenMPPolicy : public ExecutionPolicy
+    {
+    public:
+        std::size_t concurrency() const override;
+        void parallel_for(std::size_t begin, std::size_t end, std::size_t grain,
+                          const std::function<void(std::size_t, std::size_t)>& body) override;
+    };
+#endif
+
+    // Policy used by Matrix operations on the calling thread: the innermost
+    // ScopedExecutionPolicy if there is one, otherwise the global policy.
+    std::shared_ptr<ExecutionPolicy> execution_policy();
+    void set_execution_policy(std::shared_ptr<ExecutionPolicy> policy);
+
+    // Operations estimated to take fewer scalar operations than the threshold
+    // always run on the calling thread.
+    std::size_t parallel_threshold();
+    void set_parallel_threshold(std::size_t threshold);
+
+    // Floating point Matrix products whose smallest dimension exceeds the
+    // crossover take the Strassen-Winograd path, recursing until it is at most
+    // the crossover. Zero, the default, keeps every product on the blocked gemm.
+    std::size_t strassen_crossover();
+    void set_strassen_crossover(std::size_t crossover);
+
+    class ScopedExecutionPolicy
+    {
+    public:
+        explicit ScopedExecutionPolicy(std::shared_ptr<ExecutionPolicy> policy);
+        ScopedExecutionPolicy(const ScopedExecutionPolicy&) = delete;
+        ScopedExecutionPolicy& operator= (const ScopedExecutionPolicy&) = delete;
+        ~ScopedExecutionPolicy();
+
+    private:
+        std::shared_ptr<ExecutionPolicy> _previous;
+        static std::shared_ptr<ExecutionPolicy>& current();
+
+        friend std::shared_ptr<ExecutionPolicy> execution_policy();
+        friend class ThreadPool;
+#ifdef _OPENMP
+        friend class OpenMPPolicy;
+#endif
+    };
+
+    // Runs body over [begin, end) on the current policy when work reaches the
+    // parallel threshold, and inline on the calling thread otherwise.
+    void parallel_for(std::size_t work, std::size_t begin, std::size_t end, std::size_t grain,
+                      const std::function<void(std::size_t, std::size_t)>& body);
+
+    namespace Detail
+    {
+        struct ExecutionState
+        {
+            std::mutex mutex;
+            std::shared_ptr<ExecutionPolicy> policy = std::make_shared<SequentialPolicy>();
+            std::atomic<std::size_t> threshold{ std::size_t(1) << 18 };
+            std::atomic<std::size_t> strassenCrossover{ 0 };
+        };
+
+        ExecutionState& execution_state();
+    }
+}
+
+inline void LinAlg::SequentialPolicy::parallel_for(std::size_t begin, std::size_t end, std::size_t grain,
+                                                   const std::function<void(std::size_t, std::size_t)>& body)
+{
+    if (begin < end) { body(begin, end); }
+    (void)grain;
+}
+
+inline LinAlg::ThreadPool::ThreadPool(std::size_t threads)
+    : _pending(0), _nextQueue(0), _stop(false)
+{
+    const std::size_t workers = threads > 1 ? threads - 1 : 0;
+    for (std::size_t i = 0; i < workers; ++i) {
+        _queues.emplace_back(new WorkQueue);
+    }
+    for (std::size_t i = 0; i < workers; ++i) {
+        _workers.emplace_back(&ThreadPool::worker_loop, this, i);
+    }
+}
+
+inline LinAlg::ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _stop = true;
+    }
+    _wakeUp.notify_all();
+    for (std::thread& worker : _workers) { worker.join(); }
+}
+
+inline void LinAlg::ThreadPool::submit(std::function<void()> task)
+{
+    if (_workers.empty()) {
+        task();
+        return;
+    }
+
+    // A task holding the last reference to the pool it runs on would destroy
+    // the pool from one of its workers, so this pool is installed unowned: it
+    // outlives every task it runs.
+    std::shared_ptr<ExecutionPolicy> policy = ScopedExecutionPolicy::current();
+    if (policy) {
+        if (policy.get() == this) { policy = std::shared_ptr<ExecutionPolicy>(std::shared_ptr<ExecutionPolicy>(), this); }
+        task = [policy, task]() {
+            ScopedExecutionPolicy scopedPolicy(policy);
+            task();
+        };
+    }
+
+    const WorkerIdentity& identity = worker_identity();
+    const std::size_t queue = (identity.pool == this) ? identity.index : _nextQueue++ % _queues.size();
+    {
+        std::lock_guard<std::mutex> lock(_queues[queue]->mutex);
+        _queues[queue]->tasks.push_back(std::move(task));
+    }
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        ++_pending;
+    }
+    _wakeUp.notify_one();
+}
+
+inline void LinAlg::ThreadPool::parallel_for(std::size_t begin, std::size_t end, std::size_t grain,
+                                             const std::function<void(std::size_t, std::size_t)>& body)
+{
+    if (begin >= end) { return; }
+    if (grain == 0) { grain = 1; }
+
+    const std::size_t chunks = (end - begin + grain - 1) / grain;
+    if (chunks == 1 || _workers.empty()) {
+        body(begin, end);
+        return;
+    }
+
+    struct Job
+    {
+        std::atomic<std::size_t> next{ 0 };
+        std::atomic<std::size_t> done{ 0 };
+        std::mutex mutex;
+        std::condition_variable finished;
+        std::exception_ptr error;
+    };
+
+    std::shared_ptr<Job> job = std::make_shared<Job>();
+    const std::function<void(std::size_t, std::size_t)>* task = &body;
+    std::function<void()> run = [job, task, begin, end, grain, chunks]() {
+        for (std::size_t chunk = job->next++; chunk < chunks; chunk = job->next++) {
+            const std::size_t first = begin + chunk * grain;
+            const std::size_t last = (end - first < grain) ? end : first + grain;
+            try {
+                (*task)(first, last);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(job->mutex);
+                if (!job->error) { job->error = std::current_exception(); }
+            }
+            if (++job->done == chunks) {
+                std::lock_guard<std::mutex> lock(job->mutex);
+                job->finished.notify_all();
+            }
+        }
+    };
+
+    const std::size_t helpers = std::min(chunks, concurrency()) - 1;
+    for (std::size_t i = 0; i < helpers; ++i) { submit(run); }
+    run();
+
+    std::unique_lock<std::mutex> lock(job->mutex);
+    job->finished.wait(lock, [&job, chunks]() { return job->done == chunks; });
+    if (job->error) { std::rethrow_exception(job->error); }
+}
+
+inline bool LinAlg::ThreadPool::try_pop(std::size_t queue, std::function<void()>& task)
+{
+    std::lock_guard<std::mutex> lock(_queues[queue]->mutex);
+    if (_queues[queue]->tasks.empty()) { return false; }
+    task = std::move(_queues[queue]->tasks.back());
+    _queues[queue]->tasks.pop_back();
+    return true;
+}
+
+inline bool LinAlg::ThreadPool::try_steal(std::size_t thief, std::function<void()>& task)
+{
+    for (std::size_t i = 1; i < _queues.size(); ++i) {
+        WorkQueue& victim = *_queues[(thief + i) % _queues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+inline void LinAlg::ThreadPool::worker_loop(std::size_t index)
+{
+    worker_identity().pool = this;
+    worker_identity().index = index;
+
+    for (;;) {
+        std::function<void()> task;
+        if (try_pop(index, task) || try_steal(index, task)) {
+            --_pending;
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _wakeUp.wait(lock, [this]() { return _stop || _pending > 0; });
+        if (_stop && _pending == 0) { return; }
+    }
+}
+
+inline LinAlg::ThreadPool::WorkerIdentity& LinAlg::ThreadPool::worker_identity()
+{
+    thread_local WorkerIdentity identity = { nullptr, 0 };
+    return identity;
+}
+
+#ifdef _OPENMP
+#include <omp.h>
+
+inline std::size_t LinAlg::OpenMPPolicy::concurrency() const
+{
+    return static_cast<std::size_t>(omp_get_max_threads());
+}
+
+inline void LinAlg::OpenMPPolicy::parallel_for(std::size_t begin, std::size_t end, std::size_t grain,
+                                               const std::function<void(std::size_t, std::size_t)>& body)
+{
+    if (begin >= end) { return; }
+    if (grain == 0) { grain = 1; }
+
+    const long long chunks = static_cast<long long>((end - begin + grain - 1) / grain);
+    const std::shared_ptr<ExecutionPolicy> policy = ScopedExecutionPolicy::current();
+    std::exception_ptr error;
+    #pragma omp parallel for schedule(dynamic)
+    for (long long chunk = 0; chunk < chunks; ++chunk) {
+        const std::size_t first = begin + static_cast<std::size_t>(chunk) * grain;
+        const std::size_t last = (end - first < grain) ? end : first + grain;
+        try {
+            ScopedExecutionPolicy scopedPolicy(policy);
+            body(first, last);
+        } catch (...) {
+            #pragma omp critical
+            if (!error) { error = std::current_exception(); }
+        }
+    }
+    if (error) { std::rethrow_exception(error); }
+}
+#endif
+
+inline LinAlg::Detail::ExecutionState& LinAlg::Detail::execution_state()
+{
+    static ExecutionState state;
+    return state;
+}
+
+inline std::shared_ptr<LinAlg::ExecutionPolicy>& LinAlg::ScopedExecutionPolicy::current()
+{
+    thread_local std::shared_ptr<ExecutionPolicy> policy;
+    return policy;
+}
+
+inline LinAlg::ScopedExecutionPolicy::ScopedExecutionPolicy(std::shared_ptr<ExecutionPolicy> policy)
+    : _previous(std::move(current()))
+{
+    current() = std::move(policy);
+}
+
+inline LinAlg::ScopedExecutionPolicy::~ScopedExecutionPolicy()
+{
+    current() = std::move(_previous);
+}
+
+inline std::shared_ptr<LinAlg::ExecutionPolicy> LinAlg::execution_policy()
+{
+    if (ScopedExecutionPolicy::current()) { return ScopedExecutionPolicy::current(); }
+
+    Detail::ExecutionState& state = Detail::execution_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    return state.policy;
+}
+
+inline void LinAlg::set_execution_policy(std::shared_ptr<ExecutionPolicy> policy)
+{
+    if (!policy) { policy = std::make_shared<SequentialPolicy>(); }
+
+    Detail::ExecutionState& state = Detail::execution_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.policy = std::move(policy);
+}
+
+inline std::size_t LinAlg::parallel_threshold()
+{
+    return Detail::execution_state().threshold;
+}
+
+inline void LinAlg::set_parallel_threshold(std::size_t threshold)
+{
+    Detail::execution_state().threshold = threshold;
+}
+
+inline std::size_t LinAlg::strassen_crossover()
+{
+    return Detail::execution_state().strassenCrossover;
+}
+
+inline void LinAlg::set_strassen_crossover(std::size_t crossover)
+{
+    Detail::execution_state().strassenCrossover = crossover;
+}
+
+inline void LinAlg::parallel_for(std::size_t work, std::size_t begin, std::size_t end, std::size_t grain,
+                                 const std::function<void(std::size_t, std::size_t)>& body)
+{
+    if (begin >= end) { return; }
+
+    if (work >= parallel_threshold() && end - begin > grain) {
+        std::shared_ptr<ExecutionPolicy> policy = execution_policy();
+        if (policy->concurrency() > 1) {
+            policy->parallel_for(begin, end, grain, body);
+            return;
+        }
+    }
+    body(begin, end);
+}
+
+#endif // EXECUTION_POLICY_HPP
@@ -0,0 +1,478 @@
+#ifndef FIXED_MATRIX_HPP
+#define FIXED_MATRIX_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Matrix.hpp"
+#include "MatrixExpression.hpp"
+#include "MatrixView.hpp"
+#include "Kernels/determinant.hpp"
+#include "Kernels/elementwise.hpp"
+#include "Kernels/inverse.hpp"
+
+namespace LinAlg
+{
+    // R x C matrix with compile-time dimensions and row-major stack storage.
+    // Every loop has a constant trip count, so small sizes are fully unrolled,
+    // and nothing ever allocates for orders up to four.
+    template <typename T, std::size_t R, std::size_t C>
+    class FixedMatrix : public MatrixExpression< FixedMatrix<T, R, C> >
+    {
+        static_assert(std::is_arithmetic<T>::value && !std::is_const<T>::value, "invalid Matrix template argument");
+        static_assert(R > 0 && C > 0, "invalid Matrix size argument");
+
+    public:
+        typedef T value_type;
+
+        constexpr FixedMatrix() : _matrix() {}
+        constexpr explicit FixedMatrix(T value);
+        constexpr FixedMatrix(std::initializer_list< std::initializer_list<T> > il);
+        template <typename E>
+        explicit FixedMatrix(const MatrixExpression<E>& expression);
+
+        static constexpr std::size_t rows() { return R; }
+        static constexpr std::size_t cols() { return C; }
+        static constexpr std::size_t vector_size() { return R * C; }
+        static constexpr bool square() { return R == C; }
+        static constexpr FixedMatrix<T, R, C> identity();
+
+        constexpr T& operator()(std::size_t row, std::size_t col) { return _matrix[row * C + col]; }
+        constexpr const T& operator()(std::size_t row, std::size_t col) const { return _matrix[row * C + col]; }
+        T& at(std::size_t row, std::size_t col);
+        const T& at(std::size_t row, std::size_t col) const;
+
+        T* data() { return _matrix; }
+        const T* data() const { return _matrix; }
+
+        constexpr FixedMatrix<T, R, C>& operator+= (const FixedMatrix<T, R, C>& other);
+        constexpr FixedMatrix<T, R, C>& operator-= (const FixedMatrix<T, R, C>& other);
+        constexpr FixedMatrix<T, R, C>& operator*= (T value);
+        FixedMatrix<T, R, C>& operator/= (T value);
+
+        constexpr FixedMatrix<T, C, R> transposed() const;
+        T determinant() const;
+        FixedMatrix<T, R, C> inverse() const;
+
+    private:
+        T _matrix[R * C];
+    };
+
+    template <typename T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C> operator+ (const FixedMatrix<T, R, C>& lhs, const FixedMatrix<T, R, C>& rhs);
+
+    template <typename T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C> operator- (const FixedMatrix<T, R, C>& lhs, const FixedMatrix<T, R, C>& rhs);
+
+    template <typename T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C> operator- (const FixedMatrix<T, R, C>& operand);
+
+    template <typename T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C> operator* (const FixedMatrix<T, R, C>& operand, typename FixedMatrix<T, R, C>::value_type value);
+
+    template <typename T, std::size_t R, std::size_t C>
+    constexpr FixedMatrix<T, R, C> operator* (typename FixedMatrix<T, R, C>::value_type value, const FixedMatrix<T, R, C>& operand);
+
+    template <typename T, std::size_t R, std::size_t C>
+    FixedMatrix<T, R, C> operator/ (const FixedMatrix<T, R, C>& operand, typename FixedMatrix<T, R, C>::value_type value);
+
+    template <typename T, std::size_t R, std::size_t K, std::size_t C>
+    constexpr FixedMatrix<T, R, C> operator* (const FixedMatrix<T, R, K>& lhs, const FixedMatrix<T, K, C>& rhs);
+
+    template <typename T, std::size_t R, std::size_t C>
+    bool operator== (const FixedMatrix<T, R, C>& lhs, const FixedMatrix<T, R, C>& rhs);
+
+    template <typename T, std::size_t R, std::size_t C>
+    struct ExpressionOperand< FixedMatrix<T, R, C> >
+    {
+        typedef const FixedMatrix<T, R, C>& type;
+    };
+
+    namespace Detail
+    {
+        template <typename T, std::size_t R, std::size_t C>
+        struct GemmOperand< FixedMatrix<T, R, C> >
+        {
+            explicit GemmOperand(const FixedMatrix<T, R, C>& matrix) : view(matrix.data(), R, C, C, 1) {}
+
+            ConstMatrixView<T> view;
+        };
+
+        // Closed forms for orders one to four, elimination on stack storage above.
+        template <typename T, std::size_t N>
+        struct FixedSquare
+        {
+            static T determinant(const T* m);
+            static void inverse(const T* m, T* out);
+        };
+
+        template <typename T>
+        struct FixedSquare<T, 1>
+        {
+            static T determinant(const T* m) { return m[0]; }
+            static void inverse(const T* m, T* out);
+        };
+
+        template <typename T>
+        struct FixedSquare<T, 2>
+        {
+            static T determinant(const T* m) { return m[0] * m[3] - m[1] * m[2]; }
+            static void inverse(const T* m, T* out);
+        };
+
+        template <typename T>
+        struct FixedSquare<T, 3>
+        {
+            static T determinant(const T* m);
+            static void inverse(const T* m, T* out);
+        };
+
+        template <typename T>
+        struct FixedSquare<T, 4>
+        {
+            static T determinant(const T* m);
+            static void inverse(const T* m, T* out);
+        };
+
+        template <typename T, std::size_t N>
+        void fixed_inverse(const T* m, T* out, std::true_type);
+
+        template <typename T, std::size_t N>
+        void fixed_inverse(const T* m, T* out, std::false_type);
+
+        template <typename T, std::size_t N>
+        T fixed_determinant(const T* m, std::true_type);
+
+        template <typename T, std::size_t N>
+        T fixed_determinant(const T* m, std::false_type);
+    }
+}
+
+template <typename T, std::size_t R, std::size_t C>
+inline constexpr LinAlg::FixedMatrix<T, R, C>::FixedMatrix(T value)
+    : _matrix()
+{
+    for (std::size_t i = 0; i < R * C; ++i) { _matrix[i] = value; }
+}
+
+template <typename T, std::size_t R, std::size_t C>
+inline constexpr LinAlg::FixedMatrix<T, R, C>::FixedMatrix(std::initializer_list< std::initializer_list<T> > il)
+    : _matrix()
+{
+    if (il.size() != R) { throw std::invalid_argument("invalid Matrix rows argument"); }
+
+    std::size_t i = 0;
+    for (const std::initializer_list<T>& row : il) {
+        if (row.size() != C) { throw std::invalid_argument("invalid Matrix cols argument"); }
+        for (const T& value : row) { _matrix[i++] = value; }
+    }
+}
+
+template <typename T, std::size_t R, std::size_t C>
+template <typename E>
+inline LinAlg::FixedMatrix<T, R, C>::FixedMatrix(const MatrixExpression<E>& expression)
+    : _matrix()
+{
+    if (expression.rows() != R || expression.cols() != C) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+    const E& source = expression.derived();
+    for (std::size_t i = 0; i < R; ++i) {
+        for (std::size_t j = 0; j < C; ++j) { _matrix[i * C + j] = source(i, j); }
+    }
+}
+
+template <typename T, std::size_t R, std::size_t C>
+inline constexpr LinAlg::FixedMatrix<T, R, C> LinAlg::FixedMatrix<T, R, C>::identity()
+{
+    static_assert(R == C, "square Matrix required");
+
+    FixedMatrix<T, R, C> identityMatrix;
+    for (std::size_t i = 0; i < R; ++i) { identityMatrix._matrix[i * C + i] = T(1); }
+    return identityMatrix;
+}
+
+template <typename T, std::size_t R, std::size_t C>
+inline T& LinAlg::FixedMatrix<T, R, C>::at(std::size_t row, std::size_t col)
+{
+    if (row >= R) { throw std::out_of_range("invalid Matrix row subscript"); }
+    if (col >= C) { throw std::out_of_range("invalid Matrix column subscript"); }
+
+    return _matrix[row * C + col];
+}
+
+template <typename T, std::size_t R, std::size_t C>
+inline const T& LinAlg::FixedMatrix<T, R, C>::at(std::size_t row, std::size_t col) const
+{
+    if (row >= R) { throw std::out_of_range("invalid Matrix row subscript"); }
+    if (col >= C) { throw std::out_of_range("invalid Matrix column subscript"); }
+
+    return _matrix[row * C + col];
+}
+
+template <typename T, std::size_t R, std::size_t C>
+inline constexpr LinAlg::FixedMatrix<T, R, C>& LinAlg::FixedMatrix<T, R, C>::operator+= (const FixedMatrix<T, R, C>& other)
+{
+    for (std::size_t i = 0; i < R * C; ++i) { _matrix[i] += other._matrix[i]; }
+    return *this;
+}
+
+template <typename T, std::size_t R, std::size_t C>
+inline constexpr LinAlg::FixedMatrix<T, R, C>& LinAlg::FixedMatrix<T, R, C>::operator-= (const FixedMatrix<T, R, C>& other)
+{
+    for (std::size_t i = 0; i < R * C; ++i) { _matrix[i] -= other._matrix[i]; }
+    return *this;
+}
+
+template <typename T, std::size_t R, std::size_t C>
+inline constexpr LinAlg::FixedMatrix<T, R, C>& LinAlg::FixedMatrix<T, R, C>::operator*= (T value)
+{
+    for (std::size_t i = 0; i < R * C; ++i) { _matrix[i] *= value; }
+    return *this;
+}
+
+template <typename T, std::size_t R, std::size_t C>
+inline LinAlg::FixedMatrix<T, R, C>& LinAlg::FixedMatrix<T, R, C>::operator/= (T value)
+{
+    if (value == T()) { throw std::invalid_argument("Matrix division by zero"); }
+
+    for (std::size_t i = 0; i < R * C; ++i) { _matrix[i] /= value; }
+    return *this;
+}
+
+template <typename T, std::size_t R, std::size_t C>
+inline constexpr LinAlg::FixedMatrix<T, C, R> LinAlg::FixedMatrix<T, R, C>::transposed() const
+{
+    FixedMatrix<T, C, R> transposedMatrix;
+    for (std::size_t i = 0; i < R; ++i) {
+        for (std::size_t j = 0; j < C; ++j) { transposedMatrix(j, i) = _matrix[i * C + j]; }
+    }
+    return transposedMatrix;
+}
+
+template <typename T, std::size_t R, std::size_t C>
+inline T LinAlg::FixedMatrix<T, R, C>::determinant() const
+{
+    static_assert(R == C, "square Matrix required");
+
+    return LinAlg::Detail::FixedSquare<T, R>::determinant(_matrix);
+}
+
+template <typename T, std::size_t R, std::size_t C>
+inline LinAlg::FixedMatrix<T, R, C> LinAlg::FixedMatrix<T, R, C>::inverse() const
+{
+    static_assert(R == C, "square Matrix required");
+
+    FixedMatrix<T, R, C> inverseMatrix;
+    LinAlg::Detail::FixedSquare<T, R>::inverse(_matrix, inverseMatrix._matrix);
+    return inverseMatrix;
+}
+
+template <typename T, std::size_t R, std::size_t C>
+inline constexpr LinAlg::FixedMatrix<T, R, C> LinAlg::operator+ (const FixedMatrix<T, R, C>& lhs, const FixedMatrix<T, R, C>& rhs)
+{
+    FixedMatrix<T, R, C> resultMatrix(lhs);
+    resultMatrix += rhs;
+    return resultMatrix;
+}
+
+template <typename T, std::size_t R, std::size_t C>
+inline constexpr LinAlg::FixedMatrix<T, R, C> LinAlg::operator- (const FixedMatrix<T, R, C>& lhs, const FixedMatrix<T, R, C>& rhs)
+{
+    FixedMatrix<T, R, C> resultMatrix(lhs);
+    resultMatrix -= rhs;
+    return resultMatrix;
+}
+
+template <typename T, std::size_t R, std::size_t C>
+inline constexpr LinAlg::FixedMatrix<T, R, C> LinAlg::operator- (const FixedMatrix<T, R, C>& operand)
+{
+    FixedMatrix<T, R, C> resultMatrix;
+    for (std::size_t i = 0; i < R; ++i) {
+        for (std::size_t j = 0; j < C; ++j) { resultMatrix(i, j) = -operand(i, j); }
+    }
+    return resultMatrix;
+}
+
+template <typename T, std::size_t R, std::size_t C>
+inline constexpr LinAlg::FixedMatrix<T, R, C> LinAlg::operator* (const FixedMatrix<T, R, C>& operand, typename FixedMatrix<T, R, C>::value_type value)
+{
+    FixedMatrix<T, R, C> resultMatrix(operand);
+    resultMatrix *= value;
+    return resultMatrix;
+}
+
+template <typename T, std::size_t R, std::size_t C>
+inline constexpr LinAlg::FixedMatrix<T, R, C> LinAlg::operator* (typename FixedMatrix<T, R, C>::value_type value, const FixedMatrix<T, R, C>& operand)
+{
+    return operand * value;
+}
+
+template <typename T, std::size_t R, std::size_t C>
+inline LinAlg::FixedMatrix<T, R, C> LinAlg::operator/ (const FixedMatrix<T, R, C>& operand, typename FixedMatrix<T, R, C>::value_type value)
+{
+    FixedMatrix<T, R, C> resultMatrix(operand);
+    resultMatrix /= value;
+    return resultMatrix;
+}
+
+template <typename T, std::size_t R, std::size_t K, std::size_t C>
+inline constexpr LinAlg::FixedMatrix<T, R, C> LinAlg::operator* (const FixedMatrix<T, R, K>& lhs, const FixedMatrix<T, K, C>& rhs)
+{
+    FixedMatrix<T, R, C> resultMatrix;
+    for (std::size_t i = 0; i < R; ++i) {
+        for (std::size_t p = 0; p < K; ++p) {
+            const T value = lhs(i, p);
+            for (std::size_t j = 0; j < C; ++j) { resultMatrix(i, j) += value * rhs(p, j); }
+        }
+    }
+    return resultMatrix;
+}
+
+template <typename T, std::size_t R, std::size_t C>
+inline bool LinAlg::operator== (const FixedMatrix<T, R, C>& lhs, const FixedMatrix<T, R, C>& rhs)
+{
+    return LinAlg::Kernels::equal(R * C, lhs.data(), rhs.data());
+}
+
+template <typename T, std::size_t N>
+inline T LinAlg::Detail::FixedSquare<T, N>::determinant(const T* m)
+{
+    return fixed_determinant<T, N>(m, std::is_floating_point<T>());
+}
+
+template <typename T, std::size_t N>
+inline void LinAlg::Detail::FixedSquare<T, N>::inverse(const T* m, T* out)
+{
+    fixed_inverse<T, N>(m, out, std::is_floating_point<T>());
+}
+
+template <typename T>
+inline void LinAlg::Detail::FixedSquare<T, 1>::inverse(const T* m, T* out)
+{
+    if (m[0] == T()) { throw std::runtime_error("null determinant"); }
+
+    out[0] = T(1) / m[0];
+}
+
+template <typename T>
+inline void LinAlg::Detail::FixedSquare<T, 2>::inverse(const T* m, T* out)
+{
+    const T determinant = FixedSquare<T, 2>::determinant(m);
+    if (determinant == T()) { throw std::runtime_error("null determinant"); }
+
+    out[0] = m[3] / determinant;
+    out[1] = -m[1] / determinant;
+    out[2] = -m[2] / determinant;
+    out[3] = m[0] / determinant;
+}
+
+template <typename T>
+inline T LinAlg::Detail::FixedSquare<T, 3>::determinant(const T* m)
+{
+    return m[0] * (m[4] * m[8] - m[5] * m[7])
+         - m[1] * (m[3] * m[8] - m[5] * m[6])
+         + m[2] * (m[3] * m[7] - m[4] * m[6]);
+}
+
+template <typename T>
+inline void LinAlg::Detail::FixedSquare<T, 3>::inverse(const T* m, T* out)
+{
+    const T c00 = m[4] * m[8] - m[5] * m[7], c01 = m[5] * m[6] - m[3] * m[8], c02 = m[3] * m[7] - m[4] * m[6];
+    const T determinant = m[0] * c00 + m[1] * c01 + m[2] * c02;
+    if (determinant == T()) { throw std::runtime_error("null determinant"); }
+
+    out[0] = c00 / determinant;
+    out[1] = (m[2] * m[7] - m[1] * m[8]) / determinant;
+    out[2] = (m[1] * m[5] - m[2] * m[4]) / determinant;
+    out[3] = c01 / determinant;
+    out[4] = (m[0] * m[8] - m[2] * m[6]) / determinant;
+    out[5] = (m[2] * m[3] - m[0] * m[5]) / determinant;
+    out[6] = c02 / determinant;
+    out[7] = (m[1] * m[6] - m[0] * m[7]) / determinant;
+    out[8] = (m[0] * m[4] - m[1] * m[3]) / determinant;
+}
+
+template <typename T>
+inline T LinAlg::Detail::FixedSquare<T, 4>::determinant(const T* m)
+{
+    const T s0 = m[0] * m[5] - m[4] * m[1], s1 = m[0] * m[6] - m[4] * m[2], s2 = m[0] * m[7] - m[4] * m[3];
+    const T s3 = m[1] * m[6] - m[5] * m[2], s4 = m[1] * m[7] - m[5] * m[3], s5 = m[2] * m[7] - m[6] * m[3];
+    const T c0 = m[8] * m[13] - m[12] * m[9], c1 = m[8] * m[14] - m[12] * m[10], c2 = m[8] * m[15] - m[12] * m[11];
+    const T c3 = m[9] * m[14] - m[13] * m[10], c4 = m[9] * m[15] - m[13] * m[11], c5 = m[10] * m[15] - m[14] * m[11];
+    return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+}
+
+template <typename T>
+inline void LinAlg::Detail::FixedSquare<T, 4>::inverse(const T* m, T* out)
+{
+    const T s0 = m[0] * m[5] - m[4] * m[1], s1 = m[0] * m[6] - m[4] * m[2], s2 = m[0] * m[7] - m[4] * m[3];
+    const T s3 = m[1] * m[6] - m[5] * m[2], s4 = m[1] * m[7] - m[5] * m[3], s5 = m[2] * m[7] - m[6] * m[3];
+    const T c0 = m[8] * m[13] - m[12] * m[9], c1 = m[8] * m[14] - m[12] * m[10], c2 = m[8] * m[15] - m[12] * m[11];
+    const T c3 = m[9] * m[14] - m[13] * m[10], c4 = m[9] * m[15] - m[13] * m[11], c5 = m[10] * m[15] - m[14] * m[11];
+    const T determinant = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    if (determinant == T()) { throw std::runtime_error("null determinant"); }
+
+    out[0] = (m[5] * c5 - m[6] * c4 + m[7] * c3) / determinant;
+    out[1] = (-m[1] * c5 + m[2] * c4 - m[3] * c3) / determinant;
+    out[2] = (m[13] * s5 - m[14] * s4 + m[15] * s3) / determinant;
+    out[3] = (-m[9] * s5 + m[10] * s4 - m[11] * s3) / determinant;
+    out[4] = (-m[4] * c5 + m[6] * c2 - m[7] * c1) / determinant;
+    out[5] = (m[0] * c5 - m[2] * c2 + m[3] * c1) / determinant;
+    out[6] = (-m[12] * s5 + m[14] * s2 - m[15] * s1) / determinant;
+    out[7] = (m[8] * s5 - m[10] * s2 + m[11] * s1) / determinant;
+    out[8] = (m[4] * c4 - m[5] * c2 + m[7] * c0) / determinant;
+    out[9] = (-m[0] * c4 + m[1] * c2 - m[3] * c0) / determinant;
+    out[10] = (m[12] * s4 - m[13] * s2 + m[15] * s0) / determinant;
+    out[11] = (-m[8] * s4 + m[9] * s2 - m[11] * s0) / determinant;
+    out[12] = (-m[4] * c3 + m[5] * c1 - m[6] * c0) / determinant;
+    out[13] = (m[0] * c3 - m[1] * c1 + m[2] * c0) / determinant;
+    out[14] = (-m[12] * s3 + m[13] * s1 - m[14] * s0) / determinant;
+    out[15] = (m[8] * s3 - m[9] * s1 + m[10] * s0) / determinant;
+}
+
+template <typename T, std::size_t N>
+inline T LinAlg::Detail::fixed_determinant(const T* m, std::true_type)
+{
+    T work[N * N];
+    std::size_t pivots[N];
+    std::copy(m, m + N * N, work);
+    return LinAlg::Kernels::determinant_lu_in_place(N, work, pivots);
+}
+
+template <typename T, std::size_t N>
+inline T LinAlg::Detail::fixed_determinant(const T* m, std::false_type)
+{
+    LinAlg::Kernels::bareiss_integer work[N * N];
+    std::copy(m, m + N * N, work);
+    return static_cast<T>(LinAlg::Kernels::determinant_bareiss_in_place(N, work));
+}
+
+template <typename T, std::size_t N>
+inline void LinAlg::Detail::fixed_inverse(const T* m, T* out, std::true_type)
+{
+    std::size_t pivots[N];
+    std::copy(m, m + N * N, out);
+    if (!LinAlg::Kernels::invert_in_place(N, out, N, pivots)) { throw std::runtime_error("null determinant"); }
+}
+
+template <typename T, std::size_t N>
+inline void LinAlg::Detail::fixed_inverse(const T* m, T* out, std::false_type)
+{
+    LinAlg::Kernels::bareiss_integer work[N * 2 * N];
+    for (std::size_t i = 0; i < N; ++i) {
+        std::copy(m + i * N, m + (i + 1) * N, work + i * 2 * N);
+        std::fill(work + i * 2 * N + N, work + (i + 1) * 2 * N, LinAlg::Kernels::bareiss_integer());
+        work[i * 2 * N + N + i] = 1;
+    }
+    const LinAlg::Kernels::bareiss_integer determinant = LinAlg::Kernels::adjugate_bareiss_in_place(N, work);
+    if (determinant == 0) { throw std::runtime_error("null determinant"); }
+
+    for (std::size_t i = 0; i < N; ++i) {
+        for (std::size_t j = 0; j < N; ++j) { out[i * N + j] = static_cast<T>(work[i * 2 * N + N + j] / determinant); }
+    }
+}
+
+#endif // FIXED_MATRIX_HPP
@@ -0,0 +1,292 @@
+#ifndef INSTRUMENTATION_HPP
+#define INSTRUMENTATION_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+// Library operations report to the counters below only when LINALG_INSTRUMENTATION
+// is defined before the first library header is included. Otherwise the macros
+// expand to nothing, no counter is touched and every snapshot is zero.
+#ifdef LINALG_INSTRUMENTATION
+#define LINALG_INSTRUMENT_OPERATION(operation, flops, bytes) \
+    const ::LinAlg::ScopedOperation linalgScopedOperation((operation), (flops), (bytes))
+#define LINALG_INSTRUMENT_ALLOCATION(bytes) ::LinAlg::Detail::record_allocation(bytes)
+#else
+#define LINALG_INSTRUMENT_OPERATION(operation, flops, bytes) ((void)0)
+#define LINALG_INSTRUMENT_ALLOCATION(bytes) ((void)0)
+#endif
+
+namespace LinAlg
+{
+    enum class Operation
+    {
+        gemm,
+        matrix_vector,
+        transpose,
+        determinant,
+        inverse,
+        row_operation,
+        minor,
+        cofactor,
+        adjoint
+    };
+
+    const std::size_t operation_count = 9;
+
+    // Totals of one operation. Flops and bytes are the nominal counts of the
+    // algorithm, bytes being every operand read and result written once. Time
+    // and allocations are inclusive: an operation also accounts for the nested
+    // operations it runs on the calling thread.
+    struct OperationStatistics
+    {
+        std::uint64_t calls;
+        std::uint64_t flops;
+        std::uint64_t bytes;
+        std::uint64_t allocations;
+        std::uint64_t allocated_bytes;
+        std::uint64_t nanoseconds;
+    };
+
+    struct InstrumentationSnapshot
+    {
+        OperationStatistics operations[operation_count];
+        // Heap allocations of Matrix storage, inside operations or not.
+        std::uint64_t allocations;
+        std::uint64_t allocated_bytes;
+
+        const OperationStatistics& operator[](Operation operation) const { return operations[static_cast<std::size_t>(operation)]; }
+    };
+
+    constexpr bool instrumentation_enabled()
+    {
+#ifdef LINALG_INSTRUMENTATION
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    const char* operation_name(Operation operation);
+
+    // Sum over all threads, including those that have exited, since the last reset.
+    InstrumentationSnapshot instrumentation_snapshot();
+    void reset_instrumentation();
+
+    // Calls sink once per operation with the current totals, the hook for
+    // forwarding them to an external metrics system.
+    typedef std::function<void(const char*, const OperationStatistics&)> InstrumentationSink;
+    void export_instrumentation(const InstrumentationSink& sink);
+
+    // Records one call of operation when destroyed, with the time and the
+    // allocations of the calling thread since construction.
+    class ScopedOperation
+    {
+    public:
+        ScopedOperation(Operation operation, std::uint64_t flops, std::uint64_t bytes);
+        ScopedOperation(const ScopedOperation&) = delete;
+        ScopedOperation& operator= (const ScopedOperation&) = delete;
+        ~ScopedOperation();
+
+    private:
+        Operation _operation;
+        std::uint64_t _flops;
+        std::uint64_t _bytes;
+        std::uint64_t _allocations;
+        std::uint64_t _allocatedBytes;
+        std::chrono::steady_clock::time_point _start;
+    };
+
+    namespace Detail
+    {
+        const std::size_t statistic_count = 6;
+
+        // Counters of one thread, operations[i] in the field order of
+        // OperationStatistics. Only the owning thread writes them, so updates are
+        // plain relaxed loads and stores; aggregation reads them concurrently.
+        struct ThreadCounters
+        {
+            std::atomic<std::uint64_t> operations[operation_count][statistic_count];
+            std::atomic<std::uint64_t> allocations;
+            std::atomic<std::uint64_t> allocatedBytes;
+
+            ThreadCounters();
+            void add_to(InstrumentationSnapshot& snapshot) const;
+        };
+
+        // Live thread counters, the totals of exited threads and the snapshot
+        // taken by the last reset, which later snapshots are relative to.
+        struct InstrumentationRegistry
+        {
+            std::mutex mutex;
+            std::vector<const ThreadCounters*> threads;
+            InstrumentationSnapshot retired;
+            InstrumentationSnapshot baseline;
+        };
+
+        class ThreadCountersHandle
+        {
+        public:
+            ThreadCountersHandle();
+            ~ThreadCountersHandle();
+
+            ThreadCounters counters;
+        };
+
+        // Never destroyed, so that threads exiting during static destruction can
+        // still retire their counters.
+        InstrumentationRegistry& instrumentation_registry();
+        ThreadCounters& thread_counters();
+
+        void add_counter(std::atomic<std::uint64_t>& counter, std::uint64_t value);
+        void record_allocation(std::size_t bytes);
+    }
+}
+
+inline const char* LinAlg::operation_name(Operation operation)
+{
+    switch (operation) {
+    case Operation::gemm: return "gemm";
+    case Operation::matrix_vector: return "matrix_vector";
+    case Operation::transpose: return "transpose";
+    case Operation::determinant: return "determinant";
+    case Operation::inverse: return "inverse";
+    case Operation::row_operation: return "row_operation";
+    case Operation::minor: return "minor";
+    case Operation::cofactor: return "cofactor";
+    case Operation::adjoint: return "adjoint";
+    }
+    return "unknown";
+}
+
+inline LinAlg::Detail::ThreadCounters::ThreadCounters()
+    : allocations(0), allocatedBytes(0)
+{
+    for (std::size_t i = 0; i < operation_count; ++i) {
+        for (std::size_t j = 0; j < statistic_count; ++j) { operations[i][j].store(0, std::memory_order_relaxed); }
+    }
+}
+
+inline void LinAlg::Detail::ThreadCounters::add_to(InstrumentationSnapshot& snapshot) const
+{
+    for (std::size_t i = 0; i < operation_count; ++i) {
+        OperationStatistics& statistics = snapshot.operations[i];
+        statistics.calls += operations[i][0].load(std::memory_order_relaxed);
+        statistics.flops += operations[i][1].load(std::memory_order_relaxed);
+        statistics.bytes += operations[i][2].load(std::memory_order_relaxed);
+        statistics.allocations += operations[i][3].load(std::memory_order_relaxed);
+        statistics.allocated_bytes += operations[i][4].load(std::memory_order_relaxed);
+        statistics.nanoseconds += operations[i][5].load(std::memory_order_relaxed);
+    }
+    snapshot.allocations += allocations.load(std::memory_order_relaxed);
+    snapshot.allocated_bytes += allocatedBytes.load(std::memory_order_relaxed);
+}
+
+inline LinAlg::Detail::InstrumentationRegistry& LinAlg::Detail::instrumentation_registry()
+{
+    static InstrumentationRegistry* registry = new InstrumentationRegistry();
+    return *registry;
+}
+
+inline LinAlg::Detail::ThreadCountersHandle::ThreadCountersHandle()
+{
+    InstrumentationRegistry& registry = instrumentation_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.threads.push_back(&counters);
+}
+
+inline LinAlg::Detail::ThreadCountersHandle::~ThreadCountersHandle()
+{
+    InstrumentationRegistry& registry = instrumentation_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    counters.add_to(registry.retired);
+    registry.threads.erase(std::find(registry.threads.begin(), registry.threads.end(), &counters));
+}
+
+inline LinAlg::Detail::ThreadCounters& LinAlg::Detail::thread_counters()
+{
+    thread_local ThreadCountersHandle handle;
+    return handle.counters;
+}
+
+inline void LinAlg::Detail::add_counter(std::atomic<std::uint64_t>& counter, std::uint64_t value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+inline void LinAlg::Detail::record_allocation(std::size_t bytes)
+{
+    ThreadCounters& counters = thread_counters();
+    add_counter(counters.allocations, 1);
+    add_counter(counters.allocatedBytes, bytes);
+}
+
+inline LinAlg::InstrumentationSnapshot LinAlg::instrumentation_snapshot()
+{
+    Detail::InstrumentationRegistry& registry = Detail::instrumentation_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    InstrumentationSnapshot snapshot = registry.retired;
+    for (const Detail::ThreadCounters* counters : registry.threads) { counters->add_to(snapshot); }
+
+    for (std::size_t i = 0; i < operation_count; ++i) {
+        OperationStatistics& statistics = snapshot.operations[i];
+        const OperationStatistics& baseline = registry.baseline.operations[i];
+        statistics.calls -= baseline.calls;
+        statistics.flops -= baseline.flops;
+        statistics.bytes -= baseline.bytes;
+        statistics.allocations -= baseline.allocations;
+        statistics.allocated_bytes -= baseline.allocated_bytes;
+        statistics.nanoseconds -= baseline.nanoseconds;
+    }
+    snapshot.allocations -= registry.baseline.allocations;
+    snapshot.allocated_bytes -= registry.baseline.allocated_bytes;
+    return snapshot;
+}
+
+// Counters are never written by other threads, so a reset moves the baseline
+// instead of clearing them.
+inline void LinAlg::reset_instrumentation()
+{
+    Detail::InstrumentationRegistry& registry = Detail::instrumentation_registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    InstrumentationSnapshot totals = registry.retired;
+    for (const Detail::ThreadCounters* counters : registry.threads) { counters->add_to(totals); }
+    registry.baseline = totals;
+}
+
+inline void LinAlg::export_instrumentation(const InstrumentationSink& sink)
+{
+    const InstrumentationSnapshot snapshot = instrumentation_snapshot();
+    for (std::size_t i = 0; i < operation_count; ++i) {
+        sink(operation_name(static_cast<Operation>(i)), snapshot.operations[i]);
+    }
+}
+
+inline LinAlg::ScopedOperation::ScopedOperation(Operation operation, std::uint64_t flops, std::uint64_t bytes)
+    : _operation(operation), _flops(flops), _bytes(bytes), _allocations(0), _allocatedBytes(0), _start()
+{
+    const Detail::ThreadCounters& counters = Detail::thread_counters();
+    _allocations = counters.allocations.load(std::memory_order_relaxed);
+    _allocatedBytes = counters.allocatedBytes.load(std::memory_order_relaxed);
+    _start = std::chrono::steady_clock::now();
+}
+
+inline LinAlg::ScopedOperation::~ScopedOperation()
+{
+    const std::chrono::steady_clock::duration elapsed = std::chrono::steady_clock::now() - _start;
+    Detail::ThreadCounters& counters = Detail::thread_counters();
+    std::atomic<std::uint64_t>* statistics = counters.operations[static_cast<std::size_t>(_operation)];
+    Detail::add_counter(statistics[0], 1);
+    Detail::add_counter(statistics[1], _flops);
+    Detail::add_counter(statistics[2], _bytes);
+    Detail::add_counter(statistics[3], counters.allocations.load(std::memory_order_relaxed) - _allocations);
+    Detail::add_counter(statistics[4], counters.allocatedBytes.load(std::memory_order_relaxed) - _allocatedBytes);
+    Detail::add_counter(statistics[5], static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+}
+
+#endif // INSTRUMENTATION_HPP
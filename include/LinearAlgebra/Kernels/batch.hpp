@@ -0,0 +1,191 @@
+#ifndef BATCH_HPP
+#define BATCH_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace LinAlg
+{
+    namespace Kernels
+    {
+        // Interleaved batch layout: a block of batch_lanes matrices is stored
+        // contiguously, entry e of the row-major matrix l of the block at
+        // x[e * batch_lanes + l]. Every kernel processes one block with fixed-length
+        // inner loops across the lanes, which the compiler turns into SIMD code.
+        // A nonzero order template argument replaces the runtime order with a
+        // compile-time constant, fully unrolling the loops over entries.
+        const std::size_t batch_lanes = 16;
+
+        // C = A B for m x k A, k x n B and m x n C.
+        template <std::size_t M, std::size_t K, std::size_t N, typename T>
+        void batch_gemm(std::size_t m, std::size_t k, std::size_t n, const T* a, const T* b, T* c);
+
+        // In-place LU with partial pivoting chosen independently for every matrix,
+        // as in lu_factor. Row k was exchanged with row pivots[k * batch_lanes + l]
+        // of matrix l, and singular[l] is set when one of its pivots is exactly zero.
+        template <std::size_t N, typename T>
+        void batch_lu_factor(std::size_t n, T* a, std::size_t* pivots, unsigned char* singular);
+
+        // Solves A X = B in place for the n x nrhs matrices B given the output of
+        // batch_lu_factor. Lanes with a zero pivot produce zero rather than inf.
+        template <std::size_t N, typename T>
+        void batch_lu_solve(std::size_t n, std::size_t nrhs, const T* lu, const std::size_t* pivots, T* b);
+
+        template <std::size_t N, typename T>
+        void batch_lu_determinant(std::size_t n, const T* lu, const std::size_t* pivots, T* determinants);
+
+        // Calls f(std::integral_constant<std::size_t, N>()) with N = n for the
+        // orders that have unrolled kernels and N = 0 otherwise.
+        template <typename F>
+        void batch_dispatch(std::size_t n, F f);
+    }
+}
+
+template <std::size_t M, std::size_t K, std::size_t N, typename T>
+inline void LinAlg::Kernels::batch_gemm(std::size_t m, std::size_t k, std::size_t n, const T* a, const T* b, T* c)
+{
+    const std::size_t rows = M == 0 ? m : M;
+    const std::size_t inner = K == 0 ? k : K;
+    const std::size_t cols = N == 0 ? n : N;
+
+    for (std::size_t i = 0; i < rows; ++i) {
+        for (std::size_t j = 0; j < cols; ++j) {
+            T sum[batch_lanes] = {};
+            for (std::size_t p = 0; p < inner; ++p) {
+                const T* x = a + (i * inner + p) * batch_lanes;
+                const T* y = b + (p * cols + j) * batch_lanes;
+                for (std::size_t l = 0; l < batch_lanes; ++l) { sum[l] += x[l] * y[l]; }
+            }
+            T* z = c + (i * cols + j) * batch_lanes;
+            for (std::size_t l = 0; l < batch_lanes; ++l) { z[l] = sum[l]; }
+        }
+    }
+}
+
+template <std::size_t N, typename T>
+inline void LinAlg::Kernels::batch_lu_factor(std::size_t n, T* a, std::size_t* pivots, unsigned char* singular)
+{
+    const std::size_t order = N == 0 ? n : N;
+    const auto entry = [=](std::size_t i, std::size_t j) { return a + (i * order + j) * batch_lanes; };
+
+    for (std::size_t l = 0; l < batch_lanes; ++l) { singular[l] = 0; }
+
+    for (std::size_t k = 0; k < order; ++k) {
+        T largest[batch_lanes];
+        std::size_t pivot[batch_lanes];
+        const T* diagonal = entry(k, k);
+        for (std::size_t l = 0; l < batch_lanes; ++l) {
+            largest[l] = diagonal[l] < T() ? -diagonal[l] : diagonal[l];
+            pivot[l] = k;
+        }
+        for (std::size_t i = k + 1; i < order; ++i) {
+            const T* candidate = entry(i, k);
+            for (std::size_t l = 0; l < batch_lanes; ++l) {
+                const T value = candidate[l] < T() ? -candidate[l] : candidate[l];
+                if (value > largest[l]) {
+                    largest[l] = value;
+                    pivot[l] = i;
+                }
+            }
+        }
+
+        // Row exchanges differ from lane to lane, so they are the only scalar step.
+        for (std::size_t l = 0; l < batch_lanes; ++l) {
+            pivots[k * batch_lanes + l] = pivot[l];
+            if (pivot[l] != k) {
+                for (std::size_t j = 0; j < order; ++j) { std::swap(entry(k, j)[l], entry(pivot[l], j)[l]); }
+            }
+        }
+
+        T inverse[batch_lanes];
+        for (std::size_t l = 0; l < batch_lanes; ++l) {
+            singular[l] |= static_cast<unsigned char>(diagonal[l] == T());
+            inverse[l] = diagonal[l] == T() ? T() : T(1) / diagonal[l];
+        }
+
+        for (std::size_t i = k + 1; i < order; ++i) {
+            T* multiplier = entry(i, k);
+            for (std::size_t l = 0; l < batch_lanes; ++l) { multiplier[l] *= inverse[l]; }
+            for (std::size_t j = k + 1; j < order; ++j) {
+                T* target = entry(i, j);
+                const T* source = entry(k, j);
+                for (std::size_t l = 0; l < batch_lanes; ++l) { target[l] -= multiplier[l] * source[l]; }
+            }
+        }
+    }
+}
+
+template <std::size_t N, typename T>
+inline void LinAlg::Kernels::batch_lu_solve(std::size_t n, std::size_t nrhs, const T* lu, const std::size_t* pivots, T* b)
+{
+    const std::size_t order = N == 0 ? n : N;
+    const auto factor = [=](std::size_t i, std::size_t j) { return lu + (i * order + j) * batch_lanes; };
+    const auto entry = [=](std::size_t i, std::size_t r) { return b + (i * nrhs + r) * batch_lanes; };
+
+    for (std::size_t k = 0; k < order; ++k) {
+        for (std::size_t l = 0; l < batch_lanes; ++l) {
+            const std::size_t pivot = pivots[k * batch_lanes + l];
+            if (pivot != k) {
+                for (std::size_t r = 0; r < nrhs; ++r) { std::swap(entry(k, r)[l], entry(pivot, r)[l]); }
+            }
+        }
+    }
+
+    for (std::size_t i = 1; i < order; ++i) {
+        for (std::size_t j = 0; j < i; ++j) {
+            const T* multiplier = factor(i, j);
+            for (std::size_t r = 0; r < nrhs; ++r) {
+                T* target = entry(i, r);
+                const T* source = entry(j, r);
+                for (std::size_t l = 0; l < batch_lanes; ++l) { target[l] -= multiplier[l] * source[l]; }
+            }
+        }
+    }
+
+    for (std::size_t i = order; i-- > 0;) {
+        for (std::size_t j = i + 1; j < order; ++j) {
+            const T* multiplier = factor(i, j);
+            for (std::size_t r = 0; r < nrhs; ++r) {
+                T* target = entry(i, r);
+                const T* source = entry(j, r);
+                for (std::size_t l = 0; l < batch_lanes; ++l) { target[l] -= multiplier[l] * source[l]; }
+            }
+        }
+
+        const T* diagonal = factor(i, i);
+        T inverse[batch_lanes];
+        for (std::size_t l = 0; l < batch_lanes; ++l) { inverse[l] = diagonal[l] == T() ? T() : T(1) / diagonal[l]; }
+        for (std::size_t r = 0; r < nrhs; ++r) {
+            T* target = entry(i, r);
+            for (std::size_t l = 0; l < batch_lanes; ++l) { target[l] *= inverse[l]; }
+        }
+    }
+}
+
+template <std::size_t N, typename T>
+inline void LinAlg::Kernels::batch_lu_determinant(std::size_t n, const T* lu, const std::size_t* pivots, T* determinants)
+{
+    const std::size_t order = N == 0 ? n : N;
+
+    for (std::size_t l = 0; l < batch_lanes; ++l) { determinants[l] = order == 0 ? T() : T(1); }
+    for (std::size_t k = 0; k < order; ++k) {
+        const T* diagonal = lu + (k * order + k) * batch_lanes;
+        for (std::size_t l = 0; l < batch_lanes; ++l) {
+            determinants[l] *= pivots[k * batch_lanes + l] == k ? diagonal[l] : -diagonal[l];
+        }
+    }
+}
+
+template <typename F>
+inline void LinAlg::Kernels::batch_dispatch(std::size_t n, F f)
+{
+    switch (n) {
+    case 2: f(std::integral_constant<std::size_t, 2>()); break;
+    case 3: f(std::integral_constant<std::size_t, 3>()); break;
+    case 4: f(std::integral_constant<std::size_t, 4>()); break;
+    default: f(std::integral_constant<std::size_t, 0>()); break;
+    }
+}
+
+#endif // BATCH_HPP
@@ -0,0 +1,326 @@
+#ifndef CHOLESKY_HPP
+#define CHOLESKY_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "../ExecutionPolicy.hpp"
+#include "elementwise.hpp"
+#include "gemm.hpp"
+
+namespace LinAlg
+{
+    namespace Kernels
+    {
+        const std::size_t cholesky_block_size = 64;
+
+        // Packed lower triangular storage: row i of an n x n lower triangle holds
+        // i + 1 contiguous entries starting at packed_index(i, 0).
+        inline std::size_t packed_size(std::size_t n) { return n * (n + 1) / 2; }
+        inline std::size_t packed_index(std::size_t i, std::size_t j) { return i * (i + 1) / 2 + j; }
+
+        template <typename T>
+        void pack_lower(std::size_t n, const T* a, std::size_t lda, T* packed);
+
+        // Right-looking blocked Cholesky A = L L^T of the row-major n x n matrix a.
+        // Only the lower triangle is read and it is overwritten by L; the strict
+        // upper triangle is clobbered. Returns zero on success, or one plus the
+        // index of the first non-positive pivot.
+        template <typename T>
+        std::size_t cholesky_factor(std::size_t n, T* a, std::size_t lda);
+
+        // Solves L L^T X = B in place for the n x nrhs row-major B and packed L.
+        template <typename T>
+        void cholesky_solve_packed(std::size_t n, std::size_t nrhs, const T* l, T* b, std::size_t ldb);
+
+        // Replaces packed L by the factor of L L^T + sign x x^T, sign being 1 for an
+        // update and -1 for a downdate. x is destroyed. Returns false and leaves L
+        // partially modified if a downdate loses positive definiteness.
+        template <typename T>
+        bool cholesky_rank_update_packed(std::size_t n, T* l, T* x, T sign);
+
+        // Bunch-Kaufman factorization A = L D L^T of the symmetric row-major n x n
+        // matrix a, reading and overwriting its lower triangle. D is block diagonal
+        // with 1 x 1 and 2 x 2 blocks; blocks[k] is 1 or 2 at the first row of a
+        // block and 0 at the second row of a 2 x 2 block. The last row kk of the
+        // block starting at k was interchanged with row pivots[kk] >= kk of the
+        // trailing matrix; other rows have pivots[i] = i. Returns zero on success,
+        // or one plus the index of the first exactly singular block of D.
+        template <typename T>
+        std::size_t ldlt_factor(std::size_t n, T* a, std::size_t lda, std::size_t* pivots, unsigned char* blocks);
+
+        // Solves A X = B in place for the n x nrhs row-major B, given the packed
+        // lower triangle of the output of ldlt_factor.
+        template <typename T>
+        void ldlt_solve_packed(std::size_t n, std::size_t nrhs, const T* ld, const std::size_t* pivots, const unsigned char* blocks,
+                               T* b, std::size_t ldb);
+    }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::pack_lower(std::size_t n, const T* a, std::size_t lda, T* packed)
+{
+    for (std::size_t i = 0; i < n; ++i) { std::copy(a + i * lda, a + i * lda + i + 1, packed + packed_index(i, 0)); }
+}
+
+template <typename T>
+inline std::size_t LinAlg::Kernels::cholesky_factor(std::size_t n, T* a, std::size_t lda)
+{
+    std::vector<T> transposed(cholesky_block_size * cholesky_block_size), panel;
+
+    for (std::size_t k = 0; k < n; k += cholesky_block_size) {
+        const std::size_t nb = std::min(cholesky_block_size, n - k);
+
+        // L11 from the already updated diagonal block
+        for (std::size_t j = k; j < k + nb; ++j) {
+            T* rowJ = a + j * lda;
+            const T pivot = rowJ[j] - dot(j - k, rowJ + k, rowJ + k);
+            if (!(pivot > T())) { return j + 1; }
+            rowJ[j] = std::sqrt(pivot);
+            for (std::size_t i = j + 1; i < k + nb; ++i) {
+                T* rowI = a + i * lda;
+                rowI[j] = (rowI[j] - dot(j - k, rowI + k, rowJ + k)) / rowJ[j];
+            }
+        }
+
+        const std::size_t trailing = n - k - nb;
+        if (trailing == 0) { break; }
+
+        // L21 = A21 L11^-T, one independent forward substitution per row against
+        // a contiguous copy of L11^T
+        for (std::size_t j = 0; j < nb; ++j) {
+            for (std::size_t i = j; i < nb; ++i) { transposed[j * nb + i] = a[(k + i) * lda + k + j]; }
+        }
+        const T* l11t = transposed.data();
+        const std::size_t rowGrain = 8 * GemmBlocking<T>::MR;
+        LinAlg::parallel_for(trailing * nb * nb, k + nb, n, rowGrain, [=](std::size_t firstRow, std::size_t lastRow) {
+            for (std::size_t i = firstRow; i < lastRow; ++i) {
+                T* row = a + i * lda + k;
+                for (std::size_t j = 0; j < nb; ++j) {
+                    row[j] /= l11t[j * nb + j];
+                    if (row[j] != T()) { axpy(nb - j - 1, -row[j], l11t + j * nb + j + 1, row + j + 1); }
+                }
+            }
+        });
+
+        // A22 -= L21 L21^T on the lower triangle, in row strips that each stop at
+        // their last row. L21^T is copied once so that gemm packs it with unit stride.
+        const T* l21 = a + (k + nb) * lda + k;
+        T* a22 = a + (k + nb) * lda + k + nb;
+        panel.resize(nb * trailing);
+        for (std::size_t i = 0; i < trailing; ++i) {
+            for (std::size_t j = 0; j < nb; ++j) { panel[j * trailing + i] = l21[i * lda + j]; }
+        }
+        const T* l21t = panel.data();
+        LinAlg::parallel_for(trailing * trailing * nb / 2, 0, trailing, rowGrain, [=](std::size_t firstRow, std::size_t lastRow) {
+            for (std::size_t first = firstRow; first < lastRow; first += cholesky_block_size) {
+                const std::size_t last = std::min(first + cholesky_block_size, lastRow);
+                gemm<T>(last - first, last, nb, T(-1),
+                        l21 + first * lda, lda, 1,
+                        l21t, trailing, 1,
+                        T(1), a22 + first * lda, lda);
+            }
+        });
+    }
+    return 0;
+}
+
+template <typename T>
+inline void LinAlg::Kernels::cholesky_solve_packed(std::size_t n, std::size_t nrhs, const T* l, T* b, std::size_t ldb)
+{
+    if (nrhs == 1) {
+        for (std::size_t i = 0; i < n; ++i) {
+            const T* row = l + packed_index(i, 0);
+            T sum = T();
+            if (ldb == 1) {
+                sum = dot(i, row, b);
+            } else {
+                for (std::size_t j = 0; j < i; ++j) { sum += row[j] * b[j * ldb]; }
+            }
+            b[i * ldb] = (b[i * ldb] - sum) / row[i];
+        }
+        for (std::size_t i = n; i-- > 0;) {
+            const T* row = l + packed_index(i, 0);
+            b[i * ldb] /= row[i];
+            const T value = b[i * ldb];
+            for (std::size_t j = 0; j < i; ++j) { b[j * ldb] -= row[j] * value; }
+        }
+        return;
+    }
+
+    for (std::size_t i = 0; i < n; ++i) {
+        const T* row = l + packed_index(i, 0);
+        for (std::size_t j = 0; j < i; ++j) {
+            if (row[j] != T()) { axpy(nrhs, -row[j], b + j * ldb, b + i * ldb); }
+        }
+        divide(nrhs, row[i], b + i * ldb);
+    }
+    for (std::size_t i = n; i-- > 0;) {
+        const T* row = l + packed_index(i, 0);
+        divide(nrhs, row[i], b + i * ldb);
+        for (std::size_t j = 0; j < i; ++j) {
+            if (row[j] != T()) { axpy(nrhs, -row[j], b + i * ldb, b + j * ldb); }
+        }
+    }
+}
+
+template <typename T>
+inline bool LinAlg::Kernels::cholesky_rank_update_packed(std::size_t n, T* l, T* x, T sign)
+{
+    for (std::size_t k = 0; k < n; ++k) {
+        T& diagonal = l[packed_index(k, k)];
+        const T square = diagonal * diagonal + sign * x[k] * x[k];
+        if (!(square > T())) { return false; }
+
+        const T radius = std::sqrt(square);
+        const T c = radius / diagonal;
+        const T s = x[k] / diagonal;
+        diagonal = radius;
+        for (std::size_t i = k + 1; i < n; ++i) {
+            T& value = l[packed_index(i, k)];
+            value = (value + sign * s * x[i]) / c;
+            x[i] = c * x[i] - s * value;
+        }
+    }
+    return true;
+}
+
+template <typename T>
+inline std::size_t LinAlg::Kernels::ldlt_factor(std::size_t n, T* a, std::size_t lda, std::size_t* pivots, unsigned char* blocks)
+{
+    const T alpha = (T(1) + std::sqrt(T(17))) / T(8);
+    std::vector<T> column1(n), column2(n);
+    std::size_t info = 0;
+
+    const auto at = [=](std::size_t i, std::size_t j) -> T& { return a[i * lda + j]; };
+    const auto magnitude = [](T value) { return value < T() ? -value : value; };
+
+    std::size_t k = 0;
+    while (k < n) {
+        const T absakk = magnitude(at(k, k));
+        std::size_t imax = k;
+        T colmax = T();
+        for (std::size_t i = k + 1; i < n; ++i) {
+            if (magnitude(at(i, k)) > colmax) {
+                imax = i;
+                colmax = magnitude(at(i, k));
+            }
+        }
+
+        std::size_t kp = k, kstep = 1;
+        if (std::max(absakk, colmax) == T()) {
+            if (info == 0) { info = k + 1; }
+            pivots[k] = k;
+            blocks[k] = 1;
+            ++k;
+            continue;
+        }
+
+        if (absakk < alpha * colmax) {
+            T rowmax = T();
+            for (std::size_t j = k; j < imax; ++j) { rowmax = std::max(rowmax, magnitude(at(imax, j))); }
+            for (std::size_t i = imax + 1; i < n; ++i) { rowmax = std::max(rowmax, magnitude(at(i, imax))); }
+
+            if (absakk >= alpha * colmax * (colmax / rowmax)) {
+                kp = k;
+            } else if (magnitude(at(imax, imax)) >= alpha * rowmax) {
+                kp = imax;
+            } else {
+                kp = imax;
+                kstep = 2;
+            }
+        }
+
+        // Symmetric interchange of kk and kp within the lower trailing triangle
+        const std::size_t kk = k + kstep - 1;
+        if (kp != kk) {
+            for (std::size_t i = kp + 1; i < n; ++i) { std::swap(at(i, kk), at(i, kp)); }
+            for (std::size_t j = kk + 1; j < kp; ++j) { std::swap(at(j, kk), at(kp, j)); }
+            std::swap(at(kk, kk), at(kp, kp));
+            if (kstep == 2) { std::swap(at(k + 1, k), at(kp, k)); }
+        }
+
+        const std::size_t next = k + kstep;
+        if (kstep == 1) {
+            const T d = at(k, k);
+            for (std::size_t i = next; i < n; ++i) { column1[i] = at(i, k); }
+            for (std::size_t i = next; i < n; ++i) {
+                const T multiplier = column1[i] / d;
+                if (multiplier != T()) { axpy(i + 1 - next, -multiplier, column1.data() + next, a + i * lda + next); }
+                at(i, k) = multiplier;
+            }
+        } else {
+            const T d11 = at(k, k), d21 = at(k + 1, k), d22 = at(k + 1, k + 1);
+            const T determinant = d11 * d22 - d21 * d21;
+            for (std::size_t i = next; i < n; ++i) {
+                column1[i] = at(i, k);
+                column2[i] = at(i, k + 1);
+            }
+            for (std::size_t i = next; i < n; ++i) {
+                const T multiplier1 = (d22 * column1[i] - d21 * column2[i]) / determinant;
+                const T multiplier2 = (d11 * column2[i] - d21 * column1[i]) / determinant;
+                T* row = a + i * lda + next;
+                if (multiplier1 != T()) { axpy(i + 1 - next, -multiplier1, column1.data() + next, row); }
+                if (multiplier2 != T()) { axpy(i + 1 - next, -multiplier2, column2.data() + next, row); }
+                at(i, k) = multiplier1;
+                at(i, k + 1) = multiplier2;
+            }
+        }
+
+        for (std::size_t i = k; i < next; ++i) { pivots[i] = i; }
+        pivots[kk] = kp;
+        blocks[k] = static_cast<unsigned char>(kstep);
+        if (kstep == 2) { blocks[k + 1] = 0; }
+        k = next;
+    }
+    return info;
+}
+
+template <typename T>
+inline void LinAlg::Kernels::ldlt_solve_packed(std::size_t n, std::size_t nrhs, const T* ld, const std::size_t* pivots, const unsigned char* blocks,
+                                               T* b, std::size_t ldb)
+{
+    const auto row = [=](std::size_t i) { return b + i * ldb; };
+    const auto at = [=](std::size_t i, std::size_t j) { return ld[packed_index(i, j)]; };
+    const auto update = [=](T* target, T multiplier, const T* source) {
+        if (multiplier != T()) { axpy(nrhs, -multiplier, source, target); }
+    };
+
+    // L D Y = P B, applying every interchange before the block column it precedes
+    for (std::size_t k = 0; k < n;) {
+        const std::size_t kk = k + blocks[k] - 1;
+        if (pivots[kk] != kk) { std::swap_ranges(row(kk), row(kk) + nrhs, row(pivots[kk])); }
+
+        for (std::size_t i = kk + 1; i < n; ++i) {
+            for (std::size_t j = k; j <= kk; ++j) { update(row(i), at(i, j), row(j)); }
+        }
+
+        if (blocks[k] == 1) {
+            divide(nrhs, at(k, k), row(k));
+        } else {
+            const T d11 = at(k, k), d21 = at(k + 1, k), d22 = at(k + 1, k + 1);
+            const T determinant = d11 * d22 - d21 * d21;
+            for (std::size_t j = 0; j < nrhs; ++j) {
+                const T b1 = row(k)[j], b2 = row(k + 1)[j];
+                row(k)[j] = (d22 * b1 - d21 * b2) / determinant;
+                row(k + 1)[j] = (d11 * b2 - d21 * b1) / determinant;
+            }
+        }
+        k = kk + 1;
+    }
+
+    // L^T P^T X = Y in reverse block order
+    for (std::size_t kk = n; kk-- > 0;) {
+        const std::size_t k = blocks[kk] == 0 ? kk - 1 : kk;
+        for (std::size_t j = k; j <= kk; ++j) {
+            for (std::size_t i = kk + 1; i < n; ++i) { update(row(j), at(i, j), row(i)); }
+        }
+        if (pivots[kk] != kk) { std::swap_ranges(row(kk), row(kk) + nrhs, row(pivots[kk])); }
+        kk = k;
+    }
+}
+
+#endif // CHOLESKY_HPP
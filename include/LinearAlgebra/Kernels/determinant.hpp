@@ -0,0 +1,181 @@
+#ifndef DETERMINANT_HPP
+#define DETERMINANT_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "lu.hpp"
+
+namespace LinAlg
+{
+    namespace Kernels
+    {
+        // Determinant of the row-major n x n matrix a through the partially
+        // pivoted LU factorization. The input is left untouched.
+        template <typename T>
+        T determinant_lu(std::size_t n, const T* a, std::size_t lda);
+
+        // Without a 128-bit integer the products are checked and an overflow
+        // throws instead of returning a wrong determinant.
+#ifdef __SIZEOF_INT128__
+        __extension__ typedef __int128 bareiss_integer;
+#else
+        typedef long long bareiss_integer;
+#endif
+
+        // Fraction-free Bareiss elimination: every intermediate value is itself a
+        // minor of a, so integral determinants are exact as long as the products
+        // of two such minors fit in bareiss_integer.
+        template <typename T>
+        T determinant_bareiss(std::size_t n, const T* a, std::size_t lda);
+
+        // Workspace variants: the n x n work matrix is overwritten and pivots (n)
+        // is caller-provided, so nothing is allocated.
+        template <typename T>
+        T determinant_lu_in_place(std::size_t n, T* work, std::size_t* pivots);
+
+        bareiss_integer determinant_bareiss_in_place(std::size_t n, bareiss_integer* work);
+
+        // Fraction-free Gauss-Jordan elimination of the row-major n x 2n work
+        // matrix [a | I]. The right half is left holding d a^-1, where d is the
+        // returned determinant of the row-permuted a, so d a^-1 is the adjugate
+        // of a up to sign. Returns zero when a is singular.
+        bareiss_integer adjugate_bareiss_in_place(std::size_t n, bareiss_integer* work);
+
+        // (a * b - c * d) / divisor, the exact division of one Bareiss step.
+        bareiss_integer bareiss_step(bareiss_integer a, bareiss_integer b, bareiss_integer c, bareiss_integer d, bareiss_integer divisor);
+    }
+}
+
+template <typename T>
+inline T LinAlg::Kernels::determinant_lu_in_place(std::size_t n, T* work, std::size_t* pivots)
+{
+    if (lu_factor(n, work, n, pivots) != 0) { return T(); }
+
+    T determinant = T(1);
+    for (std::size_t i = 0; i < n; ++i) {
+        determinant *= work[i * n + i];
+        if (pivots[i] != i) { determinant = -determinant; }
+    }
+    return determinant;
+}
+
+template <typename T>
+inline T LinAlg::Kernels::determinant_lu(std::size_t n, const T* a, std::size_t lda)
+{
+    std::vector<T> work(n * n);
+    for (std::size_t i = 0; i < n; ++i) { std::copy(a + i * lda, a + i * lda + n, work.data() + i * n); }
+    std::vector<std::size_t> pivots(n);
+
+    return determinant_lu_in_place(n, work.data(), pivots.data());
+}
+
+inline LinAlg::Kernels::bareiss_integer LinAlg::Kernels::determinant_bareiss_in_place(std::size_t n, bareiss_integer* work)
+{
+    typedef bareiss_integer Wide;
+
+    bool negative = false;
+    Wide previous = 1;
+    for (std::size_t k = 0; k + 1 < n; ++k) {
+        if (work[k * n + k] == 0) {
+            std::size_t pivot = k + 1;
+            while (pivot < n && work[pivot * n + k] == 0) { ++pivot; }
+            if (pivot == n) { return Wide(); }
+            std::swap_ranges(work + k * n, work + (k + 1) * n, work + pivot * n);
+            negative = !negative;
+        }
+
+        const Wide diagonal = work[k * n + k];
+        const Wide* pivotRow = work + k * n;
+        for (std::size_t i = k + 1; i < n; ++i) {
+            Wide* row = work + i * n;
+            const Wide multiplier = row[k];
+            for (std::size_t j = k + 1; j < n; ++j) {
+                row[j] = bareiss_step(row[j], diagonal, multiplier, pivotRow[j], previous);
+            }
+        }
+        previous = diagonal;
+    }
+
+    const Wide determinant = (n == 0) ? Wide() : work[n * n - 1];
+    return negative ? -determinant : determinant;
+}
+
+// Every pivot row eliminates its column from all the other rows. The earlier
+// pivots are rescaled along with them and all equal d at the end.
+inline LinAlg::Kernels::bareiss_integer LinAlg::Kernels::adjugate_bareiss_in_place(std::size_t n, bareiss_integer* work)
+{
+    typedef bareiss_integer Wide;
+
+    const std::size_t width = 2 * n;
+    Wide previous = 1;
+    for (std::size_t k = 0; k < n; ++k) {
+        if (work[k * width + k] == 0) {
+            std::size_t pivot = k + 1;
+            while (pivot < n && work[pivot * width + k] == 0) { ++pivot; }
+            if (pivot == n) { return Wide(); }
+            std::swap_ranges(work + k * width, work + (k + 1) * width, work + pivot * width);
+        }
+
+        const Wide diagonal = work[k * width + k];
+        const Wide* pivotRow = work + k * width;
+        for (std::size_t i = 0; i < n; ++i) {
+            if (i == k) { continue; }
+            Wide* row = work + i * width;
+            const Wide multiplier = row[k];
+            for (std::size_t j = 0; j < width; ++j) {
+                if (j != k) { row[j] = bareiss_step(row[j], diagonal, multiplier, pivotRow[j], previous); }
+            }
+            row[k] = Wide();
+        }
+        previous = diagonal;
+    }
+    return previous;
+}
+
+#ifdef __SIZEOF_INT128__
+inline LinAlg::Kernels::bareiss_integer LinAlg::Kernels::bareiss_step(bareiss_integer a, bareiss_integer b, bareiss_integer c, bareiss_integer d, bareiss_integer divisor)
+{
+    return (a * b - c * d) / divisor;
+}
+#else
+// Products are formed on the magnitudes, whose bound is one larger for a
+// negative result, and the difference is checked against the signed range.
+inline LinAlg::Kernels::bareiss_integer LinAlg::Kernels::bareiss_step(bareiss_integer a, bareiss_integer b, bareiss_integer c, bareiss_integer d, bareiss_integer divisor)
+{
+    typedef unsigned long long Magnitude;
+    const Magnitude maximum = static_cast<Magnitude>(std::numeric_limits<bareiss_integer>::max());
+    const auto product = [maximum](bareiss_integer x, bareiss_integer y) {
+        const Magnitude magnitudeX = (x < 0) ? Magnitude(0) - static_cast<Magnitude>(x) : static_cast<Magnitude>(x);
+        const Magnitude magnitudeY = (y < 0) ? Magnitude(0) - static_cast<Magnitude>(y) : static_cast<Magnitude>(y);
+        const bool negative = (x < 0) != (y < 0);
+        const Magnitude bound = negative ? maximum + 1 : maximum;
+        if (magnitudeX != 0 && magnitudeY > bound / magnitudeX) { throw std::overflow_error("integer determinant overflow"); }
+        const Magnitude magnitude = magnitudeX * magnitudeY;
+        if (!negative) { return static_cast<bareiss_integer>(magnitude); }
+        return (magnitude == maximum + 1) ? std::numeric_limits<bareiss_integer>::min() : -static_cast<bareiss_integer>(magnitude);
+    };
+
+    const bareiss_integer left = product(a, b);
+    const bareiss_integer right = product(c, d);
+    if ((right < 0 && left > std::numeric_limits<bareiss_integer>::max() + right)
+        || (right > 0 && left < std::numeric_limits<bareiss_integer>::min() + right)) {
+        throw std::overflow_error("integer determinant overflow");
+    }
+    return (left - right) / divisor;
+}
+#endif
+
+template <typename T>
+inline T LinAlg::Kernels::determinant_bareiss(std::size_t n, const T* a, std::size_t lda)
+{
+    std::vector<bareiss_integer> work(n * n);
+    for (std::size_t i = 0; i < n; ++i) { std::copy(a + i * lda, a + i * lda + n, work.data() + i * n); }
+
+    return static_cast<T>(determinant_bareiss_in_place(n, work.data()));
+}
+
+#endif // DETERMINANT_HPP
@@ -0,0 +1,329 @@
+#ifndef EIGEN_HPP
+#define EIGEN_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "../ExecutionPolicy.hpp"
+#include "elementwise.hpp"
+#include "gemv.hpp"
+#include "qr.hpp"
+
+namespace LinAlg
+{
+    namespace Kernels
+    {
+        // Iteration limit per eigenvalue or singular value. The shifted QL and
+        // QR steps converge cubically in practice, so reaching it means the
+        // input holds NaN or infinity.
+        const std::size_t shifted_iterations = 60;
+
+        // Reduces the symmetric row-major n x n matrix a, both triangles stored,
+        // to tridiagonal T = Q^T A Q with diagonal d and subdiagonal e (n - 1
+        // entries). Q = H_0 ... H_{n-3}, where H_k = I - tau[k] v v^T acts on
+        // indices k + 1 and beyond; the tail of v after its implied leading one
+        // replaces a(k, k + 2:n). Every step is a matrix-vector product and a
+        // fused symmetric rank-2 update of the trailing block.
+        template <typename T>
+        void tridiagonalize(std::size_t n, T* a, std::size_t lda, T* d, T* e, T* tau);
+
+        // Reduces the row-major n x n matrix a to upper bidiagonal B = U^T A V
+        // with diagonal d and superdiagonal e (n - 1 entries). U = H_0 ... H_{n-1}
+        // with H_k acting on indices k and beyond, its vector tail replacing
+        // left(k, k + 1:n); V = P_0 ... P_{n-3} with P_k acting on indices k + 1
+        // and beyond, stored as in tridiagonalize in a(k, k + 2:n).
+        template <typename T>
+        void bidiagonalize(std::size_t n, T* a, std::size_t lda, T* d, T* e, T* left, std::size_t ldl, T* tauLeft, T* tauRight);
+
+        // Q^T into the row-major n x n q for Q = H_0 ... H_{count-1}, where H_k
+        // = I - tau[k] v v^T acts on indices k + shift and beyond and the tail of
+        // v after its implied leading one starts at v(k, k + shift + 1). Row i of
+        // q is column i of Q. The reflectors are accumulated backwards, each one
+        // touching only the trailing block it acts on.
+        template <typename T>
+        void reflectors_transposed(std::size_t n, std::size_t count, std::size_t shift, const T* v, std::size_t ldv, const T* tau, T* q, std::size_t ldq);
+
+        // Eigenvalues of the symmetric tridiagonal matrix with diagonal d and
+        // subdiagonal e by the implicit QL method with Wilkinson shifts. The
+        // eigenvalues replace d, unsorted, and e is left intact. When z is not
+        // null every rotation is applied to its n rows of length cols, so rows
+        // holding Q^T come out as the eigenvectors. Returns false when an
+        // eigenvalue needs more than shifted_iterations iterations.
+        template <typename T>
+        bool tridiagonal_ql(std::size_t n, T* d, T* e, T* z, std::size_t cols, std::size_t ldz);
+
+        // Singular values of the upper bidiagonal matrix with diagonal d and
+        // superdiagonal e by implicitly shifted QR (Golub and Kahan). The
+        // singular values replace d, nonnegative but unsorted, and e is left
+        // intact. The left and right rotations are applied to the n rows of u
+        // and v, of length cols, which holding U^T and V^T come out as the
+        // singular vectors. Returns false when a singular value needs more than
+        // shifted_iterations iterations.
+        template <typename T>
+        bool bidiagonal_qr(std::size_t n, T* d, T* e, T* u, std::size_t ldu, T* v, std::size_t ldv, std::size_t cols);
+
+        // x = c x - s y, y = s x + c y.
+        template <typename T>
+        void rotate(std::size_t n, T c, T s, T* x, T* y);
+    }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::rotate(std::size_t n, T c, T s, T* x, T* y)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        const T xi = x[i], yi = y[i];
+        x[i] = c * xi - s * yi;
+        y[i] = s * xi + c * yi;
+    }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::tridiagonalize(std::size_t n, T* a, std::size_t lda, T* d, T* e, T* tau)
+{
+    std::vector<T> v(n), w(n);
+    for (std::size_t k = 0; k + 2 < n; ++k) {
+        const std::size_t length = n - k - 1;
+        T* x = a + k * lda + k + 1;
+        d[k] = a[k * lda + k];
+        tau[k] = householder(length, x);
+        e[k] = x[0];
+        if (tau[k] == T()) { continue; }
+
+        // p = tau A22 v, w = p - (tau / 2)(p^T v) v, A22 -= v w^T + w v^T.
+        T* a22 = a + (k + 1) * lda + k + 1;
+        v[0] = T(1);
+        std::copy(x + 1, x + length, v.begin() + 1);
+        gemv(length, length, tau[k], a22, lda, v.data(), T(), w.data());
+        axpy(length, -tau[k] / T(2) * dot(length, w.data(), v.data()), v.data(), w.data());
+        const T* vData = v.data();
+        const T* wData = w.data();
+        LinAlg::parallel_for(length * length, 0, length, matrix_vector_row_grain, [=](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i) {
+                T* row = a22 + i * lda;
+                const T vi = vData[i], wi = wData[i];
+                for (std::size_t j = 0; j < length; ++j) { row[j] -= vi * wData[j] + wi * vData[j]; }
+            }
+        });
+    }
+    if (n >= 2) {
+        d[n - 2] = a[(n - 2) * lda + n - 2];
+        e[n - 2] = a[(n - 2) * lda + n - 1];
+        tau[n - 2] = T();
+    }
+    if (n >= 1) {
+        d[n - 1] = a[(n - 1) * lda + n - 1];
+        tau[n - 1] = T();
+    }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::bidiagonalize(std::size_t n, T* a, std::size_t lda, T* d, T* e, T* left, std::size_t ldl, T* tauLeft, T* tauRight)
+{
+    std::vector<T> v(n), w(n);
+    for (std::size_t k = 0; k < n; ++k) {
+        // H_k from column k, gathered into row k of left, applied from the left.
+        const std::size_t height = n - k;
+        T* u = left + k * ldl + k;
+        for (std::size_t i = 0; i < height; ++i) { u[i] = a[(k + i) * lda + k]; }
+        tauLeft[k] = householder(height, u);
+        d[k] = u[0];
+        u[0] = T(1);
+        if (tauLeft[k] != T() && k + 1 < n) {
+            T* block = a + k * lda + k + 1;
+            gemv_transposed(height, n - k - 1, T(1), block, lda, u, T(), w.data());
+            ger(height, n - k - 1, -tauLeft[k], u, w.data(), block, lda);
+        }
+        if (k + 1 == n) { break; }
+
+        // P_k from the rest of row k, applied from the right.
+        const std::size_t width = n - k - 1;
+        T* x = a + k * lda + k + 1;
+        tauRight[k] = (width > 1) ? householder(width, x) : T();
+        e[k] = x[0];
+        if (tauRight[k] != T()) {
+            T* block = a + (k + 1) * lda + k + 1;
+            v[0] = T(1);
+            std::copy(x + 1, x + width, v.begin() + 1);
+            gemv(width, width, T(1), block, lda, v.data(), T(), w.data());
+            ger(width, width, -tauRight[k], w.data(), v.data(), block, lda);
+        }
+    }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::reflectors_transposed(std::size_t n, std::size_t count, std::size_t shift, const T* v, std::size_t ldv, const T* tau,
+                                                   T* q, std::size_t ldq)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        std::fill(q + i * ldq, q + i * ldq + n, T());
+        q[i * ldq + i] = T(1);
+    }
+
+    // Q = H_0 (H_1 (... H_{count-1})): H_k only meets the trailing block from
+    // k + shift, outside of which the later reflectors left the identity.
+    std::vector<T> vector(n), w(n);
+    for (std::size_t k = count; k-- > 0;) {
+        if (tau[k] == T()) { continue; }
+
+        const std::size_t first = k + shift, length = n - first;
+        T* block = q + first * ldq + first;
+        vector[0] = T(1);
+        std::copy(v + k * ldv + first + 1, v + k * ldv + n, vector.begin() + 1);
+        gemv_transposed(length, length, T(1), block, ldq, vector.data(), T(), w.data());
+        ger(length, length, -tau[k], vector.data(), w.data(), block, ldq);
+    }
+
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = i + 1; j < n; ++j) { std::swap(q[i * ldq + j], q[j * ldq + i]); }
+    }
+}
+
+template <typename T>
+inline bool LinAlg::Kernels::tridiagonal_ql(std::size_t n, T* d, T* e, T* z, std::size_t cols, std::size_t ldz)
+{
+    if (n == 0) { return true; }
+
+    const T epsilon = std::numeric_limits<T>::epsilon();
+    std::vector<T> offDiagonal(e, e + n - 1);
+    offDiagonal.push_back(T());
+    T* f = offDiagonal.data();
+
+    for (std::size_t l = 0; l < n; ++l) {
+        std::size_t iteration = 0;
+        while (true) {
+            std::size_t m = l;
+            for (; m + 1 < n; ++m) {
+                if (std::abs(f[m]) <= epsilon * (std::abs(d[m]) + std::abs(d[m + 1]))) { break; }
+            }
+            if (m == l) { break; }
+            if (++iteration > shifted_iterations) { return false; }
+
+            // Wilkinson shift from the leading 2 x 2 block, then chase the bulge
+            // from row m up to row l with Givens rotations.
+            T g = (d[l + 1] - d[l]) / (T(2) * f[l]);
+            T r = std::hypot(g, T(1));
+            g = d[m] - d[l] + f[l] / (g + std::copysign(r, g));
+            T s = T(1), c = T(1), p = T();
+            bool deflated = false;
+            for (std::size_t i = m; i-- > l;) {
+                const T h = s * f[i], b = c * f[i];
+                r = std::hypot(h, g);
+                f[i + 1] = r;
+                if (r == T()) {
+                    d[i + 1] -= p;
+                    f[m] = T();
+                    deflated = true;
+                    break;
+                }
+                s = h / r;
+                c = g / r;
+                g = d[i + 1] - p;
+                r = (d[i] - g) * s + T(2) * c * b;
+                p = s * r;
+                d[i + 1] = g + p;
+                g = c * r - b;
+                if (z != nullptr) { rotate(cols, c, s, z + i * ldz, z + (i + 1) * ldz); }
+            }
+            if (deflated) { continue; }
+            d[l] -= p;
+            f[l] = g;
+            f[m] = T();
+        }
+    }
+    return true;
+}
+
+template <typename T>
+inline bool LinAlg::Kernels::bidiagonal_qr(std::size_t n, T* d, T* e, T* u, std::size_t ldu, T* v, std::size_t ldv, std::size_t cols)
+{
+    if (n == 0) { return true; }
+
+    // f[i] couples columns i - 1 and i; f[0] is zero.
+    std::vector<T> superDiagonal(1, T());
+    superDiagonal.insert(superDiagonal.end(), e, e + n - 1);
+    T* f = superDiagonal.data();
+    T norm = T();
+    for (std::size_t i = 0; i < n; ++i) { norm = std::max(norm, std::abs(d[i]) + std::abs(f[i])); }
+    const T negligible = std::numeric_limits<T>::epsilon() * norm;
+
+    for (std::size_t k = n; k-- > 0;) {
+        for (std::size_t iteration = 0;; ++iteration) {
+            // Splits at the largest l whose f[l] is negligible; a negligible
+            // d[l - 1] instead is chased off f[l] with rotations from the left.
+            std::size_t l = k;
+            bool cancel = false;
+            for (;; --l) {
+                if (l == 0 || std::abs(f[l]) <= negligible) { break; }
+                if (std::abs(d[l - 1]) <= negligible) {
+                    cancel = true;
+                    break;
+                }
+            }
+            if (cancel) {
+                T c = T(), s = T(1);
+                for (std::size_t i = l; i <= k; ++i) {
+                    const T h = s * f[i];
+                    f[i] = c * f[i];
+                    if (std::abs(h) <= negligible) { break; }
+                    const T g = d[i], r = std::hypot(h, g);
+                    d[i] = r;
+                    c = g / r;
+                    s = -h / r;
+                    rotate(cols, c, -s, u + (l - 1) * ldu, u + i * ldu);
+                }
+            }
+            if (l == k) {
+                if (d[k] < T()) {
+                    d[k] = -d[k];
+                    scale(cols, T(-1), v + k * ldv);
+                }
+                break;
+            }
+            if (iteration >= shifted_iterations) { return false; }
+
+            // Shift from the trailing 2 x 2 block of B^T B, then one implicit QR
+            // step chasing the bulge down from row l to row k.
+            T x = d[l], y = d[k - 1], g = f[k - 1], h = f[k], z = d[k];
+            T shift = ((y - z) * (y + z) + (g - h) * (g + h)) / (T(2) * h * y);
+            g = std::hypot(shift, T(1));
+            shift = ((x - z) * (x + z) + h * ((y / (shift + std::copysign(g, shift))) - h)) / x;
+            T c = T(1), s = T(1);
+            for (std::size_t j = l; j < k; ++j) {
+                const std::size_t i = j + 1;
+                g = f[i];
+                y = d[i];
+                h = s * g;
+                g = c * g;
+                z = std::hypot(shift, h);
+                f[j] = z;
+                c = shift / z;
+                s = h / z;
+                shift = x * c + g * s;
+                g = g * c - x * s;
+                h = y * s;
+                y *= c;
+                rotate(cols, c, -s, v + j * ldv, v + i * ldv);
+                z = std::hypot(shift, h);
+                d[j] = z;
+                if (z != T()) {
+                    c = shift / z;
+                    s = h / z;
+                }
+                shift = c * g + s * y;
+                x = c * y - s * g;
+                rotate(cols, c, -s, u + j * ldu, u + i * ldu);
+            }
+            f[l] = T();
+            f[k] = shift;
+            d[k] = x;
+        }
+    }
+    return true;
+}
+
+#endif // EIGEN_HPP
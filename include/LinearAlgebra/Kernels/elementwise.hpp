@@ -0,0 +1,508 @@
+#ifndef ELEMENTWISE_HPP
+#define ELEMENTWISE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+
+#if defined(__AVX512F__) || defined(__AVX__) || defined(__SSE2__) || defined(_M_X64)
+#include <immintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
+namespace LinAlg
+{
+    namespace Kernels
+    {
+        // Vector register abstraction selected at compile time from the target
+        // instruction set. Types without a specialization use the scalar loops.
+        template <typename T>
+        struct SimdTraits
+        {
+            static constexpr bool enabled = false;
+        };
+
+#if defined(__AVX512F__)
+        template <>
+        struct SimdTraits<float>
+        {
+            typedef __m512 vector_type;
+            static constexpr bool enabled = true;
+            static constexpr std::size_t width = 16;
+
+            static vector_type load(const float* p) { return _mm512_loadu_ps(p); }
+            static void store(float* p, vector_type v) { _mm512_storeu_ps(p, v); }
+            static vector_type set1(float value) { return _mm512_set1_ps(value); }
+            static vector_type add(vector_type a, vector_type b) { return _mm512_add_ps(a, b); }
+            static vector_type sub(vector_type a, vector_type b) { return _mm512_sub_ps(a, b); }
+            static vector_type mul(vector_type a, vector_type b) { return _mm512_mul_ps(a, b); }
+            static vector_type div(vector_type a, vector_type b) { return _mm512_div_ps(a, b); }
+            static vector_type abs(vector_type a) { return _mm512_castsi512_ps(_mm512_and_si512(_mm512_castps_si512(a), _mm512_set1_epi32(0x7FFFFFFF))); }
+            static vector_type max(vector_type a, vector_type b) { return _mm512_max_ps(a, b); }
+            static bool all_le(vector_type a, vector_type b) { return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ) == 0xFFFF; }
+        };
+
+        template <>
+        struct SimdTraits<double>
+        {
+            typedef __m512d vector_type;
+            static constexpr bool enabled = true;
+            static constexpr std::size_t width = 8;
+
+            static vector_type load(const double* p) { return _mm512_loadu_pd(p); }
+            static void store(double* p, vector_type v) { _mm512_storeu_pd(p, v); }
+            static vector_type set1(double value) { return _mm512_set1_pd(value); }
+            static vector_type add(vector_type a, vector_type b) { return _mm512_add_pd(a, b); }
+            static vector_type sub(vector_type a, vector_type b) { return _mm512_sub_pd(a, b); }
+            static vector_type mul(vector_type a, vector_type b) { return _mm512_mul_pd(a, b); }
+            static vector_type div(vector_type a, vector_type b) { return _mm512_div_pd(a, b); }
+            static vector_type abs(vector_type a) { return _mm512_castsi512_pd(_mm512_and_si512(_mm512_castpd_si512(a), _mm512_set1_epi64(0x7FFFFFFFFFFFFFFFLL))); }
+            static vector_type max(vector_type a, vector_type b) { return _mm512_max_pd(a, b); }
+            static bool all_le(vector_type a, vector_type b) { return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ) == 0xFF; }
+        };
+#elif defined(__AVX__)
+        template <>
+        struct SimdTraits<float>
+        {
+            typedef __m256 vector_type;
+            static constexpr bool enabled = true;
+            static constexpr std::size_t width = 8;
+
+            static vector_type load(const float* p) { return _mm256_loadu_ps(p); }
+            static void store(float* p, vector_type v) { _mm256_storeu_ps(p, v); }
+            static vector_type set1(float value) { return _mm256_set1_ps(value); }
+            static vector_type add(vector_type a, vector_type b) { return _mm256_add_ps(a, b); }
+            static vector_type sub(vector_type a, vector_type b) { return _mm256_sub_ps(a, b); }
+            static vector_type mul(vector_type a, vector_type b) { return _mm256_mul_ps(a, b); }
+            static vector_type div(vector_type a, vector_type b) { return _mm256_div_ps(a, b); }
+            static vector_type abs(vector_type a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+            static vector_type max(vector_type a, vector_type b) { return _mm256_max_ps(a, b); }
+            static bool all_le(vector_type a, vector_type b) { return _mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_LE_OQ)) == 0xFF; }
+        };
+
+        template <>
+        struct SimdTraits<double>
+        {
+            typedef __m256d vector_type;
+            static constexpr bool enabled = true;
+            static constexpr std::size_t width = 4;
+
+            static vector_type load(const double* p) { return _mm256_loadu_pd(p); }
+            static void store(double* p, vector_type v) { _mm256_storeu_pd(p, v); }
+            static vector_type set1(double value) { return _mm256_set1_pd(value); }
+            static vector_type add(vector_type a, vector_type b) { return _mm256_add_pd(a, b); }
+            static vector_type sub(vector_type a, vector_type b) { return _mm256_sub_pd(a, b); }
+            static vector_type mul(vector_type a, vector_type b) { return _mm256_mul_pd(a, b); }
+            static vector_type div(vector_type a, vector_type b) { return _mm256_div_pd(a, b); }
+            static vector_type abs(vector_type a) { return _mm256_andnot_pd(_mm256_set1_pd(-0.0), a); }
+            static vector_type max(vector_type a, vector_type b) { return _mm256_max_pd(a, b); }
+            static bool all_le(vector_type a, vector_type b) { return _mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_LE_OQ)) == 0xF; }
+        };
+#elif defined(__SSE2__) || defined(_M_X64)
+        template <>
+        struct SimdTraits<float>
+        {
+            typedef __m128 vector_type;
+            static constexpr bool enabled = true;
+            static constexpr std::size_t width = 4;
+
+            static vector_type load(const float* p) { return _mm_loadu_ps(p); }
+            static void store(float* p, vector_type v) { _mm_storeu_ps(p, v); }
+            static vector_type set1(float value) { return _mm_set1_ps(value); }
+            static vector_type add(vector_type a, vector_type b) { return _mm_add_ps(a, b); }
+            static vector_type sub(vector_type a, vector_type b) { return _mm_sub_ps(a, b); }
+            static vector_type mul(vector_type a, vector_type b) { return _mm_mul_ps(a, b); }
+            static vector_type div(vector_type a, vector_type b) { return _mm_div_ps(a, b); }
+            static vector_type abs(vector_type a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+            static vector_type max(vector_type a, vector_type b) { return _mm_max_ps(a, b); }
+            static bool all_le(vector_type a, vector_type b) { return _mm_movemask_ps(_mm_cmple_ps(a, b)) == 0xF; }
+        };
+
+        template <>
+        struct SimdTraits<double>
+        {
+            typedef __m128d vector_type;
+            static constexpr bool enabled = true;
+            static constexpr std::size_t width = 2;
+
+            static vector_type load(const double* p) { return _mm_loadu_pd(p); }
+            static void store(double* p, vector_type v) { _mm_storeu_pd(p, v); }
+            static vector_type set1(double value) { return _mm_set1_pd(value); }
+            static vector_type add(vector_type a, vector_type b) { return _mm_add_pd(a, b); }
+            static vector_type sub(vector_type a, vector_type b) { return _mm_sub_pd(a, b); }
+            static vector_type mul(vector_type a, vector_type b) { return _mm_mul_pd(a, b); }
+            static vector_type div(vector_type a, vector_type b) { return _mm_div_pd(a, b); }
+            static vector_type abs(vector_type a) { return _mm_andnot_pd(_mm_set1_pd(-0.0), a); }
+            static vector_type max(vector_type a, vector_type b) { return _mm_max_pd(a, b); }
+            static bool all_le(vector_type a, vector_type b) { return _mm_movemask_pd(_mm_cmple_pd(a, b)) == 0x3; }
+        };
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        template <>
+        struct SimdTraits<float>
+        {
+            typedef float32x4_t vector_type;
+            static constexpr bool enabled = true;
+            static constexpr std::size_t width = 4;
+
+            static vector_type load(const float* p) { return vld1q_f32(p); }
+            static void store(float* p, vector_type v) { vst1q_f32(p, v); }
+            static vector_type set1(float value) { return vdupq_n_f32(value); }
+            static vector_type add(vector_type a, vector_type b) { return vaddq_f32(a, b); }
+            static vector_type sub(vector_type a, vector_type b) { return vsubq_f32(a, b); }
+            static vector_type mul(vector_type a, vector_type b) { return vmulq_f32(a, b); }
+            static vector_type div(vector_type a, vector_type b) { return vdivq_f32(a, b); }
+            static vector_type abs(vector_type a) { return vabsq_f32(a); }
+            static vector_type max(vector_type a, vector_type b) { return vmaxq_f32(a, b); }
+            static bool all_le(vector_type a, vector_type b) { return vminvq_u32(vcleq_f32(a, b)) == 0xFFFFFFFFu; }
+        };
+
+        template <>
+        struct SimdTraits<double>
+        {
+            typedef float64x2_t vector_type;
+            static constexpr bool enabled = true;
+            static constexpr std::size_t width = 2;
+
+            static vector_type load(const double* p) { return vld1q_f64(p); }
+            static void store(double* p, vector_type v) { vst1q_f64(p, v); }
+            static vector_type set1(double value) { return vdupq_n_f64(value); }
+            static vector_type add(vector_type a, vector_type b) { return vaddq_f64(a, b); }
+            static vector_type sub(vector_type a, vector_type b) { return vsubq_f64(a, b); }
+            static vector_type mul(vector_type a, vector_type b) { return vmulq_f64(a, b); }
+            static vector_type div(vector_type a, vector_type b) { return vdivq_f64(a, b); }
+            static vector_type abs(vector_type a) { return vabsq_f64(a); }
+            static vector_type max(vector_type a, vector_type b) { return vmaxq_f64(a, b); }
+            static bool all_le(vector_type a, vector_type b) { return (vgetq_lane_u64(vcleq_f64(a, b), 0) & vgetq_lane_u64(vcleq_f64(a, b), 1)) == 0xFFFFFFFFFFFFFFFFull; }
+        };
+#endif
+
+        // Vectorized bodies of the kernels below. Each returns the number of leading
+        // elements it processed, the caller finishes the remainder with scalar code.
+        template <typename T, bool Enabled = SimdTraits<T>::enabled>
+        struct VectorLoops
+        {
+            static std::size_t add(std::size_t, const T*, const T*, T*) { return 0; }
+            static std::size_t sub(std::size_t, const T*, const T*, T*) { return 0; }
+            static std::size_t scale(std::size_t, T, T*) { return 0; }
+            static std::size_t divide(std::size_t, T, T*) { return 0; }
+            static std::size_t axpy(std::size_t, T, const T*, T*) { return 0; }
+            static std::size_t dot(std::size_t, const T*, const T*, T& result) { result = T(); return 0; }
+            static std::size_t equal(std::size_t, const T*, const T*, bool& result) { result = true; return 0; }
+        };
+
+        template <typename T>
+        struct VectorLoops<T, true>
+        {
+            typedef SimdTraits<T> Simd;
+
+            static std::size_t add(std::size_t n, const T* x, const T* y, T* out);
+            static std::size_t sub(std::size_t n, const T* x, const T* y, T* out);
+            static std::size_t scale(std::size_t n, T alpha, T* x);
+            static std::size_t divide(std::size_t n, T value, T* x);
+            static std::size_t axpy(std::size_t n, T alpha, const T* x, T* y);
+            static std::size_t dot(std::size_t n, const T* x, const T* y, T& result);
+            static std::size_t equal(std::size_t n, const T* x, const T* y, bool& result);
+        };
+
+        // Vectorized float <-> double conversion, other pairs use the scalar loop.
+        template <typename From, typename To>
+        struct ConvertLoops
+        {
+            static std::size_t convert(std::size_t, const From*, To*) { return 0; }
+        };
+
+#if defined(__AVX512F__)
+        template <>
+        struct ConvertLoops<double, float>
+        {
+            static std::size_t convert(std::size_t n, const double* x, float* out)
+            {
+                std::size_t i = 0;
+                for (; i + 8 <= n; i += 8) { _mm256_storeu_ps(out + i, _mm512_cvtpd_ps(_mm512_loadu_pd(x + i))); }
+                return i;
+            }
+        };
+
+        template <>
+        struct ConvertLoops<float, double>
+        {
+            static std::size_t convert(std::size_t n, const float* x, double* out)
+            {
+                std::size_t i = 0;
+                for (; i + 8 <= n; i += 8) { _mm512_storeu_pd(out + i, _mm512_cvtps_pd(_mm256_loadu_ps(x + i))); }
+                return i;
+            }
+        };
+#elif defined(__AVX__)
+        template <>
+        struct ConvertLoops<double, float>
+        {
+            static std::size_t convert(std::size_t n, const double* x, float* out)
+            {
+                std::size_t i = 0;
+                for (; i + 4 <= n; i += 4) { _mm_storeu_ps(out + i, _mm256_cvtpd_ps(_mm256_loadu_pd(x + i))); }
+                return i;
+            }
+        };
+
+        template <>
+        struct ConvertLoops<float, double>
+        {
+            static std::size_t convert(std::size_t n, const float* x, double* out)
+            {
+                std::size_t i = 0;
+                for (; i + 4 <= n; i += 4) { _mm256_storeu_pd(out + i, _mm256_cvtps_pd(_mm_loadu_ps(x + i))); }
+                return i;
+            }
+        };
+#elif defined(__SSE2__) || defined(_M_X64)
+        template <>
+        struct ConvertLoops<double, float>
+        {
+            static std::size_t convert(std::size_t n, const double* x, float* out)
+            {
+                std::size_t i = 0;
+                for (; i + 4 <= n; i += 4) {
+                    const __m128 low = _mm_cvtpd_ps(_mm_loadu_pd(x + i));
+                    const __m128 high = _mm_cvtpd_ps(_mm_loadu_pd(x + i + 2));
+                    _mm_storeu_ps(out + i, _mm_movelh_ps(low, high));
+                }
+                return i;
+            }
+        };
+
+        template <>
+        struct ConvertLoops<float, double>
+        {
+            static std::size_t convert(std::size_t n, const float* x, double* out)
+            {
+                std::size_t i = 0;
+                for (; i + 4 <= n; i += 4) {
+                    const __m128 values = _mm_loadu_ps(x + i);
+                    _mm_storeu_pd(out + i, _mm_cvtps_pd(values));
+                    _mm_storeu_pd(out + i + 2, _mm_cvtps_pd(_mm_movehl_ps(values, values)));
+                }
+                return i;
+            }
+        };
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+        template <>
+        struct ConvertLoops<double, float>
+        {
+            static std::size_t convert(std::size_t n, const double* x, float* out)
+            {
+                std::size_t i = 0;
+                for (; i + 4 <= n; i += 4) { vst1q_f32(out + i, vcvt_high_f32_f64(vcvt_f32_f64(vld1q_f64(x + i)), vld1q_f64(x + i + 2))); }
+                return i;
+            }
+        };
+
+        template <>
+        struct ConvertLoops<float, double>
+        {
+            static std::size_t convert(std::size_t n, const float* x, double* out)
+            {
+                std::size_t i = 0;
+                for (; i + 4 <= n; i += 4) {
+                    const float32x4_t values = vld1q_f32(x + i);
+                    vst1q_f64(out + i, vcvt_f64_f32(vget_low_f32(values)));
+                    vst1q_f64(out + i + 2, vcvt_high_f64_f32(values));
+                }
+                return i;
+            }
+        };
+#endif
+
+        template <typename T>
+        bool are_equal(T value1, T value2);
+
+        // out = x + y
+        template <typename T>
+        void add(std::size_t n, const T* x, const T* y, T* out);
+
+        // out = x - y
+        template <typename T>
+        void sub(std::size_t n, const T* x, const T* y, T* out);
+
+        // x *= alpha
+        template <typename T>
+        void scale(std::size_t n, T alpha, T* x);
+
+        // x /= value
+        template <typename T>
+        void divide(std::size_t n, T value, T* x);
+
+        // y += alpha * x, rounded as a separate multiply and add
+        template <typename T>
+        void axpy(std::size_t n, T alpha, const T* x, T* y);
+
+        // sum of x[i] * y[i]
+        template <typename T>
+        T dot(std::size_t n, const T* x, const T* y);
+
+        // are_equal over every pair of elements
+        template <typename T>
+        bool equal(std::size_t n, const T* x, const T* y);
+
+        // out = x converted element by element
+        template <typename From, typename To>
+        void convert(std::size_t n, const From* x, To* out);
+    }
+}
+
+template <typename T>
+inline std::size_t LinAlg::Kernels::VectorLoops<T, true>::add(std::size_t n, const T* x, const T* y, T* out)
+{
+    std::size_t i = 0;
+    for (; i + Simd::width <= n; i += Simd::width) {
+        Simd::store(out + i, Simd::add(Simd::load(x + i), Simd::load(y + i)));
+    }
+    return i;
+}
+
+template <typename T>
+inline std::size_t LinAlg::Kernels::VectorLoops<T, true>::sub(std::size_t n, const T* x, const T* y, T* out)
+{
+    std::size_t i = 0;
+    for (; i + Simd::width <= n; i += Simd::width) {
+        Simd::store(out + i, Simd::sub(Simd::load(x + i), Simd::load(y + i)));
+    }
+    return i;
+}
+
+template <typename T>
+inline std::size_t LinAlg::Kernels::VectorLoops<T, true>::scale(std::size_t n, T alpha, T* x)
+{
+    const typename Simd::vector_type alphaVector = Simd::set1(alpha);
+    std::size_t i = 0;
+    for (; i + Simd::width <= n; i += Simd::width) {
+        Simd::store(x + i, Simd::mul(Simd::load(x + i), alphaVector));
+    }
+    return i;
+}
+
+template <typename T>
+inline std::size_t LinAlg::Kernels::VectorLoops<T, true>::divide(std::size_t n, T value, T* x)
+{
+    const typename Simd::vector_type valueVector = Simd::set1(value);
+    std::size_t i = 0;
+    for (; i + Simd::width <= n; i += Simd::width) {
+        Simd::store(x + i, Simd::div(Simd::load(x + i), valueVector));
+    }
+    return i;
+}
+
+template <typename T>
+inline std::size_t LinAlg::Kernels::VectorLoops<T, true>::axpy(std::size_t n, T alpha, const T* x, T* y)
+{
+    const typename Simd::vector_type alphaVector = Simd::set1(alpha);
+    std::size_t i = 0;
+    for (; i + Simd::width <= n; i += Simd::width) {
+        Simd::store(y + i, Simd::add(Simd::load(y + i), Simd::mul(alphaVector, Simd::load(x + i))));
+    }
+    return i;
+}
+
+template <typename T>
+inline std::size_t LinAlg::Kernels::VectorLoops<T, true>::dot(std::size_t n, const T* x, const T* y, T& result)
+{
+    typename Simd::vector_type sum = Simd::set1(T());
+    std::size_t i = 0;
+    for (; i + Simd::width <= n; i += Simd::width) {
+        sum = Simd::add(sum, Simd::mul(Simd::load(x + i), Simd::load(y + i)));
+    }
+
+    T lanes[Simd::width];
+    Simd::store(lanes, sum);
+    result = T();
+    for (std::size_t lane = 0; lane < Simd::width; ++lane) { result += lanes[lane]; }
+    return i;
+}
+
+template <typename T>
+inline std::size_t LinAlg::Kernels::VectorLoops<T, true>::equal(std::size_t n, const T* x, const T* y, bool& result)
+{
+    const typename Simd::vector_type epsilon = Simd::set1(std::numeric_limits<T>::epsilon());
+    std::size_t i = 0;
+    for (; i + Simd::width <= n; i += Simd::width) {
+        const typename Simd::vector_type xVector = Simd::load(x + i);
+        const typename Simd::vector_type yVector = Simd::load(y + i);
+        const typename Simd::vector_type difference = Simd::abs(Simd::sub(xVector, yVector));
+        const typename Simd::vector_type tolerance = Simd::mul(Simd::max(Simd::abs(xVector), Simd::abs(yVector)), epsilon);
+        if (!Simd::all_le(difference, tolerance)) {
+            result = false;
+            return i;
+        }
+    }
+    result = true;
+    return i;
+}
+
+template <typename T>
+inline bool LinAlg::Kernels::are_equal(T value1, T value2)
+{
+    if (std::numeric_limits<T>::is_iec559) {
+        return std::fabs(value1 - value2) <= (std::max(std::fabs(value1), std::fabs(value2)) * std::numeric_limits<T>::epsilon());
+    } else {
+        return value1 == value2;
+    }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::add(std::size_t n, const T* x, const T* y, T* out)
+{
+    for (std::size_t i = VectorLoops<T>::add(n, x, y, out); i < n; ++i) { out[i] = x[i] + y[i]; }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::sub(std::size_t n, const T* x, const T* y, T* out)
+{
+    for (std::size_t i = VectorLoops<T>::sub(n, x, y, out); i < n; ++i) { out[i] = x[i] - y[i]; }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::scale(std::size_t n, T alpha, T* x)
+{
+    for (std::size_t i = VectorLoops<T>::scale(n, alpha, x); i < n; ++i) { x[i] *= alpha; }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::divide(std::size_t n, T value, T* x)
+{
+    for (std::size_t i = VectorLoops<T>::divide(n, value, x); i < n; ++i) { x[i] /= value; }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::axpy(std::size_t n, T alpha, const T* x, T* y)
+{
+    for (std::size_t i = VectorLoops<T>::axpy(n, alpha, x, y); i < n; ++i) { y[i] += alpha * x[i]; }
+}
+
+template <typename T>
+inline T LinAlg::Kernels::dot(std::size_t n, const T* x, const T* y)
+{
+    T result;
+    for (std::size_t i = VectorLoops<T>::dot(n, x, y, result); i < n; ++i) { result += x[i] * y[i]; }
+    return result;
+}
+
+template <typename T>
+inline bool LinAlg::Kernels::equal(std::size_t n, const T* x, const T* y)
+{
+    bool result = true;
+    for (std::size_t i = VectorLoops<T>::equal(n, x, y, result); result && i < n; ++i) {
+        if (!are_equal(x[i], y[i])) { return false; }
+    }
+    return result;
+}
+
+template <typename From, typename To>
+inline void LinAlg::Kernels::convert(std::size_t n, const From* x, To* out)
+{
+    for (std::size_t i = ConvertLoops<From, To>::convert(n, x, out); i < n; ++i) { out[i] = static_cast<To>(x[i]); }
+}
+
+#endif // ELEMENTWISE_HPP
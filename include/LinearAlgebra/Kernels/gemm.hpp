@@ -0,0 +1,232 @@
+#ifndef GEMM_HPP
+#define GEMM_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "../Allocator.hpp"
+#include "elementwise.hpp"
+
+namespace LinAlg
+{
+    namespace Kernels
+    {
+        // Blocking parameters: an MR x NR block of C is kept in registers, a KC x NR
+        // micro-panel of B stays in L1, an MC x KC block of A in L2 and a KC x NC
+        // panel of B in L3.
+        template <typename T>
+        struct GemmBlocking
+        {
+            static constexpr std::size_t MR = 4;
+            static constexpr std::size_t NR = (64 / sizeof(T) < 16) ? 64 / sizeof(T) : 16;
+            static constexpr std::size_t KC = 256;
+            static constexpr std::size_t MC = 128;
+            static constexpr std::size_t NC = 4096;
+        };
+
+        template <typename T> constexpr std::size_t GemmBlocking<T>::MR;
+        template <typename T> constexpr std::size_t GemmBlocking<T>::NR;
+        template <typename T> constexpr std::size_t GemmBlocking<T>::KC;
+        template <typename T> constexpr std::size_t GemmBlocking<T>::MC;
+        template <typename T> constexpr std::size_t GemmBlocking<T>::NC;
+
+        // C = alpha * A * B + beta * C, where A is m x k, B is k x n and C is m x n.
+        // A and B are addressed through arbitrary row/col strides, C is row-major
+        // with row stride ldc. C is never read when beta is zero.
+        template <typename T>
+        void gemm(std::size_t m, std::size_t n, std::size_t k, T alpha,
+                  const T* a, std::ptrdiff_t rsa, std::ptrdiff_t csa,
+                  const T* b, std::ptrdiff_t rsb, std::ptrdiff_t csb,
+                  T beta, T* c, std::ptrdiff_t ldc);
+
+        template <typename T>
+        void pack_a(std::size_t mc, std::size_t kc, const T* a, std::ptrdiff_t rsa, std::ptrdiff_t csa, T* packed);
+
+        template <typename T>
+        void pack_b(std::size_t kc, std::size_t nc, const T* b, std::ptrdiff_t rsb, std::ptrdiff_t csb, T* packed);
+
+        template <typename T>
+        void micro_kernel(std::size_t kc, T alpha, const T* packedA, const T* packedB,
+                          T beta, bool overwrite, T* c, std::ptrdiff_t ldc, std::size_t mr, std::size_t nr);
+
+        // ab = packed A panel * packed B panel for one MR x NR block. The vector
+        // form keeps the block in MR * NR / width registers across the whole panel.
+        template <typename T, bool Enabled = SimdTraits<T>::enabled>
+        struct MicroKernelLoops
+        {
+            static void accumulate(std::size_t kc, const T* packedA, const T* packedB, T* ab);
+        };
+
+        template <typename T>
+        struct MicroKernelLoops<T, true>
+        {
+            static void accumulate(std::size_t kc, const T* packedA, const T* packedB, T* ab);
+        };
+    }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::pack_a(std::size_t mc, std::size_t kc, const T* a, std::ptrdiff_t rsa, std::ptrdiff_t csa, T* packed)
+{
+    const std::size_t MR = GemmBlocking<T>::MR;
+
+    for (std::size_t ir = 0; ir < mc; ir += MR) {
+        const std::size_t mr = std::min(MR, mc - ir);
+        for (std::size_t p = 0; p < kc; ++p) {
+            const T* column = a + static_cast<std::ptrdiff_t>(ir) * rsa + static_cast<std::ptrdiff_t>(p) * csa;
+            std::size_t i = 0;
+            for (; i < mr; ++i) { *packed++ = column[static_cast<std::ptrdiff_t>(i) * rsa]; }
+            for (; i < MR; ++i) { *packed++ = T(); }
+        }
+    }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::pack_b(std::size_t kc, std::size_t nc, const T* b, std::ptrdiff_t rsb, std::ptrdiff_t csb, T* packed)
+{
+    const std::size_t NR = GemmBlocking<T>::NR;
+
+    for (std::size_t jr = 0; jr < nc; jr += NR) {
+        const std::size_t nr = std::min(NR, nc - jr);
+        for (std::size_t p = 0; p < kc; ++p) {
+            const T* row = b + static_cast<std::ptrdiff_t>(p) * rsb + static_cast<std::ptrdiff_t>(jr) * csb;
+            std::size_t j = 0;
+            if (csb == 1) {
+                for (; j < nr; ++j) { *packed++ = row[j]; }
+            } else {
+                for (; j < nr; ++j) { *packed++ = row[static_cast<std::ptrdiff_t>(j) * csb]; }
+            }
+            for (; j < NR; ++j) { *packed++ = T(); }
+        }
+    }
+}
+
+template <typename T, bool Enabled>
+inline void LinAlg::Kernels::MicroKernelLoops<T, Enabled>::accumulate(std::size_t kc, const T* packedA, const T* packedB, T* ab)
+{
+    const std::size_t MR = GemmBlocking<T>::MR;
+    const std::size_t NR = GemmBlocking<T>::NR;
+
+    std::fill(ab, ab + MR * NR, T());
+    for (std::size_t p = 0; p < kc; ++p) {
+        for (std::size_t i = 0; i < MR; ++i) {
+            const T aValue = packedA[i];
+            for (std::size_t j = 0; j < NR; ++j) {
+                ab[i * NR + j] += aValue * packedB[j];
+            }
+        }
+        packedA += MR;
+        packedB += NR;
+    }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::MicroKernelLoops<T, true>::accumulate(std::size_t kc, const T* packedA, const T* packedB, T* ab)
+{
+    typedef SimdTraits<T> Simd;
+    static_assert(GemmBlocking<T>::NR % Simd::width == 0, "NR must be a multiple of the vector width");
+    const std::size_t MR = GemmBlocking<T>::MR;
+    const std::size_t VR = GemmBlocking<T>::NR / Simd::width;
+
+    typename Simd::vector_type sums[MR][VR];
+    for (std::size_t i = 0; i < MR; ++i) {
+        for (std::size_t v = 0; v < VR; ++v) { sums[i][v] = Simd::set1(T()); }
+    }
+    for (std::size_t p = 0; p < kc; ++p) {
+        typename Simd::vector_type b[VR];
+        for (std::size_t v = 0; v < VR; ++v) { b[v] = Simd::load(packedB + v * Simd::width); }
+        for (std::size_t i = 0; i < MR; ++i) {
+            const typename Simd::vector_type aValue = Simd::set1(packedA[i]);
+            for (std::size_t v = 0; v < VR; ++v) { sums[i][v] = Simd::add(sums[i][v], Simd::mul(aValue, b[v])); }
+        }
+        packedA += MR;
+        packedB += VR * Simd::width;
+    }
+    for (std::size_t i = 0; i < MR; ++i) {
+        for (std::size_t v = 0; v < VR; ++v) { Simd::store(ab + (i * VR + v) * Simd::width, sums[i][v]); }
+    }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::micro_kernel(std::size_t kc, T alpha, const T* packedA, const T* packedB,
+                                          T beta, bool overwrite, T* c, std::ptrdiff_t ldc, std::size_t mr, std::size_t nr)
+{
+    const std::size_t MR = GemmBlocking<T>::MR;
+    const std::size_t NR = GemmBlocking<T>::NR;
+
+    T ab[MR * NR];
+    MicroKernelLoops<T>::accumulate(kc, packedA, packedB, ab);
+
+    for (std::size_t i = 0; i < mr; ++i) {
+        T* cRow = c + static_cast<std::ptrdiff_t>(i) * ldc;
+        if (overwrite) {
+            if (alpha == T(1)) {
+                for (std::size_t j = 0; j < nr; ++j) { cRow[j] = ab[i * NR + j]; }
+            } else {
+                for (std::size_t j = 0; j < nr; ++j) { cRow[j] = alpha * ab[i * NR + j]; }
+            }
+        } else if (beta == T(1)) {
+            for (std::size_t j = 0; j < nr; ++j) { cRow[j] += alpha * ab[i * NR + j]; }
+        } else {
+            for (std::size_t j = 0; j < nr; ++j) { cRow[j] = beta * cRow[j] + alpha * ab[i * NR + j]; }
+        }
+    }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::gemm(std::size_t m, std::size_t n, std::size_t k, T alpha,
+                                  const T* a, std::ptrdiff_t rsa, std::ptrdiff_t csa,
+                                  const T* b, std::ptrdiff_t rsb, std::ptrdiff_t csb,
+                                  T beta, T* c, std::ptrdiff_t ldc)
+{
+    typedef GemmBlocking<T> Blocking;
+
+    if (m == 0 || n == 0) { return; }
+    if (k == 0 || alpha == T()) {
+        for (std::size_t i = 0; i < m; ++i) {
+            T* cRow = c + static_cast<std::ptrdiff_t>(i) * ldc;
+            for (std::size_t j = 0; j < n; ++j) { cRow[j] = (beta == T()) ? T() : beta * cRow[j]; }
+        }
+        return;
+    }
+
+    thread_local std::vector< T, LinAlg::AlignedAllocator<T> > packedA;
+    thread_local std::vector< T, LinAlg::AlignedAllocator<T> > packedB;
+
+    const std::size_t mcMax = std::min(Blocking::MC, (m + Blocking::MR - 1) / Blocking::MR * Blocking::MR);
+    const std::size_t ncMax = std::min(Blocking::NC, (n + Blocking::NR - 1) / Blocking::NR * Blocking::NR);
+    const std::size_t kcMax = std::min(Blocking::KC, k);
+    if (packedA.size() < mcMax * kcMax) { packedA.resize(mcMax * kcMax); }
+    if (packedB.size() < kcMax * ncMax) { packedB.resize(kcMax * ncMax); }
+
+    for (std::size_t jc = 0; jc < n; jc += Blocking::NC) {
+        const std::size_t nc = std::min(Blocking::NC, n - jc);
+
+        for (std::size_t pc = 0; pc < k; pc += Blocking::KC) {
+            const std::size_t kc = std::min(Blocking::KC, k - pc);
+            const bool overwrite = (pc == 0 && beta == T());
+            const T betaBlock = (pc == 0) ? beta : T(1);
+
+            pack_b(kc, nc, b + static_cast<std::ptrdiff_t>(pc) * rsb + static_cast<std::ptrdiff_t>(jc) * csb, rsb, csb, packedB.data());
+
+            for (std::size_t ic = 0; ic < m; ic += Blocking::MC) {
+                const std::size_t mc = std::min(Blocking::MC, m - ic);
+
+                pack_a(mc, kc, a + static_cast<std::ptrdiff_t>(ic) * rsa + static_cast<std::ptrdiff_t>(pc) * csa, rsa, csa, packedA.data());
+
+                for (std::size_t jr = 0; jr < nc; jr += Blocking::NR) {
+                    const std::size_t nr = std::min(Blocking::NR, nc - jr);
+                    for (std::size_t ir = 0; ir < mc; ir += Blocking::MR) {
+                        const std::size_t mr = std::min(Blocking::MR, mc - ir);
+                        T* cBlock = c + static_cast<std::ptrdiff_t>(ic + ir) * ldc + static_cast<std::ptrdiff_t>(jc + jr);
+                        micro_kernel(kc, alpha, packedA.data() + ir * kc, packedB.data() + jr * kc,
+                                     betaBlock, overwrite, cBlock, ldc, mr, nr);
+                    }
+                }
+            }
+        }
+    }
+}
+
+#endif // GEMM_HPP
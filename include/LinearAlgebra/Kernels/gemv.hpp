@@ -0,0 +1,197 @@
+#ifndef GEMV_HPP
+#define GEMV_HPP
+
+#include <algorithm>
+#include <cstddef>
+
+#include "../ExecutionPolicy.hpp"
+#include "elementwise.hpp"
+
+namespace LinAlg
+{
+    namespace Kernels
+    {
+        // Level 2 routines on row-major matrices with row stride lda. Vectors are
+        // contiguous and must not overlap the matrix or each other.
+        const std::size_t matrix_vector_row_grain = 64;
+        const std::size_t matrix_vector_col_grain = 512;
+        const std::size_t trsv_block = 256;
+
+        // Four simultaneous dot products sharing the loads of x. Returns the
+        // number of leading elements processed, see VectorLoops.
+        template <typename T, bool Enabled = SimdTraits<T>::enabled>
+        struct MatrixVectorLoops
+        {
+            static std::size_t dot4(std::size_t, const T*, const T*, const T*, const T*, const T*, T* result)
+            {
+                std::fill(result, result + 4, T());
+                return 0;
+            }
+        };
+
+        template <typename T>
+        struct MatrixVectorLoops<T, true>
+        {
+            typedef SimdTraits<T> Simd;
+
+            static std::size_t dot4(std::size_t n, const T* a0, const T* a1, const T* a2, const T* a3, const T* x, T* result);
+        };
+
+        // y = alpha * A * x + beta * y for m x n A. y is never read when beta is zero.
+        template <typename T>
+        void gemv(std::size_t m, std::size_t n, T alpha, const T* a, std::size_t lda, const T* x, T beta, T* y);
+
+        // y = alpha * A^T * x + beta * y for m x n A, so x has m and y has n elements.
+        template <typename T>
+        void gemv_transposed(std::size_t m, std::size_t n, T alpha, const T* a, std::size_t lda, const T* x, T beta, T* y);
+
+        // A += alpha * x * y^T for m x n A.
+        template <typename T>
+        void ger(std::size_t m, std::size_t n, T alpha, const T* x, const T* y, T* a, std::size_t lda);
+
+        // Solves L x = b or U x = b in place, reading only the selected triangle.
+        // A unit diagonal is implied and not read when unitDiagonal is set. Rows are
+        // processed in blocks so that all but the diagonal blocks go through gemv.
+        template <typename T>
+        void trsv(bool lower, bool unitDiagonal, std::size_t n, const T* a, std::size_t lda, T* x);
+
+        // y = alpha * A * x + beta * y for symmetric A given by its lower triangle.
+        template <typename T>
+        void symv(std::size_t n, T alpha, const T* a, std::size_t lda, const T* x, T beta, T* y);
+
+        template <typename T>
+        void scale_output(std::size_t n, T beta, T* y);
+    }
+}
+
+template <typename T>
+inline std::size_t LinAlg::Kernels::MatrixVectorLoops<T, true>::dot4(std::size_t n, const T* a0, const T* a1, const T* a2, const T* a3, const T* x, T* result)
+{
+    typename Simd::vector_type sum0 = Simd::set1(T()), sum1 = sum0, sum2 = sum0, sum3 = sum0;
+    std::size_t i = 0;
+    for (; i + Simd::width <= n; i += Simd::width) {
+        const typename Simd::vector_type xVector = Simd::load(x + i);
+        sum0 = Simd::add(sum0, Simd::mul(Simd::load(a0 + i), xVector));
+        sum1 = Simd::add(sum1, Simd::mul(Simd::load(a1 + i), xVector));
+        sum2 = Simd::add(sum2, Simd::mul(Simd::load(a2 + i), xVector));
+        sum3 = Simd::add(sum3, Simd::mul(Simd::load(a3 + i), xVector));
+    }
+
+    T lanes[4][Simd::width];
+    Simd::store(lanes[0], sum0);
+    Simd::store(lanes[1], sum1);
+    Simd::store(lanes[2], sum2);
+    Simd::store(lanes[3], sum3);
+    for (std::size_t r = 0; r < 4; ++r) {
+        result[r] = T();
+        for (std::size_t lane = 0; lane < Simd::width; ++lane) { result[r] += lanes[r][lane]; }
+    }
+    return i;
+}
+
+template <typename T>
+inline void LinAlg::Kernels::scale_output(std::size_t n, T beta, T* y)
+{
+    if (beta == T()) {
+        std::fill(y, y + n, T());
+    } else if (beta != T(1)) {
+        scale(n, beta, y);
+    }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::gemv(std::size_t m, std::size_t n, T alpha, const T* a, std::size_t lda, const T* x, T beta, T* y)
+{
+    LinAlg::parallel_for(m * n, 0, m, matrix_vector_row_grain, [=](std::size_t first, std::size_t last) {
+        std::size_t i = first;
+        for (; i + 4 <= last; i += 4) {
+            const T* row = a + i * lda;
+            T sums[4];
+            std::size_t j = MatrixVectorLoops<T>::dot4(n, row, row + lda, row + 2 * lda, row + 3 * lda, x, sums);
+            for (; j < n; ++j) {
+                for (std::size_t r = 0; r < 4; ++r) { sums[r] += row[r * lda + j] * x[j]; }
+            }
+            for (std::size_t r = 0; r < 4; ++r) { y[i + r] = beta == T() ? alpha * sums[r] : alpha * sums[r] + beta * y[i + r]; }
+        }
+        for (; i < last; ++i) {
+            const T sum = dot(n, a + i * lda, x);
+            y[i] = beta == T() ? alpha * sum : alpha * sum + beta * y[i];
+        }
+    });
+}
+
+// Every task owns a range of y and streams the rows of A through it, so the
+// result is written without synchronization.
+template <typename T>
+inline void LinAlg::Kernels::gemv_transposed(std::size_t m, std::size_t n, T alpha, const T* a, std::size_t lda, const T* x, T beta, T* y)
+{
+    LinAlg::parallel_for(m * n, 0, n, matrix_vector_col_grain, [=](std::size_t first, std::size_t last) {
+        scale_output(last - first, beta, y + first);
+        for (std::size_t i = 0; i < m; ++i) {
+            if (x[i] != T()) { axpy(last - first, alpha * x[i], a + i * lda + first, y + first); }
+        }
+    });
+}
+
+template <typename T>
+inline void LinAlg::Kernels::ger(std::size_t m, std::size_t n, T alpha, const T* x, const T* y, T* a, std::size_t lda)
+{
+    LinAlg::parallel_for(m * n, 0, m, matrix_vector_row_grain, [=](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            if (x[i] != T()) { axpy(n, alpha * x[i], y, a + i * lda); }
+        }
+    });
+}
+
+template <typename T>
+inline void LinAlg::Kernels::trsv(bool lower, bool unitDiagonal, std::size_t n, const T* a, std::size_t lda, T* x)
+{
+    for (std::size_t block = 0; block < n; block += trsv_block) {
+        const std::size_t nb = std::min(trsv_block, n - block);
+        if (lower) {
+            const std::size_t k = block;
+            if (k > 0) { gemv(nb, k, T(-1), a + k * lda, lda, x, T(1), x + k); }
+            for (std::size_t i = k; i < k + nb; ++i) {
+                const T* row = a + i * lda;
+                x[i] -= dot(i - k, row + k, x + k);
+                if (!unitDiagonal) { x[i] /= row[i]; }
+            }
+        } else {
+            const std::size_t k = n - block - nb;
+            if (block > 0) { gemv(nb, block, T(-1), a + k * lda + k + nb, lda, x + k + nb, T(1), x + k); }
+            for (std::size_t i = k + nb; i-- > k;) {
+                const T* row = a + i * lda;
+                x[i] -= dot(k + nb - i - 1, row + i + 1, x + i + 1);
+                if (!unitDiagonal) { x[i] /= row[i]; }
+            }
+        }
+    }
+}
+
+// Sequentially both halves of the matrix are applied in one pass over the lower
+// triangle. A task owning only rows [first, last) of y instead gathers the
+// strictly upper part from columns [first, last) of the rows below, reading
+// the triangle twice but writing nothing outside its range.
+template <typename T>
+inline void LinAlg::Kernels::symv(std::size_t n, T alpha, const T* a, std::size_t lda, const T* x, T beta, T* y)
+{
+    scale_output(n, beta, y);
+    LinAlg::parallel_for(n * n, 0, n, matrix_vector_row_grain, [=](std::size_t first, std::size_t last) {
+        if (first == 0 && last == n) {
+            for (std::size_t i = 0; i < n; ++i) {
+                const T* row = a + i * lda;
+                axpy(i, alpha * x[i], row, y);
+                y[i] += alpha * (dot(i, row, x) + row[i] * x[i]);
+            }
+            return;
+        }
+
+        for (std::size_t i = first; i < last; ++i) { y[i] += alpha * dot(i + 1, a + i * lda, x); }
+        for (std::size_t i = first + 1; i < n; ++i) {
+            const std::size_t end = std::min(last, i);
+            axpy(end - first, alpha * x[i], a + i * lda + first, y + first);
+        }
+    });
+}
+
+#endif // GEMV_HPP
@@ -0,0 +1,79 @@
+#ifndef INVERSE_HPP
+#define INVERSE_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "../ExecutionPolicy.hpp"
+#include "elementwise.hpp"
+
+namespace LinAlg
+{
+    namespace Kernels
+    {
+        // In-place Gauss-Jordan inversion with partial pivoting of the row-major
+        // n x n matrix a. Returns false, leaving a partially reduced, when a is
+        // singular.
+        template <typename T>
+        bool invert_in_place(std::size_t n, T* a, std::size_t lda);
+
+        // Same, with caller-provided storage for the n pivot indices.
+        template <typename T>
+        bool invert_in_place(std::size_t n, T* a, std::size_t lda, std::size_t* pivots);
+    }
+}
+
+template <typename T>
+inline bool LinAlg::Kernels::invert_in_place(std::size_t n, T* a, std::size_t lda)
+{
+    std::vector<std::size_t> pivots(n);
+    return invert_in_place(n, a, lda, pivots.data());
+}
+
+template <typename T>
+inline bool LinAlg::Kernels::invert_in_place(std::size_t n, T* a, std::size_t lda, std::size_t* pivots)
+{
+    for (std::size_t k = 0; k < n; ++k) {
+        std::size_t pivot = k;
+        T pivotValue = std::fabs(a[k * lda + k]);
+        for (std::size_t i = k + 1; i < n; ++i) {
+            const T value = std::fabs(a[i * lda + k]);
+            if (value > pivotValue) {
+                pivot = i;
+                pivotValue = value;
+            }
+        }
+        if (pivotValue == T()) { return false; }
+
+        pivots[k] = pivot;
+        if (pivot != k) { std::swap_ranges(a + k * lda, a + k * lda + n, a + pivot * lda); }
+
+        T* pivotRow = a + k * lda;
+        const T diagonal = pivotRow[k];
+        pivotRow[k] = T(1);
+        divide(n, diagonal, pivotRow);
+
+        LinAlg::parallel_for(n * n, 0, n, 8, [=](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i) {
+                if (i == k) { continue; }
+                T* row = a + i * lda;
+                const T multiplier = row[k];
+                if (multiplier != T()) {
+                    row[k] = T();
+                    axpy(n, -multiplier, pivotRow, row);
+                }
+            }
+        });
+    }
+
+    for (std::size_t k = n; k-- > 0;) {
+        if (pivots[k] != k) {
+            for (std::size_t i = 0; i < n; ++i) { std::swap(a[i * lda + k], a[i * lda + pivots[k]]); }
+        }
+    }
+    return true;
+}
+
+#endif // INVERSE_HPP
@@ -0,0 +1,144 @@
+#ifndef LU_HPP
+#define LU_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+#include "../ExecutionPolicy.hpp"
+#include "elementwise.hpp"
+#include "gemm.hpp"
+
+namespace LinAlg
+{
+    namespace Kernels
+    {
+        const std::size_t lu_block_size = 64;
+
+        // Right-looking blocked LU with partial pivoting of the row-major n x n
+        // matrix a, overwritten by the unit lower factor L and the upper factor U.
+        // Row i was exchanged with row pivots[i] >= i. Returns zero on success,
+        // or one plus the index of the first exactly zero pivot.
+        template <typename T>
+        std::size_t lu_factor(std::size_t n, T* a, std::size_t lda, std::size_t* pivots);
+
+        // Solves A X = B in place for the n x nrhs row-major B, given the output of lu_factor.
+        template <typename T>
+        void lu_solve(std::size_t n, std::size_t nrhs, const T* lu, std::size_t lda, const std::size_t* pivots, T* b, std::size_t ldb);
+
+        template <typename T>
+        std::size_t lu_factor_panel(std::size_t n, std::size_t first, std::size_t width, T* a, std::size_t lda, std::size_t* pivots);
+    }
+}
+
+template <typename T>
+inline std::size_t LinAlg::Kernels::lu_factor_panel(std::size_t n, std::size_t first, std::size_t width, T* a, std::size_t lda, std::size_t* pivots)
+{
+    std::size_t info = 0;
+    const std::size_t last = first + width;
+
+    for (std::size_t j = first; j < last; ++j) {
+        std::size_t pivot = j;
+        T pivotValue = std::fabs(a[j * lda + j]);
+        for (std::size_t i = j + 1; i < n; ++i) {
+            const T value = std::fabs(a[i * lda + j]);
+            if (value > pivotValue) {
+                pivot = i;
+                pivotValue = value;
+            }
+        }
+
+        pivots[j] = pivot;
+        if (pivot != j) { std::swap_ranges(a + j * lda, a + j * lda + n, a + pivot * lda); }
+
+        const T diagonal = a[j * lda + j];
+        if (diagonal == T()) {
+            if (info == 0) { info = j + 1; }
+            continue;
+        }
+
+        for (std::size_t i = j + 1; i < n; ++i) {
+            T& multiplier = a[i * lda + j];
+            multiplier /= diagonal;
+            if (multiplier != T() && j + 1 < last) {
+                axpy(last - j - 1, -multiplier, a + j * lda + j + 1, a + i * lda + j + 1);
+            }
+        }
+    }
+    return info;
+}
+
+template <typename T>
+inline std::size_t LinAlg::Kernels::lu_factor(std::size_t n, T* a, std::size_t lda, std::size_t* pivots)
+{
+    std::size_t info = 0;
+
+    for (std::size_t k = 0; k < n; k += lu_block_size) {
+        const std::size_t nb = std::min(lu_block_size, n - k);
+        const std::size_t panelInfo = lu_factor_panel(n, k, nb, a, lda, pivots);
+        if (info == 0 && panelInfo != 0) { info = panelInfo; }
+
+        const std::size_t trailing = n - k - nb;
+        if (trailing == 0) { continue; }
+
+        // U12 = L11^-1 A12, one contiguous row sweep per panel row
+        for (std::size_t r = k + 1; r < k + nb; ++r) {
+            for (std::size_t i = k; i < r; ++i) {
+                const T multiplier = a[r * lda + i];
+                if (multiplier != T()) { axpy(trailing, -multiplier, a + i * lda + k + nb, a + r * lda + k + nb); }
+            }
+        }
+
+        // A22 -= L21 U12
+        const T* l21 = a + (k + nb) * lda + k;
+        const T* u12 = a + k * lda + k + nb;
+        T* a22 = a + (k + nb) * lda + k + nb;
+        const std::size_t rowGrain = 8 * GemmBlocking<T>::MR;
+        LinAlg::parallel_for(trailing * trailing * nb, 0, trailing, rowGrain, [=](std::size_t firstRow, std::size_t lastRow) {
+            gemm<T>(lastRow - firstRow, trailing, nb, T(-1),
+                    l21 + firstRow * lda, lda, 1,
+                    u12, lda, 1,
+                    T(1), a22 + firstRow * lda, lda);
+        });
+    }
+    return info;
+}
+
+template <typename T>
+inline void LinAlg::Kernels::lu_solve(std::size_t n, std::size_t nrhs, const T* lu, std::size_t lda, const std::size_t* pivots, T* b, std::size_t ldb)
+{
+    for (std::size_t i = 0; i < n; ++i) {
+        if (pivots[i] != i) { std::swap_ranges(b + i * ldb, b + i * ldb + nrhs, b + pivots[i] * ldb); }
+    }
+
+    if (nrhs == 1) {
+        for (std::size_t i = 1; i < n; ++i) {
+            T sum = b[i * ldb];
+            for (std::size_t j = 0; j < i; ++j) { sum -= lu[i * lda + j] * b[j * ldb]; }
+            b[i * ldb] = sum;
+        }
+        for (std::size_t i = n; i-- > 0;) {
+            T sum = b[i * ldb];
+            for (std::size_t j = i + 1; j < n; ++j) { sum -= lu[i * lda + j] * b[j * ldb]; }
+            b[i * ldb] = sum / lu[i * lda + i];
+        }
+        return;
+    }
+
+    for (std::size_t i = 1; i < n; ++i) {
+        for (std::size_t j = 0; j < i; ++j) {
+            const T multiplier = lu[i * lda + j];
+            if (multiplier != T()) { axpy(nrhs, -multiplier, b + j * ldb, b + i * ldb); }
+        }
+    }
+    for (std::size_t i = n; i-- > 0;) {
+        for (std::size_t j = i + 1; j < n; ++j) {
+            const T multiplier = lu[i * lda + j];
+            if (multiplier != T()) { axpy(nrhs, -multiplier, b + j * ldb, b + i * ldb); }
+        }
+        divide(nrhs, lu[i * lda + i], b + i * ldb);
+    }
+}
+
+#endif // LU_HPP
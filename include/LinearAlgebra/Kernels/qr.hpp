@@ -0,0 +1,252 @@
+#ifndef QR_HPP
+#define QR_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "../ExecutionPolicy.hpp"
+#include "elementwise.hpp"
+#include "gemm.hpp"
+
+namespace LinAlg
+{
+    namespace Kernels
+    {
+        const std::size_t qr_block_size = 64;
+
+        // Entries of the T factors qr_factor stores for k reflectors: one
+        // qr_block_size x qr_block_size row-major block per panel.
+        inline std::size_t qr_t_size(std::size_t k) { return (k + qr_block_size - 1) / qr_block_size * qr_block_size * qr_block_size; }
+
+        // Turns x into the Householder reflector H = I - tau v v^T with H x =
+        // (beta, 0, ..., 0): x[0] receives beta and x[1, n) the tail of v, whose
+        // leading element is an implied one. Returns tau, zero when x is already
+        // a multiple of e1.
+        template <typename T>
+        T householder(std::size_t n, T* x);
+
+        // Householder QR of the column-major height x width panel p, column j at
+        // p + j * ldp, with height >= width. The reflectors replace the panel as in
+        // qr_factor and the upper triangular T goes to t with row stride ldt, whose
+        // strict lower triangle must be zero. Wide panels split in half
+        // recursively (Elmroth and Gustavson), so all but the narrowest leaves
+        // update through gemm.
+        template <typename T>
+        void qr_panel(std::size_t height, std::size_t width, T* p, std::size_t ldp, T* t, std::size_t ldt);
+
+        // Blocked Householder QR of the row-major m x n matrix a. R overwrites
+        // the upper triangle, the reflectors of the min(m, n) columns are stored
+        // below the diagonal, and each panel of qr_block_size columns keeps the
+        // upper triangular T of its compact WY form Q = I - V T V^T in t. Panels
+        // are factored by qr_panel on a transposed copy, so that every column is
+        // contiguous; the trailing matrix is updated with three gemm calls per panel.
+        template <typename T>
+        void qr_factor(std::size_t m, std::size_t n, T* a, std::size_t lda, T* t);
+
+        // B = Q^T B when transpose is set and B = Q B otherwise, for the m x nrhs
+        // row-major B and the first k reflectors stored by qr_factor.
+        template <typename T>
+        void qr_apply(bool transpose, std::size_t m, std::size_t k, const T* a, std::size_t lda, const T* t,
+                      std::size_t nrhs, T* b, std::size_t ldb);
+
+        // B = (I - V op(T) V^T) B for the m x nb unit lower trapezoidal V addressed
+        // through strides, op(T) = T^T when transpose is set. Columns of B are
+        // split across the execution policy.
+        template <typename T>
+        void qr_apply_block(bool transpose, std::size_t m, std::size_t nb, const T* v, std::ptrdiff_t rsv, std::ptrdiff_t csv,
+                            const T* t, std::size_t ldt, std::size_t cols, T* b, std::size_t ldb);
+
+        // Solves R X = B in place for the upper triangle of the n x n row-major r
+        // and the n x nrhs row-major B.
+        template <typename T>
+        void upper_solve(std::size_t n, const T* r, std::size_t ldr, std::size_t nrhs, T* b, std::size_t ldb);
+    }
+}
+
+template <typename T>
+inline T LinAlg::Kernels::householder(std::size_t n, T* x)
+{
+    if (n <= 1) { return T(); }
+
+    const T alpha = x[0];
+    const T tailNorm = std::sqrt(dot(n - 1, x + 1, x + 1));
+    if (tailNorm == T()) { return T(); }
+
+    const T beta = -std::copysign(std::hypot(alpha, tailNorm), alpha);
+    scale(n - 1, T(1) / (alpha - beta), x + 1);
+    x[0] = beta;
+    return (beta - alpha) / beta;
+}
+
+template <typename T>
+inline void LinAlg::Kernels::qr_apply_block(bool transpose, std::size_t m, std::size_t nb, const T* v, std::ptrdiff_t rsv, std::ptrdiff_t csv,
+                                            const T* t, std::size_t ldt, std::size_t cols, T* b, std::size_t ldb)
+{
+    if (m == 0 || nb == 0 || cols == 0) { return; }
+
+    const std::ptrdiff_t rst = transpose ? 1 : static_cast<std::ptrdiff_t>(ldt), cst = transpose ? static_cast<std::ptrdiff_t>(ldt) : 1;
+    const std::ptrdiff_t rsb = static_cast<std::ptrdiff_t>(ldb);
+    LinAlg::parallel_for(m * nb * cols, 0, cols, 4 * GemmBlocking<T>::NR, [=](std::size_t first, std::size_t last) {
+        const std::size_t width = last - first;
+        const std::ptrdiff_t ldw = static_cast<std::ptrdiff_t>(width);
+        std::vector<T> work(2 * nb * width);
+        T* product = work.data();
+        T* scaled = product + nb * width;
+        gemm<T>(nb, width, m, T(1), v, csv, rsv, b + first, rsb, 1, T(), product, ldw);
+        gemm<T>(nb, width, nb, T(1), t, rst, cst, product, ldw, 1, T(), scaled, ldw);
+        gemm<T>(m, width, nb, T(-1), v, rsv, csv, scaled, ldw, 1, T(1), b + first, rsb);
+    });
+}
+
+template <typename T>
+inline void LinAlg::Kernels::qr_panel(std::size_t height, std::size_t width, T* p, std::size_t ldp, T* t, std::size_t ldt)
+{
+    const std::size_t leafWidth = 8;
+    const std::ptrdiff_t sp = static_cast<std::ptrdiff_t>(ldp), st = static_cast<std::ptrdiff_t>(ldt);
+
+    if (width <= leafWidth) {
+        // Left to right: generate reflector j, apply it to the columns after it,
+        // then extend T by T(0:j, j) = -tau_j T(0:j, 0:j) V(:, 0:j)^T v_j.
+        for (std::size_t j = 0; j < width; ++j) {
+            T* x = p + j * ldp + j;
+            const std::size_t length = height - j;
+            const T tau = householder(length, x);
+            t[j * ldt + j] = tau;
+            if (tau == T()) { continue; }
+
+            for (std::size_t l = j + 1; l < width; ++l) {
+                T* y = p + l * ldp + j;
+                const T w = tau * (y[0] + dot(length - 1, x + 1, y + 1));
+                y[0] -= w;
+                axpy(length - 1, -w, x + 1, y + 1);
+            }
+
+            T z[leafWidth];
+            for (std::size_t i = 0; i < j; ++i) { z[i] = -tau * (p[i * ldp + j] + dot(length - 1, p + i * ldp + j + 1, x + 1)); }
+            for (std::size_t i = 0; i < j; ++i) {
+                T sum = T();
+                for (std::size_t l = i; l < j; ++l) { sum += t[i * ldt + l] * z[l]; }
+                t[i * ldt + j] = sum;
+            }
+        }
+        return;
+    }
+
+    const std::size_t n1 = width / 2, n2 = width - n1, rest = height - n1;
+    T* right = p + n1 * ldp;
+    T* t2 = t + n1 * ldt + n1;
+    qr_panel(height, n1, p, ldp, t, ldt);
+
+    // The top n1 x n1 of V1, unit lower triangular, copied out column-major.
+    std::vector<T> work(n1 * n1 + 2 * n1 * n2 + n2 * n2);
+    T* top = work.data();
+    T* w = top + n1 * n1;
+    T* scaled = w + n1 * n2;
+    T* top2 = scaled + n1 * n2;
+    for (std::size_t j = 0; j < n1; ++j) {
+        top[j * n1 + j] = T(1);
+        std::copy(p + j * ldp + j + 1, p + j * ldp + n1, top + j * n1 + j + 1);
+    }
+
+    // A2 = (I - V1 T1^T V1^T) A2. A2 is updated through its row-major transpose.
+    const std::ptrdiff_t ld1 = static_cast<std::ptrdiff_t>(n1), ld2 = static_cast<std::ptrdiff_t>(n2);
+    gemm<T>(n1, n2, n1, T(1), top, ld1, 1, right, 1, sp, T(), w, ld2);
+    gemm<T>(n1, n2, rest, T(1), p + n1, sp, 1, right + n1, 1, sp, T(1), w, ld2);
+    gemm<T>(n1, n2, n1, T(1), t, 1, st, w, ld2, 1, T(), scaled, ld2);
+    gemm<T>(n2, n1, n1, T(-1), scaled, 1, ld2, top, ld1, 1, T(1), right, sp);
+    gemm<T>(n2, rest, n1, T(-1), scaled, 1, ld2, p + n1, sp, 1, T(1), right + n1, sp);
+
+    qr_panel(rest, n2, right + n1, ldp, t2, ldt);
+
+    // T12 = -T1 (V1^T V2) T2, where only the rows of V1 below n1 meet V2.
+    for (std::size_t j = 0; j < n2; ++j) {
+        top2[j * n2 + j] = T(1);
+        std::copy(right + j * ldp + n1 + j + 1, right + j * ldp + n1 + n2, top2 + j * n2 + j + 1);
+    }
+    gemm<T>(n1, n2, n2, T(1), p + n1, sp, 1, top2, 1, ld2, T(), w, ld2);
+    gemm<T>(n1, n2, rest - n2, T(1), p + n1 + n2, sp, 1, right + n1 + n2, 1, sp, T(1), w, ld2);
+    gemm<T>(n1, n2, n1, T(1), t, st, 1, w, ld2, 1, T(), scaled, ld2);
+    gemm<T>(n1, n2, n2, T(-1), scaled, ld2, 1, t2, st, 1, T(), t + n1, st);
+}
+
+template <typename T>
+inline void LinAlg::Kernels::qr_factor(std::size_t m, std::size_t n, T* a, std::size_t lda, T* t)
+{
+    const std::size_t nb = qr_block_size, k = std::min(m, n);
+    std::vector<T> panel(nb * m);
+
+    for (std::size_t first = 0; first < k; first += nb) {
+        const std::size_t width = std::min(nb, k - first), height = m - first;
+        T* block = a + first * lda + first;
+        T* tBlock = t + first / nb * nb * nb;
+        std::fill(tBlock, tBlock + nb * nb, T());
+
+        // Row j of the panel buffer is column first + j from row first down.
+        for (std::size_t r = 0; r < height; ++r) {
+            for (std::size_t j = 0; j < width; ++j) { panel[j * height + r] = block[r * lda + j]; }
+        }
+        qr_panel(height, width, panel.data(), height, tBlock, nb);
+        for (std::size_t r = 0; r < height; ++r) {
+            for (std::size_t j = 0; j < width; ++j) { block[r * lda + j] = panel[j * height + r]; }
+        }
+
+        // The trailing update needs V with its unit diagonal and zeros above.
+        for (std::size_t j = 0; j < width; ++j) {
+            std::fill(panel.data() + j * height, panel.data() + j * height + j, T());
+            panel[j * height + j] = T(1);
+        }
+        if (first + width < n) {
+            qr_apply_block(true, height, width, panel.data(), 1, static_cast<std::ptrdiff_t>(height), tBlock, nb,
+                           n - first - width, block + width, lda);
+        }
+    }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::qr_apply(bool transpose, std::size_t m, std::size_t k, const T* a, std::size_t lda, const T* t,
+                                      std::size_t nrhs, T* b, std::size_t ldb)
+{
+    const std::size_t nb = qr_block_size, blocks = (k + nb - 1) / nb;
+    std::vector<T> v;
+
+    for (std::size_t step = 0; step < blocks; ++step) {
+        const std::size_t blockIndex = transpose ? step : blocks - 1 - step;
+        const std::size_t first = blockIndex * nb, width = std::min(nb, k - first), height = m - first;
+        const T* block = a + first * lda + first;
+
+        v.assign(height * width, T());
+        for (std::size_t r = 0; r < height; ++r) {
+            const std::size_t end = std::min(r, width);
+            std::copy(block + r * lda, block + r * lda + end, v.begin() + r * width);
+            if (r < width) { v[r * width + r] = T(1); }
+        }
+        qr_apply_block(transpose, height, width, v.data(), static_cast<std::ptrdiff_t>(width), 1, t + blockIndex * nb * nb, nb,
+                       nrhs, b + first * ldb, ldb);
+    }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::upper_solve(std::size_t n, const T* r, std::size_t ldr, std::size_t nrhs, T* b, std::size_t ldb)
+{
+    for (std::size_t i = n; i-- > 0;) {
+        const T* row = r + i * ldr;
+        if (nrhs == 1) {
+            T sum = T();
+            if (ldb == 1) {
+                sum = dot(n - i - 1, row + i + 1, b + i + 1);
+            } else {
+                for (std::size_t j = i + 1; j < n; ++j) { sum += row[j] * b[j * ldb]; }
+            }
+            b[i * ldb] = (b[i * ldb] - sum) / row[i];
+            continue;
+        }
+        for (std::size_t j = i + 1; j < n; ++j) {
+            if (row[j] != T()) { axpy(nrhs, -row[j], b + j * ldb, b + i * ldb); }
+        }
+        divide(nrhs, row[i], b + i * ldb);
+    }
+}
+
+#endif // QR_HPP
@@ -0,0 +1,122 @@
+#ifndef SPARSE_HPP
+#define SPARSE_HPP
+
+#include <algorithm>
+#include <cstddef>
+
+#include "elementwise.hpp"
+
+namespace LinAlg
+{
+    namespace Kernels
+    {
+        // Compressed sparse row storage: the entries of row i are values[p] at
+        // column indices[p] for p in [pointers[i], pointers[i + 1]).
+
+        // y[i] = A(i, :) x for rows [first, last) of the CSR matrix A.
+        template <typename T>
+        void csr_gemv(std::size_t first, std::size_t last, const std::size_t* pointers, const std::size_t* indices, const T* values,
+                      const T* x, T* y);
+
+        // y = A^T x for the rows x cols CSR matrix A: every row of A scatters
+        // into y, which receives cols elements.
+        template <typename T>
+        void csr_gemv_transposed(std::size_t rows, std::size_t cols, const std::size_t* pointers, const std::size_t* indices, const T* values,
+                                 const T* x, T* y);
+
+        // Rows [first, last) of C = A B for CSR A and the dense n-column B
+        // addressed through strides. C is row-major with row stride ldc.
+        template <typename T>
+        void csr_gemm(std::size_t first, std::size_t last, std::size_t n, const std::size_t* pointers, const std::size_t* indices, const T* values,
+                      const T* b, std::ptrdiff_t rsb, std::ptrdiff_t csb, T* c, std::size_t ldc);
+
+        // Rows [first, last) of C = A B for the dense k-column A addressed
+        // through strides and CSR B with n columns. C is row-major with row stride ldc.
+        template <typename T>
+        void gemm_csr(std::size_t first, std::size_t last, std::size_t k, std::size_t n, const T* a, std::ptrdiff_t rsa, std::ptrdiff_t csa,
+                      const std::size_t* pointers, const std::size_t* indices, const T* values, T* c, std::size_t ldc);
+
+        // CSR storage of the cols x rows transpose of the rows x cols CSR matrix.
+        // The output pointer array has cols + 1 entries, indices come out sorted.
+        template <typename T>
+        void csr_transpose(std::size_t rows, std::size_t cols, const std::size_t* pointers, const std::size_t* indices, const T* values,
+                           std::size_t* outPointers, std::size_t* outIndices, T* outValues);
+    }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::csr_gemv(std::size_t first, std::size_t last, const std::size_t* pointers, const std::size_t* indices, const T* values,
+                                      const T* x, T* y)
+{
+    for (std::size_t i = first; i < last; ++i) {
+        T sum = T();
+        for (std::size_t p = pointers[i]; p < pointers[i + 1]; ++p) { sum += values[p] * x[indices[p]]; }
+        y[i] = sum;
+    }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::csr_gemv_transposed(std::size_t rows, std::size_t cols, const std::size_t* pointers, const std::size_t* indices,
+                                                 const T* values, const T* x, T* y)
+{
+    std::fill(y, y + cols, T());
+    for (std::size_t i = 0; i < rows; ++i) {
+        if (x[i] == T()) { continue; }
+        for (std::size_t p = pointers[i]; p < pointers[i + 1]; ++p) { y[indices[p]] += values[p] * x[i]; }
+    }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::csr_gemm(std::size_t first, std::size_t last, std::size_t n, const std::size_t* pointers, const std::size_t* indices, const T* values,
+                                      const T* b, std::ptrdiff_t rsb, std::ptrdiff_t csb, T* c, std::size_t ldc)
+{
+    for (std::size_t i = first; i < last; ++i) {
+        T* cRow = c + i * ldc;
+        std::fill(cRow, cRow + n, T());
+        for (std::size_t p = pointers[i]; p < pointers[i + 1]; ++p) {
+            const T* bRow = b + static_cast<std::ptrdiff_t>(indices[p]) * rsb;
+            if (csb == 1) {
+                axpy(n, values[p], bRow, cRow);
+            } else {
+                for (std::size_t j = 0; j < n; ++j) { cRow[j] += values[p] * bRow[static_cast<std::ptrdiff_t>(j) * csb]; }
+            }
+        }
+    }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::gemm_csr(std::size_t first, std::size_t last, std::size_t k, std::size_t n, const T* a, std::ptrdiff_t rsa, std::ptrdiff_t csa,
+                                      const std::size_t* pointers, const std::size_t* indices, const T* values, T* c, std::size_t ldc)
+{
+    for (std::size_t i = first; i < last; ++i) {
+        T* cRow = c + i * ldc;
+        std::fill(cRow, cRow + n, T());
+        const T* aRow = a + static_cast<std::ptrdiff_t>(i) * rsa;
+        for (std::size_t l = 0; l < k; ++l) {
+            const T aValue = aRow[static_cast<std::ptrdiff_t>(l) * csa];
+            for (std::size_t p = pointers[l]; p < pointers[l + 1]; ++p) { cRow[indices[p]] += aValue * values[p]; }
+        }
+    }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::csr_transpose(std::size_t rows, std::size_t cols, const std::size_t* pointers, const std::size_t* indices, const T* values,
+                                           std::size_t* outPointers, std::size_t* outIndices, T* outValues)
+{
+    std::fill(outPointers, outPointers + cols + 1, std::size_t(0));
+    for (std::size_t p = 0; p < pointers[rows]; ++p) { ++outPointers[indices[p] + 1]; }
+    for (std::size_t j = 0; j < cols; ++j) { outPointers[j + 1] += outPointers[j]; }
+
+    // Rows are visited in order, so every output row receives its indices sorted.
+    for (std::size_t i = 0; i < rows; ++i) {
+        for (std::size_t p = pointers[i]; p < pointers[i + 1]; ++p) {
+            const std::size_t q = outPointers[indices[p]]++;
+            outIndices[q] = i;
+            outValues[q] = values[p];
+        }
+    }
+    for (std::size_t j = cols; j > 0; --j) { outPointers[j] = outPointers[j - 1]; }
+    outPointers[0] = 0;
+}
+
+#endif // SPARSE_HPP
@@ -0,0 +1,256 @@
+#ifndef STRASSEN_HPP
+#define STRASSEN_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "../Allocator.hpp"
+#include "../ExecutionPolicy.hpp"
+#include "elementwise.hpp"
+#include "gemm.hpp"
+
+namespace LinAlg
+{
+    namespace Kernels
+    {
+        // Strassen-Winograd C = A * B for row-major A (m x k), B (k x n) and C
+        // (m x n): 7 half-size products and 15 additions per level. Every level
+        // halves the three dimensions, and recursion stops once the smallest is at
+        // most crossover; the products below go to the blocked gemm. Dimensions
+        // that do not halve evenly down to the leaves are zero padded up front.
+        //
+        // The workspace is a single block taken from the arena of the calling
+        // thread, which keeps it for the next product of that size. Sequential
+        // levels use the schedule of Boyer, Dumas, Pernet and Zhou (2009), which
+        // needs two half-size temporaries besides C. When the execution policy is
+        // parallel, the seven products of the top level run concurrently, each
+        // with its own temporaries.
+        template <typename T>
+        void strassen(std::size_t m, std::size_t n, std::size_t k, const T* a, std::size_t lda,
+                      const T* b, std::size_t ldb, T* c, std::size_t ldc, std::size_t crossover);
+
+        // Levels of recursion strassen takes for the given crossover.
+        std::size_t strassen_levels(std::size_t m, std::size_t n, std::size_t k, std::size_t crossover);
+
+        // Workspace elements of the recursion below the top level, and of a
+        // parallel top level including the products under it.
+        std::size_t strassen_workspace(std::size_t m, std::size_t n, std::size_t k, std::size_t levels);
+        std::size_t strassen_parallel_workspace(std::size_t m, std::size_t n, std::size_t k, std::size_t levels);
+
+        // out = x + y and out = x - y over a rows x cols block; out may alias x or y.
+        template <typename T>
+        void block_add(std::size_t rows, std::size_t cols, const T* x, std::size_t ldx, const T* y, std::size_t ldy, T* out, std::size_t ldo);
+
+        template <typename T>
+        void block_sub(std::size_t rows, std::size_t cols, const T* x, std::size_t ldx, const T* y, std::size_t ldy, T* out, std::size_t ldo);
+
+        template <typename T>
+        void strassen_leaf(std::size_t m, std::size_t n, std::size_t k, const T* a, std::size_t lda,
+                           const T* b, std::size_t ldb, T* c, std::size_t ldc);
+
+        template <typename T>
+        void strassen_sequential(std::size_t levels, std::size_t m, std::size_t n, std::size_t k, const T* a, std::size_t lda,
+                                 const T* b, std::size_t ldb, T* c, std::size_t ldc, T* workspace);
+
+        template <typename T>
+        void strassen_parallel(std::size_t levels, std::size_t m, std::size_t n, std::size_t k, const T* a, std::size_t lda,
+                               const T* b, std::size_t ldb, T* c, std::size_t ldc, T* workspace);
+    }
+}
+
+inline std::size_t LinAlg::Kernels::strassen_levels(std::size_t m, std::size_t n, std::size_t k, std::size_t crossover)
+{
+    if (crossover == 0) { return 0; }
+
+    std::size_t smallest = std::min(m, std::min(n, k)), levels = 0;
+    while (smallest > crossover) {
+        smallest = (smallest + 1) / 2;
+        ++levels;
+    }
+    return levels;
+}
+
+inline std::size_t LinAlg::Kernels::strassen_workspace(std::size_t m, std::size_t n, std::size_t k, std::size_t levels)
+{
+    std::size_t size = 0;
+    for (; levels > 0; --levels) {
+        m /= 2;
+        n /= 2;
+        k /= 2;
+        size += m * std::max(k, n) + k * n;
+    }
+    return size;
+}
+
+inline std::size_t LinAlg::Kernels::strassen_parallel_workspace(std::size_t m, std::size_t n, std::size_t k, std::size_t levels)
+{
+    const std::size_t mh = m / 2, nh = n / 2, kh = k / 2;
+    return 4 * mh * kh + 4 * kh * nh + 3 * mh * nh + 7 * strassen_workspace(mh, nh, kh, levels - 1);
+}
+
+template <typename T>
+inline void LinAlg::Kernels::block_add(std::size_t rows, std::size_t cols, const T* x, std::size_t ldx, const T* y, std::size_t ldy, T* out, std::size_t ldo)
+{
+    for (std::size_t i = 0; i < rows; ++i) { add(cols, x + i * ldx, y + i * ldy, out + i * ldo); }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::block_sub(std::size_t rows, std::size_t cols, const T* x, std::size_t ldx, const T* y, std::size_t ldy, T* out, std::size_t ldo)
+{
+    for (std::size_t i = 0; i < rows; ++i) { sub(cols, x + i * ldx, y + i * ldy, out + i * ldo); }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::strassen_leaf(std::size_t m, std::size_t n, std::size_t k, const T* a, std::size_t lda,
+                                           const T* b, std::size_t ldb, T* c, std::size_t ldc)
+{
+    const std::size_t rowGrain = 8 * GemmBlocking<T>::MR;
+    LinAlg::parallel_for(m * n * k, 0, m, rowGrain, [=](std::size_t first, std::size_t last) {
+        gemm<T>(last - first, n, k, T(1), a + first * lda, static_cast<std::ptrdiff_t>(lda), 1,
+                b, static_cast<std::ptrdiff_t>(ldb), 1, T(), c + first * ldc, static_cast<std::ptrdiff_t>(ldc));
+    });
+}
+
+template <typename T>
+inline void LinAlg::Kernels::strassen_sequential(std::size_t levels, std::size_t m, std::size_t n, std::size_t k, const T* a, std::size_t lda,
+                                                 const T* b, std::size_t ldb, T* c, std::size_t ldc, T* workspace)
+{
+    if (levels == 0) {
+        strassen_leaf(m, n, k, a, lda, b, ldb, c, ldc);
+        return;
+    }
+
+    const std::size_t mh = m / 2, nh = n / 2, kh = k / 2;
+    const T *a11 = a, *a12 = a + kh, *a21 = a + mh * lda, *a22 = a21 + kh;
+    const T *b11 = b, *b12 = b + nh, *b21 = b + kh * ldb, *b22 = b21 + nh;
+    T *c11 = c, *c12 = c + nh, *c21 = c + mh * ldc, *c22 = c21 + nh;
+    T* x = workspace;
+    T* y = x + mh * std::max(kh, nh);
+    T* below = y + kh * nh;
+
+    block_sub(mh, kh, a11, lda, a21, lda, x, kh);                               // S3 = A11 - A21
+    block_sub(kh, nh, b22, ldb, b12, ldb, y, nh);                               // T3 = B22 - B12
+    strassen_sequential(levels - 1, mh, nh, kh, x, kh, y, nh, c21, ldc, below); // P7 = S3 T3
+    block_add(mh, kh, a21, lda, a22, lda, x, kh);                               // S1 = A21 + A22
+    block_sub(kh, nh, b12, ldb, b11, ldb, y, nh);                               // T1 = B12 - B11
+    strassen_sequential(levels - 1, mh, nh, kh, x, kh, y, nh, c22, ldc, below); // P5 = S1 T1
+    block_sub(mh, kh, x, kh, a11, lda, x, kh);                                  // S2 = S1 - A11
+    block_sub(kh, nh, b22, ldb, y, nh, y, nh);                                  // T2 = B22 - T1
+    strassen_sequential(levels - 1, mh, nh, kh, x, kh, y, nh, c12, ldc, below); // P6 = S2 T2
+    block_sub(mh, kh, a12, lda, x, kh, x, kh);                                  // S4 = A12 - S2
+    strassen_sequential(levels - 1, mh, nh, kh, x, kh, b22, ldb, c11, ldc, below); // P3 = S4 B22
+    strassen_sequential(levels - 1, mh, nh, kh, a11, lda, b11, ldb, x, nh, below); // P1 = A11 B11
+    block_add(mh, nh, x, nh, c12, ldc, c12, ldc);                               // U2 = P1 + P6
+    block_add(mh, nh, c12, ldc, c21, ldc, c21, ldc);                            // U3 = U2 + P7
+    block_add(mh, nh, c12, ldc, c22, ldc, c12, ldc);                            // U4 = U2 + P5
+    block_add(mh, nh, c21, ldc, c22, ldc, c22, ldc);                            // C22 = U3 + P5
+    block_add(mh, nh, c12, ldc, c11, ldc, c12, ldc);                            // C12 = U4 + P3
+    block_sub(kh, nh, y, nh, b21, ldb, y, nh);                                  // T4 = T2 - B21
+    strassen_sequential(levels - 1, mh, nh, kh, a22, lda, y, nh, c11, ldc, below); // P4 = A22 T4
+    block_sub(mh, nh, c21, ldc, c11, ldc, c21, ldc);                            // C21 = U3 - P4
+    strassen_sequential(levels - 1, mh, nh, kh, a12, lda, b21, ldb, c11, ldc, below); // P2 = A12 B21
+    block_add(mh, nh, x, nh, c11, ldc, c11, ldc);                               // C11 = P1 + P2
+}
+
+template <typename T>
+inline void LinAlg::Kernels::strassen_parallel(std::size_t levels, std::size_t m, std::size_t n, std::size_t k, const T* a, std::size_t lda,
+                                               const T* b, std::size_t ldb, T* c, std::size_t ldc, T* workspace)
+{
+    const std::size_t mh = m / 2, nh = n / 2, kh = k / 2;
+    const T *a11 = a, *a12 = a + kh, *a21 = a + mh * lda, *a22 = a21 + kh;
+    const T *b11 = b, *b12 = b + nh, *b21 = b + kh * ldb, *b22 = b21 + nh;
+    T *c11 = c, *c12 = c + nh, *c21 = c + mh * ldc, *c22 = c21 + nh;
+
+    T* s[4];
+    T* t[4];
+    T* p[3];
+    T* next = workspace;
+    for (std::size_t i = 0; i < 4; ++i, next += mh * kh) { s[i] = next; }
+    for (std::size_t i = 0; i < 4; ++i, next += kh * nh) { t[i] = next; }
+    for (std::size_t i = 0; i < 3; ++i, next += mh * nh) { p[i] = next; }
+    T* below = next;
+    const std::size_t belowSize = strassen_workspace(mh, nh, kh, levels - 1);
+
+    block_add(mh, kh, a21, lda, a22, lda, s[0], kh);  // S1 = A21 + A22
+    block_sub(mh, kh, s[0], kh, a11, lda, s[1], kh);  // S2 = S1 - A11
+    block_sub(mh, kh, a11, lda, a21, lda, s[2], kh);  // S3 = A11 - A21
+    block_sub(mh, kh, a12, lda, s[1], kh, s[3], kh);  // S4 = A12 - S2
+    block_sub(kh, nh, b12, ldb, b11, ldb, t[0], nh);  // T1 = B12 - B11
+    block_sub(kh, nh, b22, ldb, t[0], nh, t[1], nh);  // T2 = B22 - T1
+    block_sub(kh, nh, b22, ldb, b12, ldb, t[2], nh);  // T3 = B22 - B12
+    block_sub(kh, nh, t[1], nh, b21, ldb, t[3], nh);  // T4 = T2 - B21
+
+    // P1, P3, P4 and P5 land in the quadrants of C, P2, P6 and P7 in the workspace.
+    LinAlg::parallel_for(m * n * k, 0, 7, 1, [=](std::size_t first, std::size_t last) {
+        for (std::size_t product = first; product < last; ++product) {
+            T* scratch = below + product * belowSize;
+            switch (product) {
+            case 0: strassen_sequential(levels - 1, mh, nh, kh, a11, lda, b11, ldb, c11, ldc, scratch); break;
+            case 1: strassen_sequential(levels - 1, mh, nh, kh, a12, lda, b21, ldb, p[0], nh, scratch); break;
+            case 2: strassen_sequential(levels - 1, mh, nh, kh, s[3], kh, b22, ldb, c12, ldc, scratch); break;
+            case 3: strassen_sequential(levels - 1, mh, nh, kh, a22, lda, t[3], nh, c21, ldc, scratch); break;
+            case 4: strassen_sequential(levels - 1, mh, nh, kh, s[0], kh, t[0], nh, c22, ldc, scratch); break;
+            case 5: strassen_sequential(levels - 1, mh, nh, kh, s[1], kh, t[1], nh, p[1], nh, scratch); break;
+            default: strassen_sequential(levels - 1, mh, nh, kh, s[2], kh, t[2], nh, p[2], nh, scratch); break;
+            }
+        }
+    });
+
+    block_add(mh, nh, c11, ldc, p[1], nh, p[1], nh);   // U2 = P1 + P6
+    block_add(mh, nh, c11, ldc, p[0], nh, c11, ldc);   // C11 = P1 + P2
+    block_add(mh, nh, p[1], nh, p[2], nh, p[2], nh);   // U3 = U2 + P7
+    block_add(mh, nh, p[1], nh, c22, ldc, p[1], nh);   // U4 = U2 + P5
+    block_add(mh, nh, c12, ldc, p[1], nh, c12, ldc);   // C12 = P3 + U4
+    block_sub(mh, nh, p[2], nh, c21, ldc, c21, ldc);   // C21 = U3 - P4
+    block_add(mh, nh, c22, ldc, p[2], nh, c22, ldc);   // C22 = U3 + P5
+}
+
+template <typename T>
+inline void LinAlg::Kernels::strassen(std::size_t m, std::size_t n, std::size_t k, const T* a, std::size_t lda,
+                                      const T* b, std::size_t ldb, T* c, std::size_t ldc, std::size_t crossover)
+{
+    const std::size_t levels = strassen_levels(m, n, k, crossover);
+    if (levels == 0) {
+        strassen_leaf(m, n, k, a, lda, b, ldb, c, ldc);
+        return;
+    }
+
+    const std::size_t unit = std::size_t(1) << levels;
+    const std::size_t mp = (m + unit - 1) / unit * unit, np = (n + unit - 1) / unit * unit, kp = (k + unit - 1) / unit * unit;
+    const bool padded = mp != m || np != n || kp != k;
+    const bool parallel = execution_policy()->concurrency() > 1;
+
+    const std::size_t recursion = parallel ? strassen_parallel_workspace(mp, np, kp, levels) : strassen_workspace(mp, np, kp, levels);
+    std::vector< T, ArenaAllocator<T> > workspace(recursion + (padded ? mp * kp + kp * np + mp * np : 0));
+
+    const T* aPadded = a;
+    const T* bPadded = b;
+    T* cPadded = c;
+    std::size_t ldaPadded = lda, ldbPadded = ldb, ldcPadded = ldc;
+    if (padded) {
+        T* aCopy = workspace.data() + recursion;
+        T* bCopy = aCopy + mp * kp;
+        cPadded = bCopy + kp * np;
+        std::fill(aCopy, cPadded, T());
+        for (std::size_t i = 0; i < m; ++i) { std::copy(a + i * lda, a + i * lda + k, aCopy + i * kp); }
+        for (std::size_t i = 0; i < k; ++i) { std::copy(b + i * ldb, b + i * ldb + n, bCopy + i * np); }
+        aPadded = aCopy;
+        bPadded = bCopy;
+        ldaPadded = kp;
+        ldbPadded = np;
+        ldcPadded = np;
+    }
+
+    if (parallel) {
+        strassen_parallel(levels, mp, np, kp, aPadded, ldaPadded, bPadded, ldbPadded, cPadded, ldcPadded, workspace.data());
+    } else {
+        strassen_sequential(levels, mp, np, kp, aPadded, ldaPadded, bPadded, ldbPadded, cPadded, ldcPadded, workspace.data());
+    }
+
+    if (padded) {
+        for (std::size_t i = 0; i < m; ++i) { std::copy(cPadded + i * ldcPadded, cPadded + i * ldcPadded + n, c + i * ldc); }
+    }
+}
+
+#endif // STRASSEN_HPP
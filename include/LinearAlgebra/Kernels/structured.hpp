@@ -0,0 +1,274 @@
+#ifndef STRUCTURED_HPP
+#define STRUCTURED_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <utility>
+
+#include "cholesky.hpp"
+#include "elementwise.hpp"
+
+namespace LinAlg
+{
+    namespace Kernels
+    {
+        // Band storage: row i of an n x n matrix with lower and upper bandwidths
+        // kl and ku holds columns [i - kl, i + ku] in ld >= kl + ku + 1 slots,
+        // A(i, j) at band[i * ld + kl + j - i]. Slots outside the matrix are zero.
+        inline std::size_t band_index(std::size_t kl, std::size_t ld, std::size_t i, std::size_t j) { return i * ld + kl + j - i; }
+
+        // Packed upper triangular storage: row i of an n x n upper triangle holds
+        // the n - i contiguous entries starting at packed_upper_index(n, i, i).
+        // The lower counterpart is packed_index from cholesky.hpp.
+        inline std::size_t packed_upper_index(std::size_t n, std::size_t i, std::size_t j) { return i * (2 * n - i + 1) / 2 + j - i; }
+
+        // y += alpha * x for n elements of x spaced incx apart.
+        template <typename T>
+        void strided_axpy(std::size_t n, T alpha, const T* x, std::ptrdiff_t incx, T* y);
+
+        // y[i] = A(i, :) x for rows [first, last) of the banded n x n A.
+        template <typename T>
+        void band_gemv(std::size_t first, std::size_t last, std::size_t n, std::size_t kl, std::size_t ku, const T* band, std::size_t ld,
+                       const T* x, T* y);
+
+        // Rows [first, last) of C = A B for banded n x n A and the dense n x cols B
+        // addressed through strides. C is row-major with row stride ldc.
+        template <typename T>
+        void band_gemm(std::size_t first, std::size_t last, std::size_t n, std::size_t kl, std::size_t ku, const T* band, std::size_t ld,
+                       std::size_t cols, const T* b, std::ptrdiff_t rsb, std::ptrdiff_t csb, T* c, std::size_t ldc);
+
+        // Banded LU with partial pivoting in O(n kl (kl + ku)). The input is band
+        // storage with bandwidths kl and kl + ku, the extra kl superdiagonals zero,
+        // and receives U in its upper part and the multipliers of step k below the
+        // diagonal of column k. Row k was exchanged with row pivots[k] >= k before
+        // step k. Returns zero on success, or one plus the index of the first
+        // exactly zero pivot.
+        template <typename T>
+        std::size_t band_lu_factor(std::size_t n, std::size_t kl, std::size_t ku, T* a, std::size_t ld, std::size_t* pivots);
+
+        // Solves A X = B in place for the n x nrhs row-major B, given the output of band_lu_factor.
+        template <typename T>
+        void band_lu_solve(std::size_t n, std::size_t kl, std::size_t ku, const T* a, std::size_t ld, const std::size_t* pivots,
+                           std::size_t nrhs, T* b, std::size_t ldb);
+
+        // y[i] = T(i, :) x for rows [first, last) of the packed n x n triangle T.
+        template <typename T>
+        void tp_gemv(bool lower, std::size_t first, std::size_t last, std::size_t n, const T* a, const T* x, T* y);
+
+        // Rows [first, last) of C = T B for the packed n x n triangle T and dense B.
+        template <typename T>
+        void tp_gemm(bool lower, std::size_t first, std::size_t last, std::size_t n, const T* a,
+                     std::size_t cols, const T* b, std::ptrdiff_t rsb, std::ptrdiff_t csb, T* c, std::size_t ldc);
+
+        // Solves T X = B in place for the packed n x n triangle T and the
+        // n x nrhs row-major B.
+        template <typename T>
+        void tp_solve(bool lower, std::size_t n, const T* a, std::size_t nrhs, T* b, std::size_t ldb);
+
+        // y = A x for symmetric n x n A given by its packed lower triangle.
+        template <typename T>
+        void sp_gemv(std::size_t n, const T* a, const T* x, T* y);
+
+        // C = A B for packed symmetric A and dense B; C is overwritten.
+        template <typename T>
+        void sp_gemm(std::size_t n, const T* a, std::size_t cols, const T* b, std::ptrdiff_t rsb, std::ptrdiff_t csb, T* c, std::size_t ldc);
+    }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::strided_axpy(std::size_t n, T alpha, const T* x, std::ptrdiff_t incx, T* y)
+{
+    if (incx == 1) {
+        axpy(n, alpha, x, y);
+        return;
+    }
+    for (std::size_t j = 0; j < n; ++j) { y[j] += alpha * x[static_cast<std::ptrdiff_t>(j) * incx]; }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::band_gemv(std::size_t first, std::size_t last, std::size_t n, std::size_t kl, std::size_t ku, const T* band, std::size_t ld,
+                                       const T* x, T* y)
+{
+    for (std::size_t i = first; i < last; ++i) {
+        const std::size_t begin = (i > kl) ? i - kl : 0, end = std::min(n, i + ku + 1);
+        y[i] = dot(end - begin, band + band_index(kl, ld, i, begin), x + begin);
+    }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::band_gemm(std::size_t first, std::size_t last, std::size_t n, std::size_t kl, std::size_t ku, const T* band, std::size_t ld,
+                                       std::size_t cols, const T* b, std::ptrdiff_t rsb, std::ptrdiff_t csb, T* c, std::size_t ldc)
+{
+    for (std::size_t i = first; i < last; ++i) {
+        T* cRow = c + i * ldc;
+        std::fill(cRow, cRow + cols, T());
+        const std::size_t begin = (i > kl) ? i - kl : 0, end = std::min(n, i + ku + 1);
+        for (std::size_t j = begin; j < end; ++j) {
+            const T value = band[band_index(kl, ld, i, j)];
+            if (value != T()) { strided_axpy(cols, value, b + static_cast<std::ptrdiff_t>(j) * rsb, csb, cRow); }
+        }
+    }
+}
+
+template <typename T>
+inline std::size_t LinAlg::Kernels::band_lu_factor(std::size_t n, std::size_t kl, std::size_t ku, T* a, std::size_t ld, std::size_t* pivots)
+{
+    std::size_t info = 0;
+    for (std::size_t k = 0; k < n; ++k) {
+        const std::size_t lastRow = std::min(n - 1, k + kl), lastCol = std::min(n - 1, k + kl + ku);
+
+        std::size_t pivot = k;
+        for (std::size_t i = k + 1; i <= lastRow; ++i) {
+            if (std::fabs(a[band_index(kl, ld, i, k)]) > std::fabs(a[band_index(kl, ld, pivot, k)])) { pivot = i; }
+        }
+        pivots[k] = pivot;
+
+        const T diagonal = a[band_index(kl, ld, pivot, k)];
+        if (diagonal == T()) {
+            if (info == 0) { info = k + 1; }
+            continue;
+        }
+        if (pivot != k) {
+            std::swap_ranges(a + band_index(kl, ld, k, k), a + band_index(kl, ld, k, lastCol) + 1, a + band_index(kl, ld, pivot, k));
+        }
+
+        const T* pivotRow = a + band_index(kl, ld, k, k + 1);
+        for (std::size_t i = k + 1; i <= lastRow; ++i) {
+            T& multiplier = a[band_index(kl, ld, i, k)];
+            multiplier /= diagonal;
+            if (multiplier != T()) { axpy(lastCol - k, -multiplier, pivotRow, a + band_index(kl, ld, i, k + 1)); }
+        }
+    }
+    return info;
+}
+
+template <typename T>
+inline void LinAlg::Kernels::band_lu_solve(std::size_t n, std::size_t kl, std::size_t ku, const T* a, std::size_t ld, const std::size_t* pivots,
+                                           std::size_t nrhs, T* b, std::size_t ldb)
+{
+    const std::size_t upper = kl + ku;
+    if (nrhs == 1) {
+        for (std::size_t k = 0; k < n; ++k) {
+            std::swap(b[k * ldb], b[pivots[k] * ldb]);
+            const T value = b[k * ldb];
+            const std::size_t lastRow = std::min(n - 1, k + kl);
+            for (std::size_t i = k + 1; i <= lastRow; ++i) { b[i * ldb] -= a[band_index(kl, ld, i, k)] * value; }
+        }
+        for (std::size_t i = n; i-- > 0;) {
+            const std::size_t end = std::min(n, i + upper + 1);
+            T sum = b[i * ldb];
+            for (std::size_t j = i + 1; j < end; ++j) { sum -= a[band_index(kl, ld, i, j)] * b[j * ldb]; }
+            b[i * ldb] = sum / a[band_index(kl, ld, i, i)];
+        }
+        return;
+    }
+
+    for (std::size_t k = 0; k < n; ++k) {
+        if (pivots[k] != k) { std::swap_ranges(b + k * ldb, b + k * ldb + nrhs, b + pivots[k] * ldb); }
+        const std::size_t lastRow = std::min(n - 1, k + kl);
+        for (std::size_t i = k + 1; i <= lastRow; ++i) {
+            const T multiplier = a[band_index(kl, ld, i, k)];
+            if (multiplier != T()) { axpy(nrhs, -multiplier, b + k * ldb, b + i * ldb); }
+        }
+    }
+    for (std::size_t i = n; i-- > 0;) {
+        const std::size_t end = std::min(n, i + upper + 1);
+        for (std::size_t j = i + 1; j < end; ++j) {
+            const T value = a[band_index(kl, ld, i, j)];
+            if (value != T()) { axpy(nrhs, -value, b + j * ldb, b + i * ldb); }
+        }
+        divide(nrhs, a[band_index(kl, ld, i, i)], b + i * ldb);
+    }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::tp_gemv(bool lower, std::size_t first, std::size_t last, std::size_t n, const T* a, const T* x, T* y)
+{
+    for (std::size_t i = first; i < last; ++i) {
+        y[i] = lower ? dot(i + 1, a + packed_index(i, 0), x) : dot(n - i, a + packed_upper_index(n, i, i), x + i);
+    }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::tp_gemm(bool lower, std::size_t first, std::size_t last, std::size_t n, const T* a,
+                                     std::size_t cols, const T* b, std::ptrdiff_t rsb, std::ptrdiff_t csb, T* c, std::size_t ldc)
+{
+    for (std::size_t i = first; i < last; ++i) {
+        T* cRow = c + i * ldc;
+        std::fill(cRow, cRow + cols, T());
+        const std::size_t begin = lower ? 0 : i, end = lower ? i + 1 : n;
+        const T* row = lower ? a + packed_index(i, 0) : a + packed_upper_index(n, i, i) - i;
+        for (std::size_t j = begin; j < end; ++j) {
+            if (row[j] != T()) { strided_axpy(cols, row[j], b + static_cast<std::ptrdiff_t>(j) * rsb, csb, cRow); }
+        }
+    }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::tp_solve(bool lower, std::size_t n, const T* a, std::size_t nrhs, T* b, std::size_t ldb)
+{
+    if (nrhs == 1 && ldb == 1) {
+        if (lower) {
+            for (std::size_t i = 0; i < n; ++i) {
+                const T* row = a + packed_index(i, 0);
+                b[i] = (b[i] - dot(i, row, b)) / row[i];
+            }
+        } else {
+            for (std::size_t i = n; i-- > 0;) {
+                const T* row = a + packed_upper_index(n, i, i);
+                b[i] = (b[i] - dot(n - i - 1, row + 1, b + i + 1)) / row[0];
+            }
+        }
+        return;
+    }
+
+    if (lower) {
+        for (std::size_t i = 0; i < n; ++i) {
+            const T* row = a + packed_index(i, 0);
+            for (std::size_t j = 0; j < i; ++j) {
+                if (row[j] != T()) { axpy(nrhs, -row[j], b + j * ldb, b + i * ldb); }
+            }
+            divide(nrhs, row[i], b + i * ldb);
+        }
+        return;
+    }
+    for (std::size_t i = n; i-- > 0;) {
+        const T* row = a + packed_upper_index(n, i, i) - i;
+        for (std::size_t j = i + 1; j < n; ++j) {
+            if (row[j] != T()) { axpy(nrhs, -row[j], b + j * ldb, b + i * ldb); }
+        }
+        divide(nrhs, row[i], b + i * ldb);
+    }
+}
+
+// Row i of the packed lower triangle contributes its dot product with x to
+// y[i] and, mirrored, x[i] times the row to y[0, i).
+template <typename T>
+inline void LinAlg::Kernels::sp_gemv(std::size_t n, const T* a, const T* x, T* y)
+{
+    std::fill(y, y + n, T());
+    for (std::size_t i = 0; i < n; ++i) {
+        const T* row = a + packed_index(i, 0);
+        y[i] += dot(i + 1, row, x);
+        if (x[i] != T()) { axpy(i, x[i], row, y); }
+    }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::sp_gemm(std::size_t n, const T* a, std::size_t cols, const T* b, std::ptrdiff_t rsb, std::ptrdiff_t csb, T* c, std::size_t ldc)
+{
+    for (std::size_t i = 0; i < n; ++i) { std::fill(c + i * ldc, c + i * ldc + cols, T()); }
+    for (std::size_t i = 0; i < n; ++i) {
+        const T* row = a + packed_index(i, 0);
+        const T* bRow = b + static_cast<std::ptrdiff_t>(i) * rsb;
+        for (std::size_t j = 0; j < i; ++j) {
+            if (row[j] == T()) { continue; }
+            strided_axpy(cols, row[j], b + static_cast<std::ptrdiff_t>(j) * rsb, csb, c + i * ldc);
+            strided_axpy(cols, row[j], bRow, csb, c + j * ldc);
+        }
+        strided_axpy(cols, row[i], bRow, csb, c + i * ldc);
+    }
+}
+
+#endif // STRUCTURED_HPP
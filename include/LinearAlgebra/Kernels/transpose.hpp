@@ -0,0 +1,70 @@
+#ifndef TRANSPOSE_HPP
+#define TRANSPOSE_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+
+namespace LinAlg
+{
+    namespace Kernels
+    {
+        const std::size_t transpose_tile = 32;
+
+        // dst = src for a rows x cols source addressed through arbitrary strides and
+        // a row-major destination with row stride ldd. Tiles keep both the reads
+        // and the writes cache resident when the source is column-major.
+        template <typename T>
+        void copy_strided(std::size_t rows, std::size_t cols,
+                          const T* src, std::ptrdiff_t rss, std::ptrdiff_t css, T* dst, std::ptrdiff_t ldd);
+
+        // Transposes tile rows [firstTile, lastTile) of the row-major n x n matrix
+        // a in place, swapping every tile above the diagonal with its mirror.
+        template <typename T>
+        void transpose_square(std::size_t n, T* a, std::ptrdiff_t lda, std::size_t firstTile, std::size_t lastTile);
+    }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::copy_strided(std::size_t rows, std::size_t cols,
+                                          const T* src, std::ptrdiff_t rss, std::ptrdiff_t css, T* dst, std::ptrdiff_t ldd)
+{
+    if (css == 1) {
+        for (std::size_t i = 0; i < rows; ++i) {
+            const T* row = src + static_cast<std::ptrdiff_t>(i) * rss;
+            std::copy(row, row + cols, dst + static_cast<std::ptrdiff_t>(i) * ldd);
+        }
+        return;
+    }
+
+    for (std::size_t ii = 0; ii < rows; ii += transpose_tile) {
+        const std::size_t iEnd = std::min(rows, ii + transpose_tile);
+        for (std::size_t jj = 0; jj < cols; jj += transpose_tile) {
+            const std::size_t jEnd = std::min(cols, jj + transpose_tile);
+            for (std::size_t i = ii; i < iEnd; ++i) {
+                const T* row = src + static_cast<std::ptrdiff_t>(i) * rss;
+                T* out = dst + static_cast<std::ptrdiff_t>(i) * ldd;
+                for (std::size_t j = jj; j < jEnd; ++j) { out[j] = row[static_cast<std::ptrdiff_t>(j) * css]; }
+            }
+        }
+    }
+}
+
+template <typename T>
+inline void LinAlg::Kernels::transpose_square(std::size_t n, T* a, std::ptrdiff_t lda, std::size_t firstTile, std::size_t lastTile)
+{
+    for (std::size_t tile = firstTile; tile < lastTile; ++tile) {
+        const std::size_t ii = tile * transpose_tile;
+        const std::size_t iEnd = std::min(n, ii + transpose_tile);
+        for (std::size_t jj = ii; jj < n; jj += transpose_tile) {
+            const std::size_t jEnd = std::min(n, jj + transpose_tile);
+            for (std::size_t i = ii; i < iEnd; ++i) {
+                for (std::size_t j = std::max(jj, i + 1); j < jEnd; ++j) {
+                    std::swap(a[static_cast<std::ptrdiff_t>(i) * lda + j], a[static_cast<std::ptrdiff_t>(j) * lda + i]);
+                }
+            }
+        }
+    }
+}
+
+#endif // TRANSPOSE_HPP
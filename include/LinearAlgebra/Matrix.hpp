@@ -11,56 +11,76 @@
 #include <utility>
 #include <vector>
 
+#include "Allocator.hpp"
+#include "ExecutionPolicy.hpp"
+#include "Instrumentation.hpp"
+#include "MatrixExpression.hpp"
+#include "MatrixView.hpp"
+#include "Kernels/determinant.hpp"
+#include "Kernels/elementwise.hpp"
+#include "Kernels/gemm.hpp"
+#include "Kernels/inverse.hpp"
+#include "Kernels/strassen.hpp"
+#include "Kernels/transpose.hpp"
+
 namespace LinAlg
 {
     template <typename T>
     bool areEqual(T value1, T value2);
 
-    template <typename T>
-    class Matrix
+    // Selects the Matrix constructor that allocates storage without
+    // initializing it, for results that are about to be overwritten in full.
+    struct UninitializedTag {};
+    const UninitializedTag uninitialized = UninitializedTag();
+
+    template <typename T, typename Allocator>
+    class Matrix : public MatrixExpression< Matrix<T, Allocator> >
     {
     public:
+        typedef T value_type;
+        typedef std::vector<T, Allocator> storage_type;
+
         Matrix();
         Matrix(std::size_t rows, std::size_t cols);
+        Matrix(std::size_t rows, std::size_t cols, UninitializedTag);
         Matrix(std::size_t rows, std::size_t cols, T value);
         Matrix(std::size_t rows, std::size_t cols, const std::vector<T>& v);
+        Matrix(std::size_t rows, std::size_t cols, storage_type&& v);
         Matrix(std::initializer_list< std::initializer_list<T> > il);
-        Matrix(const Matrix<T>& other) = default;
-        Matrix(Matrix<T>&& other) noexcept;
+        Matrix(const Matrix& other) = default;
+        Matrix(Matrix&& other) noexcept;
+        template <typename E>
+        Matrix(const MatrixExpression<E>& expression);
         ~Matrix() = default;
 
         T& operator()(std::size_t row, std::size_t col);
         const T& operator()(std::size_t row, std::size_t col) const;
 
-        Matrix<T>& operator= (const Matrix<T>& other) = default;
-        Matrix<T>& operator= (Matrix<T>&& other) noexcept;
-
-        Matrix<T> operator* (T value);
-        Matrix<T> operator/ (T value);
+        Matrix& operator= (const Matrix& other) = default;
+        Matrix& operator= (Matrix&& other) noexcept;
+        template <typename E>
+        Matrix& operator= (const MatrixExpression<E>& expression);
 
-        Matrix<T>& operator*= (T value);
-        Matrix<T>& operator/= (T value);
+        Matrix& operator*= (T value);
+        Matrix& operator/= (T value);
 
-        Matrix<T> operator- ();
-
-        Matrix<T> operator+ (const Matrix<T>& other);
-        Matrix<T> operator- (const Matrix<T>& other);
-        Matrix<T> operator* (const Matrix<T>& other);
-        Matrix<T> operator/ (const Matrix<T>& other);
-
-        Matrix<T>& operator+= (const Matrix<T>& other);
-        Matrix<T>& operator-= (const Matrix<T>& other);
-        Matrix<T>& operator*= (const Matrix<T>& other);
-        Matrix<T>& operator/= (const Matrix<T>& other);
+        template <typename E>
+        Matrix& operator+= (const MatrixExpression<E>& expression);
+        template <typename E>
+        Matrix& operator-= (const MatrixExpression<E>& expression);
+        Matrix& operator*= (const Matrix& other);
+        Matrix& operator/= (const Matrix& other);
 
         std::size_t rows() const { return _rows; }
         std::size_t cols() const { return _cols; }
         std::size_t vector_size() const { return _matrix.size(); }
+        T* data() { return _matrix.data(); }
+        const T* data() const { return _matrix.data(); }
         std::size_t max_rows() { return _matrix.max_size(); };
         std::size_t max_cols() { return max_rows() / _rows; };
 
         bool square() const { return _rows == _cols; }
-        bool zero() const { return *this == Matrix<T>(_rows, _cols); };
+        bool zero() const { return *this == Matrix(_rows, _cols); };
 
         T& at(std::size_t row, std::size_t col);
         const T& at(std::size_t row, std::size_t col) const;
@@ -79,7 +99,17 @@ namespace LinAlg
         std::vector<T> get_row(std::size_t row) const;
         std::vector<T> get_col(std::size_t col) const;
 
+        MatrixView<T> view();
+        ConstMatrixView<T> view() const;
+        MatrixView<T> row_view(std::size_t row);
+        ConstMatrixView<T> row_view(std::size_t row) const;
+        MatrixView<T> col_view(std::size_t col);
+        ConstMatrixView<T> col_view(std::size_t col) const;
+        MatrixView<T> block(std::size_t row, std::size_t col, std::size_t rows, std::size_t cols);
+        ConstMatrixView<T> block(std::size_t row, std::size_t col, std::size_t rows, std::size_t cols) const;
+
         void transpose();
+        ConstMatrixView<T> transposed() const;
         void pow(int power);
         void swap_row(std::size_t lhsRow, std::size_t rhsRow);
         void swap_col(std::size_t lhsCol, std::size_t rhsCol);
@@ -89,89 +119,548 @@ namespace LinAlg
         void add_col(std::size_t lhsCol, std::size_t rhsCol, T value);
         T cofactor(std::size_t row, std::size_t col);
         T determinant();
-        Matrix<T> minor(std::size_t row, std::size_t col);
-        Matrix<T> adjoint();
-        Matrix<T> inverse();
-
-        template <typename U>
-        friend bool operator== (const Matrix<U>& lhs, const Matrix<U>& rhs);
+        Matrix minor(std::size_t row, std::size_t col);
+        Matrix adjoint();
+        Matrix inverse();
+        void invert_in_place();
 
-        template <typename U>
-        friend Matrix<U> operator* (U value, const Matrix<U>& other);
+        template <typename U, typename A>
+        friend bool operator== (const Matrix<U, A>& lhs, const Matrix<U, A>& rhs);
 
     private:
         std::size_t _rows;
         std::size_t _cols;
-        std::vector<T> _matrix;
+        storage_type _matrix;
 
         std::size_t check_rows_arg(std::size_t rows);
         std::size_t check_cols_arg(std::size_t cols);
         std::size_t check_template_arg(std::size_t size);
+
+        template <typename E>
+        void evaluate(const E& expression);
     };
 
+    template <typename T, typename A>
+    Matrix<T, A> operator* (const Matrix<T, A>& lhs, const Matrix<T, A>& rhs);
+
+    template <typename L, typename R>
+    Matrix<typename L::value_type> operator* (const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs);
+
+    template <typename T, typename A>
+    Matrix<T, A> operator/ (const Matrix<T, A>& lhs, const Matrix<T, A>& rhs);
+
+    // Overloads for expiring Matrix operands: the result is computed into the
+    // operand's storage and returned by move instead of being allocated.
+    template <typename T, typename A, typename R>
+    Matrix<T, A> operator+ (Matrix<T, A>&& lhs, const MatrixExpression<R>& rhs);
+
+    template <typename L, typename T, typename A>
+    Matrix<T, A> operator+ (const MatrixExpression<L>& lhs, Matrix<T, A>&& rhs);
+
+    template <typename T, typename A, typename B>
+    Matrix<T, A> operator+ (Matrix<T, A>&& lhs, Matrix<T, B>&& rhs);
+
+    template <typename T, typename A, typename R>
+    Matrix<T, A> operator- (Matrix<T, A>&& lhs, const MatrixExpression<R>& rhs);
+
+    template <typename L, typename T, typename A>
+    Matrix<T, A> operator- (const MatrixExpression<L>& lhs, Matrix<T, A>&& rhs);
+
+    template <typename T, typename A, typename B>
+    Matrix<T, A> operator- (Matrix<T, A>&& lhs, Matrix<T, B>&& rhs);
+
+    template <typename T, typename A>
+    Matrix<T, A> operator- (Matrix<T, A>&& operand);
+
+    template <typename T, typename A>
+    Matrix<T, A> operator* (Matrix<T, A>&& operand, typename Matrix<T, A>::value_type value);
+
+    template <typename T, typename A>
+    Matrix<T, A> operator* (typename Matrix<T, A>::value_type value, Matrix<T, A>&& operand);
+
+    template <typename T, typename A>
+    Matrix<T, A> operator/ (Matrix<T, A>&& operand, typename Matrix<T, A>::value_type value);
+
+    namespace Detail
+    {
+        const std::size_t elementwise_grain = std::size_t(1) << 15;
+        const std::size_t transpose_row_grain = 64;
+        const std::size_t closed_form_order = 4;
+
+        // Buffer a rectangular transpose writes into before swapping it with the
+        // matrix storage. With a stateless allocator it is a per-thread buffer that
+        // keeps the storage given up by the previous transpose, so transposing
+        // matrices of the same size again and again allocates nothing.
+        template <typename S>
+        S& transpose_buffer(S& local, std::true_type);
+
+        template <typename S>
+        S& transpose_buffer(S& local, std::false_type);
+
+        // Writes rows [first, last) of an expression into row-major storage. The
+        // overloads for plain Matrix operands forward to the vectorized kernels.
+        template <typename T, typename E>
+        void evaluate_rows(T* out, const E& expression, std::size_t first, std::size_t last);
+
+        template <typename T, typename A>
+        void evaluate_rows(T* out, const Matrix<T, A>& expression, std::size_t first, std::size_t last);
+
+        // Converting construction and assignment from a Matrix of another element type.
+        template <typename T, typename U, typename A>
+        void evaluate_rows(T* out, const Matrix<U, A>& expression, std::size_t first, std::size_t last);
+
+        template <typename T>
+        void evaluate_rows(T* out, const ConstMatrixView<T>& expression, std::size_t first, std::size_t last);
+
+        template <typename T>
+        void evaluate_rows(T* out, const MatrixView<T>& expression, std::size_t first, std::size_t last);
+
+        template <typename T, typename A, typename B>
+        void evaluate_rows(T* out, const MatrixBinaryExpression< Plus, Matrix<T, A>, Matrix<T, B> >& expression, std::size_t first, std::size_t last);
+
+        template <typename T, typename A, typename B>
+        void evaluate_rows(T* out, const MatrixBinaryExpression< Minus, Matrix<T, A>, Matrix<T, B> >& expression, std::size_t first, std::size_t last);
+
+        template <typename T, typename E>
+        void accumulate_rows(T* out, const E& expression, Plus op, std::size_t first, std::size_t last);
+
+        template <typename T, typename E>
+        void accumulate_rows(T* out, const E& expression, Minus op, std::size_t first, std::size_t last);
+
+        template <typename T, typename A>
+        void accumulate_rows(T* out, const Matrix<T, A>& expression, Plus op, std::size_t first, std::size_t last);
+
+        template <typename T, typename A>
+        void accumulate_rows(T* out, const Matrix<T, A>& expression, Minus op, std::size_t first, std::size_t last);
+
+        // Strided operand of a matrix product. Matrices and views are used in place,
+        // any other expression is evaluated once into owned storage.
+        template <typename E>
+        struct GemmOperand
+        {
+            typedef typename E::value_type value_type;
+
+            explicit GemmOperand(const E& expression) : storage(expression), view(storage) {}
+
+            Matrix<value_type> storage;
+            ConstMatrixView<value_type> view;
+        };
+
+        template <typename T, typename A>
+        struct GemmOperand< Matrix<T, A> >
+        {
+            explicit GemmOperand(const Matrix<T, A>& matrix) : view(matrix) {}
+
+            ConstMatrixView<T> view;
+        };
+
+        template <typename T>
+        struct GemmOperand< ConstMatrixView<T> >
+        {
+            explicit GemmOperand(const ConstMatrixView<T>& matrix) : view(matrix) {}
+
+            ConstMatrixView<T> view;
+        };
+
+        template <typename T>
+        struct GemmOperand< MatrixView<T> >
+        {
+            explicit GemmOperand(const MatrixView<T>& matrix) : view(matrix) {}
+
+            ConstMatrixView<T> view;
+        };
+
+        std::size_t row_grain(std::size_t cols);
+
+        // c = a * b for m x k a and k x n b addressed through strides, c row-major
+        // with n columns. Rows of c are split across the execution policy.
+        template <typename T>
+        void multiply(std::size_t m, std::size_t n, std::size_t k,
+                      const T* a, std::ptrdiff_t rsa, std::ptrdiff_t csa,
+                      const T* b, std::ptrdiff_t rsb, std::ptrdiff_t csb, T* c);
+
+        template <typename T, typename A>
+        bool is_diagonal(const Matrix<T, A>& matrix);
+
+        template <typename T>
+        T power(T value, unsigned int exponent);
+
+        // Elimination-based determinant: LU for floating point types, exact
+        // Bareiss elimination for integral ones.
+        template <typename T>
+        T determinant(std::size_t size, const T* data, std::true_type);
+
+        template <typename T>
+        T determinant(std::size_t size, const T* data, std::false_type);
+
+        // Gauss-Jordan elimination on a single working copy for floating point
+        // types, adjoint over determinant for integral ones and for orders up to
+        // closed_form_order, where the cofactors have closed forms.
+        template <typename T, typename A>
+        Matrix<T, A> inverse(Matrix<T, A>& matrix, std::true_type);
+
+        template <typename T, typename A>
+        Matrix<T, A> inverse(Matrix<T, A>& matrix, std::false_type);
+
+        // Same, overwriting matrix with its inverse. The contents are unspecified
+        // once a null determinant has been thrown.
+        template <typename T, typename A>
+        void invert_in_place(Matrix<T, A>& matrix, std::true_type);
+
+        template <typename T, typename A>
+        void invert_in_place(Matrix<T, A>& matrix, std::false_type);
+    }
+
     template <typename T>
     inline bool areEqual(T value1, T value2)
     {
-        if (std::numeric_limits<T>::is_iec559) {
-            return std::fabs(value1 - value2) <= (std::max(std::fabs(value1), std::fabs(value2)) * std::numeric_limits<T>::epsilon());
-        } else {
-            return value1 == value2;
-        }
+        return LinAlg::Kernels::are_equal(value1, value2);
     }
 
-    template <typename U>
-    inline bool operator== (const Matrix<U>& lhs, const Matrix<U>& rhs)
+    template <typename U, typename A>
+    inline bool operator== (const Matrix<U, A>& lhs, const Matrix<U, A>& rhs)
     {
         if (&lhs == &rhs) { return true; };
         if (lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols()) { return false; }
 
-        for (auto i = 0; i < lhs.rows(); ++i) {
-            for (auto j = 0; j < lhs.cols(); ++j) {
-                if (!areEqual(lhs.at(i, j), rhs.at(i, j))) { return false; }
+        return LinAlg::Kernels::equal(lhs._matrix.size(), lhs._matrix.data(), rhs._matrix.data());
+    }
+
+    template <typename T, typename A>
+    inline Matrix<T, A> operator* (const Matrix<T, A>& lhs, const Matrix<T, A>& rhs)
+    {
+        if (lhs.cols() != rhs.rows()) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+        Matrix<T, A> resultMatrix(lhs.rows(), rhs.cols(), uninitialized);
+        Detail::multiply(lhs.rows(), rhs.cols(), lhs.cols(), lhs.data(), lhs.cols(), 1, rhs.data(), rhs.cols(), 1, resultMatrix.data());
+        return resultMatrix;
+    }
+
+    template <typename L, typename R>
+    inline Matrix<typename L::value_type> operator* (const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs)
+    {
+        if (lhs.cols() != rhs.rows()) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+        const Detail::GemmOperand<L> lhsOperand(lhs.derived());
+        const Detail::GemmOperand<R> rhsOperand(rhs.derived());
+        const ConstMatrixView<typename L::value_type>& a = lhsOperand.view;
+        const ConstMatrixView<typename L::value_type>& b = rhsOperand.view;
+        Matrix<typename L::value_type> resultMatrix(a.rows(), b.cols(), uninitialized);
+        Detail::multiply(a.rows(), b.cols(), a.cols(), a.data(), a.row_stride(), a.col_stride(),
+                         b.data(), b.row_stride(), b.col_stride(), resultMatrix.data());
+        return resultMatrix;
+    }
+
+    template <typename T, typename A>
+    inline Matrix<T, A> operator/ (const Matrix<T, A>& lhs, const Matrix<T, A>& rhs)
+    {
+        Matrix<T, A> tempMatrix(rhs);
+        return lhs * tempMatrix.inverse();
+    }
+
+    template <typename T, typename A, typename R>
+    inline Matrix<T, A> operator+ (Matrix<T, A>&& lhs, const MatrixExpression<R>& rhs)
+    {
+        lhs += rhs;
+        return std::move(lhs);
+    }
+
+    template <typename L, typename T, typename A>
+    inline Matrix<T, A> operator+ (const MatrixExpression<L>& lhs, Matrix<T, A>&& rhs)
+    {
+        rhs += lhs;
+        return std::move(rhs);
+    }
+
+    template <typename T, typename A, typename B>
+    inline Matrix<T, A> operator+ (Matrix<T, A>&& lhs, Matrix<T, B>&& rhs)
+    {
+        lhs += rhs;
+        return std::move(lhs);
+    }
+
+    template <typename T, typename A, typename R>
+    inline Matrix<T, A> operator- (Matrix<T, A>&& lhs, const MatrixExpression<R>& rhs)
+    {
+        lhs -= rhs;
+        return std::move(lhs);
+    }
+
+    template <typename L, typename T, typename A>
+    inline Matrix<T, A> operator- (const MatrixExpression<L>& lhs, Matrix<T, A>&& rhs)
+    {
+        rhs = MatrixBinaryExpression< Minus, L, Matrix<T, A> >(lhs.derived(), rhs);
+        return std::move(rhs);
+    }
+
+    template <typename T, typename A, typename B>
+    inline Matrix<T, A> operator- (Matrix<T, A>&& lhs, Matrix<T, B>&& rhs)
+    {
+        lhs -= rhs;
+        return std::move(lhs);
+    }
+
+    template <typename T, typename A>
+    inline Matrix<T, A> operator- (Matrix<T, A>&& operand)
+    {
+        operand *= T(-1);
+        return std::move(operand);
+    }
+
+    template <typename T, typename A>
+    inline Matrix<T, A> operator* (Matrix<T, A>&& operand, typename Matrix<T, A>::value_type value)
+    {
+        operand *= value;
+        return std::move(operand);
+    }
+
+    template <typename T, typename A>
+    inline Matrix<T, A> operator* (typename Matrix<T, A>::value_type value, Matrix<T, A>&& operand)
+    {
+        operand *= value;
+        return std::move(operand);
+    }
+
+    template <typename T, typename A>
+    inline Matrix<T, A> operator/ (Matrix<T, A>&& operand, typename Matrix<T, A>::value_type value)
+    {
+        operand /= value;
+        return std::move(operand);
+    }
+
+    template <typename T, typename E>
+    inline void Detail::evaluate_rows(T* out, const E& expression, std::size_t first, std::size_t last)
+    {
+        const std::size_t cols = expression.cols();
+        for (std::size_t i = first; i < last; ++i) {
+            T* row = out + i * cols;
+            for (std::size_t j = 0; j < cols; ++j) { row[j] = expression(i, j); }
+        }
+    }
+
+    template <typename T, typename A>
+    inline void Detail::evaluate_rows(T* out, const Matrix<T, A>& expression, std::size_t first, std::size_t last)
+    {
+        const std::size_t cols = expression.cols();
+        std::copy(expression.data() + first * cols, expression.data() + last * cols, out + first * cols);
+    }
+
+    template <typename T, typename U, typename A>
+    inline void Detail::evaluate_rows(T* out, const Matrix<U, A>& expression, std::size_t first, std::size_t last)
+    {
+        const std::size_t cols = expression.cols();
+        LinAlg::Kernels::convert((last - first) * cols, expression.data() + first * cols, out + first * cols);
+    }
+
+    template <typename T>
+    inline void Detail::evaluate_rows(T* out, const ConstMatrixView<T>& expression, std::size_t first, std::size_t last)
+    {
+        const std::size_t cols = expression.cols();
+        if (cols == 0) { return; }
+        LinAlg::Kernels::copy_strided(last - first, cols, &expression(first, 0), expression.row_stride(), expression.col_stride(),
+                                      out + first * cols, static_cast<std::ptrdiff_t>(cols));
+    }
+
+    template <typename T>
+    inline void Detail::evaluate_rows(T* out, const MatrixView<T>& expression, std::size_t first, std::size_t last)
+    {
+        evaluate_rows(out, ConstMatrixView<T>(expression), first, last);
+    }
+
+    template <typename T, typename A, typename B>
+    inline void Detail::evaluate_rows(T* out, const MatrixBinaryExpression< Plus, Matrix<T, A>, Matrix<T, B> >& expression, std::size_t first, std::size_t last)
+    {
+        const std::size_t cols = expression.cols();
+        LinAlg::Kernels::add((last - first) * cols, expression.lhs().data() + first * cols, expression.rhs().data() + first * cols, out + first * cols);
+    }
+
+    template <typename T, typename A, typename B>
+    inline void Detail::evaluate_rows(T* out, const MatrixBinaryExpression< Minus, Matrix<T, A>, Matrix<T, B> >& expression, std::size_t first, std::size_t last)
+    {
+        const std::size_t cols = expression.cols();
+        LinAlg::Kernels::sub((last - first) * cols, expression.lhs().data() + first * cols, expression.rhs().data() + first * cols, out + first * cols);
+    }
+
+    template <typename T, typename E>
+    inline void Detail::accumulate_rows(T* out, const E& expression, Plus, std::size_t first, std::size_t last)
+    {
+        const std::size_t cols = expression.cols();
+        for (std::size_t i = first; i < last; ++i) {
+            T* row = out + i * cols;
+            for (std::size_t j = 0; j < cols; ++j) { row[j] += expression(i, j); }
+        }
+    }
+
+    template <typename T, typename E>
+    inline void Detail::accumulate_rows(T* out, const E& expression, Minus, std::size_t first, std::size_t last)
+    {
+        const std::size_t cols = expression.cols();
+        for (std::size_t i = first; i < last; ++i) {
+            T* row = out + i * cols;
+            for (std::size_t j = 0; j < cols; ++j) { row[j] -= expression(i, j); }
+        }
+    }
+
+    template <typename T, typename A>
+    inline void Detail::accumulate_rows(T* out, const Matrix<T, A>& expression, Plus, std::size_t first, std::size_t last)
+    {
+        const std::size_t cols = expression.cols();
+        LinAlg::Kernels::add((last - first) * cols, out + first * cols, expression.data() + first * cols, out + first * cols);
+    }
+
+    template <typename T, typename A>
+    inline void Detail::accumulate_rows(T* out, const Matrix<T, A>& expression, Minus, std::size_t first, std::size_t last)
+    {
+        const std::size_t cols = expression.cols();
+        LinAlg::Kernels::sub((last - first) * cols, out + first * cols, expression.data() + first * cols, out + first * cols);
+    }
+
+    inline std::size_t Detail::row_grain(std::size_t cols)
+    {
+        return (cols == 0 || cols >= elementwise_grain) ? 1 : elementwise_grain / cols;
+    }
+
+    template <typename T>
+    inline void Detail::multiply(std::size_t m, std::size_t n, std::size_t k,
+                                 const T* a, std::ptrdiff_t rsa, std::ptrdiff_t csa,
+                                 const T* b, std::ptrdiff_t rsb, std::ptrdiff_t csb, T* c)
+    {
+        LINALG_INSTRUMENT_OPERATION(Operation::gemm, 2 * m * n * k, (m * k + k * n + m * n) * sizeof(T));
+        const std::size_t crossover = LinAlg::strassen_crossover();
+        if (std::is_floating_point<T>::value && crossover != 0 && std::min(m, std::min(n, k)) > crossover
+            && csa == 1 && csb == 1 && rsa > 0 && rsb > 0) {
+            LinAlg::Kernels::strassen(m, n, k, a, static_cast<std::size_t>(rsa), b, static_cast<std::size_t>(rsb), c, n, crossover);
+            return;
+        }
+        const std::size_t rowGrain = 8 * LinAlg::Kernels::GemmBlocking<T>::MR;
+        LinAlg::parallel_for(m * n * k, 0, m, rowGrain, [=](std::size_t first, std::size_t last) {
+            LinAlg::Kernels::gemm<T>(last - first, n, k, T(1), a + static_cast<std::ptrdiff_t>(first) * rsa, rsa, csa,
+                                     b, rsb, csb, T(), c + first * n, n);
+        });
+    }
+
+    template <typename T, typename A>
+    inline bool Detail::is_diagonal(const Matrix<T, A>& matrix)
+    {
+        for (std::size_t i = 0; i < matrix.rows(); ++i) {
+            for (std::size_t j = 0; j < matrix.cols(); ++j) {
+                if (i != j && matrix(i, j) != T()) { return false; }
             }
         }
         return true;
     }
 
-    template <typename U>
-    inline Matrix<U> operator* (U value, const Matrix<U>& other)
+    template <typename T>
+    inline T Detail::power(T value, unsigned int exponent)
     {
-        Matrix<U> tempMatrix(other);
-        return tempMatrix * value;
+        T result = T(1);
+        while (exponent != 0) {
+            if (exponent & 1u) { result *= value; }
+            exponent >>= 1;
+            if (exponent != 0) { value *= value; }
+        }
+        return result;
     }
 
+    template <typename T>
+    inline T Detail::determinant(std::size_t size, const T* data, std::true_type)
+    {
+        return LinAlg::Kernels::determinant_lu(size, data, size);
+    }
+
+    template <typename T>
+    inline T Detail::determinant(std::size_t size, const T* data, std::false_type)
+    {
+        return LinAlg::Kernels::determinant_bareiss(size, data, size);
+    }
+
+    template <typename T, typename A>
+    inline Matrix<T, A> Detail::inverse(Matrix<T, A>& matrix, std::true_type)
+    {
+        if (matrix.rows() <= closed_form_order) { return inverse(matrix, std::false_type()); }
+
+        Matrix<T, A> inverseMatrix(matrix);
+        invert_in_place(inverseMatrix, std::true_type());
+        return inverseMatrix;
+    }
+
+    template <typename T, typename A>
+    inline Matrix<T, A> Detail::inverse(Matrix<T, A>& matrix, std::false_type)
+    {
+        const T determinant = matrix.determinant();
+        if (determinant == 0) { throw std::runtime_error("null determinant"); }
+
+        Matrix<T, A> inverseMatrix = matrix.adjoint() / determinant;
+        return inverseMatrix;
+    }
+
+    template <typename T, typename A>
+    inline void Detail::invert_in_place(Matrix<T, A>& matrix, std::true_type)
+    {
+        if (matrix.rows() <= closed_form_order) {
+            matrix = inverse(matrix, std::false_type());
+            return;
+        }
+
+        if (!LinAlg::Kernels::invert_in_place(matrix.rows(), matrix.data(), matrix.cols())) {
+            throw std::runtime_error("null determinant");
+        }
+    }
+
+    template <typename T, typename A>
+    inline void Detail::invert_in_place(Matrix<T, A>& matrix, std::false_type)
+    {
+        matrix = inverse(matrix, std::false_type());
+    }
 }
 
-template <typename T>
-inline LinAlg::Matrix<T>::Matrix()
+template <typename T, typename Allocator>
+inline LinAlg::Matrix<T, Allocator>::Matrix()
     :  _rows(0), _cols(0), _matrix(check_template_arg(0))
 {
 }
 
-template <typename T>
-inline LinAlg::Matrix<T>::Matrix(std::size_t rows, std::size_t cols)
-    : _rows(check_rows_arg(rows)), _cols(check_cols_arg(cols)), _matrix(check_template_arg(rows * cols))
+template <typename T, typename Allocator>
+inline LinAlg::Matrix<T, Allocator>::Matrix(std::size_t rows, std::size_t cols)
+    : _rows(check_rows_arg(rows)), _cols(check_cols_arg(cols)), _matrix(check_template_arg(rows * cols), T())
 {
 }
 
-template <typename T>
-inline LinAlg::Matrix<T>::Matrix(std::size_t rows, std::size_t cols, T value)
-    : _rows(check_rows_arg(rows)), _cols(check_cols_arg(cols)), _matrix(check_template_arg(rows * cols))
+template <typename T, typename Allocator>
+inline LinAlg::Matrix<T, Allocator>::Matrix(std::size_t rows, std::size_t cols, UninitializedTag)
+    : _rows(check_rows_arg(rows)), _cols(check_cols_arg(cols)), _matrix()
 {
-    _matrix.assign(vector_size(), value);
+    const std::size_t size = check_template_arg(rows * cols);
+    LinAlg::Detail::DefaultInitializationScope scope;
+    _matrix.resize(size);
 }
 
-template <typename T>
-inline LinAlg::Matrix<T>::Matrix(std::size_t rows, std::size_t cols, const std::vector<T>& v)
-    : _rows(check_rows_arg(rows)), _cols(check_cols_arg(cols)), _matrix(check_template_arg(rows * cols))
+template <typename T, typename Allocator>
+inline LinAlg::Matrix<T, Allocator>::Matrix(std::size_t rows, std::size_t cols, T value)
+    : _rows(check_rows_arg(rows)), _cols(check_cols_arg(cols)), _matrix(check_template_arg(rows * cols), value)
 {
-    if (v.size() != _matrix.size()) { throw std::invalid_argument("invalid vector argument size"); }
+}
+
+template <typename T, typename Allocator>
+inline LinAlg::Matrix<T, Allocator>::Matrix(std::size_t rows, std::size_t cols, const std::vector<T>& v)
+    : _rows(check_rows_arg(rows)), _cols(check_cols_arg(cols)), _matrix()
+{
+    if (v.size() != check_template_arg(rows * cols)) { throw std::invalid_argument("invalid vector argument size"); }
 
     _matrix.assign(v.begin(), v.end());
 }
 
-template <typename T>
-inline LinAlg::Matrix<T>::Matrix(std::initializer_list< std::initializer_list<T> > il)
+template <typename T, typename Allocator>
+inline LinAlg::Matrix<T, Allocator>::Matrix(std::size_t rows, std::size_t cols, storage_type&& v)
+    : _rows(check_rows_arg(rows)), _cols(check_cols_arg(cols)), _matrix()
+{
+    if (v.size() != check_template_arg(rows * cols)) { throw std::invalid_argument("invalid vector argument size"); }
+
+    _matrix.swap(v);
+}
+
+template <typename T, typename Allocator>
+inline LinAlg::Matrix<T, Allocator>::Matrix(std::initializer_list< std::initializer_list<T> > il)
     : _rows(il.size()), _cols(il.begin()->size())
 {
     if (!std::is_arithmetic<T>::value) { throw std::invalid_argument("invalid Matrix template argument"); }
@@ -183,28 +672,36 @@ inline LinAlg::Matrix<T>::Matrix(std::initializer_list< std::initializer_list<T>
     }
 }
 
-template <typename T>
-inline LinAlg::Matrix<T>::Matrix(Matrix&& other) noexcept
+template <typename T, typename Allocator>
+inline LinAlg::Matrix<T, Allocator>::Matrix(Matrix&& other) noexcept
     : _rows(other._rows), _cols(other._cols), _matrix(std::move(other._matrix))
 {
     other._rows = 0;
     other._cols = 0;
 }
 
-template <typename T>
-inline T& LinAlg::Matrix<T>::operator() (std::size_t row, std::size_t col)
+template <typename T, typename Allocator>
+template <typename E>
+inline LinAlg::Matrix<T, Allocator>::Matrix(const MatrixExpression<E>& expression)
+    : _rows(expression.rows()), _cols(expression.cols()), _matrix(check_template_arg(expression.rows() * expression.cols()))
+{
+    evaluate(expression.derived());
+}
+
+template <typename T, typename Allocator>
+inline T& LinAlg::Matrix<T, Allocator>::operator() (std::size_t row, std::size_t col)
 {
     return _matrix[row * _cols + col];
 }
 
-template <typename T>
-inline const T& LinAlg::Matrix<T>::operator() (std::size_t row, std::size_t col) const
+template <typename T, typename Allocator>
+inline const T& LinAlg::Matrix<T, Allocator>::operator() (std::size_t row, std::size_t col) const
 {
     return _matrix[row * _cols + col];
 }
 
-template <typename T>
-inline LinAlg::Matrix<T>& LinAlg::Matrix<T>::operator= (Matrix<T>&& other) noexcept
+template <typename T, typename Allocator>
+inline LinAlg::Matrix<T, Allocator>& LinAlg::Matrix<T, Allocator>::operator= (Matrix<T, Allocator>&& other) noexcept
 {
     if (this != &other) {
         _rows = other._rows;
@@ -217,151 +714,110 @@ inline LinAlg::Matrix<T>& LinAlg::Matrix<T>::operator= (Matrix<T>&& other) noexc
     return *this;
 }
 
-template <typename T>
-inline LinAlg::Matrix<T> LinAlg::Matrix<T>::operator* (T value)
-{
-    LinAlg::Matrix<T> temp(*this);
-    for (T& element : temp._matrix) { element *= value; }
-    return temp;
-}
-
-template <typename T>
-inline LinAlg::Matrix<T> LinAlg::Matrix<T>::operator/ (T value)
+template <typename T, typename Allocator>
+template <typename E>
+inline LinAlg::Matrix<T, Allocator>& LinAlg::Matrix<T, Allocator>::operator= (const MatrixExpression<E>& expression)
 {
-    if (value == T()) { throw std::invalid_argument("Matrix division by zero"); }
-    LinAlg::Matrix<T> temp(*this);
-    for (T& element : temp._matrix) { element /= value; }
-    return temp;
+    if (_rows == expression.rows() && _cols == expression.cols() && LinAlg::InPlaceEvaluable<E>::value) {
+        evaluate(expression.derived());
+    } else {
+        *this = LinAlg::Matrix<T, Allocator>(expression);
+    }
+    return *this;
 }
 
-template <typename T>
-inline LinAlg::Matrix<T>& LinAlg::Matrix<T>::operator*= (T value)
+template <typename T, typename Allocator>
+inline LinAlg::Matrix<T, Allocator>& LinAlg::Matrix<T, Allocator>::operator*= (T value)
 {
-    for (T& element : _matrix) { element *= value; }
+    LinAlg::Kernels::scale(_matrix.size(), value, _matrix.data());
     return *this;
 }
 
-template <typename T>
-inline LinAlg::Matrix<T>& LinAlg::Matrix<T>::operator/= (T value)
+template <typename T, typename Allocator>
+inline LinAlg::Matrix<T, Allocator>& LinAlg::Matrix<T, Allocator>::operator/= (T value)
 {
     if (value == T()) { throw std::invalid_argument("Matrix division by zero"); }
-    for (T& element : _matrix) { element /= value; }
+    LinAlg::Kernels::divide(_matrix.size(), value, _matrix.data());
     return *this;
 }
 
-template <typename T>
-inline LinAlg::Matrix<T> LinAlg::Matrix<T>::operator- ()
+template <typename T, typename Allocator>
+template <typename E>
+inline LinAlg::Matrix<T, Allocator>& LinAlg::Matrix<T, Allocator>::operator+= (const MatrixExpression<E>& expression)
 {
-    return (*this) * -1;
-}
-
-template <typename T>
-inline LinAlg::Matrix<T> LinAlg::Matrix<T>::operator+ (const Matrix<T>& other)
-{
-    if (_rows != other._rows || _cols != other._cols) { throw std::invalid_argument("invalid Matrix argument size"); }
-
-    LinAlg::Matrix<T> resultMatrix(*this);
-    for (auto i = 0; i < resultMatrix.rows(); ++i) {
-        for (auto j = 0; j < resultMatrix.cols(); ++j) {
-            resultMatrix.at(i, j) += other.at(i, j);
-        }
-    }
-    return resultMatrix;
-}
-
-template <typename T>
-inline LinAlg::Matrix<T> LinAlg::Matrix<T>::operator- (const Matrix<T>& other)
-{
-    LinAlg::Matrix<T> tempMatrix(other);
-    LinAlg::Matrix<T> resultMatrix(*this + -tempMatrix);
-    return resultMatrix;
-}
-
-template <typename T>
-inline LinAlg::Matrix<T> LinAlg::Matrix<T>::operator* (const Matrix<T>& other)
-{
-    if (_cols != other._rows) { throw std::invalid_argument("invalid Matrix argument size"); }
-    LinAlg::Matrix<T> resultMatrix(_rows, other._cols);
-    for (auto i = 0; i < resultMatrix.rows(); ++i) {
-        for (auto j = 0; j < resultMatrix.cols(); ++j) {
-            for (auto k = 0; k < _cols; ++k) {
-                resultMatrix.at(i, j) += at(i, k) * other.at(k, j);
-            }
-        }
-    }
-    return resultMatrix;
-}
-
-template <typename T>
-inline LinAlg::Matrix<T> LinAlg::Matrix<T>::operator/ (const Matrix<T>& other)
-{
-    LinAlg::Matrix<T> tempMatrix(other);
-    LinAlg::Matrix<T> resultMatrix = *this * tempMatrix.inverse();
-    return resultMatrix;
-}
-
-template <typename T>
-inline LinAlg::Matrix<T>& LinAlg::Matrix<T>::operator+= (const Matrix<T>& other)
-{
-    *this = *this + other;
+    if (_rows != expression.rows() || _cols != expression.cols()) { throw std::invalid_argument("invalid Matrix argument size"); }
+    if (!LinAlg::InPlaceEvaluable<E>::value) { return *this += LinAlg::Matrix<T, Allocator>(expression); }
+
+    T* result = _matrix.data();
+    const E& operand = expression.derived();
+    LinAlg::parallel_for(vector_size(), 0, _rows, LinAlg::Detail::row_grain(_cols), [result, &operand](std::size_t first, std::size_t last) {
+        LinAlg::Detail::accumulate_rows(result, operand, LinAlg::Plus(), first, last);
+    });
     return *this;
 }
 
-template <typename T>
-inline LinAlg::Matrix<T>& LinAlg::Matrix<T>::operator-= (const Matrix<T>& other)
+template <typename T, typename Allocator>
+template <typename E>
+inline LinAlg::Matrix<T, Allocator>& LinAlg::Matrix<T, Allocator>::operator-= (const MatrixExpression<E>& expression)
 {
-    *this = *this - other;
+    if (_rows != expression.rows() || _cols != expression.cols()) { throw std::invalid_argument("invalid Matrix argument size"); }
+    if (!LinAlg::InPlaceEvaluable<E>::value) { return *this -= LinAlg::Matrix<T, Allocator>(expression); }
+
+    T* result = _matrix.data();
+    const E& operand = expression.derived();
+    LinAlg::parallel_for(vector_size(), 0, _rows, LinAlg::Detail::row_grain(_cols), [result, &operand](std::size_t first, std::size_t last) {
+        LinAlg::Detail::accumulate_rows(result, operand, LinAlg::Minus(), first, last);
+    });
     return *this;
 }
 
-template <typename T>
-inline LinAlg::Matrix<T>& LinAlg::Matrix<T>::operator*= (const Matrix<T>& other)
+template <typename T, typename Allocator>
+inline LinAlg::Matrix<T, Allocator>& LinAlg::Matrix<T, Allocator>::operator*= (const Matrix<T, Allocator>& other)
 {
     *this = *this * other;
     return *this;
 }
 
-template <typename T>
-inline LinAlg::Matrix<T>& LinAlg::Matrix<T>::operator/= (const Matrix<T>& other)
+template <typename T, typename Allocator>
+inline LinAlg::Matrix<T, Allocator>& LinAlg::Matrix<T, Allocator>::operator/= (const Matrix<T, Allocator>& other)
 {
     *this = *this / other;
     return *this;
 }
 
-template <typename T>
-inline T& LinAlg::Matrix<T>::at(std::size_t row, std::size_t col)
+template <typename T, typename Allocator>
+inline T& LinAlg::Matrix<T, Allocator>::at(std::size_t row, std::size_t col)
 {
     if (row < 0 || col < 0 || _rows < row || _cols < col) { throw std::out_of_range("invalid Matrix subscripts"); }
     return _matrix[row * _cols + col];
 }
 
-template <typename T>
-inline const T& LinAlg::Matrix<T>::at(std::size_t row, std::size_t col) const
+template <typename T, typename Allocator>
+inline const T& LinAlg::Matrix<T, Allocator>::at(std::size_t row, std::size_t col) const
 {
     if (row < 0 || col < 0 || _rows < row || _cols < col) { throw std::out_of_range("invalid Matrix subscripts"); }
     return _matrix[row * _cols + col];
 }
 
-template <typename T>
-inline void LinAlg::Matrix<T>::set_identity()
+template <typename T, typename Allocator>
+inline void LinAlg::Matrix<T, Allocator>::set_identity()
 {
     if (!square()) { throw std::invalid_argument("square Matrix required"); }
 
-    std::vector<T> identityVector(vector_size());
-    for (auto i = 0; i < identityVector.size(); i += _rows + 1) {
-        identityVector[i] = 1;
+    std::fill(_matrix.begin(), _matrix.end(), T());
+    for (std::size_t i = 0; i < _matrix.size(); i += _rows + 1) {
+        _matrix[i] = T(1);
     }
-    *this = LinAlg::Matrix<T>(_rows, _cols, identityVector);
 }
 
-template <typename T>
-inline void LinAlg::Matrix<T>::set_zero()
+template <typename T, typename Allocator>
+inline void LinAlg::Matrix<T, Allocator>::set_zero()
 {
-    *this = LinAlg::Matrix<T>(_rows, _cols);
+    std::fill(_matrix.begin(), _matrix.end(), T());
 }
 
-template <typename T>
-inline void LinAlg::Matrix<T>::set_diag(const std::vector<T>& v)
+template <typename T, typename Allocator>
+inline void LinAlg::Matrix<T, Allocator>::set_diag(const std::vector<T>& v)
 {
     if (!square()) { throw std::invalid_argument("square Matrix required"); }
     if (v.size() != _rows) { throw std::invalid_argument("invalid vector argument size"); }
@@ -372,8 +828,8 @@ inline void LinAlg::Matrix<T>::set_diag(const std::vector<T>& v)
     }
 }
 
-template <typename T>
-inline void LinAlg::Matrix<T>::set_diag(std::initializer_list<T> il)
+template <typename T, typename Allocator>
+inline void LinAlg::Matrix<T, Allocator>::set_diag(std::initializer_list<T> il)
 {
     if (!square()) { throw std::invalid_argument("square Matrix required"); }
     if (il.size() != _rows) { throw std::invalid_argument("invalid initializer list argument size"); }
@@ -385,8 +841,8 @@ inline void LinAlg::Matrix<T>::set_diag(std::initializer_list<T> il)
     }
 }
 
-template <typename T>
-inline void LinAlg::Matrix<T>::set_row(std::size_t row, T value)
+template <typename T, typename Allocator>
+inline void LinAlg::Matrix<T, Allocator>::set_row(std::size_t row, T value)
 {
     if (row < 0 || row >= _rows) { throw std::out_of_range("invalid Matrix row subscript"); }
 
@@ -395,8 +851,8 @@ inline void LinAlg::Matrix<T>::set_row(std::size_t row, T value)
     }
 }
 
-template <typename T>
-inline void LinAlg::Matrix<T>::set_row(std::size_t row, const std::vector<T>& v)
+template <typename T, typename Allocator>
+inline void LinAlg::Matrix<T, Allocator>::set_row(std::size_t row, const std::vector<T>& v)
 {
     if (v.size() != _cols) { throw std::invalid_argument("invalid vector argument size"); }
     if (row < 0 || row >= _rows) { throw std::out_of_range("invalid Matrix row subscript"); }
@@ -406,8 +862,8 @@ inline void LinAlg::Matrix<T>::set_row(std::size_t row, const std::vector<T>& v)
     }
 }
 
-template <typename T>
-inline void LinAlg::Matrix<T>::set_row(std::size_t row, std::initializer_list<T> il)
+template <typename T, typename Allocator>
+inline void LinAlg::Matrix<T, Allocator>::set_row(std::size_t row, std::initializer_list<T> il)
 {
     if (il.size() != _cols) { throw std::invalid_argument("invalid initializer list argument size"); }
     if (row < 0 || row >= _rows) { throw std::out_of_range("invalid Matrix row subscript"); }
@@ -418,8 +874,8 @@ inline void LinAlg::Matrix<T>::set_row(std::size_t row, std::initializer_list<T>
     }
 }
 
-template <typename T>
-inline void LinAlg::Matrix<T>::set_col(std::size_t col, T value)
+template <typename T, typename Allocator>
+inline void LinAlg::Matrix<T, Allocator>::set_col(std::size_t col, T value)
 {
     if (col < 0 || col >= _cols) { throw std::out_of_range("invalid Matrix column subscript"); }
 
@@ -428,8 +884,8 @@ inline void LinAlg::Matrix<T>::set_col(std::size_t col, T value)
     }
 }
 
-template <typename T>
-inline void LinAlg::Matrix<T>::set_col(std::size_t col, const std::vector<T>& v)
+template <typename T, typename Allocator>
+inline void LinAlg::Matrix<T, Allocator>::set_col(std::size_t col, const std::vector<T>& v)
 {
     if (v.size() != _rows) { throw std::invalid_argument("invalid vector argument size"); }
     if (col < 0 || col >= _cols) { throw std::out_of_range("invalid Matrix column subscript"); }
@@ -439,8 +895,8 @@ inline void LinAlg::Matrix<T>::set_col(std::size_t col, const std::vector<T>& v)
     }
 }
 
-template <typename T>
-inline void LinAlg::Matrix<T>::set_col(std::size_t col, std::initializer_list<T> il)
+template <typename T, typename Allocator>
+inline void LinAlg::Matrix<T, Allocator>::set_col(std::size_t col, std::initializer_list<T> il)
 {
     if (il.size() != _rows) { throw std::invalid_argument("invalid initializer list argument size"); }
     if (col < 0 || col >= _cols) { throw std::out_of_range("invalid Matrix column subscript"); }
@@ -451,8 +907,8 @@ inline void LinAlg::Matrix<T>::set_col(std::size_t col, std::initializer_list<T>
     }
 }
 
-template <typename T>
-inline std::vector<T> LinAlg::Matrix<T>::get_row(std::size_t row) const
+template <typename T, typename Allocator>
+inline std::vector<T> LinAlg::Matrix<T, Allocator>::get_row(std::size_t row) const
 {
     if (row < 0 || row >= _rows) { throw std::out_of_range("invalid Matrix row subscript"); }
 
@@ -463,8 +919,8 @@ inline std::vector<T> LinAlg::Matrix<T>::get_row(std::size_t row) const
     return rowVector;
 }
 
-template <typename T>
-inline std::vector<T> LinAlg::Matrix<T>::get_col(std::size_t col) const
+template <typename T, typename Allocator>
+inline std::vector<T> LinAlg::Matrix<T, Allocator>::get_col(std::size_t col) const
 {
     if (col < 0 || col >= _cols) { throw std::out_of_range("invalid Matrix column subscript"); }
 
@@ -475,46 +931,156 @@ inline std::vector<T> LinAlg::Matrix<T>::get_col(std::size_t col) const
     return colVector;
 }
 
-template <typename T>
-inline void LinAlg::Matrix<T>::transpose()
+template <typename S>
+inline S& LinAlg::Detail::transpose_buffer(S&, std::true_type)
 {
-    std::vector<T> tempVector(vector_size());
-    std::swap(_rows, _cols);
-    int counter = 0;
-    for (auto i = 0; i < _rows; ++i) {
-        for (auto j = 0; j < _cols; ++j) {
-            tempVector[counter++] = _matrix[i + j * _rows];
-        }
+    thread_local S buffer;
+    return buffer;
+}
+
+template <typename S>
+inline S& LinAlg::Detail::transpose_buffer(S& local, std::false_type)
+{
+    return local;
+}
+
+template <typename T, typename Allocator>
+inline void LinAlg::Matrix<T, Allocator>::transpose()
+{
+    LINALG_INSTRUMENT_OPERATION(Operation::transpose, 0, 2 * vector_size() * sizeof(T));
+    const std::size_t tile = LinAlg::Kernels::transpose_tile;
+
+    if (square()) {
+        const std::size_t size = _rows;
+        const std::size_t tiles = (size + tile - 1) / tile;
+        T* matrix = _matrix.data();
+        LinAlg::parallel_for(vector_size(), 0, tiles, 1, [=](std::size_t first, std::size_t last) {
+            LinAlg::Kernels::transpose_square(size, matrix, static_cast<std::ptrdiff_t>(size), first, last);
+        });
+        return;
     }
-    _matrix.assign(tempVector.begin(), tempVector.end());
+
+    storage_type localVector(_matrix.get_allocator());
+    storage_type& tempVector = LinAlg::Detail::transpose_buffer(localVector, std::integral_constant<bool, std::is_empty<Allocator>::value>());
+    {
+        LinAlg::Detail::DefaultInitializationScope scope;
+        tempVector.resize(vector_size());
+    }
+    const std::size_t rows = _cols, cols = _rows;
+    const T* source = _matrix.data();
+    T* destination = tempVector.data();
+    LinAlg::parallel_for(vector_size(), 0, rows, LinAlg::Detail::transpose_row_grain, [=](std::size_t first, std::size_t last) {
+        LinAlg::Kernels::copy_strided(last - first, cols, source + first, 1, static_cast<std::ptrdiff_t>(rows),
+                                      destination + first * cols, static_cast<std::ptrdiff_t>(cols));
+    });
+    std::swap(_rows, _cols);
+    _matrix.swap(tempVector);
 }
 
-template <typename T>
-inline void LinAlg::Matrix<T>::pow(int power)
+template <typename T, typename Allocator>
+inline LinAlg::ConstMatrixView<T> LinAlg::Matrix<T, Allocator>::transposed() const
+{
+    return LinAlg::ConstMatrixView<T>(_matrix.data(), _cols, _rows, 1, static_cast<std::ptrdiff_t>(_cols));
+}
+
+template <typename T, typename Allocator>
+inline LinAlg::MatrixView<T> LinAlg::Matrix<T, Allocator>::view()
+{
+    return LinAlg::MatrixView<T>(*this);
+}
+
+template <typename T, typename Allocator>
+inline LinAlg::ConstMatrixView<T> LinAlg::Matrix<T, Allocator>::view() const
+{
+    return LinAlg::ConstMatrixView<T>(*this);
+}
+
+template <typename T, typename Allocator>
+inline LinAlg::MatrixView<T> LinAlg::Matrix<T, Allocator>::row_view(std::size_t row)
+{
+    return view().row(row);
+}
+
+template <typename T, typename Allocator>
+inline LinAlg::ConstMatrixView<T> LinAlg::Matrix<T, Allocator>::row_view(std::size_t row) const
+{
+    return view().row(row);
+}
+
+template <typename T, typename Allocator>
+inline LinAlg::MatrixView<T> LinAlg::Matrix<T, Allocator>::col_view(std::size_t col)
+{
+    return view().col(col);
+}
+
+template <typename T, typename Allocator>
+inline LinAlg::ConstMatrixView<T> LinAlg::Matrix<T, Allocator>::col_view(std::size_t col) const
+{
+    return view().col(col);
+}
+
+template <typename T, typename Allocator>
+inline LinAlg::MatrixView<T> LinAlg::Matrix<T, Allocator>::block(std::size_t row, std::size_t col, std::size_t rows, std::size_t cols)
+{
+    return view().block(row, col, rows, cols);
+}
+
+template <typename T, typename Allocator>
+inline LinAlg::ConstMatrixView<T> LinAlg::Matrix<T, Allocator>::block(std::size_t row, std::size_t col, std::size_t rows, std::size_t cols) const
+{
+    return view().block(row, col, rows, cols);
+}
+
+template <typename T, typename Allocator>
+inline void LinAlg::Matrix<T, Allocator>::pow(int power)
 {
     if (!square()) { throw std::invalid_argument("square Matrix required"); }
 
     if (power == 0) {
         set_identity();
-    } else if(power > 0) {
-        LinAlg::Matrix<T> resultMatrix(*this);
-        for (int i = 1; i < power; ++i) {
-            resultMatrix *= *this;
+        return;
+    }
+    if (power < 0) { *this = inverse(); }
+
+    unsigned int exponent = (power < 0) ? 0u - static_cast<unsigned int>(power) : static_cast<unsigned int>(power);
+    if (exponent == 1) { return; }
+
+    if (LinAlg::Detail::is_diagonal(*this)) {
+        for (std::size_t i = 0; i < vector_size(); i += _cols + 1) {
+            _matrix[i] = LinAlg::Detail::power(_matrix[i], exponent);
         }
-        *this = resultMatrix;
-    } else if(power < 0) {
-        LinAlg::Matrix<T> resultMatrix(inverse());
-        for (int i = 1; i < std::abs(power); ++i) {
-            resultMatrix *= inverse();
+        return;
+    }
+
+    // Right-to-left binary exponentiation; products are written into a spare
+    // buffer that is then swapped in, so no step allocates.
+    const std::size_t size = _rows;
+    LinAlg::Matrix<T, Allocator> baseMatrix(*this);
+    LinAlg::Matrix<T, Allocator> bufferMatrix(size, size, LinAlg::uninitialized);
+    bool started = false;
+    while (true) {
+        if (exponent & 1u) {
+            if (!started) {
+                std::copy(baseMatrix._matrix.begin(), baseMatrix._matrix.end(), _matrix.begin());
+                started = true;
+            } else {
+                LinAlg::Detail::multiply(size, size, size, data(), size, 1, baseMatrix.data(), size, 1, bufferMatrix.data());
+                std::swap(_matrix, bufferMatrix._matrix);
+            }
         }
-        *this = resultMatrix;
+        exponent >>= 1;
+        if (exponent == 0) { break; }
+
+        LinAlg::Detail::multiply(size, size, size, baseMatrix.data(), size, 1, baseMatrix.data(), size, 1, bufferMatrix.data());
+        std::swap(baseMatrix._matrix, bufferMatrix._matrix);
     }
 }
 
-template <typename T>
-inline void LinAlg::Matrix<T>::swap_row(std::size_t lhsRow, std::size_t rhsRow)
+template <typename T, typename Allocator>
+inline void LinAlg::Matrix<T, Allocator>::swap_row(std::size_t lhsRow, std::size_t rhsRow)
 {
     if ( (lhsRow < 0 || lhsRow >= _rows) || (rhsRow < 0 || rhsRow >= _rows) ) { throw std::out_of_range("invalid Matrix row subscript"); }
+    LINALG_INSTRUMENT_OPERATION(Operation::row_operation, 0, 4 * _cols * sizeof(T));
 
     if (lhsRow != rhsRow) {
         for (auto i = lhsRow * _cols, j = rhsRow * _cols; i < (lhsRow + 1) * _cols; ++i, ++j) {
@@ -523,10 +1089,11 @@ inline void LinAlg::Matrix<T>::swap_row(std::size_t lhsRow, std::size_t rhsRow)
     }
 }
 
-template <typename T>
-inline void LinAlg::Matrix<T>::swap_col(std::size_t lhsCol, std::size_t rhsCol)
+template <typename T, typename Allocator>
+inline void LinAlg::Matrix<T, Allocator>::swap_col(std::size_t lhsCol, std::size_t rhsCol)
 {
     if ( (lhsCol < 0 || lhsCol >= _cols) || (rhsCol < 0 || rhsCol >= _cols) ) { throw std::out_of_range("invalid Matrix column subscript"); }
+    LINALG_INSTRUMENT_OPERATION(Operation::row_operation, 0, 4 * _rows * sizeof(T));
 
     if (lhsCol != rhsCol) {
         for (auto i = lhsCol, j = rhsCol; i < (_rows - 1) * _cols + lhsCol + 1; i += _cols, j += _cols) {
@@ -535,46 +1102,46 @@ inline void LinAlg::Matrix<T>::swap_col(std::size_t lhsCol, std::size_t rhsCol)
     }
 }
 
-template <typename T>
-inline void LinAlg::Matrix<T>::mult_row(std::size_t row, T value)
+template <typename T, typename Allocator>
+inline void LinAlg::Matrix<T, Allocator>::mult_row(std::size_t row, T value)
 {
     if (row < 0 || row >= _rows) { throw std::out_of_range("invalid Matrix row subscript"); }
+    LINALG_INSTRUMENT_OPERATION(Operation::row_operation, _cols, 2 * _cols * sizeof(T));
 
-    for (auto i = row * _cols; i < (row + 1) * _cols; ++i) {
-        _matrix[i] *= value;
-    }
+    LinAlg::Kernels::scale(_cols, value, _matrix.data() + row * _cols);
 }
 
-template <typename T>
-inline void LinAlg::Matrix<T>::mult_col(std::size_t col, T value)
+template <typename T, typename Allocator>
+inline void LinAlg::Matrix<T, Allocator>::mult_col(std::size_t col, T value)
 {
     if (col < 0 || col >= _cols) { throw std::out_of_range("invalid Matrix column subscript"); }
+    LINALG_INSTRUMENT_OPERATION(Operation::row_operation, _rows, 2 * _rows * sizeof(T));
 
     for (auto i = col; i < (_rows - 1) * _cols + col + 1; i += _cols) {
         _matrix[i] *= value;
     }
 }
 
-template <typename T>
-inline void LinAlg::Matrix<T>::add_row(std::size_t lhsRow, std::size_t rhsRow, T value)
+template <typename T, typename Allocator>
+inline void LinAlg::Matrix<T, Allocator>::add_row(std::size_t lhsRow, std::size_t rhsRow, T value)
 {
     if ( (lhsRow < 0 || lhsRow >= _rows) || (rhsRow < 0 || rhsRow >= _rows) ) { throw std::out_of_range("invalid Matrix row subscript"); }
+    LINALG_INSTRUMENT_OPERATION(Operation::row_operation, 2 * _cols, 3 * _cols * sizeof(T));
 
     if (value != 0) {
         if (lhsRow == rhsRow) {
             mult_row(lhsRow, value + 1);
         } else {
-            for (auto i = lhsRow * _cols, j = rhsRow * _cols; i < (lhsRow + 1) * _cols; ++i, ++j) {
-                _matrix[i] += value * _matrix[j];
-            }
+            LinAlg::Kernels::axpy(_cols, value, _matrix.data() + rhsRow * _cols, _matrix.data() + lhsRow * _cols);
         }
     }
 }
 
-template <typename T>
-inline void LinAlg::Matrix<T>::add_col(std::size_t lhsCol, std::size_t rhsCol, T value)
+template <typename T, typename Allocator>
+inline void LinAlg::Matrix<T, Allocator>::add_col(std::size_t lhsCol, std::size_t rhsCol, T value)
 {
     if ( (lhsCol < 0 || lhsCol >= _cols) || (rhsCol < 0 || rhsCol >= _cols) ) { throw std::out_of_range("invalid Matrix column subscript"); }
+    LINALG_INSTRUMENT_OPERATION(Operation::row_operation, 2 * _rows, 3 * _rows * sizeof(T));
 
     if (value != 0) {
         if (lhsCol == rhsCol) {
@@ -587,81 +1154,117 @@ inline void LinAlg::Matrix<T>::add_col(std::size_t lhsCol, std::size_t rhsCol, T
     }
 }
 
-template <typename T>
-inline T LinAlg::Matrix<T>::cofactor(std::size_t row, std::size_t col)
+template <typename T, typename Allocator>
+inline T LinAlg::Matrix<T, Allocator>::cofactor(std::size_t row, std::size_t col)
 {
+    LINALG_INSTRUMENT_OPERATION(Operation::cofactor, 0, vector_size() * sizeof(T));
     return std::pow(-1, row + col) * minor(row, col).determinant();
 }
 
-template <typename T>
-inline T LinAlg::Matrix<T>::determinant()
+template <typename T, typename Allocator>
+inline T LinAlg::Matrix<T, Allocator>::determinant()
 {
     if (!square()) { throw std::invalid_argument("square Matrix required"); }
-
-    if (_rows == 1) { 
-        return at(0, 0); 
-    } else if (_rows == 2) { 
-        return at(0, 0) * at(1, 1) - at(0, 1) * at(1, 0); 
-    } else {
-        T totalDeterminant = 0;
-        for (auto i = 0; i < _cols; ++i) {
-            totalDeterminant += _matrix[i] * cofactor(0, i);
-        }
-        return totalDeterminant;
+    LINALG_INSTRUMENT_OPERATION(Operation::determinant, 2 * _rows * _rows * _rows / 3, vector_size() * sizeof(T));
+
+    const T* m = _matrix.data();
+    switch (_rows) {
+    case 0:
+        return T();
+    case 1:
+        return m[0];
+    case 2:
+        return m[0] * m[3] - m[1] * m[2];
+    case 3:
+        return m[0] * (m[4] * m[8] - m[5] * m[7])
+             - m[1] * (m[3] * m[8] - m[5] * m[6])
+             + m[2] * (m[3] * m[7] - m[4] * m[6]);
+    case 4: {
+        const T s0 = m[0] * m[5] - m[4] * m[1], s1 = m[0] * m[6] - m[4] * m[2], s2 = m[0] * m[7] - m[4] * m[3];
+        const T s3 = m[1] * m[6] - m[5] * m[2], s4 = m[1] * m[7] - m[5] * m[3], s5 = m[2] * m[7] - m[6] * m[3];
+        const T c0 = m[8] * m[13] - m[12] * m[9], c1 = m[8] * m[14] - m[12] * m[10], c2 = m[8] * m[15] - m[12] * m[11];
+        const T c3 = m[9] * m[14] - m[13] * m[10], c4 = m[9] * m[15] - m[13] * m[11], c5 = m[10] * m[15] - m[14] * m[11];
+        return s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+    }
+    default:
+        return LinAlg::Detail::determinant(_rows, m, std::is_floating_point<T>());
     }
 }
 
-template <typename T>
-inline LinAlg::Matrix<T> LinAlg::Matrix<T>::minor(std::size_t row, std::size_t col)
+template <typename T, typename Allocator>
+inline LinAlg::Matrix<T, Allocator> LinAlg::Matrix<T, Allocator>::minor(std::size_t row, std::size_t col)
 {
     if (!square()) { throw std::invalid_argument("square Matrix required"); }
     if (row < 0 || row >= _rows) { throw std::out_of_range("invalid Matrix row subscript"); }
     if (col < 0 || col >= _cols) { throw std::out_of_range("invalid Matrix column subscript"); }
+    LINALG_INSTRUMENT_OPERATION(Operation::minor, 0, 2 * vector_size() * sizeof(T));
 
-    std::vector<T> tempVector;
-    for (auto i = 0; i < _rows; ++i) {
+    LinAlg::Matrix<T, Allocator> minorMatrix(_rows - 1, _cols - 1, LinAlg::uninitialized);
+    T* destination = minorMatrix.data();
+    for (std::size_t i = 0; i < _rows; ++i) {
         if (i != row) {
-            for (auto j = 0; j < _cols; ++j) {
-                if (j != col) { tempVector.push_back(at(i, j)); }
-            }
+            const T* source = _matrix.data() + i * _cols;
+            destination = std::copy(source + col + 1, source + _cols, std::copy(source, source + col, destination));
         }
     }
-    return LinAlg::Matrix<T>(_rows - 1, _cols - 1, tempVector);
+    return minorMatrix;
 }
 
-template <typename T>
-inline LinAlg::Matrix<T> LinAlg::Matrix<T>::adjoint()
+template <typename T, typename Allocator>
+inline LinAlg::Matrix<T, Allocator> LinAlg::Matrix<T, Allocator>::adjoint()
 {
     if (!square()) { throw std::invalid_argument("square Matrix required"); }
+    LINALG_INSTRUMENT_OPERATION(Operation::adjoint, 2 * vector_size() * _rows * _rows * _rows / 3, 2 * vector_size() * sizeof(T));
 
     if (_rows == 1) {
-        return LinAlg::Matrix<T>({ { 1 } });
+        return LinAlg::Matrix<T, Allocator>({ { 1 } });
     } else if (_rows == 2) {
-        return LinAlg::Matrix<T>({ { at(1, 1), -at(0, 1) }, { -at(1, 0), at(0, 0) } });
+        return LinAlg::Matrix<T, Allocator>({ { at(1, 1), -at(0, 1) }, { -at(1, 0), at(0, 0) } });
     } else {
-        LinAlg::Matrix<T> adjointMatrix(_rows, _cols);
-        for (auto i = 0; i < _rows; ++i) {
-            for (auto j = 0; j < _cols; ++j) {
-                adjointMatrix.at(i, j) = cofactor(i, j);
+        LinAlg::Matrix<T, Allocator> adjointMatrix(_rows, _cols, LinAlg::uninitialized);
+        LinAlg::parallel_for(vector_size() * vector_size(), 0, _rows, 1, [this, &adjointMatrix](std::size_t first, std::size_t last) {
+            for (std::size_t i = first; i < last; ++i) {
+                for (std::size_t j = 0; j < _cols; ++j) {
+                    adjointMatrix(j, i) = cofactor(i, j);
+                }
             }
-        }
-        adjointMatrix.transpose();
+        });
         return adjointMatrix;
     }
 }
 
-template <typename T>
-inline LinAlg::Matrix<T> LinAlg::Matrix<T>::inverse()
+template <typename T, typename Allocator>
+inline LinAlg::Matrix<T, Allocator> LinAlg::Matrix<T, Allocator>::inverse()
 {
     if (!square()) { throw std::invalid_argument("square Matrix required"); }
-    if (determinant() == 0) { throw std::runtime_error("null determinant"); }
+    if (_rows == 0) { throw std::runtime_error("null determinant"); }
+    LINALG_INSTRUMENT_OPERATION(Operation::inverse, 2 * _rows * _rows * _rows, 2 * vector_size() * sizeof(T));
 
-    LinAlg::Matrix<T> inverseMatrix = adjoint() / determinant();
-    return inverseMatrix;
+    return LinAlg::Detail::inverse(*this, std::is_floating_point<T>());
+}
+
+template <typename T, typename Allocator>
+inline void LinAlg::Matrix<T, Allocator>::invert_in_place()
+{
+    if (!square()) { throw std::invalid_argument("square Matrix required"); }
+    if (_rows == 0) { throw std::runtime_error("null determinant"); }
+    LINALG_INSTRUMENT_OPERATION(Operation::inverse, 2 * _rows * _rows * _rows, vector_size() * sizeof(T));
+
+    LinAlg::Detail::invert_in_place(*this, std::is_floating_point<T>());
+}
+
+template <typename T, typename Allocator>
+template <typename E>
+inline void LinAlg::Matrix<T, Allocator>::evaluate(const E& expression)
+{
+    T* result = _matrix.data();
+    LinAlg::parallel_for(vector_size(), 0, _rows, LinAlg::Detail::row_grain(_cols), [result, &expression](std::size_t first, std::size_t last) {
+        LinAlg::Detail::evaluate_rows(result, expression, first, last);
+    });
 }
 
-template <typename T>
-inline std::size_t LinAlg::Matrix<T>::check_rows_arg(std::size_t rows)
+template <typename T, typename Allocator>
+inline std::size_t LinAlg::Matrix<T, Allocator>::check_rows_arg(std::size_t rows)
 {
     if (rows < max_rows()) { 
         return rows; 
@@ -670,8 +1273,8 @@ inline std::size_t LinAlg::Matrix<T>::check_rows_arg(std::size_t rows)
     }
 }
 
-template <typename T>
-inline std::size_t LinAlg::Matrix<T>::check_cols_arg(std::size_t cols)
+template <typename T, typename Allocator>
+inline std::size_t LinAlg::Matrix<T, Allocator>::check_cols_arg(std::size_t cols)
 {
     if (_rows != 0) {
         if (cols < max_cols() && cols > 0) {
@@ -686,8 +1289,8 @@ inline std::size_t LinAlg::Matrix<T>::check_cols_arg(std::size_t cols)
     }
 }
 
-template <typename T>
-inline std::size_t LinAlg::Matrix<T>::check_template_arg(std::size_t size)
+template <typename T, typename Allocator>
+inline std::size_t LinAlg::Matrix<T, Allocator>::check_template_arg(std::size_t size)
 {
     if (std::is_arithmetic<T>::value && !std::is_const<T>::value) {
         return size;
@@ -0,0 +1,300 @@
+#ifndef MATRIX_BATCH_HPP
+#define MATRIX_BATCH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "Allocator.hpp"
+#include "ExecutionPolicy.hpp"
+#include "FixedMatrix.hpp"
+#include "Matrix.hpp"
+#include "Kernels/batch.hpp"
+
+namespace LinAlg
+{
+    // count() matrices of equal shape in the interleaved layout of Kernels/batch.hpp:
+    // blocks of Kernels::batch_lanes matrices, each block storing one entry of all
+    // its matrices contiguously. The last block is padded to the full lane count.
+    // Operations vectorize across the batch instead of within a matrix, which is
+    // what keeps orders of 2 to 32 busy.
+    template <typename T>
+    class MatrixBatch
+    {
+    public:
+        typedef T value_type;
+        typedef std::vector<T, AlignedAllocator<T> > storage_type;
+
+        MatrixBatch();
+        MatrixBatch(std::size_t count, std::size_t rows, std::size_t cols);
+        MatrixBatch(std::size_t count, std::size_t rows, std::size_t cols, UninitializedTag);
+        template <std::size_t R, std::size_t C>
+        explicit MatrixBatch(const std::vector< FixedMatrix<T, R, C> >& matrices);
+
+        std::size_t count() const { return _count; }
+        std::size_t rows() const { return _rows; }
+        std::size_t cols() const { return _cols; }
+        bool square() const { return _rows == _cols; }
+        std::size_t blocks() const { return _blocks; }
+        // Number of elements of one block of Kernels::batch_lanes matrices.
+        std::size_t block_size() const { return _rows * _cols * Kernels::batch_lanes; }
+
+        T& operator()(std::size_t index, std::size_t row, std::size_t col) { return _batch[offset(index, row * _cols + col)]; }
+        const T& operator()(std::size_t index, std::size_t row, std::size_t col) const { return _batch[offset(index, row * _cols + col)]; }
+        T& at(std::size_t index, std::size_t row, std::size_t col);
+        const T& at(std::size_t index, std::size_t row, std::size_t col) const;
+
+        T* data() { return _batch.data(); }
+        const T* data() const { return _batch.data(); }
+
+        Matrix<T> get_matrix(std::size_t index) const;
+        template <std::size_t R, std::size_t C>
+        FixedMatrix<T, R, C> get_fixed(std::size_t index) const;
+        template <typename E>
+        void set_matrix(std::size_t index, const MatrixExpression<E>& matrix);
+
+        std::vector<T> determinants() const;
+
+    private:
+        std::size_t _count;
+        std::size_t _rows;
+        std::size_t _cols;
+        std::size_t _blocks;
+        storage_type _batch;
+
+        std::size_t offset(std::size_t index, std::size_t entry) const;
+        void check_index(std::size_t index) const;
+    };
+
+    // Batched C[i] = A[i] B[i].
+    template <typename T>
+    MatrixBatch<T> operator* (const MatrixBatch<T>& lhs, const MatrixBatch<T>& rhs);
+
+    template <typename T>
+    bool operator== (const MatrixBatch<T>& lhs, const MatrixBatch<T>& rhs);
+
+    namespace Detail
+    {
+        std::size_t batch_blocks(std::size_t count);
+
+        // Runs body(block) for every block index below blocks, in parallel when the
+        // batch is large enough. blockWork estimates the cost of one block.
+        template <typename F>
+        void batch_for(std::size_t blocks, std::size_t blockWork, F body);
+
+        // Factors every matrix of lu in place, see Kernels::batch_lu_factor.
+        template <typename T>
+        void batch_lu_factor(MatrixBatch<T>& lu, std::vector<std::size_t>& pivots, std::vector<unsigned char>& singular);
+
+        template <typename T>
+        std::vector<T> batch_lu_determinants(const MatrixBatch<T>& lu, const std::vector<std::size_t>& pivots);
+    }
+}
+
+inline std::size_t LinAlg::Detail::batch_blocks(std::size_t count)
+{
+    return (count + Kernels::batch_lanes - 1) / Kernels::batch_lanes;
+}
+
+template <typename F>
+inline void LinAlg::Detail::batch_for(std::size_t blocks, std::size_t blockWork, F body)
+{
+    const std::size_t grain = std::max<std::size_t>(1, (std::size_t(1) << 16) / std::max<std::size_t>(1, blockWork));
+    LinAlg::parallel_for(blocks * blockWork, 0, blocks, grain, [=](std::size_t first, std::size_t last) {
+        for (std::size_t block = first; block < last; ++block) { body(block); }
+    });
+}
+
+template <typename T>
+inline LinAlg::MatrixBatch<T>::MatrixBatch()
+    : _count(0), _rows(0), _cols(0), _blocks(0), _batch()
+{
+}
+
+template <typename T>
+inline LinAlg::MatrixBatch<T>::MatrixBatch(std::size_t count, std::size_t rows, std::size_t cols)
+    : _count(count), _rows(rows), _cols(cols), _blocks(Detail::batch_blocks(count)), _batch(rows * cols * Kernels::batch_lanes * _blocks, T())
+{
+}
+
+template <typename T>
+inline LinAlg::MatrixBatch<T>::MatrixBatch(std::size_t count, std::size_t rows, std::size_t cols, UninitializedTag)
+    : _count(count), _rows(rows), _cols(cols), _blocks(Detail::batch_blocks(count)), _batch()
+{
+    Detail::DefaultInitializationScope scope;
+    _batch.resize(rows * cols * Kernels::batch_lanes * _blocks);
+}
+
+template <typename T>
+template <std::size_t R, std::size_t C>
+inline LinAlg::MatrixBatch<T>::MatrixBatch(const std::vector< FixedMatrix<T, R, C> >& matrices)
+    : MatrixBatch(matrices.size(), R, C)
+{
+    for (std::size_t index = 0; index < _count; ++index) {
+        for (std::size_t e = 0; e < R * C; ++e) { _batch[offset(index, e)] = matrices[index].data()[e]; }
+    }
+}
+
+template <typename T>
+inline std::size_t LinAlg::MatrixBatch<T>::offset(std::size_t index, std::size_t entry) const
+{
+    return (index / Kernels::batch_lanes) * block_size() + entry * Kernels::batch_lanes + index % Kernels::batch_lanes;
+}
+
+template <typename T>
+inline void LinAlg::MatrixBatch<T>::check_index(std::size_t index) const
+{
+    if (index >= _count) { throw std::out_of_range("invalid Matrix batch subscript"); }
+}
+
+template <typename T>
+inline T& LinAlg::MatrixBatch<T>::at(std::size_t index, std::size_t row, std::size_t col)
+{
+    check_index(index);
+    if (row >= _rows) { throw std::out_of_range("invalid Matrix row subscript"); }
+    if (col >= _cols) { throw std::out_of_range("invalid Matrix column subscript"); }
+    return (*this)(index, row, col);
+}
+
+template <typename T>
+inline const T& LinAlg::MatrixBatch<T>::at(std::size_t index, std::size_t row, std::size_t col) const
+{
+    check_index(index);
+    if (row >= _rows) { throw std::out_of_range("invalid Matrix row subscript"); }
+    if (col >= _cols) { throw std::out_of_range("invalid Matrix column subscript"); }
+    return (*this)(index, row, col);
+}
+
+template <typename T>
+inline LinAlg::Matrix<T> LinAlg::MatrixBatch<T>::get_matrix(std::size_t index) const
+{
+    check_index(index);
+
+    Matrix<T> matrix(_rows, _cols, uninitialized);
+    for (std::size_t e = 0; e < _rows * _cols; ++e) { matrix.data()[e] = _batch[offset(index, e)]; }
+    return matrix;
+}
+
+template <typename T>
+template <std::size_t R, std::size_t C>
+inline LinAlg::FixedMatrix<T, R, C> LinAlg::MatrixBatch<T>::get_fixed(std::size_t index) const
+{
+    check_index(index);
+    if (R != _rows || C != _cols) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+    FixedMatrix<T, R, C> matrix;
+    for (std::size_t e = 0; e < R * C; ++e) { matrix.data()[e] = _batch[offset(index, e)]; }
+    return matrix;
+}
+
+template <typename T>
+template <typename E>
+inline void LinAlg::MatrixBatch<T>::set_matrix(std::size_t index, const MatrixExpression<E>& matrix)
+{
+    check_index(index);
+    if (matrix.rows() != _rows || matrix.cols() != _cols) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+    for (std::size_t i = 0; i < _rows; ++i) {
+        for (std::size_t j = 0; j < _cols; ++j) { (*this)(index, i, j) = matrix.derived()(i, j); }
+    }
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::MatrixBatch<T>::determinants() const
+{
+    if (!std::is_floating_point<T>::value) { throw std::invalid_argument("invalid Matrix template argument"); }
+    if (!square()) { throw std::invalid_argument("square Matrix required"); }
+
+    MatrixBatch<T> lu(*this);
+    std::vector<std::size_t> pivots;
+    std::vector<unsigned char> singular;
+    Detail::batch_lu_factor(lu, pivots, singular);
+
+    return Detail::batch_lu_determinants(lu, pivots);
+}
+
+template <typename T>
+inline void LinAlg::Detail::batch_lu_factor(MatrixBatch<T>& lu, std::vector<std::size_t>& pivots, std::vector<unsigned char>& singular)
+{
+    const std::size_t n = lu.rows();
+    const std::size_t lanes = Kernels::batch_lanes;
+    pivots.resize(n * lanes * lu.blocks());
+    singular.resize(lanes * lu.blocks());
+
+    T* factors = lu.data();
+    const std::size_t blockSize = lu.block_size();
+    std::size_t* pivotData = pivots.data();
+    unsigned char* singularData = singular.data();
+    Kernels::batch_dispatch(n, [&](auto order) {
+        typedef decltype(order) Order;
+        Detail::batch_for(lu.blocks(), n * n * n * lanes, [=](std::size_t block) {
+            Kernels::batch_lu_factor<Order::value>(n, factors + block * blockSize, pivotData + block * n * lanes, singularData + block * lanes);
+        });
+    });
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::Detail::batch_lu_determinants(const MatrixBatch<T>& lu, const std::vector<std::size_t>& pivots)
+{
+    const std::size_t n = lu.rows();
+    const std::size_t lanes = Kernels::batch_lanes;
+    std::vector<T> result(lanes * lu.blocks());
+
+    const T* factors = lu.data();
+    const std::size_t blockSize = lu.block_size();
+    const std::size_t* pivotData = pivots.data();
+    T* out = result.data();
+    Kernels::batch_dispatch(n, [&](auto order) {
+        typedef decltype(order) Order;
+        Detail::batch_for(lu.blocks(), n * lanes, [=](std::size_t block) {
+            Kernels::batch_lu_determinant<Order::value>(n, factors + block * blockSize, pivotData + block * n * lanes, out + block * lanes);
+        });
+    });
+    result.resize(lu.count());
+    return result;
+}
+
+template <typename T>
+inline LinAlg::MatrixBatch<T> LinAlg::operator* (const MatrixBatch<T>& lhs, const MatrixBatch<T>& rhs)
+{
+    if (lhs.count() != rhs.count() || lhs.cols() != rhs.rows()) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+    MatrixBatch<T> result(lhs.count(), lhs.rows(), rhs.cols(), uninitialized);
+    const std::size_t m = lhs.rows(), k = lhs.cols(), n = rhs.cols();
+    if (m * n == 0) { return result; }
+    if (k == 0) {
+        std::fill(result.data(), result.data() + result.block_size() * result.blocks(), T());
+        return result;
+    }
+
+    const T* a = lhs.data();
+    const T* b = rhs.data();
+    T* c = result.data();
+    const std::size_t aSize = lhs.block_size(), bSize = rhs.block_size(), cSize = result.block_size();
+    Kernels::batch_dispatch(m == k && k == n ? n : 0, [&](auto order) {
+        typedef decltype(order) Order;
+        Detail::batch_for(result.blocks(), m * n * k * Kernels::batch_lanes, [=](std::size_t block) {
+            Kernels::batch_gemm<Order::value, Order::value, Order::value>(m, k, n, a + block * aSize, b + block * bSize, c + block * cSize);
+        });
+    });
+    return result;
+}
+
+template <typename T>
+inline bool LinAlg::operator== (const MatrixBatch<T>& lhs, const MatrixBatch<T>& rhs)
+{
+    if (lhs.count() != rhs.count() || lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols()) { return false; }
+
+    for (std::size_t index = 0; index < lhs.count(); ++index) {
+        for (std::size_t i = 0; i < lhs.rows(); ++i) {
+            for (std::size_t j = 0; j < lhs.cols(); ++j) {
+                if (!Kernels::are_equal(lhs(index, i, j), rhs(index, i, j))) { return false; }
+            }
+        }
+    }
+    return true;
+}
+
+#endif // MATRIX_BATCH_HPP
@@ -0,0 +1,240 @@
+#ifndef MATRIX_EXPRESSION_HPP
+#define MATRIX_EXPRESSION_HPP
+
+#include <cstddef>
+#include <stdexcept>
+
+#include "Allocator.hpp"
+#include "Kernels/elementwise.hpp"
+
+namespace LinAlg
+{
+    template <typename T, typename Allocator = AlignedAllocator<T> >
+    class Matrix;
+
+    // Base of every lazily evaluated element-wise expression. Derived types
+    // provide value_type, rows(), cols() and an element accessor operator()(row, col).
+    template <typename E>
+    class MatrixExpression
+    {
+    public:
+        const E& derived() const { return static_cast<const E&>(*this); }
+
+        std::size_t rows() const { return derived().rows(); }
+        std::size_t cols() const { return derived().cols(); }
+
+    protected:
+        MatrixExpression() = default;
+        MatrixExpression(const MatrixExpression&) = default;
+        MatrixExpression& operator= (const MatrixExpression&) = default;
+        ~MatrixExpression() = default;
+    };
+
+    // Matrix operands are held by reference, nested expressions by value.
+    template <typename E>
+    struct ExpressionOperand
+    {
+        typedef const E type;
+    };
+
+    template <typename T, typename Allocator>
+    struct ExpressionOperand< Matrix<T, Allocator> >
+    {
+        typedef const Matrix<T, Allocator>& type;
+    };
+
+    // Whether element (i, j) of the expression reads only element (i, j) of its
+    // operands, so it can be evaluated straight into one of them.
+    template <typename E>
+    struct InPlaceEvaluable
+    {
+        static const bool value = true;
+    };
+
+    struct Plus
+    {
+        template <typename T>
+        T operator() (T lhs, T rhs) const { return lhs + rhs; }
+    };
+
+    struct Minus
+    {
+        template <typename T>
+        T operator() (T lhs, T rhs) const { return lhs - rhs; }
+    };
+
+    struct Multiplies
+    {
+        template <typename T>
+        T operator() (T lhs, T rhs) const { return lhs * rhs; }
+    };
+
+    struct Divides
+    {
+        template <typename T>
+        T operator() (T lhs, T rhs) const { return lhs / rhs; }
+    };
+
+    struct Negate
+    {
+        template <typename T>
+        T operator() (T value) const { return -value; }
+    };
+
+    template <typename Op, typename L, typename R>
+    class MatrixBinaryExpression : public MatrixExpression< MatrixBinaryExpression<Op, L, R> >
+    {
+    public:
+        typedef typename L::value_type value_type;
+
+        MatrixBinaryExpression(const L& lhs, const R& rhs);
+
+        std::size_t rows() const { return _lhs.rows(); }
+        std::size_t cols() const { return _lhs.cols(); }
+        value_type operator() (std::size_t row, std::size_t col) const { return Op()(_lhs(row, col), _rhs(row, col)); }
+
+        const L& lhs() const { return _lhs; }
+        const R& rhs() const { return _rhs; }
+
+    private:
+        typename ExpressionOperand<L>::type _lhs;
+        typename ExpressionOperand<R>::type _rhs;
+    };
+
+    // Applies Op(element, value) to every element of the operand.
+    template <typename Op, typename E>
+    class MatrixScalarExpression : public MatrixExpression< MatrixScalarExpression<Op, E> >
+    {
+    public:
+        typedef typename E::value_type value_type;
+
+        MatrixScalarExpression(const E& operand, value_type value) : _operand(operand), _value(value) {}
+
+        std::size_t rows() const { return _operand.rows(); }
+        std::size_t cols() const { return _operand.cols(); }
+        value_type operator() (std::size_t row, std::size_t col) const { return Op()(_operand(row, col), _value); }
+
+        const E& operand() const { return _operand; }
+        value_type value() const { return _value; }
+
+    private:
+        typename ExpressionOperand<E>::type _operand;
+        value_type _value;
+    };
+
+    template <typename Op, typename E>
+    class MatrixUnaryExpression : public MatrixExpression< MatrixUnaryExpression<Op, E> >
+    {
+    public:
+        typedef typename E::value_type value_type;
+
+        explicit MatrixUnaryExpression(const E& operand) : _operand(operand) {}
+
+        std::size_t rows() const { return _operand.rows(); }
+        std::size_t cols() const { return _operand.cols(); }
+        value_type operator() (std::size_t row, std::size_t col) const { return Op()(_operand(row, col)); }
+
+        const E& operand() const { return _operand; }
+
+    private:
+        typename ExpressionOperand<E>::type _operand;
+    };
+
+    template <typename Op, typename L, typename R>
+    struct InPlaceEvaluable< MatrixBinaryExpression<Op, L, R> >
+    {
+        static const bool value = InPlaceEvaluable<L>::value && InPlaceEvaluable<R>::value;
+    };
+
+    template <typename Op, typename E>
+    struct InPlaceEvaluable< MatrixScalarExpression<Op, E> >
+    {
+        static const bool value = InPlaceEvaluable<E>::value;
+    };
+
+    template <typename Op, typename E>
+    struct InPlaceEvaluable< MatrixUnaryExpression<Op, E> >
+    {
+        static const bool value = InPlaceEvaluable<E>::value;
+    };
+
+    template <typename L, typename R>
+    MatrixBinaryExpression<Plus, L, R> operator+ (const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs);
+
+    template <typename L, typename R>
+    MatrixBinaryExpression<Minus, L, R> operator- (const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs);
+
+    template <typename E>
+    MatrixUnaryExpression<Negate, E> operator- (const MatrixExpression<E>& operand);
+
+    template <typename E>
+    MatrixScalarExpression<Multiplies, E> operator* (const MatrixExpression<E>& operand, typename E::value_type value);
+
+    template <typename E>
+    MatrixScalarExpression<Multiplies, E> operator* (typename E::value_type value, const MatrixExpression<E>& operand);
+
+    template <typename E>
+    MatrixScalarExpression<Divides, E> operator/ (const MatrixExpression<E>& operand, typename E::value_type value);
+
+    template <typename L, typename R>
+    bool operator== (const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs);
+}
+
+template <typename Op, typename L, typename R>
+inline LinAlg::MatrixBinaryExpression<Op, L, R>::MatrixBinaryExpression(const L& lhs, const R& rhs)
+    : _lhs(lhs), _rhs(rhs)
+{
+    if (lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols()) { throw std::invalid_argument("invalid Matrix argument size"); }
+}
+
+template <typename L, typename R>
+inline LinAlg::MatrixBinaryExpression<LinAlg::Plus, L, R> LinAlg::operator+ (const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs)
+{
+    return MatrixBinaryExpression<Plus, L, R>(lhs.derived(), rhs.derived());
+}
+
+template <typename L, typename R>
+inline LinAlg::MatrixBinaryExpression<LinAlg::Minus, L, R> LinAlg::operator- (const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs)
+{
+    return MatrixBinaryExpression<Minus, L, R>(lhs.derived(), rhs.derived());
+}
+
+template <typename E>
+inline LinAlg::MatrixUnaryExpression<LinAlg::Negate, E> LinAlg::operator- (const MatrixExpression<E>& operand)
+{
+    return MatrixUnaryExpression<Negate, E>(operand.derived());
+}
+
+template <typename E>
+inline LinAlg::MatrixScalarExpression<LinAlg::Multiplies, E> LinAlg::operator* (const MatrixExpression<E>& operand, typename E::value_type value)
+{
+    return MatrixScalarExpression<Multiplies, E>(operand.derived(), value);
+}
+
+template <typename E>
+inline LinAlg::MatrixScalarExpression<LinAlg::Multiplies, E> LinAlg::operator* (typename E::value_type value, const MatrixExpression<E>& operand)
+{
+    return MatrixScalarExpression<Multiplies, E>(operand.derived(), value);
+}
+
+template <typename E>
+inline LinAlg::MatrixScalarExpression<LinAlg::Divides, E> LinAlg::operator/ (const MatrixExpression<E>& operand, typename E::value_type value)
+{
+    if (value == typename E::value_type()) { throw std::invalid_argument("Matrix division by zero"); }
+    return MatrixScalarExpression<Divides, E>(operand.derived(), value);
+}
+
+template <typename L, typename R>
+inline bool LinAlg::operator== (const MatrixExpression<L>& lhs, const MatrixExpression<R>& rhs)
+{
+    if (lhs.rows() != rhs.rows() || lhs.cols() != rhs.cols()) { return false; }
+
+    for (std::size_t i = 0; i < lhs.rows(); ++i) {
+        for (std::size_t j = 0; j < lhs.cols(); ++j) {
+            if (!LinAlg::Kernels::are_equal<typename L::value_type>(lhs.derived()(i, j), rhs.derived()(i, j))) { return false; }
+        }
+    }
+    return true;
+}
+
+#endif // MATRIX_EXPRESSION_HPP
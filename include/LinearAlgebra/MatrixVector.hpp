@@ -0,0 +1,144 @@
+#ifndef MATRIX_VECTOR_HPP
+#define MATRIX_VECTOR_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "Matrix.hpp"
+#include "Kernels/gemv.hpp"
+
+namespace LinAlg
+{
+    enum class Triangle { lower, upper };
+    enum class Diagonal { non_unit, unit };
+
+    // Level 2 operations between a Matrix and vectors. The pointer overloads take
+    // caller-owned buffers of the implied lengths and allocate nothing; the
+    // std::vector overloads check the lengths first. Outputs must not overlap
+    // the inputs, and y is never read when beta is zero.
+
+    // y = alpha * A * x + beta * y
+    template <typename T, typename A>
+    void gemv(typename Matrix<T, A>::value_type alpha, const Matrix<T, A>& a, const T* x, typename Matrix<T, A>::value_type beta, T* y);
+
+    template <typename T, typename A>
+    void gemv(typename Matrix<T, A>::value_type alpha, const Matrix<T, A>& a, const std::vector<T>& x, typename Matrix<T, A>::value_type beta, std::vector<T>& y);
+
+    // y = alpha * A^T * x + beta * y
+    template <typename T, typename A>
+    void gemv_transposed(typename Matrix<T, A>::value_type alpha, const Matrix<T, A>& a, const T* x, typename Matrix<T, A>::value_type beta, T* y);
+
+    template <typename T, typename A>
+    void gemv_transposed(typename Matrix<T, A>::value_type alpha, const Matrix<T, A>& a, const std::vector<T>& x, typename Matrix<T, A>::value_type beta, std::vector<T>& y);
+
+    // A += alpha * x * y^T
+    template <typename T, typename A>
+    void ger(typename Matrix<T, A>::value_type alpha, const T* x, const T* y, Matrix<T, A>& a);
+
+    template <typename T, typename A>
+    void ger(typename Matrix<T, A>::value_type alpha, const std::vector<T>& x, const std::vector<T>& y, Matrix<T, A>& a);
+
+    // Solves T x = b in place for the selected triangle of a square Matrix.
+    template <typename T, typename A>
+    void trsv(Triangle triangle, Diagonal diagonal, const Matrix<T, A>& a, T* x);
+
+    template <typename T, typename A>
+    void trsv(Triangle triangle, Diagonal diagonal, const Matrix<T, A>& a, std::vector<T>& x);
+
+    // y = alpha * A * x + beta * y for symmetric A, reading only its lower triangle.
+    template <typename T, typename A>
+    void symv(typename Matrix<T, A>::value_type alpha, const Matrix<T, A>& a, const T* x, typename Matrix<T, A>::value_type beta, T* y);
+
+    template <typename T, typename A>
+    void symv(typename Matrix<T, A>::value_type alpha, const Matrix<T, A>& a, const std::vector<T>& x, typename Matrix<T, A>::value_type beta, std::vector<T>& y);
+
+    template <typename T, typename A>
+    std::vector<T> operator* (const Matrix<T, A>& lhs, const std::vector<T>& rhs);
+}
+
+template <typename T, typename A>
+inline void LinAlg::gemv(typename Matrix<T, A>::value_type alpha, const Matrix<T, A>& a, const T* x, typename Matrix<T, A>::value_type beta, T* y)
+{
+    LINALG_INSTRUMENT_OPERATION(Operation::matrix_vector, 2 * a.vector_size(), (a.vector_size() + a.rows() + a.cols()) * sizeof(T));
+    Kernels::gemv(a.rows(), a.cols(), alpha, a.data(), a.cols(), x, beta, y);
+}
+
+template <typename T, typename A>
+inline void LinAlg::gemv(typename Matrix<T, A>::value_type alpha, const Matrix<T, A>& a, const std::vector<T>& x, typename Matrix<T, A>::value_type beta, std::vector<T>& y)
+{
+    if (x.size() != a.cols() || y.size() != a.rows()) { throw std::invalid_argument("invalid Matrix argument size"); }
+    gemv(alpha, a, x.data(), beta, y.data());
+}
+
+template <typename T, typename A>
+inline void LinAlg::gemv_transposed(typename Matrix<T, A>::value_type alpha, const Matrix<T, A>& a, const T* x, typename Matrix<T, A>::value_type beta, T* y)
+{
+    LINALG_INSTRUMENT_OPERATION(Operation::matrix_vector, 2 * a.vector_size(), (a.vector_size() + a.rows() + a.cols()) * sizeof(T));
+    Kernels::gemv_transposed(a.rows(), a.cols(), alpha, a.data(), a.cols(), x, beta, y);
+}
+
+template <typename T, typename A>
+inline void LinAlg::gemv_transposed(typename Matrix<T, A>::value_type alpha, const Matrix<T, A>& a, const std::vector<T>& x, typename Matrix<T, A>::value_type beta, std::vector<T>& y)
+{
+    if (x.size() != a.rows() || y.size() != a.cols()) { throw std::invalid_argument("invalid Matrix argument size"); }
+    gemv_transposed(alpha, a, x.data(), beta, y.data());
+}
+
+template <typename T, typename A>
+inline void LinAlg::ger(typename Matrix<T, A>::value_type alpha, const T* x, const T* y, Matrix<T, A>& a)
+{
+    LINALG_INSTRUMENT_OPERATION(Operation::matrix_vector, 2 * a.vector_size(), (2 * a.vector_size() + a.rows() + a.cols()) * sizeof(T));
+    Kernels::ger(a.rows(), a.cols(), alpha, x, y, a.data(), a.cols());
+}
+
+template <typename T, typename A>
+inline void LinAlg::ger(typename Matrix<T, A>::value_type alpha, const std::vector<T>& x, const std::vector<T>& y, Matrix<T, A>& a)
+{
+    if (x.size() != a.rows() || y.size() != a.cols()) { throw std::invalid_argument("invalid Matrix argument size"); }
+    ger(alpha, x.data(), y.data(), a);
+}
+
+template <typename T, typename A>
+inline void LinAlg::trsv(Triangle triangle, Diagonal diagonal, const Matrix<T, A>& a, T* x)
+{
+    if (!a.square()) { throw std::invalid_argument("square Matrix required"); }
+
+    LINALG_INSTRUMENT_OPERATION(Operation::matrix_vector, a.vector_size(), (a.vector_size() / 2 + 2 * a.rows()) * sizeof(T));
+    Kernels::trsv(triangle == Triangle::lower, diagonal == Diagonal::unit, a.rows(), a.data(), a.cols(), x);
+}
+
+template <typename T, typename A>
+inline void LinAlg::trsv(Triangle triangle, Diagonal diagonal, const Matrix<T, A>& a, std::vector<T>& x)
+{
+    if (x.size() != a.rows()) { throw std::invalid_argument("invalid Matrix argument size"); }
+    trsv(triangle, diagonal, a, x.data());
+}
+
+template <typename T, typename A>
+inline void LinAlg::symv(typename Matrix<T, A>::value_type alpha, const Matrix<T, A>& a, const T* x, typename Matrix<T, A>::value_type beta, T* y)
+{
+    if (!a.square()) { throw std::invalid_argument("square Matrix required"); }
+
+    LINALG_INSTRUMENT_OPERATION(Operation::matrix_vector, 2 * a.vector_size(), (a.vector_size() / 2 + 2 * a.rows()) * sizeof(T));
+    Kernels::symv(a.rows(), alpha, a.data(), a.cols(), x, beta, y);
+}
+
+template <typename T, typename A>
+inline void LinAlg::symv(typename Matrix<T, A>::value_type alpha, const Matrix<T, A>& a, const std::vector<T>& x, typename Matrix<T, A>::value_type beta, std::vector<T>& y)
+{
+    if (x.size() != a.cols() || y.size() != a.rows()) { throw std::invalid_argument("invalid Matrix argument size"); }
+    symv(alpha, a, x.data(), beta, y.data());
+}
+
+template <typename T, typename A>
+inline std::vector<T> LinAlg::operator* (const Matrix<T, A>& lhs, const std::vector<T>& rhs)
+{
+    if (lhs.cols() != rhs.size()) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+    std::vector<T> result(lhs.rows());
+    gemv(T(1), lhs, rhs.data(), T(), result.data());
+    return result;
+}
+
+#endif // MATRIX_VECTOR_HPP
@@ -0,0 +1,433 @@
+#ifndef MATRIX_VIEW_HPP
+#define MATRIX_VIEW_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+
+#include "ExecutionPolicy.hpp"
+#include "MatrixExpression.hpp"
+
+namespace LinAlg
+{
+    template <typename T, typename Allocator>
+    class Matrix;
+
+    template <typename T, std::size_t R, std::size_t C>
+    class FixedMatrix;
+
+    template <typename T>
+    class MatrixView;
+
+    // Non-owning read-only window over strided storage. Element (i, j) lives at
+    // data[i * rowStride + j * colStride]; a transposed view just swaps strides.
+    template <typename T>
+    class ConstMatrixView : public MatrixExpression< ConstMatrixView<T> >
+    {
+    public:
+        typedef T value_type;
+
+        ConstMatrixView(const T* data, std::size_t rows, std::size_t cols)
+            : _data(data), _rows(rows), _cols(cols), _rowStride(static_cast<std::ptrdiff_t>(cols)), _colStride(1) {}
+        ConstMatrixView(const T* data, std::size_t rows, std::size_t cols, std::ptrdiff_t rowStride, std::ptrdiff_t colStride)
+            : _data(data), _rows(rows), _cols(cols), _rowStride(rowStride), _colStride(colStride) {}
+        template <typename Allocator>
+        ConstMatrixView(const Matrix<T, Allocator>& matrix);
+        ConstMatrixView(const MatrixView<T>& view);
+
+        std::size_t rows() const { return _rows; }
+        std::size_t cols() const { return _cols; }
+        std::ptrdiff_t row_stride() const { return _rowStride; }
+        std::ptrdiff_t col_stride() const { return _colStride; }
+        const T* data() const { return _data; }
+        bool contiguous_rows() const { return _colStride == 1; }
+
+        const T& operator()(std::size_t row, std::size_t col) const
+        {
+            return _data[static_cast<std::ptrdiff_t>(row) * _rowStride + static_cast<std::ptrdiff_t>(col) * _colStride];
+        }
+        const T& at(std::size_t row, std::size_t col) const;
+
+        ConstMatrixView<T> row(std::size_t row) const;
+        ConstMatrixView<T> col(std::size_t col) const;
+        ConstMatrixView<T> block(std::size_t row, std::size_t col, std::size_t rows, std::size_t cols) const;
+        ConstMatrixView<T> transposed() const { return ConstMatrixView<T>(_data, _cols, _rows, _colStride, _rowStride); }
+
+    private:
+        const T* _data;
+        std::size_t _rows;
+        std::size_t _cols;
+        std::ptrdiff_t _rowStride;
+        std::ptrdiff_t _colStride;
+    };
+
+    // Mutable counterpart of ConstMatrixView. Copying a view copies the window,
+    // assigning to it writes through to the viewed elements.
+    template <typename T>
+    class MatrixView : public MatrixExpression< MatrixView<T> >
+    {
+    public:
+        typedef T value_type;
+
+        MatrixView(T* data, std::size_t rows, std::size_t cols)
+            : _data(data), _rows(rows), _cols(cols), _rowStride(static_cast<std::ptrdiff_t>(cols)), _colStride(1) {}
+        MatrixView(T* data, std::size_t rows, std::size_t cols, std::ptrdiff_t rowStride, std::ptrdiff_t colStride)
+            : _data(data), _rows(rows), _cols(cols), _rowStride(rowStride), _colStride(colStride) {}
+        template <typename Allocator>
+        MatrixView(Matrix<T, Allocator>& matrix);
+        MatrixView(const MatrixView<T>& other) = default;
+
+        MatrixView<T>& operator= (const MatrixView<T>& other);
+        template <typename E>
+        MatrixView<T>& operator= (const MatrixExpression<E>& expression);
+        template <typename E>
+        MatrixView<T>& operator+= (const MatrixExpression<E>& expression);
+        template <typename E>
+        MatrixView<T>& operator-= (const MatrixExpression<E>& expression);
+        MatrixView<T>& operator*= (T value);
+        MatrixView<T>& operator/= (T value);
+
+        std::size_t rows() const { return _rows; }
+        std::size_t cols() const { return _cols; }
+        std::ptrdiff_t row_stride() const { return _rowStride; }
+        std::ptrdiff_t col_stride() const { return _colStride; }
+        T* data() const { return _data; }
+        bool contiguous_rows() const { return _colStride == 1; }
+
+        T& operator()(std::size_t row, std::size_t col) const
+        {
+            return _data[static_cast<std::ptrdiff_t>(row) * _rowStride + static_cast<std::ptrdiff_t>(col) * _colStride];
+        }
+        T& at(std::size_t row, std::size_t col) const;
+
+        void fill(T value);
+
+        MatrixView<T> row(std::size_t row) const;
+        MatrixView<T> col(std::size_t col) const;
+        MatrixView<T> block(std::size_t row, std::size_t col, std::size_t rows, std::size_t cols) const;
+        MatrixView<T> transposed() const { return MatrixView<T>(_data, _cols, _rows, _colStride, _rowStride); }
+
+    private:
+        T* _data;
+        std::size_t _rows;
+        std::size_t _cols;
+        std::ptrdiff_t _rowStride;
+        std::ptrdiff_t _colStride;
+
+        template <typename E, typename Op>
+        void apply(const E& expression, Op op);
+    };
+
+    // A view may alias the destination with a different layout, e.g. A = A.transposed().
+    template <typename T>
+    struct InPlaceEvaluable< ConstMatrixView<T> >
+    {
+        static const bool value = false;
+    };
+
+    template <typename T>
+    struct InPlaceEvaluable< MatrixView<T> >
+    {
+        static const bool value = false;
+    };
+
+    namespace Detail
+    {
+        const std::size_t view_row_grain = 16;
+
+        template <typename T>
+        struct Assign
+        {
+            void operator() (T& target, T value) const { target = value; }
+        };
+
+        template <typename T>
+        struct AddAssign
+        {
+            void operator() (T& target, T value) const { target += value; }
+        };
+
+        template <typename T>
+        struct SubtractAssign
+        {
+            void operator() (T& target, T value) const { target -= value; }
+        };
+
+        // [begin, end) spans every element a Matrix or view operand touches.
+        template <typename T>
+        struct StorageRange
+        {
+            const T* begin;
+            const T* end;
+
+            bool overlaps(const StorageRange& other) const
+            {
+                return std::less<const T*>()(begin, other.end) && std::less<const T*>()(other.begin, end);
+            }
+        };
+
+        template <typename T>
+        StorageRange<T> storage_range(const T* data, std::size_t rows, std::size_t cols, std::ptrdiff_t rowStride, std::ptrdiff_t colStride);
+
+        // Whether an expression may read storage in range. Operands of unknown
+        // kind are assumed to, so that assigning them to a view goes through a
+        // temporary.
+        template <typename E, typename T>
+        bool may_alias(const E& expression, const StorageRange<T>& range);
+
+        template <typename T, typename Allocator>
+        bool may_alias(const Matrix<T, Allocator>& matrix, const StorageRange<T>& range);
+
+        template <typename T, std::size_t R, std::size_t C>
+        bool may_alias(const FixedMatrix<T, R, C>& matrix, const StorageRange<T>& range);
+
+        template <typename T>
+        bool may_alias(const ConstMatrixView<T>& view, const StorageRange<T>& range);
+
+        template <typename T>
+        bool may_alias(const MatrixView<T>& view, const StorageRange<T>& range);
+
+        template <typename Op, typename L, typename R, typename T>
+        bool may_alias(const MatrixBinaryExpression<Op, L, R>& expression, const StorageRange<T>& range);
+
+        template <typename Op, typename E, typename T>
+        bool may_alias(const MatrixScalarExpression<Op, E>& expression, const StorageRange<T>& range);
+
+        template <typename Op, typename E, typename T>
+        bool may_alias(const MatrixUnaryExpression<Op, E>& expression, const StorageRange<T>& range);
+
+        inline void check_block(std::size_t row, std::size_t col, std::size_t rows, std::size_t cols, std::size_t totalRows, std::size_t totalCols)
+        {
+            if (row > totalRows || rows > totalRows - row) { throw std::out_of_range("invalid Matrix row subscript"); }
+            if (col > totalCols || cols > totalCols - col) { throw std::out_of_range("invalid Matrix column subscript"); }
+        }
+    }
+}
+
+template <typename T>
+inline LinAlg::Detail::StorageRange<T> LinAlg::Detail::storage_range(const T* data, std::size_t rows, std::size_t cols,
+                                                                     std::ptrdiff_t rowStride, std::ptrdiff_t colStride)
+{
+    if (rows == 0 || cols == 0) { return StorageRange<T>{ data, data }; }
+
+    const std::ptrdiff_t rowExtent = static_cast<std::ptrdiff_t>(rows - 1) * rowStride;
+    const std::ptrdiff_t colExtent = static_cast<std::ptrdiff_t>(cols - 1) * colStride;
+    const std::ptrdiff_t first = std::min<std::ptrdiff_t>(rowExtent, 0) + std::min<std::ptrdiff_t>(colExtent, 0);
+    const std::ptrdiff_t last = std::max<std::ptrdiff_t>(rowExtent, 0) + std::max<std::ptrdiff_t>(colExtent, 0);
+    return StorageRange<T>{ data + first, data + last + 1 };
+}
+
+template <typename E, typename T>
+inline bool LinAlg::Detail::may_alias(const E&, const StorageRange<T>&)
+{
+    return true;
+}
+
+template <typename T, typename Allocator>
+inline bool LinAlg::Detail::may_alias(const Matrix<T, Allocator>& matrix, const StorageRange<T>& range)
+{
+    return storage_range<T>(matrix.data(), matrix.rows(), matrix.cols(), static_cast<std::ptrdiff_t>(matrix.cols()), 1).overlaps(range);
+}
+
+template <typename T, std::size_t R, std::size_t C>
+inline bool LinAlg::Detail::may_alias(const FixedMatrix<T, R, C>& matrix, const StorageRange<T>& range)
+{
+    return storage_range<T>(matrix.data(), R, C, static_cast<std::ptrdiff_t>(C), 1).overlaps(range);
+}
+
+template <typename T>
+inline bool LinAlg::Detail::may_alias(const ConstMatrixView<T>& view, const StorageRange<T>& range)
+{
+    return storage_range<T>(view.data(), view.rows(), view.cols(), view.row_stride(), view.col_stride()).overlaps(range);
+}
+
+template <typename T>
+inline bool LinAlg::Detail::may_alias(const MatrixView<T>& view, const StorageRange<T>& range)
+{
+    return storage_range<T>(view.data(), view.rows(), view.cols(), view.row_stride(), view.col_stride()).overlaps(range);
+}
+
+template <typename Op, typename L, typename R, typename T>
+inline bool LinAlg::Detail::may_alias(const MatrixBinaryExpression<Op, L, R>& expression, const StorageRange<T>& range)
+{
+    return may_alias(expression.lhs(), range) || may_alias(expression.rhs(), range);
+}
+
+template <typename Op, typename E, typename T>
+inline bool LinAlg::Detail::may_alias(const MatrixScalarExpression<Op, E>& expression, const StorageRange<T>& range)
+{
+    return may_alias(expression.operand(), range);
+}
+
+template <typename Op, typename E, typename T>
+inline bool LinAlg::Detail::may_alias(const MatrixUnaryExpression<Op, E>& expression, const StorageRange<T>& range)
+{
+    return may_alias(expression.operand(), range);
+}
+
+template <typename T>
+template <typename Allocator>
+inline LinAlg::ConstMatrixView<T>::ConstMatrixView(const Matrix<T, Allocator>& matrix)
+    : _data(matrix.data()), _rows(matrix.rows()), _cols(matrix.cols()),
+      _rowStride(static_cast<std::ptrdiff_t>(matrix.cols())), _colStride(1)
+{
+}
+
+template <typename T>
+inline LinAlg::ConstMatrixView<T>::ConstMatrixView(const MatrixView<T>& view)
+    : _data(view.data()), _rows(view.rows()), _cols(view.cols()), _rowStride(view.row_stride()), _colStride(view.col_stride())
+{
+}
+
+template <typename T>
+inline const T& LinAlg::ConstMatrixView<T>::at(std::size_t row, std::size_t col) const
+{
+    if (row >= _rows) { throw std::out_of_range("invalid Matrix row subscript"); }
+    if (col >= _cols) { throw std::out_of_range("invalid Matrix column subscript"); }
+
+    return (*this)(row, col);
+}
+
+template <typename T>
+inline LinAlg::ConstMatrixView<T> LinAlg::ConstMatrixView<T>::row(std::size_t row) const
+{
+    return block(row, 0, 1, _cols);
+}
+
+template <typename T>
+inline LinAlg::ConstMatrixView<T> LinAlg::ConstMatrixView<T>::col(std::size_t col) const
+{
+    return block(0, col, _rows, 1);
+}
+
+template <typename T>
+inline LinAlg::ConstMatrixView<T> LinAlg::ConstMatrixView<T>::block(std::size_t row, std::size_t col, std::size_t rows, std::size_t cols) const
+{
+    LinAlg::Detail::check_block(row, col, rows, cols, _rows, _cols);
+
+    const T* origin = _data + static_cast<std::ptrdiff_t>(row) * _rowStride + static_cast<std::ptrdiff_t>(col) * _colStride;
+    return ConstMatrixView<T>(origin, rows, cols, _rowStride, _colStride);
+}
+
+template <typename T>
+template <typename Allocator>
+inline LinAlg::MatrixView<T>::MatrixView(Matrix<T, Allocator>& matrix)
+    : _data(matrix.data()), _rows(matrix.rows()), _cols(matrix.cols()),
+      _rowStride(static_cast<std::ptrdiff_t>(matrix.cols())), _colStride(1)
+{
+}
+
+template <typename T>
+inline LinAlg::MatrixView<T>& LinAlg::MatrixView<T>::operator= (const MatrixView<T>& other)
+{
+    return *this = static_cast<const MatrixExpression< MatrixView<T> >&>(other);
+}
+
+template <typename T>
+template <typename E>
+inline LinAlg::MatrixView<T>& LinAlg::MatrixView<T>::operator= (const MatrixExpression<E>& expression)
+{
+    apply(expression.derived(), LinAlg::Detail::Assign<T>());
+    return *this;
+}
+
+template <typename T>
+template <typename E>
+inline LinAlg::MatrixView<T>& LinAlg::MatrixView<T>::operator+= (const MatrixExpression<E>& expression)
+{
+    apply(expression.derived(), LinAlg::Detail::AddAssign<T>());
+    return *this;
+}
+
+template <typename T>
+template <typename E>
+inline LinAlg::MatrixView<T>& LinAlg::MatrixView<T>::operator-= (const MatrixExpression<E>& expression)
+{
+    apply(expression.derived(), LinAlg::Detail::SubtractAssign<T>());
+    return *this;
+}
+
+template <typename T>
+inline LinAlg::MatrixView<T>& LinAlg::MatrixView<T>::operator*= (T value)
+{
+    for (std::size_t i = 0; i < _rows; ++i) {
+        for (std::size_t j = 0; j < _cols; ++j) { (*this)(i, j) *= value; }
+    }
+    return *this;
+}
+
+template <typename T>
+inline LinAlg::MatrixView<T>& LinAlg::MatrixView<T>::operator/= (T value)
+{
+    if (value == T()) { throw std::invalid_argument("Matrix division by zero"); }
+
+    for (std::size_t i = 0; i < _rows; ++i) {
+        for (std::size_t j = 0; j < _cols; ++j) { (*this)(i, j) /= value; }
+    }
+    return *this;
+}
+
+template <typename T>
+template <typename E, typename Op>
+inline void LinAlg::MatrixView<T>::apply(const E& expression, Op op)
+{
+    if (expression.rows() != _rows || expression.cols() != _cols) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+    // Operands reading storage the view writes are evaluated first: unlike a
+    // whole Matrix, the view may cover it with another layout or offset.
+    const LinAlg::Detail::StorageRange<T> range = LinAlg::Detail::storage_range<T>(_data, _rows, _cols, _rowStride, _colStride);
+    if (LinAlg::Detail::may_alias(expression, range)) {
+        const Matrix<T> tempMatrix(expression);
+        apply(tempMatrix, op);
+        return;
+    }
+
+    const MatrixView<T> target(*this);
+    const E& source = expression.derived();
+    LinAlg::parallel_for(_rows * _cols, 0, _rows, LinAlg::Detail::view_row_grain, [&target, &source, op](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            for (std::size_t j = 0; j < target.cols(); ++j) { op(target(i, j), source(i, j)); }
+        }
+    });
+}
+
+template <typename T>
+inline T& LinAlg::MatrixView<T>::at(std::size_t row, std::size_t col) const
+{
+    if (row >= _rows) { throw std::out_of_range("invalid Matrix row subscript"); }
+    if (col >= _cols) { throw std::out_of_range("invalid Matrix column subscript"); }
+
+    return (*this)(row, col);
+}
+
+template <typename T>
+inline void LinAlg::MatrixView<T>::fill(T value)
+{
+    for (std::size_t i = 0; i < _rows; ++i) {
+        for (std::size_t j = 0; j < _cols; ++j) { (*this)(i, j) = value; }
+    }
+}
+
+template <typename T>
+inline LinAlg::MatrixView<T> LinAlg::MatrixView<T>::row(std::size_t row) const
+{
+    return block(row, 0, 1, _cols);
+}
+
+template <typename T>
+inline LinAlg::MatrixView<T> LinAlg::MatrixView<T>::col(std::size_t col) const
+{
+    return block(0, col, _rows, 1);
+}
+
+template <typename T>
+inline LinAlg::MatrixView<T> LinAlg::MatrixView<T>::block(std::size_t row, std::size_t col, std::size_t rows, std::size_t cols) const
+{
+    LinAlg::Detail::check_block(row, col, rows, cols, _rows, _cols);
+
+    T* origin = _data + static_cast<std::ptrdiff_t>(row) * _rowStride + static_cast<std::ptrdiff_t>(col) * _colStride;
+    return MatrixView<T>(origin, rows, cols, _rowStride, _colStride);
+}
+
+#endif // MATRIX_VIEW_HPP
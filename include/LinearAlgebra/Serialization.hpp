@@ -0,0 +1,478 @@
+#ifndef SERIALIZATION_HPP
+#define SERIALIZATION_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "Matrix.hpp"
+#include "MatrixView.hpp"
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace LinAlg
+{
+    // Binary Matrix file: a 64 byte header followed by the row-major elements.
+    //
+    //   offset  size  field
+    //        0     4  magic "LAMX"
+    //        4     2  format version, currently 1
+    //        6     1  element type, see MatrixFileType
+    //        7     1  byte order of every later field, 1 little or 2 big endian
+    //        8     4  element size in bytes
+    //       12     4  alignment of the element data within the file
+    //       16     8  rows
+    //       24     8  columns
+    //       32     8  offset of the element data
+    //       40     4  tile rows, zero for a row-major file
+    //       44     4  tile columns, zero for a row-major file
+    //
+    // Files are written in the byte order of the writer. Readers convert when
+    // the order differs; a mapping can only adopt the file in native order.
+    // Tiled files, see TiledMatrix, store zero padded tiles one after another
+    // in row-major tile order and are only read through TiledMatrix.
+    enum class MatrixFileType : std::uint8_t
+    {
+        int8 = 1, uint8, int16, uint16, int32, uint32, int64, uint64, float32, float64
+    };
+
+    struct MatrixFileHeader
+    {
+        MatrixFileType type;
+        bool littleEndian;
+        std::uint32_t elementSize;
+        std::uint32_t alignment;
+        std::uint64_t rows;
+        std::uint64_t cols;
+        std::uint64_t dataOffset;
+        std::uint32_t tileRows;
+        std::uint32_t tileCols;
+    };
+
+    template <typename T, typename A>
+    void write_matrix(std::ostream& stream, const Matrix<T, A>& matrix);
+
+    template <typename T>
+    void write_matrix(std::ostream& stream, const ConstMatrixView<T>& view);
+
+    // Reads the elements straight into uninitialized Matrix storage.
+    template <typename T>
+    Matrix<T> read_matrix(std::istream& stream);
+
+    MatrixFileHeader read_matrix_header(std::istream& stream);
+
+    template <typename T, typename A>
+    void save_matrix(const std::string& path, const Matrix<T, A>& matrix);
+
+    template <typename T>
+    Matrix<T> load_matrix(const std::string& path);
+
+    // Read-only Matrix backed by a private mapping of a Matrix file. The file is
+    // paged in on first access instead of being parsed; the mapping lives until
+    // the object is destroyed, and views of it must not outlive it.
+    template <typename T>
+    class MappedMatrix
+    {
+    public:
+        typedef T value_type;
+
+        explicit MappedMatrix(const std::string& path);
+        MappedMatrix(const MappedMatrix&) = delete;
+        MappedMatrix(MappedMatrix&& other) noexcept;
+        MappedMatrix& operator= (const MappedMatrix&) = delete;
+        MappedMatrix& operator= (MappedMatrix&& other) noexcept;
+        ~MappedMatrix();
+
+        std::size_t rows() const { return _rows; }
+        std::size_t cols() const { return _cols; }
+        const T* data() const { return _data; }
+        const T& operator()(std::size_t row, std::size_t col) const { return _data[row * _cols + col]; }
+        const T& at(std::size_t row, std::size_t col) const;
+
+        ConstMatrixView<T> view() const { return ConstMatrixView<T>(_data, _rows, _cols); }
+        Matrix<T> to_matrix() const { return Matrix<T>(view()); }
+
+    private:
+        void* _mapping;
+        std::size_t _mappingSize;
+        const T* _data;
+        std::size_t _rows;
+        std::size_t _cols;
+
+        void unmap() noexcept;
+    };
+
+    namespace Detail
+    {
+        const std::size_t matrix_file_header_size = 64;
+        const std::size_t matrix_file_alignment = 64;
+        const std::uint16_t matrix_file_version = 1;
+
+        bool native_little_endian();
+
+        // Type code of T, zero for element types the format cannot describe.
+        template <typename T>
+        std::uint8_t matrix_file_type();
+
+        template <typename U>
+        void put_field(unsigned char* out, U value, bool littleEndian);
+
+        template <typename U>
+        U get_field(const unsigned char* in, bool littleEndian);
+
+        void reverse_elements(char* data, std::size_t count, std::size_t size);
+
+        MatrixFileHeader parse_matrix_header(const unsigned char* bytes, std::size_t available);
+
+        template <typename T>
+        MatrixFileHeader native_matrix_header(std::size_t rows, std::size_t cols, std::uint32_t tileRows, std::uint32_t tileCols);
+
+        // Encodes header into matrix_file_header_size bytes, zero padded.
+        void encode_matrix_header(const MatrixFileHeader& header, unsigned char* bytes);
+
+        template <typename T>
+        void check_matrix_file_type(const MatrixFileHeader& header);
+
+        void check_row_major_layout(const MatrixFileHeader& header);
+
+        template <typename T>
+        void write_matrix_rows(std::ostream& stream, const T* data, std::size_t rows, std::size_t cols,
+                               std::ptrdiff_t rowStride, std::ptrdiff_t colStride);
+    }
+}
+
+inline bool LinAlg::Detail::native_little_endian()
+{
+    const std::uint16_t probe = 1;
+    unsigned char first;
+    std::memcpy(&first, &probe, 1);
+    return first == 1;
+}
+
+template <typename T>
+inline std::uint8_t LinAlg::Detail::matrix_file_type()
+{
+    if (std::is_same<T, float>::value && sizeof(T) == 4) { return static_cast<std::uint8_t>(MatrixFileType::float32); }
+    if (std::is_same<T, double>::value && sizeof(T) == 8) { return static_cast<std::uint8_t>(MatrixFileType::float64); }
+    if (!std::is_integral<T>::value || std::is_same<T, bool>::value) { return 0; }
+
+    const std::uint8_t sizeIndex = sizeof(T) == 1 ? 0 : sizeof(T) == 2 ? 1 : sizeof(T) == 4 ? 2 : sizeof(T) == 8 ? 3 : 4;
+    if (sizeIndex == 4) { return 0; }
+    return static_cast<std::uint8_t>(static_cast<std::uint8_t>(MatrixFileType::int8) + 2 * sizeIndex + (std::is_signed<T>::value ? 0 : 1));
+}
+
+template <typename U>
+inline void LinAlg::Detail::put_field(unsigned char* out, U value, bool littleEndian)
+{
+    for (std::size_t i = 0; i < sizeof(U); ++i) {
+        const std::size_t shift = 8 * (littleEndian ? i : sizeof(U) - 1 - i);
+        out[i] = static_cast<unsigned char>((static_cast<std::uint64_t>(value) >> shift) & 0xFF);
+    }
+}
+
+template <typename U>
+inline U LinAlg::Detail::get_field(const unsigned char* in, bool littleEndian)
+{
+    std::uint64_t value = 0;
+    for (std::size_t i = 0; i < sizeof(U); ++i) {
+        const std::size_t shift = 8 * (littleEndian ? i : sizeof(U) - 1 - i);
+        value |= static_cast<std::uint64_t>(in[i]) << shift;
+    }
+    return static_cast<U>(value);
+}
+
+inline void LinAlg::Detail::reverse_elements(char* data, std::size_t count, std::size_t size)
+{
+    for (std::size_t i = 0; i < count; ++i) { std::reverse(data + i * size, data + (i + 1) * size); }
+}
+
+inline LinAlg::MatrixFileHeader LinAlg::Detail::parse_matrix_header(const unsigned char* bytes, std::size_t available)
+{
+    if (available < matrix_file_header_size || std::memcmp(bytes, "LAMX", 4) != 0) { throw std::runtime_error("invalid Matrix file format"); }
+    if (bytes[7] != 1 && bytes[7] != 2) { throw std::runtime_error("invalid Matrix file format"); }
+
+    MatrixFileHeader header;
+    header.littleEndian = bytes[7] == 1;
+    if (get_field<std::uint16_t>(bytes + 4, header.littleEndian) != matrix_file_version) { throw std::runtime_error("unsupported Matrix file version"); }
+    header.type = static_cast<MatrixFileType>(bytes[6]);
+    header.elementSize = get_field<std::uint32_t>(bytes + 8, header.littleEndian);
+    header.alignment = get_field<std::uint32_t>(bytes + 12, header.littleEndian);
+    header.rows = get_field<std::uint64_t>(bytes + 16, header.littleEndian);
+    header.cols = get_field<std::uint64_t>(bytes + 24, header.littleEndian);
+    header.dataOffset = get_field<std::uint64_t>(bytes + 32, header.littleEndian);
+    header.tileRows = get_field<std::uint32_t>(bytes + 40, header.littleEndian);
+    header.tileCols = get_field<std::uint32_t>(bytes + 44, header.littleEndian);
+
+    if (header.dataOffset < matrix_file_header_size || header.elementSize == 0) { throw std::runtime_error("invalid Matrix file format"); }
+    if ((header.tileRows == 0) != (header.tileCols == 0)) { throw std::runtime_error("invalid Matrix file format"); }
+    if (header.cols != 0 && header.rows > std::numeric_limits<std::uint64_t>::max() / header.elementSize / header.cols) {
+        throw std::runtime_error("invalid Matrix file format");
+    }
+    return header;
+}
+
+template <typename T>
+inline LinAlg::MatrixFileHeader LinAlg::Detail::native_matrix_header(std::size_t rows, std::size_t cols, std::uint32_t tileRows, std::uint32_t tileCols)
+{
+    if (matrix_file_type<T>() == 0) { throw std::invalid_argument("invalid Matrix template argument"); }
+
+    MatrixFileHeader header;
+    header.type = static_cast<MatrixFileType>(matrix_file_type<T>());
+    header.littleEndian = native_little_endian();
+    header.elementSize = static_cast<std::uint32_t>(sizeof(T));
+    header.alignment = static_cast<std::uint32_t>(matrix_file_alignment);
+    header.rows = rows;
+    header.cols = cols;
+    header.dataOffset = matrix_file_header_size;
+    header.tileRows = tileRows;
+    header.tileCols = tileCols;
+    return header;
+}
+
+inline void LinAlg::Detail::encode_matrix_header(const MatrixFileHeader& header, unsigned char* bytes)
+{
+    std::memset(bytes, 0, matrix_file_header_size);
+    std::memcpy(bytes, "LAMX", 4);
+    put_field<std::uint16_t>(bytes + 4, matrix_file_version, header.littleEndian);
+    bytes[6] = static_cast<unsigned char>(header.type);
+    bytes[7] = header.littleEndian ? 1 : 2;
+    put_field<std::uint32_t>(bytes + 8, header.elementSize, header.littleEndian);
+    put_field<std::uint32_t>(bytes + 12, header.alignment, header.littleEndian);
+    put_field<std::uint64_t>(bytes + 16, header.rows, header.littleEndian);
+    put_field<std::uint64_t>(bytes + 24, header.cols, header.littleEndian);
+    put_field<std::uint64_t>(bytes + 32, header.dataOffset, header.littleEndian);
+    put_field<std::uint32_t>(bytes + 40, header.tileRows, header.littleEndian);
+    put_field<std::uint32_t>(bytes + 44, header.tileCols, header.littleEndian);
+}
+
+inline void LinAlg::Detail::check_row_major_layout(const MatrixFileHeader& header)
+{
+    if (header.tileRows != 0) { throw std::runtime_error("unsupported Matrix file layout"); }
+}
+
+template <typename T>
+inline void LinAlg::Detail::check_matrix_file_type(const MatrixFileHeader& header)
+{
+    if (matrix_file_type<T>() == 0) { throw std::invalid_argument("invalid Matrix template argument"); }
+    if (static_cast<std::uint8_t>(header.type) != matrix_file_type<T>() || header.elementSize != sizeof(T)) {
+        throw std::runtime_error("incompatible Matrix file element type");
+    }
+    if (header.rows > std::numeric_limits<std::size_t>::max() || header.cols > std::numeric_limits<std::size_t>::max()) {
+        throw std::runtime_error("invalid Matrix file format");
+    }
+}
+
+template <typename T>
+inline void LinAlg::Detail::write_matrix_rows(std::ostream& stream, const T* data, std::size_t rows, std::size_t cols,
+                                              std::ptrdiff_t rowStride, std::ptrdiff_t colStride)
+{
+    unsigned char header[matrix_file_header_size];
+    encode_matrix_header(native_matrix_header<T>(rows, cols, 0, 0), header);
+    stream.write(reinterpret_cast<const char*>(header), matrix_file_header_size);
+
+    if (colStride == 1 && rowStride == static_cast<std::ptrdiff_t>(cols)) {
+        stream.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(rows * cols * sizeof(T)));
+    } else {
+        std::vector<T> row(cols);
+        for (std::size_t i = 0; i < rows && stream; ++i) {
+            for (std::size_t j = 0; j < cols; ++j) {
+                row[j] = data[static_cast<std::ptrdiff_t>(i) * rowStride + static_cast<std::ptrdiff_t>(j) * colStride];
+            }
+            stream.write(reinterpret_cast<const char*>(row.data()), static_cast<std::streamsize>(cols * sizeof(T)));
+        }
+    }
+    if (!stream) { throw std::runtime_error("Matrix file write failed"); }
+}
+
+template <typename T, typename A>
+inline void LinAlg::write_matrix(std::ostream& stream, const Matrix<T, A>& matrix)
+{
+    Detail::write_matrix_rows(stream, matrix.data(), matrix.rows(), matrix.cols(), static_cast<std::ptrdiff_t>(matrix.cols()), 1);
+}
+
+template <typename T>
+inline void LinAlg::write_matrix(std::ostream& stream, const ConstMatrixView<T>& view)
+{
+    Detail::write_matrix_rows(stream, view.data(), view.rows(), view.cols(), view.row_stride(), view.col_stride());
+}
+
+inline LinAlg::MatrixFileHeader LinAlg::read_matrix_header(std::istream& stream)
+{
+    unsigned char bytes[Detail::matrix_file_header_size];
+    stream.read(reinterpret_cast<char*>(bytes), Detail::matrix_file_header_size);
+    const MatrixFileHeader header = Detail::parse_matrix_header(bytes, static_cast<std::size_t>(stream.gcount()));
+
+    // Streams need not be seekable, so padding before the data is read and dropped.
+    char padding[256];
+    for (std::uint64_t skipped = Detail::matrix_file_header_size; skipped < header.dataOffset && stream;) {
+        const std::uint64_t chunk = std::min<std::uint64_t>(sizeof(padding), header.dataOffset - skipped);
+        stream.read(padding, static_cast<std::streamsize>(chunk));
+        skipped += chunk;
+    }
+    if (!stream) { throw std::runtime_error("Matrix file read failed"); }
+    return header;
+}
+
+template <typename T>
+inline LinAlg::Matrix<T> LinAlg::read_matrix(std::istream& stream)
+{
+    const MatrixFileHeader header = read_matrix_header(stream);
+    Detail::check_matrix_file_type<T>(header);
+    Detail::check_row_major_layout(header);
+
+    const std::size_t rows = static_cast<std::size_t>(header.rows), cols = static_cast<std::size_t>(header.cols);
+    if (rows == 0 || cols == 0) { return Matrix<T>(); }
+
+    Matrix<T> matrix(rows, cols, uninitialized);
+    stream.read(reinterpret_cast<char*>(matrix.data()), static_cast<std::streamsize>(matrix.vector_size() * sizeof(T)));
+    if (!stream) { throw std::runtime_error("Matrix file read failed"); }
+    if (header.littleEndian != Detail::native_little_endian()) {
+        Detail::reverse_elements(reinterpret_cast<char*>(matrix.data()), matrix.vector_size(), sizeof(T));
+    }
+    return matrix;
+}
+
+template <typename T, typename A>
+inline void LinAlg::save_matrix(const std::string& path, const Matrix<T, A>& matrix)
+{
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    if (!stream) { throw std::runtime_error("cannot open Matrix file"); }
+    write_matrix(stream, matrix);
+}
+
+template <typename T>
+inline LinAlg::Matrix<T> LinAlg::load_matrix(const std::string& path)
+{
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream) { throw std::runtime_error("cannot open Matrix file"); }
+    return read_matrix<T>(stream);
+}
+
+template <typename T>
+inline LinAlg::MappedMatrix<T>::MappedMatrix(const std::string& path)
+    : _mapping(nullptr), _mappingSize(0), _data(nullptr), _rows(0), _cols(0)
+{
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) { throw std::runtime_error("cannot open Matrix file"); }
+    LARGE_INTEGER fileSize;
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    }
+    if (mapping != nullptr) {
+        _mapping = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        CloseHandle(mapping);
+    }
+    CloseHandle(file);
+    if (_mapping == nullptr) { throw std::runtime_error("cannot map Matrix file"); }
+    _mappingSize = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+    const int file = ::open(path.c_str(), O_RDONLY);
+    if (file < 0) { throw std::runtime_error("cannot open Matrix file"); }
+    struct stat status;
+    void* mapping = MAP_FAILED;
+    if (::fstat(file, &status) == 0 && status.st_size > 0) {
+        mapping = ::mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+    }
+    ::close(file);
+    if (mapping == MAP_FAILED) { throw std::runtime_error("cannot map Matrix file"); }
+    _mapping = mapping;
+    _mappingSize = static_cast<std::size_t>(status.st_size);
+#endif
+
+    try {
+        const unsigned char* bytes = static_cast<const unsigned char*>(_mapping);
+        const MatrixFileHeader header = Detail::parse_matrix_header(bytes, _mappingSize);
+        Detail::check_matrix_file_type<T>(header);
+        Detail::check_row_major_layout(header);
+        if (header.littleEndian != Detail::native_little_endian()) { throw std::runtime_error("incompatible Matrix file byte order"); }
+        if (header.dataOffset % alignof(T) != 0 || header.dataOffset > _mappingSize
+            || header.rows * header.cols * sizeof(T) > _mappingSize - header.dataOffset) {
+            throw std::runtime_error("invalid Matrix file format");
+        }
+        _rows = static_cast<std::size_t>(header.rows);
+        _cols = static_cast<std::size_t>(header.cols);
+        _data = reinterpret_cast<const T*>(bytes + header.dataOffset);
+    } catch (...) {
+        unmap();
+        throw;
+    }
+}
+
+template <typename T>
+inline LinAlg::MappedMatrix<T>::MappedMatrix(MappedMatrix&& other) noexcept
+    : _mapping(other._mapping), _mappingSize(other._mappingSize), _data(other._data), _rows(other._rows), _cols(other._cols)
+{
+    other._mapping = nullptr;
+    other._mappingSize = 0;
+    other._data = nullptr;
+    other._rows = 0;
+    other._cols = 0;
+}
+
+template <typename T>
+inline LinAlg::MappedMatrix<T>& LinAlg::MappedMatrix<T>::operator= (MappedMatrix&& other) noexcept
+{
+    if (this != &other) {
+        unmap();
+        std::swap(_mapping, other._mapping);
+        std::swap(_mappingSize, other._mappingSize);
+        std::swap(_data, other._data);
+        std::swap(_rows, other._rows);
+        std::swap(_cols, other._cols);
+    }
+    return *this;
+}
+
+template <typename T>
+inline LinAlg::MappedMatrix<T>::~MappedMatrix()
+{
+    unmap();
+}
+
+template <typename T>
+inline void LinAlg::MappedMatrix<T>::unmap() noexcept
+{
+    if (_mapping != nullptr) {
+#if defined(_WIN32)
+        UnmapViewOfFile(_mapping);
+#else
+        ::munmap(_mapping, _mappingSize);
+#endif
+    }
+    _mapping = nullptr;
+    _mappingSize = 0;
+    _data = nullptr;
+    _rows = 0;
+    _cols = 0;
+}
+
+template <typename T>
+inline const T& LinAlg::MappedMatrix<T>::at(std::size_t row, std::size_t col) const
+{
+    if (row >= _rows) { throw std::out_of_range("invalid Matrix row subscript"); }
+    if (col >= _cols) { throw std::out_of_range("invalid Matrix column subscript"); }
+    return (*this)(row, col);
+}
+
+#endif // SERIALIZATION_HPP
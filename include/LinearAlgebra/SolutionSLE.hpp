@@ -1,8 +1,21 @@
 #ifndef SOLUTION_SLE_HPP
 #define SOLUTION_SLE_HPP
 
+#include "SolutionSLE/banded_lu_decomposition.hpp"
+#include "SolutionSLE/batch_lu_decomposition.hpp"
+#include "SolutionSLE/bicgstab.hpp"
+#include "SolutionSLE/cholesky_decomposition.hpp"
+#include "SolutionSLE/conjugate_gradient.hpp"
 #include "SolutionSLE/gaussian_elimination.hpp"
+#include "SolutionSLE/gmres.hpp"
 #include "SolutionSLE/inverse_matrix_method.hpp"
+#include "SolutionSLE/lanczos.hpp"
+#include "SolutionSLE/ldlt_decomposition.hpp"
 #include "SolutionSLE/lu_decomposition.hpp"
+#include "SolutionSLE/mixed_precision.hpp"
+#include "SolutionSLE/preconditioners.hpp"
+#include "SolutionSLE/qr_decomposition.hpp"
+#include "SolutionSLE/singular_value_decomposition.hpp"
+#include "SolutionSLE/symmetric_eigen_decomposition.hpp"
 
 #endif // SOLUTION_SLE_HPP
@@ -0,0 +1,124 @@
+#ifndef BANDED_LU_DECOMPOSITION_HPP
+#define BANDED_LU_DECOMPOSITION_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../Matrix.hpp"
+#include "../StructuredMatrix.hpp"
+#include "../Kernels/structured.hpp"
+
+namespace LinAlg
+{
+    // PA = LU factorization with partial pivoting of a band matrix. Pivoting
+    // widens U to kl + ku superdiagonals and L keeps kl multipliers per column,
+    // so factoring costs O(n kl (kl + ku)) and every solve O(n (2 kl + ku)) per
+    // right-hand side: O(n) throughout for a tridiagonal matrix.
+    template <typename T>
+    class BandedLUDecomposition
+    {
+    public:
+        explicit BandedLUDecomposition(const BandedMatrix<T>& matrix);
+
+        std::size_t size() const { return _size; }
+        std::size_t lower_bandwidth() const { return _lower; }
+        std::size_t upper_bandwidth() const { return _upper; }
+        bool singular() const { return _singular; }
+        const std::vector<T>& factors() const { return _factors; }
+        const std::vector<std::size_t>& pivots() const { return _pivots; }
+
+        T determinant() const;
+
+        std::vector<T> solve(const std::vector<T>& b) const;
+        template <typename E>
+        Matrix<T> solve(const MatrixExpression<E>& b) const;
+        void solve_in_place(std::vector<T>& b) const;
+        void solve_in_place(Matrix<T>& b) const;
+
+    private:
+        std::size_t _size;
+        std::size_t _lower;
+        std::size_t _upper;
+        std::vector<T> _factors;
+        std::vector<std::size_t> _pivots;
+        bool _singular;
+
+        std::size_t leading_dimension() const { return 2 * _lower + _upper + 1; }
+        void check_solvable(std::size_t rows) const;
+    };
+
+    template <typename T>
+    std::vector<T> solve_banded(const BandedMatrix<T>& matrix, const std::vector<T>& b);
+}
+
+template <typename T>
+inline LinAlg::BandedLUDecomposition<T>::BandedLUDecomposition(const BandedMatrix<T>& matrix)
+    : _size(matrix.size()), _lower(matrix.lower_bandwidth()), _upper(matrix.upper_bandwidth()), _factors(), _pivots(matrix.size()), _singular(false)
+{
+    if (!std::is_floating_point<T>::value) { throw std::invalid_argument("invalid Matrix template argument"); }
+
+    _factors = matrix.factor_storage();
+    _singular = Kernels::band_lu_factor(_size, _lower, _upper, _factors.data(), leading_dimension(), _pivots.data()) != 0;
+}
+
+template <typename T>
+inline void LinAlg::BandedLUDecomposition<T>::check_solvable(std::size_t rows) const
+{
+    if (rows != size()) { throw std::invalid_argument("invalid Matrix argument size"); }
+    if (_singular) { throw std::runtime_error("null determinant"); }
+}
+
+template <typename T>
+inline T LinAlg::BandedLUDecomposition<T>::determinant() const
+{
+    if (size() == 0 || _singular) { return T(); }
+
+    T determinant = T(1);
+    for (std::size_t i = 0; i < size(); ++i) {
+        determinant *= _factors[Kernels::band_index(_lower, leading_dimension(), i, i)];
+        if (_pivots[i] != i) { determinant = -determinant; }
+    }
+    return determinant;
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::BandedLUDecomposition<T>::solve(const std::vector<T>& b) const
+{
+    std::vector<T> x(b);
+    solve_in_place(x);
+    return x;
+}
+
+template <typename T>
+template <typename E>
+inline LinAlg::Matrix<T> LinAlg::BandedLUDecomposition<T>::solve(const MatrixExpression<E>& b) const
+{
+    Matrix<T> x(b);
+    solve_in_place(x);
+    return x;
+}
+
+template <typename T>
+inline void LinAlg::BandedLUDecomposition<T>::solve_in_place(std::vector<T>& b) const
+{
+    check_solvable(b.size());
+    Kernels::band_lu_solve(size(), _lower, _upper, _factors.data(), leading_dimension(), _pivots.data(), 1, b.data(), 1);
+}
+
+template <typename T>
+inline void LinAlg::BandedLUDecomposition<T>::solve_in_place(Matrix<T>& b) const
+{
+    check_solvable(b.rows());
+    if (b.cols() == 0) { return; }
+    Kernels::band_lu_solve(size(), _lower, _upper, _factors.data(), leading_dimension(), _pivots.data(), b.cols(), b.data(), b.cols());
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::solve_banded(const BandedMatrix<T>& matrix, const std::vector<T>& b)
+{
+    return BandedLUDecomposition<T>(matrix).solve(b);
+}
+
+#endif // BANDED_LU_DECOMPOSITION_HPP
@@ -0,0 +1,121 @@
+#ifndef BATCH_LU_DECOMPOSITION_HPP
+#define BATCH_LU_DECOMPOSITION_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../MatrixBatch.hpp"
+#include "../Kernels/batch.hpp"
+
+namespace LinAlg
+{
+    // PA = LU factorization of every matrix of a batch, each with its own
+    // partial pivoting. Solves take a batch of right-hand sides of matching count.
+    template <typename T>
+    class BatchLUDecomposition
+    {
+    public:
+        explicit BatchLUDecomposition(const MatrixBatch<T>& matrices);
+        explicit BatchLUDecomposition(MatrixBatch<T>&& matrices);
+
+        std::size_t count() const { return _lu.count(); }
+        std::size_t size() const { return _lu.rows(); }
+        bool singular(std::size_t index) const;
+        bool any_singular() const { return _anySingular; }
+        const MatrixBatch<T>& factors() const { return _lu; }
+
+        std::vector<T> determinants() const;
+
+        MatrixBatch<T> solve(const MatrixBatch<T>& b) const;
+        void solve_in_place(MatrixBatch<T>& b) const;
+
+    private:
+        MatrixBatch<T> _lu;
+        std::vector<std::size_t> _pivots;
+        std::vector<unsigned char> _singular;
+        bool _anySingular;
+
+        void factor();
+    };
+
+    template <typename T>
+    MatrixBatch<T> solve_lu(const MatrixBatch<T>& matrices, const MatrixBatch<T>& b);
+}
+
+template <typename T>
+inline LinAlg::BatchLUDecomposition<T>::BatchLUDecomposition(const MatrixBatch<T>& matrices)
+    : _lu(matrices), _pivots(), _singular(), _anySingular(false)
+{
+    factor();
+}
+
+template <typename T>
+inline LinAlg::BatchLUDecomposition<T>::BatchLUDecomposition(MatrixBatch<T>&& matrices)
+    : _lu(std::move(matrices)), _pivots(), _singular(), _anySingular(false)
+{
+    factor();
+}
+
+template <typename T>
+inline void LinAlg::BatchLUDecomposition<T>::factor()
+{
+    if (!std::is_floating_point<T>::value) { throw std::invalid_argument("invalid Matrix template argument"); }
+    if (!_lu.square()) { throw std::invalid_argument("square Matrix required"); }
+
+    Detail::batch_lu_factor(_lu, _pivots, _singular);
+    _anySingular = std::find(_singular.begin(), _singular.begin() + count(), static_cast<unsigned char>(1)) != _singular.begin() + count();
+}
+
+template <typename T>
+inline bool LinAlg::BatchLUDecomposition<T>::singular(std::size_t index) const
+{
+    if (index >= count()) { throw std::out_of_range("invalid Matrix batch subscript"); }
+    return _singular[index] != 0;
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::BatchLUDecomposition<T>::determinants() const
+{
+    return Detail::batch_lu_determinants(_lu, _pivots);
+}
+
+template <typename T>
+inline LinAlg::MatrixBatch<T> LinAlg::BatchLUDecomposition<T>::solve(const MatrixBatch<T>& b) const
+{
+    MatrixBatch<T> x(b);
+    solve_in_place(x);
+    return x;
+}
+
+template <typename T>
+inline void LinAlg::BatchLUDecomposition<T>::solve_in_place(MatrixBatch<T>& b) const
+{
+    if (b.count() != count() || b.rows() != size()) { throw std::invalid_argument("invalid Matrix argument size"); }
+    if (_anySingular) { throw std::runtime_error("null determinant"); }
+    if (b.cols() == 0) { return; }
+
+    const std::size_t n = size(), nrhs = b.cols();
+    const std::size_t lanes = Kernels::batch_lanes;
+    const T* factors = _lu.data();
+    const std::size_t factorSize = _lu.block_size(), rhsSize = b.block_size();
+    const std::size_t* pivots = _pivots.data();
+    T* rhs = b.data();
+    Kernels::batch_dispatch(n, [&](auto order) {
+        typedef decltype(order) Order;
+        Detail::batch_for(b.blocks(), n * n * nrhs * lanes, [=](std::size_t block) {
+            Kernels::batch_lu_solve<Order::value>(n, nrhs, factors + block * factorSize, pivots + block * n * lanes, rhs + block * rhsSize);
+        });
+    });
+}
+
+template <typename T>
+inline LinAlg::MatrixBatch<T> LinAlg::solve_lu(const MatrixBatch<T>& matrices, const MatrixBatch<T>& b)
+{
+    return BatchLUDecomposition<T>(matrices).solve(b);
+}
+
+#endif // BATCH_LU_DECOMPOSITION_HPP
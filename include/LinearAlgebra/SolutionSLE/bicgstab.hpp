@@ -0,0 +1,91 @@
+#ifndef BICGSTAB_HPP
+#define BICGSTAB_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "iterative_method.hpp"
+#include "preconditioners.hpp"
+
+namespace LinAlg
+{
+    // Right-preconditioned BiCGSTAB for general square A. x holds the initial
+    // guess on entry (empty for zero) and the solution on exit; the residual
+    // reported is relative to |b|.
+    template <typename M, typename P>
+    IterativeResult<typename M::value_type> solve_bicgstab(const M& matrix, const std::vector<typename M::value_type>& b,
+                                                           std::vector<typename M::value_type>& x, const P& preconditioner,
+                                                           const IterativeSettings<typename M::value_type>& settings = IterativeSettings<typename M::value_type>());
+
+    template <typename M>
+    std::vector<typename M::value_type> solve_bicgstab(const M& matrix, const std::vector<typename M::value_type>& b);
+}
+
+template <typename M, typename P>
+inline LinAlg::IterativeResult<typename M::value_type> LinAlg::solve_bicgstab(const M& matrix, const std::vector<typename M::value_type>& b,
+                                                                              std::vector<typename M::value_type>& x, const P& preconditioner,
+                                                                              const IterativeSettings<typename M::value_type>& settings)
+{
+    typedef typename M::value_type T;
+    Detail::check_iterative(matrix, preconditioner, b, x);
+
+    const std::size_t size = b.size();
+    const T bNorm = Detail::norm(b);
+    if (bNorm == T()) {
+        x.assign(size, T());
+        return Detail::converged_result(0, T(), settings.tolerance);
+    }
+
+    std::vector<T> r(size), p(size, T()), v(size, T()), s(size), t(size), pHat(size), sHat(size);
+    T residual = Detail::residual(matrix, b, x, r) / bNorm;
+    if (residual <= settings.tolerance) { return Detail::converged_result(0, residual, settings.tolerance); }
+
+    const std::vector<T> shadow(r);
+    T rho = T(1), alpha = T(1), omega = T(1);
+
+    std::size_t iteration = 0;
+    while (iteration < settings.iterations) {
+        ++iteration;
+        const T rhoNext = Kernels::dot(size, shadow.data(), r.data());
+        if (rhoNext == T() || omega == T()) { break; }
+
+        const T beta = (rhoNext / rho) * (alpha / omega);
+        rho = rhoNext;
+        for (std::size_t i = 0; i < size; ++i) { p[i] = r[i] + beta * (p[i] - omega * v[i]); }
+
+        preconditioner.apply(p.data(), pHat.data());
+        Detail::multiply_vector(matrix, pHat.data(), v.data());
+        const T shadowV = Kernels::dot(size, shadow.data(), v.data());
+        if (shadowV == T()) { break; }
+
+        alpha = rho / shadowV;
+        for (std::size_t i = 0; i < size; ++i) { s[i] = r[i] - alpha * v[i]; }
+        Kernels::axpy(size, alpha, pHat.data(), x.data());
+        residual = Detail::norm(s) / bNorm;
+        if (residual <= settings.tolerance) { break; }
+
+        preconditioner.apply(s.data(), sHat.data());
+        Detail::multiply_vector(matrix, sHat.data(), t.data());
+        const T tt = Kernels::dot(size, t.data(), t.data());
+        omega = tt == T() ? T() : Kernels::dot(size, t.data(), s.data()) / tt;
+
+        Kernels::axpy(size, omega, sHat.data(), x.data());
+        for (std::size_t i = 0; i < size; ++i) { r[i] = s[i] - omega * t[i]; }
+        residual = Detail::norm(r) / bNorm;
+        if (residual <= settings.tolerance) { break; }
+    }
+
+    return Detail::converged_result(iteration, residual, settings.tolerance);
+}
+
+template <typename M>
+inline std::vector<typename M::value_type> LinAlg::solve_bicgstab(const M& matrix, const std::vector<typename M::value_type>& b)
+{
+    std::vector<typename M::value_type> x;
+    const JacobiPreconditioner<typename M::value_type> preconditioner(matrix);
+    if (!solve_bicgstab(matrix, b, x, preconditioner).converged) { throw std::runtime_error("iterative method did not converge"); }
+    return x;
+}
+
+#endif // BICGSTAB_HPP
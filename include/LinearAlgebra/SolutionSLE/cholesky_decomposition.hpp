@@ -0,0 +1,224 @@
+#ifndef CHOLESKY_DECOMPOSITION_HPP
+#define CHOLESKY_DECOMPOSITION_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../Matrix.hpp"
+#include "../SparseMatrix.hpp"
+#include "../StructuredMatrix.hpp"
+#include "../Kernels/cholesky.hpp"
+
+namespace LinAlg
+{
+    // A = L L^T factorization of a symmetric positive definite matrix. Only the
+    // lower triangle of the input is read, and L is kept in packed form, so the
+    // factor takes half the storage of an LU decomposition.
+    template <typename T>
+    class CholeskyDecomposition
+    {
+    public:
+        explicit CholeskyDecomposition(const Matrix<T>& matrix);
+        explicit CholeskyDecomposition(Matrix<T>&& matrix);
+        template <typename E>
+        explicit CholeskyDecomposition(const MatrixExpression<E>& matrix);
+        explicit CholeskyDecomposition(const SparseMatrix<T>& matrix);
+        explicit CholeskyDecomposition(const SymmetricMatrix<T>& matrix);
+
+        std::size_t size() const { return _size; }
+        const std::vector<T>& packed() const { return _packed; }
+
+        Matrix<T> lower() const;
+        TriangularMatrix<T> lower_triangular() const { return TriangularMatrix<T>(Triangle::lower, _size, _packed); }
+        T determinant() const;
+
+        std::vector<T> solve(const std::vector<T>& b) const;
+        template <typename E>
+        Matrix<T> solve(const MatrixExpression<E>& b) const;
+        void solve_in_place(std::vector<T>& b) const;
+        void solve_in_place(Matrix<T>& b) const;
+
+        // Refactor in O(n^2) for A + x x^T and A - x x^T respectively. A failed
+        // downdate throws and leaves the factor unchanged.
+        void update(const std::vector<T>& x);
+        void downdate(const std::vector<T>& x);
+
+    private:
+        std::size_t _size;
+        std::vector<T> _packed;
+
+        void factor(Matrix<T>& matrix);
+        void rank_update(const std::vector<T>& x, T sign);
+    };
+
+    template <typename T>
+    std::vector<T> solve_cholesky(const Matrix<T>& matrix, const std::vector<T>& b);
+
+    template <typename E>
+    std::vector<typename E::value_type> solve_cholesky(const MatrixExpression<E>& matrix, const std::vector<typename E::value_type>& b);
+
+    template <typename T>
+    std::vector<T> solve_cholesky(const SparseMatrix<T>& matrix, const std::vector<T>& b);
+
+    template <typename T>
+    std::vector<T> solve_cholesky(const SymmetricMatrix<T>& matrix, const std::vector<T>& b);
+}
+
+template <typename T>
+inline LinAlg::CholeskyDecomposition<T>::CholeskyDecomposition(const Matrix<T>& matrix)
+    : _size(matrix.rows()), _packed()
+{
+    Matrix<T> work(matrix);
+    factor(work);
+}
+
+template <typename T>
+inline LinAlg::CholeskyDecomposition<T>::CholeskyDecomposition(Matrix<T>&& matrix)
+    : _size(matrix.rows()), _packed()
+{
+    factor(matrix);
+}
+
+template <typename T>
+template <typename E>
+inline LinAlg::CholeskyDecomposition<T>::CholeskyDecomposition(const MatrixExpression<E>& matrix)
+    : _size(matrix.rows()), _packed()
+{
+    Matrix<T> work(matrix);
+    factor(work);
+}
+
+template <typename T>
+inline LinAlg::CholeskyDecomposition<T>::CholeskyDecomposition(const SparseMatrix<T>& matrix)
+    : _size(matrix.rows()), _packed()
+{
+    Matrix<T> work(matrix.to_dense());
+    factor(work);
+}
+
+template <typename T>
+inline LinAlg::CholeskyDecomposition<T>::CholeskyDecomposition(const SymmetricMatrix<T>& matrix)
+    : _size(matrix.rows()), _packed()
+{
+    Matrix<T> work(matrix.to_dense());
+    factor(work);
+}
+
+template <typename T>
+inline void LinAlg::CholeskyDecomposition<T>::factor(Matrix<T>& matrix)
+{
+    if (!std::is_floating_point<T>::value) { throw std::invalid_argument("invalid Matrix template argument"); }
+    if (!matrix.square()) { throw std::invalid_argument("square Matrix required"); }
+
+    if (Kernels::cholesky_factor(_size, matrix.data(), matrix.cols()) != 0) { throw std::runtime_error("Matrix is not positive definite"); }
+    _packed.resize(Kernels::packed_size(_size));
+    Kernels::pack_lower(_size, matrix.data(), matrix.cols(), _packed.data());
+}
+
+template <typename T>
+inline LinAlg::Matrix<T> LinAlg::CholeskyDecomposition<T>::lower() const
+{
+    Matrix<T> lowerMatrix(size(), size());
+    for (std::size_t i = 0; i < size(); ++i) {
+        for (std::size_t j = 0; j <= i; ++j) { lowerMatrix(i, j) = _packed[Kernels::packed_index(i, j)]; }
+    }
+    return lowerMatrix;
+}
+
+template <typename T>
+inline T LinAlg::CholeskyDecomposition<T>::determinant() const
+{
+    if (size() == 0) { return T(); }
+
+    T determinant = T(1);
+    for (std::size_t i = 0; i < size(); ++i) {
+        const T diagonal = _packed[Kernels::packed_index(i, i)];
+        determinant *= diagonal * diagonal;
+    }
+    return determinant;
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::CholeskyDecomposition<T>::solve(const std::vector<T>& b) const
+{
+    std::vector<T> x(b);
+    solve_in_place(x);
+    return x;
+}
+
+template <typename T>
+template <typename E>
+inline LinAlg::Matrix<T> LinAlg::CholeskyDecomposition<T>::solve(const MatrixExpression<E>& b) const
+{
+    Matrix<T> x(b);
+    solve_in_place(x);
+    return x;
+}
+
+template <typename T>
+inline void LinAlg::CholeskyDecomposition<T>::solve_in_place(std::vector<T>& b) const
+{
+    if (b.size() != size()) { throw std::invalid_argument("invalid Matrix argument size"); }
+    Kernels::cholesky_solve_packed(size(), 1, _packed.data(), b.data(), 1);
+}
+
+template <typename T>
+inline void LinAlg::CholeskyDecomposition<T>::solve_in_place(Matrix<T>& b) const
+{
+    if (b.rows() != size()) { throw std::invalid_argument("invalid Matrix argument size"); }
+    if (b.cols() == 0) { return; }
+    Kernels::cholesky_solve_packed(size(), b.cols(), _packed.data(), b.data(), b.cols());
+}
+
+template <typename T>
+inline void LinAlg::CholeskyDecomposition<T>::update(const std::vector<T>& x)
+{
+    rank_update(x, T(1));
+}
+
+template <typename T>
+inline void LinAlg::CholeskyDecomposition<T>::downdate(const std::vector<T>& x)
+{
+    rank_update(x, T(-1));
+}
+
+template <typename T>
+inline void LinAlg::CholeskyDecomposition<T>::rank_update(const std::vector<T>& x, T sign)
+{
+    if (x.size() != size()) { throw std::invalid_argument("invalid vector argument size"); }
+
+    std::vector<T> work(x);
+    std::vector<T> updated(_packed);
+    if (!Kernels::cholesky_rank_update_packed(size(), updated.data(), work.data(), sign)) {
+        throw std::runtime_error("Matrix is not positive definite");
+    }
+    _packed.swap(updated);
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::solve_cholesky(const Matrix<T>& matrix, const std::vector<T>& b)
+{
+    return CholeskyDecomposition<T>(matrix).solve(b);
+}
+
+template <typename E>
+inline std::vector<typename E::value_type> LinAlg::solve_cholesky(const MatrixExpression<E>& matrix, const std::vector<typename E::value_type>& b)
+{
+    return CholeskyDecomposition<typename E::value_type>(matrix).solve(b);
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::solve_cholesky(const SparseMatrix<T>& matrix, const std::vector<T>& b)
+{
+    return CholeskyDecomposition<T>(matrix).solve(b);
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::solve_cholesky(const SymmetricMatrix<T>& matrix, const std::vector<T>& b)
+{
+    return CholeskyDecomposition<T>(matrix).solve(b);
+}
+
+#endif // CHOLESKY_DECOMPOSITION_HPP
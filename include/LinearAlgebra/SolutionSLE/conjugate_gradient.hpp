@@ -0,0 +1,80 @@
+#ifndef CONJUGATE_GRADIENT_HPP
+#define CONJUGATE_GRADIENT_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "iterative_method.hpp"
+#include "preconditioners.hpp"
+
+namespace LinAlg
+{
+    // Preconditioned conjugate gradient for symmetric positive definite A and
+    // symmetric positive definite M. x holds the initial guess on entry (empty
+    // for zero) and the solution on exit; the residual reported is relative to |b|.
+    template <typename M, typename P>
+    IterativeResult<typename M::value_type> solve_cg(const M& matrix, const std::vector<typename M::value_type>& b,
+                                                     std::vector<typename M::value_type>& x, const P& preconditioner,
+                                                     const IterativeSettings<typename M::value_type>& settings = IterativeSettings<typename M::value_type>());
+
+    template <typename M>
+    std::vector<typename M::value_type> solve_cg(const M& matrix, const std::vector<typename M::value_type>& b);
+}
+
+template <typename M, typename P>
+inline LinAlg::IterativeResult<typename M::value_type> LinAlg::solve_cg(const M& matrix, const std::vector<typename M::value_type>& b,
+                                                                        std::vector<typename M::value_type>& x, const P& preconditioner,
+                                                                        const IterativeSettings<typename M::value_type>& settings)
+{
+    typedef typename M::value_type T;
+    Detail::check_iterative(matrix, preconditioner, b, x);
+
+    const std::size_t size = b.size();
+    const T bNorm = Detail::norm(b);
+    if (bNorm == T()) {
+        x.assign(size, T());
+        return Detail::converged_result(0, T(), settings.tolerance);
+    }
+
+    std::vector<T> r(size), z(size), p(size), q(size);
+    T residual = Detail::residual(matrix, b, x, r) / bNorm;
+    if (residual <= settings.tolerance) { return Detail::converged_result(0, residual, settings.tolerance); }
+
+    preconditioner.apply(r.data(), z.data());
+    p = z;
+    T rz = Kernels::dot(size, r.data(), z.data());
+
+    std::size_t iteration = 0;
+    while (iteration < settings.iterations) {
+        ++iteration;
+        Detail::multiply_vector(matrix, p.data(), q.data());
+        const T pq = Kernels::dot(size, p.data(), q.data());
+        if (pq == T()) { break; }
+
+        const T alpha = rz / pq;
+        Kernels::axpy(size, alpha, p.data(), x.data());
+        Kernels::axpy(size, -alpha, q.data(), r.data());
+        residual = Detail::norm(r) / bNorm;
+        if (residual <= settings.tolerance) { break; }
+
+        preconditioner.apply(r.data(), z.data());
+        const T rzNext = Kernels::dot(size, r.data(), z.data());
+        const T beta = rzNext / rz;
+        rz = rzNext;
+        for (std::size_t i = 0; i < size; ++i) { p[i] = z[i] + beta * p[i]; }
+    }
+
+    return Detail::converged_result(iteration, residual, settings.tolerance);
+}
+
+template <typename M>
+inline std::vector<typename M::value_type> LinAlg::solve_cg(const M& matrix, const std::vector<typename M::value_type>& b)
+{
+    std::vector<typename M::value_type> x;
+    const JacobiPreconditioner<typename M::value_type> preconditioner(matrix);
+    if (!solve_cg(matrix, b, x, preconditioner).converged) { throw std::runtime_error("iterative method did not converge"); }
+    return x;
+}
+
+#endif // CONJUGATE_GRADIENT_HPP
@@ -1,4 +1,175 @@
 #ifndef GAUSSIAN_ELIMINATION_HPP
 #define GAUSSIAN_ELIMINATION_HPP
 
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../Matrix.hpp"
+#include "../SparseMatrix.hpp"
+
+namespace LinAlg
+{
+    // Solves A X = B by Gaussian elimination with partial pivoting on the
+    // augmented system [A | B]. The in-place overloads overwrite A with its
+    // row echelon form and B with the solution.
+    template <typename T>
+    std::vector<T> solve_gauss(const Matrix<T>& matrix, const std::vector<T>& b);
+
+    template <typename T>
+    Matrix<T> solve_gauss(const Matrix<T>& matrix, const Matrix<T>& b);
+
+    template <typename E>
+    std::vector<typename E::value_type> solve_gauss(const MatrixExpression<E>& matrix, const std::vector<typename E::value_type>& b);
+
+    template <typename L, typename R>
+    Matrix<typename L::value_type> solve_gauss(const MatrixExpression<L>& matrix, const MatrixExpression<R>& b);
+
+    template <typename T>
+    std::vector<T> solve_gauss(const SparseMatrix<T>& matrix, const std::vector<T>& b);
+
+    template <typename T>
+    void solve_gauss_in_place(Matrix<T>& matrix, std::vector<T>& b);
+
+    template <typename T>
+    void solve_gauss_in_place(Matrix<T>& matrix, Matrix<T>& b);
+
+    namespace Detail
+    {
+        template <typename T>
+        std::size_t gauss_pivot(const Matrix<T>& matrix, std::size_t col);
+    }
+}
+
+template <typename T>
+inline std::size_t LinAlg::Detail::gauss_pivot(const Matrix<T>& matrix, std::size_t col)
+{
+    std::size_t pivot = col;
+    T pivotValue = std::fabs(matrix(col, col));
+    for (std::size_t i = col + 1; i < matrix.rows(); ++i) {
+        const T value = std::fabs(matrix(i, col));
+        if (value > pivotValue) {
+            pivot = i;
+            pivotValue = value;
+        }
+    }
+
+    if (pivotValue == T()) { throw std::runtime_error("null determinant"); }
+    return pivot;
+}
+
+template <typename T>
+inline void LinAlg::solve_gauss_in_place(Matrix<T>& matrix, Matrix<T>& b)
+{
+    if (!std::is_floating_point<T>::value) { throw std::invalid_argument("invalid Matrix template argument"); }
+    if (!matrix.square()) { throw std::invalid_argument("square Matrix required"); }
+    if (b.rows() != matrix.rows()) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+    const std::size_t size = matrix.rows();
+
+    for (std::size_t k = 0; k < size; ++k) {
+        const std::size_t pivot = Detail::gauss_pivot(matrix, k);
+        matrix.swap_row(k, pivot);
+        b.swap_row(k, pivot);
+
+        const T diagonal = matrix(k, k);
+        for (std::size_t i = k + 1; i < size; ++i) {
+            const T factor = matrix(i, k) / diagonal;
+            if (factor != T()) {
+                matrix.add_row(i, k, -factor);
+                b.add_row(i, k, -factor);
+            }
+            matrix(i, k) = T();
+        }
+    }
+
+    for (std::size_t k = size; k-- > 0;) {
+        b.mult_row(k, T(1) / matrix(k, k));
+        for (std::size_t i = 0; i < k; ++i) {
+            if (matrix(i, k) != T()) { b.add_row(i, k, -matrix(i, k)); }
+        }
+    }
+}
+
+template <typename T>
+inline void LinAlg::solve_gauss_in_place(Matrix<T>& matrix, std::vector<T>& b)
+{
+    if (!std::is_floating_point<T>::value) { throw std::invalid_argument("invalid Matrix template argument"); }
+    if (!matrix.square()) { throw std::invalid_argument("square Matrix required"); }
+    if (b.size() != matrix.rows()) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+    const std::size_t size = matrix.rows();
+
+    for (std::size_t k = 0; k < size; ++k) {
+        const std::size_t pivot = Detail::gauss_pivot(matrix, k);
+        matrix.swap_row(k, pivot);
+        std::swap(b[k], b[pivot]);
+
+        const T diagonal = matrix(k, k);
+        for (std::size_t i = k + 1; i < size; ++i) {
+            const T factor = matrix(i, k) / diagonal;
+            if (factor != T()) {
+                matrix.add_row(i, k, -factor);
+                b[i] -= factor * b[k];
+            }
+            matrix(i, k) = T();
+        }
+    }
+
+    for (std::size_t k = size; k-- > 0;) {
+        T sum = b[k];
+        const T* row = matrix.data() + k * size;
+        for (std::size_t j = k + 1; j < size; ++j) { sum -= row[j] * b[j]; }
+        b[k] = sum / row[k];
+    }
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::solve_gauss(const Matrix<T>& matrix, const std::vector<T>& b)
+{
+    Matrix<T> workMatrix(matrix);
+    std::vector<T> x(b);
+    solve_gauss_in_place(workMatrix, x);
+    return x;
+}
+
+template <typename T>
+inline LinAlg::Matrix<T> LinAlg::solve_gauss(const Matrix<T>& matrix, const Matrix<T>& b)
+{
+    Matrix<T> workMatrix(matrix);
+    Matrix<T> x(b);
+    solve_gauss_in_place(workMatrix, x);
+    return x;
+}
+
+template <typename E>
+inline std::vector<typename E::value_type> LinAlg::solve_gauss(const MatrixExpression<E>& matrix, const std::vector<typename E::value_type>& b)
+{
+    Matrix<typename E::value_type> workMatrix(matrix);
+    std::vector<typename E::value_type> x(b);
+    solve_gauss_in_place(workMatrix, x);
+    return x;
+}
+
+template <typename L, typename R>
+inline LinAlg::Matrix<typename L::value_type> LinAlg::solve_gauss(const MatrixExpression<L>& matrix, const MatrixExpression<R>& b)
+{
+    Matrix<typename L::value_type> workMatrix(matrix);
+    Matrix<typename L::value_type> x(b);
+    solve_gauss_in_place(workMatrix, x);
+    return x;
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::solve_gauss(const SparseMatrix<T>& matrix, const std::vector<T>& b)
+{
+    Matrix<T> workMatrix = matrix.to_dense();
+    std::vector<T> x(b);
+    solve_gauss_in_place(workMatrix, x);
+    return x;
+}
+
 #endif // GAUSSIAN_ELIMINATION_HPP
@@ -0,0 +1,119 @@
+#ifndef GMRES_HPP
+#define GMRES_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "iterative_method.hpp"
+#include "preconditioners.hpp"
+
+namespace LinAlg
+{
+    // Right-preconditioned GMRES restarted every settings.restart iterations.
+    // The Arnoldi basis is orthogonalized with modified Gram-Schmidt and the
+    // Hessenberg least-squares problem is kept triangular with Givens rotations.
+    // x holds the initial guess on entry (empty for zero) and the solution on
+    // exit; the residual reported is relative to |b|.
+    template <typename M, typename P>
+    IterativeResult<typename M::value_type> solve_gmres(const M& matrix, const std::vector<typename M::value_type>& b,
+                                                        std::vector<typename M::value_type>& x, const P& preconditioner,
+                                                        const IterativeSettings<typename M::value_type>& settings = IterativeSettings<typename M::value_type>());
+
+    template <typename M>
+    std::vector<typename M::value_type> solve_gmres(const M& matrix, const std::vector<typename M::value_type>& b);
+}
+
+template <typename M, typename P>
+inline LinAlg::IterativeResult<typename M::value_type> LinAlg::solve_gmres(const M& matrix, const std::vector<typename M::value_type>& b,
+                                                                           std::vector<typename M::value_type>& x, const P& preconditioner,
+                                                                           const IterativeSettings<typename M::value_type>& settings)
+{
+    typedef typename M::value_type T;
+    Detail::check_iterative(matrix, preconditioner, b, x);
+
+    const std::size_t size = b.size();
+    const T bNorm = Detail::norm(b);
+    if (bNorm == T()) {
+        x.assign(size, T());
+        return Detail::converged_result(0, T(), settings.tolerance);
+    }
+
+    const std::size_t restart = std::max<std::size_t>(1, std::min(settings.restart, size));
+    std::vector< std::vector<T> > basis(restart + 1, std::vector<T>(size));
+    std::vector<T> hessenberg((restart + 1) * restart), cosines(restart), sines(restart), g(restart + 1), y(restart);
+    std::vector<T> r(size), w(size), z(size);
+
+    T residual = Detail::residual(matrix, b, x, r) / bNorm;
+    std::size_t iteration = 0;
+    while (residual > settings.tolerance && iteration < settings.iterations) {
+        const T beta = Detail::norm(r);
+        for (std::size_t i = 0; i < size; ++i) { basis[0][i] = r[i] / beta; }
+        std::fill(g.begin(), g.end(), T());
+        g[0] = beta;
+
+        std::size_t k = 0;
+        while (k < restart && iteration < settings.iterations) {
+            ++iteration;
+            const std::size_t j = k++;
+            T* column = hessenberg.data() + j * (restart + 1);
+
+            preconditioner.apply(basis[j].data(), z.data());
+            Detail::multiply_vector(matrix, z.data(), w.data());
+            for (std::size_t i = 0; i <= j; ++i) {
+                column[i] = Kernels::dot(size, w.data(), basis[i].data());
+                Kernels::axpy(size, -column[i], basis[i].data(), w.data());
+            }
+            column[j + 1] = Detail::norm(w);
+            const bool breakdown = column[j + 1] == T();
+            if (!breakdown) {
+                for (std::size_t i = 0; i < size; ++i) { basis[j + 1][i] = w[i] / column[j + 1]; }
+            }
+
+            for (std::size_t i = 0; i < j; ++i) {
+                const T upper = cosines[i] * column[i] + sines[i] * column[i + 1];
+                column[i + 1] = -sines[i] * column[i] + cosines[i] * column[i + 1];
+                column[i] = upper;
+            }
+            const T radius = std::sqrt(column[j] * column[j] + column[j + 1] * column[j + 1]);
+            cosines[j] = radius == T() ? T(1) : column[j] / radius;
+            sines[j] = radius == T() ? T() : column[j + 1] / radius;
+            column[j] = radius;
+            column[j + 1] = T();
+            g[j + 1] = -sines[j] * g[j];
+            g[j] = cosines[j] * g[j];
+
+            residual = std::abs(g[j + 1]) / bNorm;
+            if (residual <= settings.tolerance || breakdown) { break; }
+        }
+
+        // x += M^-1 V y with y solving the k x k triangular system R y = g.
+        for (std::size_t i = k; i-- > 0;) {
+            T sum = g[i];
+            for (std::size_t l = i + 1; l < k; ++l) { sum -= hessenberg[l * (restart + 1) + i] * y[l]; }
+            const T diagonal = hessenberg[i * (restart + 1) + i];
+            y[i] = diagonal == T() ? T() : sum / diagonal;
+        }
+        std::fill(w.begin(), w.end(), T());
+        for (std::size_t i = 0; i < k; ++i) { Kernels::axpy(size, y[i], basis[i].data(), w.data()); }
+        preconditioner.apply(w.data(), z.data());
+        Kernels::axpy(size, T(1), z.data(), x.data());
+
+        residual = Detail::residual(matrix, b, x, r) / bNorm;
+    }
+
+    return Detail::converged_result(iteration, residual, settings.tolerance);
+}
+
+template <typename M>
+inline std::vector<typename M::value_type> LinAlg::solve_gmres(const M& matrix, const std::vector<typename M::value_type>& b)
+{
+    std::vector<typename M::value_type> x;
+    const JacobiPreconditioner<typename M::value_type> preconditioner(matrix);
+    if (!solve_gmres(matrix, b, x, preconditioner).converged) { throw std::runtime_error("iterative method did not converge"); }
+    return x;
+}
+
+#endif // GMRES_HPP
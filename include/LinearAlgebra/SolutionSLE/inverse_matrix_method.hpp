@@ -1,4 +1,91 @@
 #ifndef INVERSE_MATRIX_METHOD_HPP
 #define INVERSE_MATRIX_METHOD_HPP
 
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "../Matrix.hpp"
+
+namespace LinAlg
+{
+    // Solves A x = b as x = A^-1 b. The inverse is computed once on
+    // construction, so every further solve is a single matrix-vector product.
+    template <typename T>
+    class InverseMatrixMethod
+    {
+    public:
+        explicit InverseMatrixMethod(const Matrix<T>& matrix);
+        template <typename E>
+        explicit InverseMatrixMethod(const MatrixExpression<E>& matrix);
+
+        std::size_t size() const { return _inverse.rows(); }
+        const Matrix<T>& inverse() const { return _inverse; }
+
+        std::vector<T> solve(const std::vector<T>& b) const;
+        template <typename E>
+        Matrix<T> solve(const MatrixExpression<E>& b) const;
+
+    private:
+        Matrix<T> _inverse;
+    };
+
+    template <typename T>
+    std::vector<T> solve_inverse(const Matrix<T>& matrix, const std::vector<T>& b);
+
+    template <typename E>
+    std::vector<typename E::value_type> solve_inverse(const MatrixExpression<E>& matrix, const std::vector<typename E::value_type>& b);
+}
+
+template <typename T>
+inline LinAlg::InverseMatrixMethod<T>::InverseMatrixMethod(const Matrix<T>& matrix)
+    : _inverse(matrix)
+{
+    _inverse.invert_in_place();
+}
+
+template <typename T>
+template <typename E>
+inline LinAlg::InverseMatrixMethod<T>::InverseMatrixMethod(const MatrixExpression<E>& matrix)
+    : _inverse(matrix)
+{
+    _inverse.invert_in_place();
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::InverseMatrixMethod<T>::solve(const std::vector<T>& b) const
+{
+    if (b.size() != size()) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+    std::vector<T> x(size());
+    for (std::size_t i = 0; i < size(); ++i) {
+        const T* row = _inverse.data() + i * size();
+        T sum = T();
+        for (std::size_t j = 0; j < size(); ++j) { sum += row[j] * b[j]; }
+        x[i] = sum;
+    }
+    return x;
+}
+
+template <typename T>
+template <typename E>
+inline LinAlg::Matrix<T> LinAlg::InverseMatrixMethod<T>::solve(const MatrixExpression<E>& b) const
+{
+    if (b.rows() != size()) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+    return _inverse * b;
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::solve_inverse(const Matrix<T>& matrix, const std::vector<T>& b)
+{
+    return InverseMatrixMethod<T>(matrix).solve(b);
+}
+
+template <typename E>
+inline std::vector<typename E::value_type> LinAlg::solve_inverse(const MatrixExpression<E>& matrix, const std::vector<typename E::value_type>& b)
+{
+    return InverseMatrixMethod<typename E::value_type>(matrix).solve(b);
+}
+
 #endif // INVERSE_MATRIX_METHOD_HPP
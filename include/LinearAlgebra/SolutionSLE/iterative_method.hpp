@@ -0,0 +1,150 @@
+#ifndef ITERATIVE_METHOD_HPP
+#define ITERATIVE_METHOD_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../Matrix.hpp"
+#include "../SparseMatrix.hpp"
+#include "../Kernels/elementwise.hpp"
+#include "../Kernels/gemv.hpp"
+
+namespace LinAlg
+{
+    // Stopping criteria of the Krylov solvers. A solve converges once the
+    // residual norm is at most tolerance times the norm of the right-hand side;
+    // restart is the Krylov subspace dimension of GMRES and of restarted Lanczos.
+    // The default tolerance stays above the precision T can reach.
+    template <typename T>
+    struct IterativeSettings
+    {
+        std::size_t iterations = 1000;
+        T tolerance = std::max(T(1e-10), T(10) * std::numeric_limits<T>::epsilon());
+        std::size_t restart = 30;
+    };
+
+    template <typename T>
+    struct IterativeResult
+    {
+        std::size_t iterations;
+        T residual;
+        bool converged;
+    };
+
+    // Preconditioner interface: apply(r, z) sets z = M^-1 r for vectors of size().
+    template <typename T>
+    class IdentityPreconditioner
+    {
+    public:
+        explicit IdentityPreconditioner(std::size_t size) : _size(size) {}
+        template <typename M>
+        explicit IdentityPreconditioner(const M& matrix) : _size(matrix.rows()) {}
+
+        std::size_t size() const { return _size; }
+        void apply(const T* r, T* z) const { std::copy(r, r + _size, z); }
+
+    private:
+        std::size_t _size;
+    };
+
+    namespace Detail
+    {
+        // y = A x for the operators the iterative solvers accept.
+        template <typename T, typename A>
+        void multiply_vector(const Matrix<T, A>& matrix, const T* x, T* y);
+
+        template <typename T>
+        void multiply_vector(const SparseMatrix<T>& matrix, const T* x, T* y);
+
+        // y = A^T x.
+        template <typename T, typename A>
+        void multiply_transposed_vector(const Matrix<T, A>& matrix, const T* x, T* y);
+
+        template <typename T>
+        void multiply_transposed_vector(const SparseMatrix<T>& matrix, const T* x, T* y);
+
+        // r = b - A x, returns the norm of r.
+        template <typename M, typename T>
+        T residual(const M& matrix, const std::vector<T>& b, const std::vector<T>& x, std::vector<T>& r);
+
+        template <typename T>
+        T norm(const std::vector<T>& x);
+
+        // Validates the system and prepares x for a solve: an empty x is a cold
+        // start from zero, otherwise x is the initial guess.
+        template <typename M, typename P, typename T>
+        void check_iterative(const M& matrix, const P& preconditioner, const std::vector<T>& b, std::vector<T>& x);
+
+        template <typename T>
+        IterativeResult<T> converged_result(std::size_t iterations, T residual, T target);
+    }
+}
+
+template <typename T, typename A>
+inline void LinAlg::Detail::multiply_vector(const Matrix<T, A>& matrix, const T* x, T* y)
+{
+    LinAlg::Kernels::gemv(matrix.rows(), matrix.cols(), T(1), matrix.data(), matrix.cols(), x, T(), y);
+}
+
+template <typename T>
+inline void LinAlg::Detail::multiply_vector(const SparseMatrix<T>& matrix, const T* x, T* y)
+{
+    matrix.multiply(x, y);
+}
+
+template <typename T, typename A>
+inline void LinAlg::Detail::multiply_transposed_vector(const Matrix<T, A>& matrix, const T* x, T* y)
+{
+    LinAlg::Kernels::gemv_transposed(matrix.rows(), matrix.cols(), T(1), matrix.data(), matrix.cols(), x, T(), y);
+}
+
+template <typename T>
+inline void LinAlg::Detail::multiply_transposed_vector(const SparseMatrix<T>& matrix, const T* x, T* y)
+{
+    matrix.multiply_transposed(x, y);
+}
+
+template <typename M, typename T>
+inline T LinAlg::Detail::residual(const M& matrix, const std::vector<T>& b, const std::vector<T>& x, std::vector<T>& r)
+{
+    multiply_vector(matrix, x.data(), r.data());
+    LinAlg::Kernels::sub(b.size(), b.data(), r.data(), r.data());
+    return norm(r);
+}
+
+template <typename T>
+inline T LinAlg::Detail::norm(const std::vector<T>& x)
+{
+    return std::sqrt(LinAlg::Kernels::dot(x.size(), x.data(), x.data()));
+}
+
+template <typename M, typename P, typename T>
+inline void LinAlg::Detail::check_iterative(const M& matrix, const P& preconditioner, const std::vector<T>& b, std::vector<T>& x)
+{
+    if (!std::is_floating_point<T>::value) { throw std::invalid_argument("invalid Matrix template argument"); }
+    if (!matrix.square()) { throw std::invalid_argument("square Matrix required"); }
+    if (b.size() != matrix.rows() || preconditioner.size() != matrix.rows()) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+    if (x.empty()) {
+        x.assign(b.size(), T());
+    } else if (x.size() != b.size()) {
+        throw std::invalid_argument("invalid vector argument size");
+    }
+}
+
+template <typename T>
+inline LinAlg::IterativeResult<T> LinAlg::Detail::converged_result(std::size_t iterations, T residual, T target)
+{
+    IterativeResult<T> result;
+    result.iterations = iterations;
+    result.residual = residual;
+    result.converged = residual <= target;
+    return result;
+}
+
+#endif // ITERATIVE_METHOD_HPP
@@ -0,0 +1,249 @@
+#ifndef LANCZOS_HPP
+#define LANCZOS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "iterative_method.hpp"
+#include "symmetric_eigen_decomposition.hpp"
+#include "../Matrix.hpp"
+#include "../Kernels/elementwise.hpp"
+#include "../Kernels/gemm.hpp"
+#include "../Kernels/gemv.hpp"
+
+namespace LinAlg
+{
+    // The count eigenpairs of largest magnitude, in descending order of
+    // magnitude, with the eigenvectors as columns. iterations counts operator
+    // products; converged is false when settings.iterations of them left a
+    // residual |A x - lambda x| above tolerance times the largest |lambda|.
+    template <typename T>
+    struct PartialEigenResult
+    {
+        std::vector<T> values;
+        Matrix<T> vectors;
+        std::size_t iterations;
+        bool converged;
+    };
+
+    // The count largest singular triplets in descending order; iterations
+    // counts products with A^T A or A A^T.
+    template <typename T>
+    struct PartialSVDResult
+    {
+        std::vector<T> values;
+        Matrix<T> u;
+        Matrix<T> v;
+        std::size_t iterations;
+        bool converged;
+    };
+
+    // Thick-restart Lanczos for the leading eigenpairs of a symmetric Matrix
+    // or SparseMatrix. Only products A x are taken, into preallocated basis
+    // vectors, and the basis is reorthogonalized in full through gemv. Once
+    // it reaches max(settings.restart, 2 count + 1) vectors the Ritz vectors
+    // of the wanted half are kept and the rest discarded, so memory stays at
+    // that many vectors of size n however many products convergence takes.
+    template <typename M>
+    PartialEigenResult<typename M::value_type> lanczos_eigen(const M& matrix, std::size_t count,
+                                                             const IterativeSettings<typename M::value_type>& settings = IterativeSettings<typename M::value_type>());
+
+    // Truncated SVD by Lanczos on A^T A, or on A A^T when A is wide, taking
+    // only products with A and A^T; the other singular vectors follow from one
+    // product with the Ritz vectors. Small singular values lose accuracy to
+    // the squared condition number, the leading ones a PCA needs do not.
+    template <typename M>
+    PartialSVDResult<typename M::value_type> truncated_svd(const M& matrix, std::size_t count,
+                                                           const IterativeSettings<typename M::value_type>& settings = IterativeSettings<typename M::value_type>());
+
+    namespace Detail
+    {
+        // Lanczos on the size x size symmetric operator multiply(x, y), y = A x.
+        template <typename T, typename Operator>
+        PartialEigenResult<T> lanczos(std::size_t size, std::size_t count, Operator multiply, const IterativeSettings<T>& settings);
+
+        // Fills x with a deterministic pseudo-random vector, orthogonalizes it
+        // against the first rows of basis and normalizes it.
+        template <typename T>
+        void lanczos_start_vector(std::size_t size, const T* basis, std::size_t rows, unsigned int& seed, T* x);
+
+        // x -= B^T (B x) twice for the first rows of the row-major basis B,
+        // accumulating B x into coefficients: classical Gram-Schmidt with one
+        // reorthogonalization keeps the basis orthonormal to working precision.
+        template <typename T>
+        void orthogonalize(std::size_t size, const T* basis, std::size_t rows, T* x, T* coefficients, T* work);
+    }
+}
+
+template <typename T>
+inline void LinAlg::Detail::orthogonalize(std::size_t size, const T* basis, std::size_t rows, T* x, T* coefficients, T* work)
+{
+    std::fill(coefficients, coefficients + rows, T());
+    for (std::size_t pass = 0; pass < 2; ++pass) {
+        Kernels::gemv(rows, size, T(1), basis, size, x, T(), work);
+        Kernels::gemv_transposed(rows, size, T(-1), basis, size, work, T(1), x);
+        Kernels::axpy(rows, T(1), work, coefficients);
+    }
+}
+
+template <typename T>
+inline void LinAlg::Detail::lanczos_start_vector(std::size_t size, const T* basis, std::size_t rows, unsigned int& seed, T* x)
+{
+    std::vector<T> coefficients(rows + 1), work(rows + 1);
+    T norm = T();
+    while (norm == T()) {
+        for (std::size_t i = 0; i < size; ++i) {
+            seed = seed * 1103515245u + 12345u;
+            x[i] = static_cast<T>((seed >> 16) % 2001) / T(1000) - T(1);
+        }
+        orthogonalize(size, basis, rows, x, coefficients.data(), work.data());
+        norm = std::sqrt(Kernels::dot(size, x, x));
+    }
+    Kernels::scale(size, T(1) / norm, x);
+}
+
+template <typename T, typename Operator>
+inline LinAlg::PartialEigenResult<T> LinAlg::Detail::lanczos(std::size_t size, std::size_t count, Operator multiply, const IterativeSettings<T>& settings)
+{
+    if (count == 0 || count > size) { throw std::invalid_argument("invalid eigenvalue count argument"); }
+
+    // Rows [0, dimension) of basis are orthonormal, row dimension holds the
+    // residual f of A V = V H + f e^T, H the projected dimension x dimension matrix.
+    const std::size_t dimension = std::min(size, std::max(settings.restart, 2 * count + 1));
+    Matrix<T> basis(dimension + 1, size), projected(dimension, dimension);
+    std::vector<T> coefficients(dimension + 1), work(dimension + 1);
+    unsigned int seed = 1u;
+    lanczos_start_vector(size, basis.data(), 0, seed, basis.data());
+
+    // Ritz residuals cannot be resolved much below the precision of T.
+    const T tolerance = std::max(settings.tolerance, T(10) * std::numeric_limits<T>::epsilon());
+
+    PartialEigenResult<T> result;
+    result.iterations = 0;
+    std::size_t kept = 0;
+    while (true) {
+        // The basis stops short of dimension vectors once settings.iterations
+        // products have been taken, though never below count vectors.
+        T beta = T();
+        std::size_t current = dimension;
+        for (std::size_t j = kept; j < dimension; ++j) {
+            T* w = basis.data() + (j + 1) * size;
+            multiply(static_cast<const T*>(basis.data() + j * size), w);
+            ++result.iterations;
+            orthogonalize(size, basis.data(), j + 1, w, coefficients.data(), work.data());
+            for (std::size_t i = 0; i <= j; ++i) { projected(i, j) = projected(j, i) = coefficients[i]; }
+
+            beta = std::sqrt(Kernels::dot(size, w, w));
+            if (j + 1 == dimension || (result.iterations >= settings.iterations && j + 1 >= count)) {
+                current = j + 1;
+                break;
+            }
+            const T productNorm = std::sqrt(Kernels::dot(j + 1, coefficients.data(), coefficients.data()) + beta * beta);
+            if (beta <= std::numeric_limits<T>::epsilon() * productNorm) {
+                // Invariant subspace: continue from a fresh direction, uncoupled.
+                lanczos_start_vector(size, basis.data(), j + 1, seed, w);
+                beta = T();
+            } else {
+                Kernels::scale(size, T(1) / beta, w);
+            }
+            projected(j + 1, j) = projected(j, j + 1) = beta;
+        }
+
+        const SymmetricEigenDecomposition<T> ritz(Matrix<T>(projected.block(0, 0, current, current)));
+        const Matrix<T>& y = ritz.vectors();
+        std::vector<std::size_t> order(current);
+        std::iota(order.begin(), order.end(), std::size_t(0));
+        std::stable_sort(order.begin(), order.end(), [&ritz](std::size_t lhs, std::size_t rhs) {
+            return std::abs(ritz.values()[lhs]) > std::abs(ritz.values()[rhs]);
+        });
+
+        // Ritz pair i has residual beta |y(current - 1, i)|.
+        const T target = tolerance * std::max(std::abs(ritz.values()[order[0]]), std::numeric_limits<T>::min());
+        result.converged = true;
+        for (std::size_t i = 0; i < count; ++i) { result.converged = result.converged && beta * std::abs(y(current - 1, order[i])) <= target; }
+
+        const bool done = result.converged || result.iterations >= settings.iterations;
+        const std::size_t keep = done ? count : std::min(dimension - 1, count + (dimension - count) / 2);
+        Matrix<T> selected(keep, current, uninitialized), ritzVectors(keep, size, uninitialized);
+        for (std::size_t r = 0; r < keep; ++r) {
+            for (std::size_t i = 0; i < current; ++i) { selected(r, i) = y(i, order[r]); }
+        }
+        Kernels::gemm<T>(keep, size, current, T(1), selected.data(), static_cast<std::ptrdiff_t>(current), 1,
+                         basis.data(), static_cast<std::ptrdiff_t>(size), 1, T(), ritzVectors.data(), size);
+
+        if (done) {
+            result.values.resize(count);
+            for (std::size_t i = 0; i < count; ++i) { result.values[i] = ritz.values()[order[i]]; }
+            result.vectors = Matrix<T>(ritzVectors.transposed());
+            return result;
+        }
+
+        // Restart from the kept Ritz vectors and the normalized residual. H
+        // becomes diag(theta); the couplings to the residual direction come back
+        // as orthogonalization coefficients in the next expansion.
+        std::copy(ritzVectors.data(), ritzVectors.data() + keep * size, basis.data());
+        std::copy(basis.data() + dimension * size, basis.data() + (dimension + 1) * size, basis.data() + keep * size);
+        Kernels::scale(size, T(1) / beta, basis.data() + keep * size);
+        projected.set_zero();
+        for (std::size_t i = 0; i < keep; ++i) { projected(i, i) = ritz.values()[order[i]]; }
+        kept = keep;
+    }
+}
+
+template <typename M>
+inline LinAlg::PartialEigenResult<typename M::value_type> LinAlg::lanczos_eigen(const M& matrix, std::size_t count,
+                                                                                const IterativeSettings<typename M::value_type>& settings)
+{
+    typedef typename M::value_type T;
+    if (!std::is_floating_point<T>::value) { throw std::invalid_argument("invalid Matrix template argument"); }
+    if (!matrix.square()) { throw std::invalid_argument("square Matrix required"); }
+
+    return Detail::lanczos<T>(matrix.rows(), count, [&matrix](const T* x, T* y) { Detail::multiply_vector(matrix, x, y); }, settings);
+}
+
+template <typename M>
+inline LinAlg::PartialSVDResult<typename M::value_type> LinAlg::truncated_svd(const M& matrix, std::size_t count,
+                                                                              const IterativeSettings<typename M::value_type>& settings)
+{
+    typedef typename M::value_type T;
+    if (!std::is_floating_point<T>::value) { throw std::invalid_argument("invalid Matrix template argument"); }
+    if (count == 0 || count > std::min(matrix.rows(), matrix.cols())) { throw std::invalid_argument("invalid singular value count argument"); }
+
+    // Lanczos runs on the smaller Gram matrix, through a buffer for A x or A^T x.
+    const bool wide = matrix.rows() < matrix.cols();
+    std::vector<T> product(wide ? matrix.cols() : matrix.rows());
+    T* buffer = product.data();
+    PartialEigenResult<T> eigen = wide
+        ? Detail::lanczos<T>(matrix.rows(), count, [&matrix, buffer](const T* x, T* y) {
+              Detail::multiply_transposed_vector(matrix, x, buffer);
+              Detail::multiply_vector(matrix, buffer, y);
+          }, settings)
+        : Detail::lanczos<T>(matrix.cols(), count, [&matrix, buffer](const T* x, T* y) {
+              Detail::multiply_vector(matrix, x, buffer);
+              Detail::multiply_transposed_vector(matrix, buffer, y);
+          }, settings);
+
+    PartialSVDResult<T> result;
+    result.iterations = eigen.iterations;
+    result.converged = eigen.converged;
+    result.values.resize(count);
+    for (std::size_t i = 0; i < count; ++i) { result.values[i] = std::sqrt(std::max(eigen.values[i], T())); }
+
+    // The other side is A v / sigma or A^T u / sigma; zero singular values
+    // leave a zero column.
+    Matrix<T> other = wide ? Matrix<T>(matrix.transposed() * eigen.vectors) : Matrix<T>(matrix * eigen.vectors);
+    for (std::size_t i = 0; i < other.rows(); ++i) {
+        for (std::size_t j = 0; j < count; ++j) { other(i, j) = (result.values[j] == T()) ? T() : other(i, j) / result.values[j]; }
+    }
+    result.u = wide ? std::move(eigen.vectors) : std::move(other);
+    result.v = wide ? std::move(other) : std::move(eigen.vectors);
+    return result;
+}
+
+#endif // LANCZOS_HPP
@@ -0,0 +1,219 @@
+#ifndef LDLT_DECOMPOSITION_HPP
+#define LDLT_DECOMPOSITION_HPP
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../Matrix.hpp"
+#include "../SparseMatrix.hpp"
+#include "../StructuredMatrix.hpp"
+#include "../Kernels/cholesky.hpp"
+
+namespace LinAlg
+{
+    // P A P^T = L D L^T factorization of a symmetric, possibly indefinite matrix
+    // with Bunch-Kaufman pivoting, D holding 1 x 1 and 2 x 2 diagonal blocks.
+    // Only the lower triangle of the input is read; the factor is kept packed.
+    template <typename T>
+    class LDLTDecomposition
+    {
+    public:
+        explicit LDLTDecomposition(const Matrix<T>& matrix);
+        explicit LDLTDecomposition(Matrix<T>&& matrix);
+        template <typename E>
+        explicit LDLTDecomposition(const MatrixExpression<E>& matrix);
+        explicit LDLTDecomposition(const SparseMatrix<T>& matrix);
+        explicit LDLTDecomposition(const SymmetricMatrix<T>& matrix);
+
+        std::size_t size() const { return _size; }
+        bool singular() const { return _singular; }
+        const std::vector<T>& packed() const { return _packed; }
+        const std::vector<std::size_t>& pivots() const { return _pivots; }
+        const std::vector<unsigned char>& blocks() const { return _blocks; }
+
+        Matrix<T> diagonal() const;
+        T determinant() const;
+
+        std::vector<T> solve(const std::vector<T>& b) const;
+        template <typename E>
+        Matrix<T> solve(const MatrixExpression<E>& b) const;
+        void solve_in_place(std::vector<T>& b) const;
+        void solve_in_place(Matrix<T>& b) const;
+
+    private:
+        std::size_t _size;
+        std::vector<T> _packed;
+        std::vector<std::size_t> _pivots;
+        std::vector<unsigned char> _blocks;
+        bool _singular;
+
+        void factor(Matrix<T>& matrix);
+        void check_solvable(std::size_t rows) const;
+    };
+
+    template <typename T>
+    std::vector<T> solve_ldlt(const Matrix<T>& matrix, const std::vector<T>& b);
+
+    template <typename E>
+    std::vector<typename E::value_type> solve_ldlt(const MatrixExpression<E>& matrix, const std::vector<typename E::value_type>& b);
+
+    template <typename T>
+    std::vector<T> solve_ldlt(const SparseMatrix<T>& matrix, const std::vector<T>& b);
+
+    template <typename T>
+    std::vector<T> solve_ldlt(const SymmetricMatrix<T>& matrix, const std::vector<T>& b);
+}
+
+template <typename T>
+inline LinAlg::LDLTDecomposition<T>::LDLTDecomposition(const Matrix<T>& matrix)
+    : _size(matrix.rows()), _packed(), _pivots(), _blocks(), _singular(false)
+{
+    Matrix<T> work(matrix);
+    factor(work);
+}
+
+template <typename T>
+inline LinAlg::LDLTDecomposition<T>::LDLTDecomposition(Matrix<T>&& matrix)
+    : _size(matrix.rows()), _packed(), _pivots(), _blocks(), _singular(false)
+{
+    factor(matrix);
+}
+
+template <typename T>
+template <typename E>
+inline LinAlg::LDLTDecomposition<T>::LDLTDecomposition(const MatrixExpression<E>& matrix)
+    : _size(matrix.rows()), _packed(), _pivots(), _blocks(), _singular(false)
+{
+    Matrix<T> work(matrix);
+    factor(work);
+}
+
+template <typename T>
+inline LinAlg::LDLTDecomposition<T>::LDLTDecomposition(const SparseMatrix<T>& matrix)
+    : _size(matrix.rows()), _packed(), _pivots(), _blocks(), _singular(false)
+{
+    Matrix<T> work(matrix.to_dense());
+    factor(work);
+}
+
+template <typename T>
+inline LinAlg::LDLTDecomposition<T>::LDLTDecomposition(const SymmetricMatrix<T>& matrix)
+    : _size(matrix.rows()), _packed(), _pivots(), _blocks(), _singular(false)
+{
+    Matrix<T> work(matrix.to_dense());
+    factor(work);
+}
+
+template <typename T>
+inline void LinAlg::LDLTDecomposition<T>::factor(Matrix<T>& matrix)
+{
+    if (!std::is_floating_point<T>::value) { throw std::invalid_argument("invalid Matrix template argument"); }
+    if (!matrix.square()) { throw std::invalid_argument("square Matrix required"); }
+
+    _pivots.resize(_size);
+    _blocks.resize(_size);
+    _singular = Kernels::ldlt_factor(_size, matrix.data(), matrix.cols(), _pivots.data(), _blocks.data()) != 0;
+    _packed.resize(Kernels::packed_size(_size));
+    Kernels::pack_lower(_size, matrix.data(), matrix.cols(), _packed.data());
+}
+
+template <typename T>
+inline void LinAlg::LDLTDecomposition<T>::check_solvable(std::size_t rows) const
+{
+    if (rows != size()) { throw std::invalid_argument("invalid Matrix argument size"); }
+    if (_singular) { throw std::runtime_error("null determinant"); }
+}
+
+template <typename T>
+inline LinAlg::Matrix<T> LinAlg::LDLTDecomposition<T>::diagonal() const
+{
+    Matrix<T> diagonalMatrix(size(), size());
+    for (std::size_t i = 0; i < size(); ++i) {
+        diagonalMatrix(i, i) = _packed[Kernels::packed_index(i, i)];
+        if (_blocks[i] == 0) {
+            diagonalMatrix(i, i - 1) = _packed[Kernels::packed_index(i, i - 1)];
+            diagonalMatrix(i - 1, i) = diagonalMatrix(i, i - 1);
+        }
+    }
+    return diagonalMatrix;
+}
+
+// Symmetric interchanges leave the determinant unchanged, so it is the product
+// of the determinants of the diagonal blocks.
+template <typename T>
+inline T LinAlg::LDLTDecomposition<T>::determinant() const
+{
+    if (size() == 0) { return T(); }
+
+    T determinant = T(1);
+    for (std::size_t i = 0; i < size(); ++i) {
+        const T diagonal = _packed[Kernels::packed_index(i, i)];
+        if (_blocks[i] == 1) {
+            determinant *= diagonal;
+        } else if (_blocks[i] == 0) {
+            const T offDiagonal = _packed[Kernels::packed_index(i, i - 1)];
+            determinant *= _packed[Kernels::packed_index(i - 1, i - 1)] * diagonal - offDiagonal * offDiagonal;
+        }
+    }
+    return determinant;
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::LDLTDecomposition<T>::solve(const std::vector<T>& b) const
+{
+    std::vector<T> x(b);
+    solve_in_place(x);
+    return x;
+}
+
+template <typename T>
+template <typename E>
+inline LinAlg::Matrix<T> LinAlg::LDLTDecomposition<T>::solve(const MatrixExpression<E>& b) const
+{
+    Matrix<T> x(b);
+    solve_in_place(x);
+    return x;
+}
+
+template <typename T>
+inline void LinAlg::LDLTDecomposition<T>::solve_in_place(std::vector<T>& b) const
+{
+    check_solvable(b.size());
+    Kernels::ldlt_solve_packed(size(), 1, _packed.data(), _pivots.data(), _blocks.data(), b.data(), 1);
+}
+
+template <typename T>
+inline void LinAlg::LDLTDecomposition<T>::solve_in_place(Matrix<T>& b) const
+{
+    check_solvable(b.rows());
+    if (b.cols() == 0) { return; }
+    Kernels::ldlt_solve_packed(size(), b.cols(), _packed.data(), _pivots.data(), _blocks.data(), b.data(), b.cols());
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::solve_ldlt(const Matrix<T>& matrix, const std::vector<T>& b)
+{
+    return LDLTDecomposition<T>(matrix).solve(b);
+}
+
+template <typename E>
+inline std::vector<typename E::value_type> LinAlg::solve_ldlt(const MatrixExpression<E>& matrix, const std::vector<typename E::value_type>& b)
+{
+    return LDLTDecomposition<typename E::value_type>(matrix).solve(b);
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::solve_ldlt(const SparseMatrix<T>& matrix, const std::vector<T>& b)
+{
+    return LDLTDecomposition<T>(matrix).solve(b);
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::solve_ldlt(const SymmetricMatrix<T>& matrix, const std::vector<T>& b)
+{
+    return LDLTDecomposition<T>(matrix).solve(b);
+}
+
+#endif // LDLT_DECOMPOSITION_HPP
@@ -1,4 +1,236 @@
 #ifndef LU_DECOMPOSITION_HPP
 #define LU_DECOMPOSITION_HPP
 
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../Matrix.hpp"
+#include "../SparseMatrix.hpp"
+#include "../StructuredMatrix.hpp"
+#include "../Kernels/lu.hpp"
+
+namespace LinAlg
+{
+    // PA = LU factorization with partial pivoting. The matrix is factored once
+    // on construction, every solve afterwards costs O(n^2) per right-hand side.
+    template <typename T>
+    class LUDecomposition
+    {
+    public:
+        explicit LUDecomposition(const Matrix<T>& matrix);
+        explicit LUDecomposition(Matrix<T>&& matrix);
+        template <typename E>
+        explicit LUDecomposition(const MatrixExpression<E>& matrix);
+        explicit LUDecomposition(const SparseMatrix<T>& matrix);
+
+        std::size_t size() const { return _lu.rows(); }
+        bool singular() const { return _singular; }
+        const Matrix<T>& factors() const { return _lu; }
+        const std::vector<std::size_t>& pivots() const { return _pivots; }
+
+        Matrix<T> lower() const;
+        Matrix<T> upper() const;
+        // The factors in packed form, L with its unit diagonal stored.
+        TriangularMatrix<T> lower_triangular() const;
+        TriangularMatrix<T> upper_triangular() const;
+        T determinant() const;
+
+        std::vector<T> solve(const std::vector<T>& b) const;
+        template <typename E>
+        Matrix<T> solve(const MatrixExpression<E>& b) const;
+        void solve_in_place(std::vector<T>& b) const;
+        void solve_in_place(Matrix<T>& b) const;
+        void solve_in_place(const MatrixView<T>& b) const;
+
+    private:
+        Matrix<T> _lu;
+        std::vector<std::size_t> _pivots;
+        bool _singular;
+
+        void factor();
+        void check_solvable(std::size_t rows) const;
+    };
+
+    template <typename T>
+    std::vector<T> solve_lu(const Matrix<T>& matrix, const std::vector<T>& b);
+
+    template <typename E>
+    std::vector<typename E::value_type> solve_lu(const MatrixExpression<E>& matrix, const std::vector<typename E::value_type>& b);
+
+    template <typename T>
+    std::vector<T> solve_lu(const SparseMatrix<T>& matrix, const std::vector<T>& b);
+}
+
+template <typename T>
+inline LinAlg::LUDecomposition<T>::LUDecomposition(const Matrix<T>& matrix)
+    : _lu(matrix), _pivots(), _singular(false)
+{
+    factor();
+}
+
+template <typename T>
+inline LinAlg::LUDecomposition<T>::LUDecomposition(Matrix<T>&& matrix)
+    : _lu(std::move(matrix)), _pivots(), _singular(false)
+{
+    factor();
+}
+
+template <typename T>
+template <typename E>
+inline LinAlg::LUDecomposition<T>::LUDecomposition(const MatrixExpression<E>& matrix)
+    : _lu(matrix), _pivots(), _singular(false)
+{
+    factor();
+}
+
+// LU fill-in is unbounded for general sparsity patterns, so sparse input is
+// factored in dense form.
+template <typename T>
+inline LinAlg::LUDecomposition<T>::LUDecomposition(const SparseMatrix<T>& matrix)
+    : _lu(matrix.to_dense()), _pivots(), _singular(false)
+{
+    factor();
+}
+
+template <typename T>
+inline void LinAlg::LUDecomposition<T>::factor()
+{
+    if (!std::is_floating_point<T>::value) { throw std::invalid_argument("invalid Matrix template argument"); }
+    if (!_lu.square()) { throw std::invalid_argument("square Matrix required"); }
+
+    _pivots.resize(_lu.rows());
+    _singular = Kernels::lu_factor(_lu.rows(), _lu.data(), _lu.cols(), _pivots.data()) != 0;
+}
+
+template <typename T>
+inline void LinAlg::LUDecomposition<T>::check_solvable(std::size_t rows) const
+{
+    if (rows != size()) { throw std::invalid_argument("invalid Matrix argument size"); }
+    if (_singular) { throw std::runtime_error("null determinant"); }
+}
+
+template <typename T>
+inline LinAlg::Matrix<T> LinAlg::LUDecomposition<T>::lower() const
+{
+    Matrix<T> lowerMatrix(size(), size());
+    for (std::size_t i = 0; i < size(); ++i) {
+        for (std::size_t j = 0; j < i; ++j) { lowerMatrix(i, j) = _lu(i, j); }
+        lowerMatrix(i, i) = T(1);
+    }
+    return lowerMatrix;
+}
+
+template <typename T>
+inline LinAlg::Matrix<T> LinAlg::LUDecomposition<T>::upper() const
+{
+    Matrix<T> upperMatrix(size(), size());
+    for (std::size_t i = 0; i < size(); ++i) {
+        for (std::size_t j = i; j < size(); ++j) { upperMatrix(i, j) = _lu(i, j); }
+    }
+    return upperMatrix;
+}
+
+template <typename T>
+inline LinAlg::TriangularMatrix<T> LinAlg::LUDecomposition<T>::lower_triangular() const
+{
+    TriangularMatrix<T> lowerMatrix(Triangle::lower, size());
+    for (std::size_t i = 0; i < size(); ++i) {
+        for (std::size_t j = 0; j < i; ++j) { lowerMatrix.set(i, j, _lu(i, j)); }
+        lowerMatrix.set(i, i, T(1));
+    }
+    return lowerMatrix;
+}
+
+template <typename T>
+inline LinAlg::TriangularMatrix<T> LinAlg::LUDecomposition<T>::upper_triangular() const
+{
+    TriangularMatrix<T> upperMatrix(Triangle::upper, size());
+    for (std::size_t i = 0; i < size(); ++i) {
+        for (std::size_t j = i; j < size(); ++j) { upperMatrix.set(i, j, _lu(i, j)); }
+    }
+    return upperMatrix;
+}
+
+template <typename T>
+inline T LinAlg::LUDecomposition<T>::determinant() const
+{
+    if (size() == 0) { return T(); }
+
+    T determinant = T(1);
+    for (std::size_t i = 0; i < size(); ++i) {
+        determinant *= _lu(i, i);
+        if (_pivots[i] != i) { determinant = -determinant; }
+    }
+    return determinant;
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::LUDecomposition<T>::solve(const std::vector<T>& b) const
+{
+    std::vector<T> x(b);
+    solve_in_place(x);
+    return x;
+}
+
+template <typename T>
+template <typename E>
+inline LinAlg::Matrix<T> LinAlg::LUDecomposition<T>::solve(const MatrixExpression<E>& b) const
+{
+    Matrix<T> x(b);
+    solve_in_place(x);
+    return x;
+}
+
+template <typename T>
+inline void LinAlg::LUDecomposition<T>::solve_in_place(std::vector<T>& b) const
+{
+    check_solvable(b.size());
+    Kernels::lu_solve(size(), 1, _lu.data(), _lu.cols(), _pivots.data(), b.data(), 1);
+}
+
+template <typename T>
+inline void LinAlg::LUDecomposition<T>::solve_in_place(Matrix<T>& b) const
+{
+    check_solvable(b.rows());
+    if (b.cols() == 0) { return; }
+    Kernels::lu_solve(size(), b.cols(), _lu.data(), _lu.cols(), _pivots.data(), b.data(), b.cols());
+}
+
+template <typename T>
+inline void LinAlg::LUDecomposition<T>::solve_in_place(const MatrixView<T>& b) const
+{
+    check_solvable(b.rows());
+    if (b.cols() == 0) { return; }
+
+    if (!b.contiguous_rows()) {
+        Matrix<T> x(b);
+        solve_in_place(x);
+        MatrixView<T> target(b);
+        target = x;
+        return;
+    }
+    Kernels::lu_solve(size(), b.cols(), _lu.data(), _lu.cols(), _pivots.data(), b.data(), static_cast<std::size_t>(b.row_stride()));
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::solve_lu(const Matrix<T>& matrix, const std::vector<T>& b)
+{
+    return LUDecomposition<T>(matrix).solve(b);
+}
+
+template <typename E>
+inline std::vector<typename E::value_type> LinAlg::solve_lu(const MatrixExpression<E>& matrix, const std::vector<typename E::value_type>& b)
+{
+    return LUDecomposition<typename E::value_type>(matrix).solve(b);
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::solve_lu(const SparseMatrix<T>& matrix, const std::vector<T>& b)
+{
+    return LUDecomposition<T>(matrix).solve(b);
+}
+
 #endif // LU_DECOMPOSITION_HPP
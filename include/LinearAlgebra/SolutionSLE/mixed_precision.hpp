@@ -0,0 +1,137 @@
+#ifndef MIXED_PRECISION_HPP
+#define MIXED_PRECISION_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../Matrix.hpp"
+#include "../Kernels/elementwise.hpp"
+#include "../Kernels/gemv.hpp"
+#include "iterative_method.hpp"
+#include "lu_decomposition.hpp"
+
+namespace LinAlg
+{
+    // LU factorization in the lower precision Low refined to the accuracy of T,
+    // as in LAPACK's dsgesv. The O(n^3) factorization runs at the vector width
+    // and bandwidth of Low; each refinement step costs an O(n^2) residual in T
+    // and a triangular solve in Low, and converges when A is well conditioned
+    // relative to the precision of Low.
+    template <typename T, typename Low = float>
+    class MixedPrecisionLUDecomposition
+    {
+    public:
+        explicit MixedPrecisionLUDecomposition(const Matrix<T>& matrix);
+
+        std::size_t size() const { return _matrix.rows(); }
+        bool singular() const { return _lu.singular(); }
+        const LUDecomposition<Low>& factorization() const { return _lu; }
+
+        // Refines x, empty for a cold start, until the normwise backward error
+        // |b - Ax| / (|A| |x| + |b|) in the infinity norm reaches the tolerance.
+        // Stops early once a step fails to halve the error.
+        IterativeResult<T> solve(const std::vector<T>& b, std::vector<T>& x, const IterativeSettings<T>& settings) const;
+
+        // Refines to a backward error of sqrt(n) eps(T) and falls back to a full
+        // precision factorization when refinement does not get there.
+        std::vector<T> solve(const std::vector<T>& b) const;
+
+    private:
+        Matrix<T> _matrix;
+        LUDecomposition<Low> _lu;
+        T _matrixNorm;
+
+        static T infinity_norm(const std::vector<T>& x);
+    };
+
+    template <typename T>
+    std::vector<T> solve_mixed_precision(const Matrix<T>& matrix, const std::vector<T>& b);
+}
+
+template <typename T, typename Low>
+inline LinAlg::MixedPrecisionLUDecomposition<T, Low>::MixedPrecisionLUDecomposition(const Matrix<T>& matrix)
+    : _matrix(matrix), _lu(Matrix<Low>(matrix)), _matrixNorm()
+{
+    if (!std::is_floating_point<T>::value) { throw std::invalid_argument("invalid Matrix template argument"); }
+
+    for (std::size_t i = 0; i < _matrix.rows(); ++i) {
+        const T* row = _matrix.data() + i * _matrix.cols();
+        T rowNorm = T();
+        for (std::size_t j = 0; j < _matrix.cols(); ++j) { rowNorm += std::fabs(row[j]); }
+        _matrixNorm = std::max(_matrixNorm, rowNorm);
+    }
+}
+
+template <typename T, typename Low>
+inline T LinAlg::MixedPrecisionLUDecomposition<T, Low>::infinity_norm(const std::vector<T>& x)
+{
+    T result = T();
+    for (const T value : x) { result = std::max(result, std::fabs(value)); }
+    return result;
+}
+
+template <typename T, typename Low>
+inline LinAlg::IterativeResult<T> LinAlg::MixedPrecisionLUDecomposition<T, Low>::solve(const std::vector<T>& b, std::vector<T>& x,
+                                                                                       const IterativeSettings<T>& settings) const
+{
+    const std::size_t n = size();
+    if (b.size() != n) { throw std::invalid_argument("invalid Matrix argument size"); }
+    if (_lu.singular()) { throw std::runtime_error("null determinant"); }
+
+    std::vector<Low> correction(n);
+    if (x.empty()) {
+        Kernels::convert(n, b.data(), correction.data());
+        _lu.solve_in_place(correction);
+        x.resize(n);
+        Kernels::convert(n, correction.data(), x.data());
+    } else if (x.size() != n) {
+        throw std::invalid_argument("invalid vector argument size");
+    }
+
+    const T bNorm = infinity_norm(b);
+    std::vector<T> r(n), update(n);
+    T previous = std::numeric_limits<T>::infinity();
+    std::size_t iteration = 0;
+    while (true) {
+        std::copy(b.begin(), b.end(), r.begin());
+        Kernels::gemv(n, n, T(-1), _matrix.data(), _matrix.cols(), x.data(), T(1), r.data());
+
+        const T scale = _matrixNorm * infinity_norm(x) + bNorm;
+        const T error = scale == T() ? T() : infinity_norm(r) / scale;
+        if (error <= settings.tolerance || iteration == settings.iterations || !(error < previous / T(2))) {
+            return Detail::converged_result(iteration, error, settings.tolerance);
+        }
+        previous = error;
+
+        Kernels::convert(n, r.data(), correction.data());
+        _lu.solve_in_place(correction);
+        Kernels::convert(n, correction.data(), update.data());
+        Kernels::axpy(n, T(1), update.data(), x.data());
+        ++iteration;
+    }
+}
+
+template <typename T, typename Low>
+inline std::vector<T> LinAlg::MixedPrecisionLUDecomposition<T, Low>::solve(const std::vector<T>& b) const
+{
+    IterativeSettings<T> settings;
+    settings.iterations = 30;
+    settings.tolerance = std::sqrt(static_cast<T>(size())) * std::numeric_limits<T>::epsilon();
+
+    std::vector<T> x;
+    if (!_lu.singular() && solve(b, x, settings).converged) { return x; }
+    return LUDecomposition<T>(_matrix).solve(b);
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::solve_mixed_precision(const Matrix<T>& matrix, const std::vector<T>& b)
+{
+    return MixedPrecisionLUDecomposition<T>(matrix).solve(b);
+}
+
+#endif // MIXED_PRECISION_HPP
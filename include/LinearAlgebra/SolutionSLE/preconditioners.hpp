@@ -0,0 +1,257 @@
+#ifndef PRECONDITIONERS_HPP
+#define PRECONDITIONERS_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "../Matrix.hpp"
+#include "../SparseMatrix.hpp"
+
+namespace LinAlg
+{
+    // M = diag(A).
+    template <typename T>
+    class JacobiPreconditioner
+    {
+    public:
+        template <typename M>
+        explicit JacobiPreconditioner(const M& matrix);
+
+        std::size_t size() const { return _inverseDiagonal.size(); }
+        void apply(const T* r, T* z) const;
+
+    private:
+        std::vector<T> _inverseDiagonal;
+    };
+
+    // M = LU, where L and U restricted to the sparsity pattern of A satisfy
+    // (LU)(i, j) = A(i, j) on that pattern. Applying it costs two sparse
+    // triangular solves. Dense input keeps its nonzeros as the pattern.
+    template <typename T>
+    class ILU0Preconditioner
+    {
+    public:
+        explicit ILU0Preconditioner(const SparseMatrix<T>& matrix);
+        template <typename E>
+        explicit ILU0Preconditioner(const MatrixExpression<E>& matrix);
+
+        std::size_t size() const { return _factors.rows(); }
+        const SparseMatrix<T>& factors() const { return _factors; }
+        void apply(const T* r, T* z) const;
+
+    private:
+        SparseMatrix<T> _factors;
+        std::vector<std::size_t> _diagonal;
+
+        void factor();
+    };
+
+    // M = L L^T for symmetric positive definite A, with L restricted to the
+    // pattern of the lower triangle of A.
+    template <typename T>
+    class IC0Preconditioner
+    {
+    public:
+        explicit IC0Preconditioner(const SparseMatrix<T>& matrix);
+        template <typename E>
+        explicit IC0Preconditioner(const MatrixExpression<E>& matrix);
+
+        std::size_t size() const { return _factor.rows(); }
+        const SparseMatrix<T>& factor() const { return _factor; }
+        void apply(const T* r, T* z) const;
+
+    private:
+        SparseMatrix<T> _factor;
+
+        static SparseMatrix<T> lower_triangle(const SparseMatrix<T>& matrix);
+        void factorize();
+    };
+}
+
+template <typename T>
+template <typename M>
+inline LinAlg::JacobiPreconditioner<T>::JacobiPreconditioner(const M& matrix)
+    : _inverseDiagonal(matrix.rows())
+{
+    if (!matrix.square()) { throw std::invalid_argument("square Matrix required"); }
+
+    for (std::size_t i = 0; i < _inverseDiagonal.size(); ++i) {
+        const T diagonal = matrix(i, i);
+        if (diagonal == T()) { throw std::runtime_error("null diagonal element"); }
+        _inverseDiagonal[i] = T(1) / diagonal;
+    }
+}
+
+template <typename T>
+inline void LinAlg::JacobiPreconditioner<T>::apply(const T* r, T* z) const
+{
+    for (std::size_t i = 0; i < _inverseDiagonal.size(); ++i) { z[i] = _inverseDiagonal[i] * r[i]; }
+}
+
+template <typename T>
+inline LinAlg::ILU0Preconditioner<T>::ILU0Preconditioner(const SparseMatrix<T>& matrix)
+    : _factors(matrix), _diagonal()
+{
+    factor();
+}
+
+template <typename T>
+template <typename E>
+inline LinAlg::ILU0Preconditioner<T>::ILU0Preconditioner(const MatrixExpression<E>& matrix)
+    : _factors(matrix), _diagonal()
+{
+    factor();
+}
+
+// Row-wise IKJ elimination that discards every update outside the pattern.
+template <typename T>
+inline void LinAlg::ILU0Preconditioner<T>::factor()
+{
+    if (!_factors.square()) { throw std::invalid_argument("square Matrix required"); }
+
+    const std::size_t size = _factors.rows();
+    const std::size_t none = std::numeric_limits<std::size_t>::max();
+    const std::vector<std::size_t>& pointers = _factors.row_pointers();
+    const std::vector<std::size_t>& indices = _factors.col_indices();
+    std::vector<T> values = _factors.values();
+
+    _diagonal.assign(size, none);
+    for (std::size_t i = 0; i < size; ++i) {
+        for (std::size_t p = pointers[i]; p < pointers[i + 1]; ++p) {
+            if (indices[p] == i) { _diagonal[i] = p; }
+        }
+        if (_diagonal[i] == none) { throw std::runtime_error("null diagonal element"); }
+    }
+
+    std::vector<std::size_t> position(size, none);
+    for (std::size_t i = 0; i < size; ++i) {
+        for (std::size_t p = pointers[i]; p < pointers[i + 1]; ++p) { position[indices[p]] = p; }
+
+        for (std::size_t p = pointers[i]; p < pointers[i + 1] && indices[p] < i; ++p) {
+            const std::size_t k = indices[p];
+            values[p] /= values[_diagonal[k]];
+            for (std::size_t q = _diagonal[k] + 1; q < pointers[k + 1]; ++q) {
+                if (position[indices[q]] != none) { values[position[indices[q]]] -= values[p] * values[q]; }
+            }
+        }
+        if (values[_diagonal[i]] == T()) { throw std::runtime_error("null pivot"); }
+
+        for (std::size_t p = pointers[i]; p < pointers[i + 1]; ++p) { position[indices[p]] = none; }
+    }
+
+    _factors = SparseMatrix<T>(size, size, pointers, indices, std::move(values));
+}
+
+template <typename T>
+inline void LinAlg::ILU0Preconditioner<T>::apply(const T* r, T* z) const
+{
+    const std::size_t size = _factors.rows();
+    const std::size_t* pointers = _factors.row_pointers().data();
+    const std::size_t* indices = _factors.col_indices().data();
+    const T* values = _factors.values().data();
+
+    for (std::size_t i = 0; i < size; ++i) {
+        T sum = r[i];
+        for (std::size_t p = pointers[i]; p < _diagonal[i]; ++p) { sum -= values[p] * z[indices[p]]; }
+        z[i] = sum;
+    }
+    for (std::size_t i = size; i-- > 0;) {
+        T sum = z[i];
+        for (std::size_t p = _diagonal[i] + 1; p < pointers[i + 1]; ++p) { sum -= values[p] * z[indices[p]]; }
+        z[i] = sum / values[_diagonal[i]];
+    }
+}
+
+template <typename T>
+inline LinAlg::IC0Preconditioner<T>::IC0Preconditioner(const SparseMatrix<T>& matrix)
+    : _factor(lower_triangle(matrix))
+{
+    factorize();
+}
+
+template <typename T>
+template <typename E>
+inline LinAlg::IC0Preconditioner<T>::IC0Preconditioner(const MatrixExpression<E>& matrix)
+    : _factor(lower_triangle(SparseMatrix<T>(matrix)))
+{
+    factorize();
+}
+
+template <typename T>
+inline LinAlg::SparseMatrix<T> LinAlg::IC0Preconditioner<T>::lower_triangle(const SparseMatrix<T>& matrix)
+{
+    if (!matrix.square()) { throw std::invalid_argument("square Matrix required"); }
+
+    std::vector<std::size_t> pointers(matrix.rows() + 1, 0), indices;
+    std::vector<T> values;
+    for (std::size_t i = 0; i < matrix.rows(); ++i) {
+        for (std::size_t p = matrix.row_pointers()[i]; p < matrix.row_pointers()[i + 1] && matrix.col_indices()[p] <= i; ++p) {
+            indices.push_back(matrix.col_indices()[p]);
+            values.push_back(matrix.values()[p]);
+        }
+        if (indices.size() == pointers[i] || indices.back() != i) { throw std::runtime_error("null diagonal element"); }
+        pointers[i + 1] = indices.size();
+    }
+    return SparseMatrix<T>(matrix.rows(), matrix.cols(), std::move(pointers), std::move(indices), std::move(values));
+}
+
+// Row i of L follows from the rows above it: L(i, k) = (A(i, k) - L(i, :k) . L(k, :k)) / L(k, k),
+// where both rows are sorted, so each dot product is a merge of two index lists.
+template <typename T>
+inline void LinAlg::IC0Preconditioner<T>::factorize()
+{
+    const std::size_t size = _factor.rows();
+    const std::vector<std::size_t>& pointers = _factor.row_pointers();
+    const std::vector<std::size_t>& indices = _factor.col_indices();
+    std::vector<T> values = _factor.values();
+
+    for (std::size_t i = 0; i < size; ++i) {
+        const std::size_t diagonal = pointers[i + 1] - 1;
+        for (std::size_t p = pointers[i]; p <= diagonal; ++p) {
+            const std::size_t k = indices[p];
+            T sum = values[p];
+            for (std::size_t q = pointers[i], s = pointers[k]; q < p && s < pointers[k + 1] - 1;) {
+                if (indices[q] < indices[s]) {
+                    ++q;
+                } else if (indices[s] < indices[q]) {
+                    ++s;
+                } else {
+                    sum -= values[q++] * values[s++];
+                }
+            }
+
+            if (p < diagonal) {
+                values[p] = sum / values[pointers[k + 1] - 1];
+            } else {
+                if (!(sum > T())) { throw std::runtime_error("Matrix is not positive definite"); }
+                values[p] = std::sqrt(sum);
+            }
+        }
+    }
+
+    _factor = SparseMatrix<T>(size, size, pointers, indices, std::move(values));
+}
+
+template <typename T>
+inline void LinAlg::IC0Preconditioner<T>::apply(const T* r, T* z) const
+{
+    const std::size_t size = _factor.rows();
+    const std::size_t* pointers = _factor.row_pointers().data();
+    const std::size_t* indices = _factor.col_indices().data();
+    const T* values = _factor.values().data();
+
+    for (std::size_t i = 0; i < size; ++i) {
+        T sum = r[i];
+        for (std::size_t p = pointers[i]; p + 1 < pointers[i + 1]; ++p) { sum -= values[p] * z[indices[p]]; }
+        z[i] = sum / values[pointers[i + 1] - 1];
+    }
+    for (std::size_t i = size; i-- > 0;) {
+        z[i] /= values[pointers[i + 1] - 1];
+        for (std::size_t p = pointers[i]; p + 1 < pointers[i + 1]; ++p) { z[indices[p]] -= values[p] * z[i]; }
+    }
+}
+
+#endif // PRECONDITIONERS_HPP
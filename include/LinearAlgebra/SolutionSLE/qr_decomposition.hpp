@@ -0,0 +1,340 @@
+#ifndef QR_DECOMPOSITION_HPP
+#define QR_DECOMPOSITION_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../ExecutionPolicy.hpp"
+#include "../Matrix.hpp"
+#include "../Kernels/qr.hpp"
+
+namespace LinAlg
+{
+    // A = QR factorization of an m x n matrix by blocked Householder reflections.
+    // Q is kept implicitly as the reflectors below the diagonal and the compact
+    // WY factor of every panel, so applying it runs through gemm. For m >= n and
+    // full column rank, solve returns the least-squares solution of A x = b
+    // without forming the normal equations A^T A, whose condition number is the
+    // square of that of A.
+    template <typename T>
+    class QRDecomposition
+    {
+    public:
+        explicit QRDecomposition(const Matrix<T>& matrix);
+        explicit QRDecomposition(Matrix<T>&& matrix);
+        template <typename E>
+        explicit QRDecomposition(const MatrixExpression<E>& matrix);
+
+        std::size_t rows() const { return _qr.rows(); }
+        std::size_t cols() const { return _qr.cols(); }
+        const Matrix<T>& factors() const { return _qr; }
+        // Fewer rows than columns, or an exactly zero diagonal entry of R.
+        bool rank_deficient() const;
+
+        // The min(m, n) x n upper trapezoidal R and the m x min(m, n) Q with
+        // orthonormal columns, A = QR.
+        Matrix<T> r() const;
+        Matrix<T> q() const;
+
+        // b = Q^T b and b = Q b for b with rows() rows.
+        void apply_transpose(std::vector<T>& b) const;
+        void apply_transpose(Matrix<T>& b) const;
+        void apply(std::vector<T>& b) const;
+        void apply(Matrix<T>& b) const;
+
+        // Minimizes |A x - b| for m >= n; x has cols() rows.
+        std::vector<T> solve(const std::vector<T>& b) const;
+        template <typename E>
+        Matrix<T> solve(const MatrixExpression<E>& b) const;
+
+    private:
+        Matrix<T> _qr;
+        std::vector<T> _t;
+
+        void factor();
+        void check_solvable(std::size_t rows) const;
+    };
+
+    // Tall-skinny QR: the rows are split into blocks that are factored
+    // concurrently, and the stacked n x n R factors of the blocks are factored
+    // once more into the final R. The row blocks never communicate, so the
+    // factorization scales with the execution policy even when n is too small
+    // for the trailing updates of QRDecomposition to be split usefully.
+    template <typename T>
+    class TSQRDecomposition
+    {
+    public:
+        // blockRows of zero picks enough blocks to occupy the execution policy;
+        // blocks never have fewer than n rows.
+        explicit TSQRDecomposition(const Matrix<T>& matrix, std::size_t blockRows = 0);
+
+        std::size_t rows() const { return _rows; }
+        std::size_t cols() const { return _cols; }
+        std::size_t block_count() const { return _blocks.size(); }
+        bool rank_deficient() const { return _top.rank_deficient(); }
+
+        // The n x n upper triangular R.
+        Matrix<T> r() const { return _top.r(); }
+
+        // Minimizes |A x - b|; x has cols() rows.
+        std::vector<T> solve(const std::vector<T>& b) const;
+        template <typename E>
+        Matrix<T> solve(const MatrixExpression<E>& b) const;
+
+    private:
+        std::size_t _rows;
+        std::size_t _cols;
+        std::vector<std::size_t> _offsets;
+        std::vector< QRDecomposition<T> > _blocks;
+        QRDecomposition<T> _top;
+
+        Matrix<T> reduce(const Matrix<T>& b) const;
+        static QRDecomposition<T> factor_top(const std::vector< QRDecomposition<T> >& blocks, std::size_t cols);
+        static std::vector<std::size_t> block_offsets(std::size_t rows, std::size_t cols, std::size_t blockRows);
+        static std::vector< QRDecomposition<T> > factor_blocks(const Matrix<T>& matrix, const std::vector<std::size_t>& offsets);
+    };
+
+    template <typename T>
+    std::vector<T> solve_least_squares(const Matrix<T>& matrix, const std::vector<T>& b);
+
+    template <typename E>
+    std::vector<typename E::value_type> solve_least_squares(const MatrixExpression<E>& matrix, const std::vector<typename E::value_type>& b);
+
+    template <typename T>
+    std::vector<T> solve_least_squares_tsqr(const Matrix<T>& matrix, const std::vector<T>& b);
+}
+
+template <typename T>
+inline LinAlg::QRDecomposition<T>::QRDecomposition(const Matrix<T>& matrix)
+    : _qr(matrix), _t()
+{
+    factor();
+}
+
+template <typename T>
+inline LinAlg::QRDecomposition<T>::QRDecomposition(Matrix<T>&& matrix)
+    : _qr(std::move(matrix)), _t()
+{
+    factor();
+}
+
+template <typename T>
+template <typename E>
+inline LinAlg::QRDecomposition<T>::QRDecomposition(const MatrixExpression<E>& matrix)
+    : _qr(matrix), _t()
+{
+    factor();
+}
+
+template <typename T>
+inline void LinAlg::QRDecomposition<T>::factor()
+{
+    if (!std::is_floating_point<T>::value) { throw std::invalid_argument("invalid Matrix template argument"); }
+
+    _t.resize(Kernels::qr_t_size(std::min(rows(), cols())));
+    Kernels::qr_factor(rows(), cols(), _qr.data(), _qr.cols(), _t.data());
+}
+
+template <typename T>
+inline bool LinAlg::QRDecomposition<T>::rank_deficient() const
+{
+    const std::size_t k = std::min(rows(), cols());
+    for (std::size_t i = 0; i < k; ++i) {
+        if (_qr(i, i) == T()) { return true; }
+    }
+    return k < cols();
+}
+
+template <typename T>
+inline void LinAlg::QRDecomposition<T>::check_solvable(std::size_t rows) const
+{
+    if (rows != this->rows()) { throw std::invalid_argument("invalid Matrix argument size"); }
+    if (rank_deficient()) { throw std::runtime_error("rank deficient Matrix"); }
+}
+
+template <typename T>
+inline LinAlg::Matrix<T> LinAlg::QRDecomposition<T>::r() const
+{
+    const std::size_t k = std::min(rows(), cols());
+    Matrix<T> rMatrix(k, cols());
+    for (std::size_t i = 0; i < k; ++i) { std::copy(_qr.data() + i * cols() + i, _qr.data() + (i + 1) * cols(), rMatrix.data() + i * cols() + i); }
+    return rMatrix;
+}
+
+template <typename T>
+inline LinAlg::Matrix<T> LinAlg::QRDecomposition<T>::q() const
+{
+    const std::size_t k = std::min(rows(), cols());
+    Matrix<T> qMatrix(rows(), k);
+    for (std::size_t i = 0; i < k; ++i) { qMatrix(i, i) = T(1); }
+    apply(qMatrix);
+    return qMatrix;
+}
+
+template <typename T>
+inline void LinAlg::QRDecomposition<T>::apply_transpose(std::vector<T>& b) const
+{
+    if (b.size() != rows()) { throw std::invalid_argument("invalid Matrix argument size"); }
+    Kernels::qr_apply(true, rows(), std::min(rows(), cols()), _qr.data(), _qr.cols(), _t.data(), 1, b.data(), 1);
+}
+
+template <typename T>
+inline void LinAlg::QRDecomposition<T>::apply_transpose(Matrix<T>& b) const
+{
+    if (b.rows() != rows()) { throw std::invalid_argument("invalid Matrix argument size"); }
+    Kernels::qr_apply(true, rows(), std::min(rows(), cols()), _qr.data(), _qr.cols(), _t.data(), b.cols(), b.data(), b.cols());
+}
+
+template <typename T>
+inline void LinAlg::QRDecomposition<T>::apply(std::vector<T>& b) const
+{
+    if (b.size() != rows()) { throw std::invalid_argument("invalid Matrix argument size"); }
+    Kernels::qr_apply(false, rows(), std::min(rows(), cols()), _qr.data(), _qr.cols(), _t.data(), 1, b.data(), 1);
+}
+
+template <typename T>
+inline void LinAlg::QRDecomposition<T>::apply(Matrix<T>& b) const
+{
+    if (b.rows() != rows()) { throw std::invalid_argument("invalid Matrix argument size"); }
+    Kernels::qr_apply(false, rows(), std::min(rows(), cols()), _qr.data(), _qr.cols(), _t.data(), b.cols(), b.data(), b.cols());
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::QRDecomposition<T>::solve(const std::vector<T>& b) const
+{
+    check_solvable(b.size());
+
+    std::vector<T> x(b);
+    apply_transpose(x);
+    x.resize(cols());
+    Kernels::upper_solve(cols(), _qr.data(), _qr.cols(), 1, x.data(), 1);
+    return x;
+}
+
+template <typename T>
+template <typename E>
+inline LinAlg::Matrix<T> LinAlg::QRDecomposition<T>::solve(const MatrixExpression<E>& b) const
+{
+    check_solvable(b.rows());
+
+    Matrix<T> work(b);
+    apply_transpose(work);
+    Matrix<T> x(cols(), work.cols(), uninitialized);
+    std::copy(work.data(), work.data() + x.vector_size(), x.data());
+    if (x.cols() != 0) { Kernels::upper_solve(cols(), _qr.data(), _qr.cols(), x.cols(), x.data(), x.cols()); }
+    return x;
+}
+
+template <typename T>
+inline std::vector<std::size_t> LinAlg::TSQRDecomposition<T>::block_offsets(std::size_t rows, std::size_t cols, std::size_t blockRows)
+{
+    const std::size_t minimum = std::max<std::size_t>(cols, 1);
+    if (blockRows == 0) {
+        const std::size_t blocks = std::max<std::size_t>(1, std::min(rows / (4 * minimum), 4 * execution_policy()->concurrency()));
+        blockRows = (rows + blocks - 1) / blocks;
+    }
+    blockRows = std::max(blockRows, minimum);
+
+    std::vector<std::size_t> offsets(1, 0);
+    while (rows - offsets.back() >= 2 * blockRows) { offsets.push_back(offsets.back() + blockRows); }
+    offsets.push_back(rows);
+    return offsets;
+}
+
+template <typename T>
+inline std::vector< LinAlg::QRDecomposition<T> > LinAlg::TSQRDecomposition<T>::factor_blocks(const Matrix<T>& matrix,
+                                                                                             const std::vector<std::size_t>& offsets)
+{
+    if (!std::is_floating_point<T>::value) { throw std::invalid_argument("invalid Matrix template argument"); }
+    if (matrix.rows() < matrix.cols()) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+    // Every task copies out its rows and factors them; the blocks are independent.
+    const std::size_t cols = matrix.cols();
+    std::vector< QRDecomposition<T> > blocks(offsets.size() - 1, QRDecomposition<T>(Matrix<T>()));
+    LinAlg::parallel_for(matrix.rows() * cols * cols, 0, blocks.size(), 1, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            Matrix<T> rowBlock(offsets[i + 1] - offsets[i], cols, uninitialized);
+            std::copy(matrix.data() + offsets[i] * cols, matrix.data() + offsets[i + 1] * cols, rowBlock.data());
+            blocks[i] = QRDecomposition<T>(std::move(rowBlock));
+        }
+    });
+    return blocks;
+}
+
+template <typename T>
+inline LinAlg::QRDecomposition<T> LinAlg::TSQRDecomposition<T>::factor_top(const std::vector< QRDecomposition<T> >& blocks, std::size_t cols)
+{
+    Matrix<T> stacked(blocks.size() * cols, cols);
+    for (std::size_t i = 0; i < blocks.size(); ++i) {
+        const Matrix<T>& factors = blocks[i].factors();
+        for (std::size_t r = 0; r < cols; ++r) {
+            std::copy(factors.data() + r * cols + r, factors.data() + (r + 1) * cols, stacked.data() + (i * cols + r) * cols + r);
+        }
+    }
+    return QRDecomposition<T>(std::move(stacked));
+}
+
+template <typename T>
+inline LinAlg::TSQRDecomposition<T>::TSQRDecomposition(const Matrix<T>& matrix, std::size_t blockRows)
+    : _rows(matrix.rows()), _cols(matrix.cols()), _offsets(block_offsets(matrix.rows(), matrix.cols(), blockRows)),
+      _blocks(factor_blocks(matrix, _offsets)), _top(factor_top(_blocks, matrix.cols()))
+{
+}
+
+// Applies Q_i^T to the rows of every block and stacks the leading n rows of
+// the results, the right-hand side of the top factorization.
+template <typename T>
+inline LinAlg::Matrix<T> LinAlg::TSQRDecomposition<T>::reduce(const Matrix<T>& b) const
+{
+    if (b.rows() != _rows) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+    const std::size_t nrhs = b.cols();
+    Matrix<T> stacked(_blocks.size() * _cols, nrhs, uninitialized);
+    LinAlg::parallel_for(_rows * _cols * nrhs, 0, _blocks.size(), 1, [&](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) {
+            Matrix<T> rowBlock(_offsets[i + 1] - _offsets[i], nrhs, uninitialized);
+            std::copy(b.data() + _offsets[i] * nrhs, b.data() + _offsets[i + 1] * nrhs, rowBlock.data());
+            _blocks[i].apply_transpose(rowBlock);
+            std::copy(rowBlock.data(), rowBlock.data() + _cols * nrhs, stacked.data() + i * _cols * nrhs);
+        }
+    });
+    return stacked;
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::TSQRDecomposition<T>::solve(const std::vector<T>& b) const
+{
+    const Matrix<T> x = _top.solve(reduce(Matrix<T>(b.size(), 1, b)));
+    return std::vector<T>(x.data(), x.data() + x.vector_size());
+}
+
+template <typename T>
+template <typename E>
+inline LinAlg::Matrix<T> LinAlg::TSQRDecomposition<T>::solve(const MatrixExpression<E>& b) const
+{
+    return _top.solve(reduce(Matrix<T>(b)));
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::solve_least_squares(const Matrix<T>& matrix, const std::vector<T>& b)
+{
+    return QRDecomposition<T>(matrix).solve(b);
+}
+
+template <typename E>
+inline std::vector<typename E::value_type> LinAlg::solve_least_squares(const MatrixExpression<E>& matrix, const std::vector<typename E::value_type>& b)
+{
+    return QRDecomposition<typename E::value_type>(matrix).solve(b);
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::solve_least_squares_tsqr(const Matrix<T>& matrix, const std::vector<T>& b)
+{
+    return TSQRDecomposition<T>(matrix).solve(b);
+}
+
+#endif // QR_DECOMPOSITION_HPP
@@ -0,0 +1,150 @@
+#ifndef SINGULAR_VALUE_DECOMPOSITION_HPP
+#define SINGULAR_VALUE_DECOMPOSITION_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../Matrix.hpp"
+#include "../Kernels/eigen.hpp"
+#include "qr_decomposition.hpp"
+
+namespace LinAlg
+{
+    // Thin A = U diag(sigma) V^T of an m x n matrix, k = min(m, n): U is m x k
+    // and V is n x k, both with orthonormal columns, and the singular values
+    // come out in descending order. A tall matrix is first reduced to its
+    // n x n R factor by QRDecomposition, a wide one is decomposed through A^T;
+    // the square core is reduced to bidiagonal form by Householder reflections
+    // from both sides and diagonalized by implicitly shifted QR.
+    template <typename T>
+    class SingularValueDecomposition
+    {
+    public:
+        explicit SingularValueDecomposition(const Matrix<T>& matrix);
+        template <typename E>
+        explicit SingularValueDecomposition(const MatrixExpression<E>& matrix);
+
+        std::size_t rows() const { return _rows; }
+        std::size_t cols() const { return _cols; }
+        const std::vector<T>& values() const { return _values; }
+        const Matrix<T>& u() const { return _u; }
+        const Matrix<T>& v() const { return _v; }
+
+        // Singular values above tolerance; a negative tolerance stands for
+        // max(m, n) epsilon sigma_max.
+        std::size_t rank(T tolerance = T(-1)) const;
+
+        // Minimum norm least-squares solution x = V diag(sigma)^+ U^T b, the
+        // singular values at or below the rank tolerance treated as zero.
+        std::vector<T> solve(const std::vector<T>& b, T tolerance = T(-1)) const;
+
+    private:
+        std::size_t _rows;
+        std::size_t _cols;
+        std::vector<T> _values;
+        Matrix<T> _u;
+        Matrix<T> _v;
+
+        void factor(const Matrix<T>& matrix);
+        T cutoff(T tolerance) const;
+    };
+}
+
+template <typename T>
+inline LinAlg::SingularValueDecomposition<T>::SingularValueDecomposition(const Matrix<T>& matrix)
+    : _rows(matrix.rows()), _cols(matrix.cols()), _values(), _u(), _v()
+{
+    factor(matrix);
+}
+
+template <typename T>
+template <typename E>
+inline LinAlg::SingularValueDecomposition<T>::SingularValueDecomposition(const MatrixExpression<E>& matrix)
+    : _rows(matrix.rows()), _cols(matrix.cols()), _values(), _u(), _v()
+{
+    factor(Matrix<T>(matrix));
+}
+
+template <typename T>
+inline void LinAlg::SingularValueDecomposition<T>::factor(const Matrix<T>& matrix)
+{
+    if (!std::is_floating_point<T>::value) { throw std::invalid_argument("invalid Matrix template argument"); }
+
+    const bool wide = matrix.rows() < matrix.cols();
+    const std::size_t m = wide ? matrix.cols() : matrix.rows(), n = wide ? matrix.rows() : matrix.cols();
+    if (n == 0) { return; }
+
+    // The n x n core G is A itself when square and R of A = QR when tall.
+    // G = U_B B V_B^T with B bidiagonal, and the QR iteration on B turns the
+    // rows of u and v, U_B^T and V_B^T to begin with, into U_G^T and V^T.
+    const Matrix<T> tall = wide ? Matrix<T>(matrix.transposed()) : Matrix<T>();
+    const Matrix<T>& a = wide ? tall : matrix;
+    QRDecomposition<T> qr((m > n) ? Matrix<T>(a) : Matrix<T>());
+    Matrix<T> core = (m > n) ? qr.r() : Matrix<T>(a);
+    Matrix<T> reflectors(n, n), u(n, n, uninitialized), v(n, n, uninitialized);
+    std::vector<T> d(n), e(n), tauLeft(n), tauRight(n);
+    Kernels::bidiagonalize(n, core.data(), n, d.data(), e.data(), reflectors.data(), n, tauLeft.data(), tauRight.data());
+    Kernels::reflectors_transposed(n, n, 0, reflectors.data(), n, tauLeft.data(), u.data(), n);
+    Kernels::reflectors_transposed(n, n - 1, 1, core.data(), n, tauRight.data(), v.data(), n);
+    if (!Kernels::bidiagonal_qr(n, d.data(), e.data(), u.data(), n, v.data(), n, n)) {
+        throw std::runtime_error("singular value iteration did not converge");
+    }
+
+    std::vector<std::size_t> order(n);
+    std::iota(order.begin(), order.end(), std::size_t(0));
+    std::stable_sort(order.begin(), order.end(), [&d](std::size_t lhs, std::size_t rhs) { return d[lhs] > d[rhs]; });
+
+    // U = Q [U_G; 0] for a tall matrix, columns in descending order.
+    Matrix<T> left(m, n), right(n, n, uninitialized);
+    _values.resize(n);
+    for (std::size_t j = 0; j < n; ++j) {
+        _values[j] = d[order[j]];
+        const T* uRow = u.data() + order[j] * n;
+        const T* vRow = v.data() + order[j] * n;
+        for (std::size_t i = 0; i < n; ++i) {
+            left(i, j) = uRow[i];
+            right(i, j) = vRow[i];
+        }
+    }
+    if (m > n) { qr.apply(left); }
+
+    _u = wide ? std::move(right) : std::move(left);
+    _v = wide ? std::move(left) : std::move(right);
+}
+
+template <typename T>
+inline T LinAlg::SingularValueDecomposition<T>::cutoff(T tolerance) const
+{
+    if (tolerance >= T()) { return tolerance; }
+    if (_values.empty()) { return T(); }
+    return static_cast<T>(std::max(rows(), cols())) * std::numeric_limits<T>::epsilon() * _values.front();
+}
+
+template <typename T>
+inline std::size_t LinAlg::SingularValueDecomposition<T>::rank(T tolerance) const
+{
+    const T limit = cutoff(tolerance);
+    return static_cast<std::size_t>(std::count_if(_values.begin(), _values.end(), [limit](T value) { return value > limit; }));
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::SingularValueDecomposition<T>::solve(const std::vector<T>& b, T tolerance) const
+{
+    if (b.size() != rows()) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+    const std::size_t k = rank(tolerance);
+    std::vector<T> coefficients(_values.size()), x(cols());
+    Kernels::gemv_transposed(rows(), _values.size(), T(1), _u.data(), _u.cols(), b.data(), T(), coefficients.data());
+    for (std::size_t j = 0; j < k; ++j) { coefficients[j] /= _values[j]; }
+    std::fill(coefficients.begin() + k, coefficients.end(), T());
+    Kernels::gemv(cols(), _values.size(), T(1), _v.data(), _v.cols(), coefficients.data(), T(), x.data());
+    return x;
+}
+
+#endif // SINGULAR_VALUE_DECOMPOSITION_HPP
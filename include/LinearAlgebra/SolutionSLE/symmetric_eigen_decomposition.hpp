@@ -0,0 +1,129 @@
+#ifndef SYMMETRIC_EIGEN_DECOMPOSITION_HPP
+#define SYMMETRIC_EIGEN_DECOMPOSITION_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "../Matrix.hpp"
+#include "../StructuredMatrix.hpp"
+#include "../Kernels/eigen.hpp"
+
+namespace LinAlg
+{
+    // A = V diag(lambda) V^T for a symmetric matrix. Only the lower triangle of
+    // the input is read. A is reduced to tridiagonal form by Householder
+    // reflections and the tridiagonal matrix is diagonalized by implicit QL,
+    // whose rotations are applied to the accumulated reflectors when
+    // eigenvectors are requested. Eigenvalues come out in ascending order, the
+    // eigenvectors as the matching columns of vectors().
+    template <typename T>
+    class SymmetricEigenDecomposition
+    {
+    public:
+        explicit SymmetricEigenDecomposition(const Matrix<T>& matrix, bool computeVectors = true);
+        explicit SymmetricEigenDecomposition(Matrix<T>&& matrix, bool computeVectors = true);
+        template <typename E>
+        explicit SymmetricEigenDecomposition(const MatrixExpression<E>& matrix, bool computeVectors = true);
+        explicit SymmetricEigenDecomposition(const SymmetricMatrix<T>& matrix, bool computeVectors = true);
+
+        std::size_t size() const { return _values.size(); }
+        const std::vector<T>& values() const { return _values; }
+        // Empty when the decomposition was built without eigenvectors.
+        const Matrix<T>& vectors() const { return _vectors; }
+
+    private:
+        std::vector<T> _values;
+        Matrix<T> _vectors;
+
+        void factor(Matrix<T>& matrix, bool computeVectors);
+    };
+
+    template <typename T>
+    std::vector<T> eigenvalues_symmetric(const Matrix<T>& matrix);
+}
+
+template <typename T>
+inline LinAlg::SymmetricEigenDecomposition<T>::SymmetricEigenDecomposition(const Matrix<T>& matrix, bool computeVectors)
+    : _values(), _vectors()
+{
+    Matrix<T> work(matrix);
+    factor(work, computeVectors);
+}
+
+template <typename T>
+inline LinAlg::SymmetricEigenDecomposition<T>::SymmetricEigenDecomposition(Matrix<T>&& matrix, bool computeVectors)
+    : _values(), _vectors()
+{
+    factor(matrix, computeVectors);
+}
+
+template <typename T>
+template <typename E>
+inline LinAlg::SymmetricEigenDecomposition<T>::SymmetricEigenDecomposition(const MatrixExpression<E>& matrix, bool computeVectors)
+    : _values(), _vectors()
+{
+    Matrix<T> work(matrix);
+    factor(work, computeVectors);
+}
+
+template <typename T>
+inline LinAlg::SymmetricEigenDecomposition<T>::SymmetricEigenDecomposition(const SymmetricMatrix<T>& matrix, bool computeVectors)
+    : _values(), _vectors()
+{
+    Matrix<T> work(matrix.to_dense());
+    factor(work, computeVectors);
+}
+
+template <typename T>
+inline void LinAlg::SymmetricEigenDecomposition<T>::factor(Matrix<T>& matrix, bool computeVectors)
+{
+    if (!std::is_floating_point<T>::value) { throw std::invalid_argument("invalid Matrix template argument"); }
+    if (!matrix.square()) { throw std::invalid_argument("square Matrix required"); }
+
+    const std::size_t n = matrix.rows();
+    if (n == 0) { return; }
+
+    T* a = matrix.data();
+    for (std::size_t i = 0; i < n; ++i) {
+        for (std::size_t j = i + 1; j < n; ++j) { a[i * n + j] = a[j * n + i]; }
+    }
+
+    std::vector<T> d(n), e(n), tau(n);
+    Kernels::tridiagonalize(n, a, n, d.data(), e.data(), tau.data());
+
+    // The rows of z start as the columns of Q and end as the eigenvectors.
+    Matrix<T> z;
+    if (computeVectors) {
+        z = Matrix<T>(n, n, uninitialized);
+        Kernels::reflectors_transposed(n, (n > 2) ? n - 2 : 0, 1, a, n, tau.data(), z.data(), n);
+    }
+    if (!Kernels::tridiagonal_ql(n, d.data(), e.data(), computeVectors ? z.data() : nullptr, n, n)) {
+        throw std::runtime_error("eigenvalue iteration did not converge");
+    }
+
+    std::vector<std::size_t> order(n);
+    std::iota(order.begin(), order.end(), std::size_t(0));
+    std::sort(order.begin(), order.end(), [&d](std::size_t lhs, std::size_t rhs) { return d[lhs] < d[rhs]; });
+    _values.resize(n);
+    for (std::size_t i = 0; i < n; ++i) { _values[i] = d[order[i]]; }
+
+    if (computeVectors) {
+        _vectors = Matrix<T>(n, n, uninitialized);
+        for (std::size_t j = 0; j < n; ++j) {
+            const T* row = z.data() + order[j] * n;
+            for (std::size_t i = 0; i < n; ++i) { _vectors(i, j) = row[i]; }
+        }
+    }
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::eigenvalues_symmetric(const Matrix<T>& matrix)
+{
+    return SymmetricEigenDecomposition<T>(matrix, false).values();
+}
+
+#endif // SYMMETRIC_EIGEN_DECOMPOSITION_HPP
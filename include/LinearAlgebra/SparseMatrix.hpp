@@ -0,0 +1,419 @@
+#ifndef SPARSE_MATRIX_HPP
+#define SPARSE_MATRIX_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "ExecutionPolicy.hpp"
+#include "Matrix.hpp"
+#include "Kernels/sparse.hpp"
+
+namespace LinAlg
+{
+    // Coordinate format entry. Duplicated coordinates are summed on construction.
+    template <typename T>
+    struct Triplet
+    {
+        std::size_t row;
+        std::size_t col;
+        T value;
+    };
+
+    // Compressed sparse column storage: the entries of column j are values[p]
+    // at row indices[p] for p in [pointers[j], pointers[j + 1]).
+    template <typename T>
+    struct CscStorage
+    {
+        std::vector<std::size_t> pointers;
+        std::vector<std::size_t> indices;
+        std::vector<T> values;
+    };
+
+    // Sparse matrix in compressed sparse row format with column indices sorted
+    // within every row. Storage is O(rows + nnz) and products cost O(nnz)
+    // per dense column.
+    template <typename T>
+    class SparseMatrix
+    {
+    public:
+        typedef T value_type;
+
+        SparseMatrix();
+        SparseMatrix(std::size_t rows, std::size_t cols);
+        SparseMatrix(std::size_t rows, std::size_t cols, const std::vector< Triplet<T> >& triplets);
+        SparseMatrix(std::size_t rows, std::size_t cols, std::vector<std::size_t> rowPointers, std::vector<std::size_t> colIndices, std::vector<T> values);
+        SparseMatrix(std::size_t rows, std::size_t cols, const CscStorage<T>& csc);
+        template <typename E>
+        explicit SparseMatrix(const MatrixExpression<E>& expression);
+
+        std::size_t rows() const { return _rows; }
+        std::size_t cols() const { return _cols; }
+        std::size_t nnz() const { return _values.size(); }
+        bool square() const { return _rows == _cols; }
+
+        const std::vector<std::size_t>& row_pointers() const { return _rowPointers; }
+        const std::vector<std::size_t>& col_indices() const { return _colIndices; }
+        const std::vector<T>& values() const { return _values; }
+
+        T operator()(std::size_t row, std::size_t col) const;
+        T at(std::size_t row, std::size_t col) const;
+
+        std::vector<T> diagonal() const;
+        SparseMatrix<T> transposed() const;
+        CscStorage<T> to_csc() const;
+        Matrix<T> to_dense() const;
+
+        // y = A x for x with cols() and y with rows() elements.
+        void multiply(const T* x, T* y) const;
+        // y = A^T x for x with rows() and y with cols() elements. The product
+        // scatters along the rows and runs serially; repeated products are
+        // faster through multiply on transposed().
+        void multiply_transposed(const T* x, T* y) const;
+
+    private:
+        std::size_t _rows;
+        std::size_t _cols;
+        std::vector<std::size_t> _rowPointers;
+        std::vector<std::size_t> _colIndices;
+        std::vector<T> _values;
+
+        void check_structure() const;
+    };
+
+    template <typename T>
+    std::vector<T> operator* (const SparseMatrix<T>& lhs, const std::vector<T>& rhs);
+
+    template <typename T, typename E>
+    Matrix<T> operator* (const SparseMatrix<T>& lhs, const MatrixExpression<E>& rhs);
+
+    template <typename E, typename T>
+    Matrix<T> operator* (const MatrixExpression<E>& lhs, const SparseMatrix<T>& rhs);
+
+    template <typename T>
+    SparseMatrix<T> operator* (const SparseMatrix<T>& lhs, const SparseMatrix<T>& rhs);
+
+    namespace Detail
+    {
+        std::size_t sparse_row_grain(std::size_t rows, std::size_t nnz);
+    }
+}
+
+inline std::size_t LinAlg::Detail::sparse_row_grain(std::size_t rows, std::size_t nnz)
+{
+    const std::size_t perRow = (rows == 0) ? 1 : std::max<std::size_t>(1, nnz / rows);
+    return std::max<std::size_t>(1, elementwise_grain / perRow);
+}
+
+template <typename T>
+inline LinAlg::SparseMatrix<T>::SparseMatrix()
+    : _rows(0), _cols(0), _rowPointers(1, 0), _colIndices(), _values()
+{
+}
+
+template <typename T>
+inline LinAlg::SparseMatrix<T>::SparseMatrix(std::size_t rows, std::size_t cols)
+    : _rows(rows), _cols(cols), _rowPointers(rows + 1, 0), _colIndices(), _values()
+{
+}
+
+template <typename T>
+inline LinAlg::SparseMatrix<T>::SparseMatrix(std::size_t rows, std::size_t cols, const std::vector< Triplet<T> >& triplets)
+    : _rows(rows), _cols(cols), _rowPointers(rows + 1, 0), _colIndices(), _values()
+{
+    for (const Triplet<T>& triplet : triplets) {
+        if (triplet.row >= _rows) { throw std::out_of_range("invalid Matrix row subscript"); }
+        if (triplet.col >= _cols) { throw std::out_of_range("invalid Matrix column subscript"); }
+        ++_rowPointers[triplet.row + 1];
+    }
+    for (std::size_t i = 0; i < _rows; ++i) { _rowPointers[i + 1] += _rowPointers[i]; }
+
+    // Bucket the triplets by row, then sort every bucket by column and merge duplicates.
+    std::vector<std::size_t> order(triplets.size());
+    std::vector<std::size_t> next(_rowPointers.begin(), _rowPointers.end() - 1);
+    for (std::size_t t = 0; t < triplets.size(); ++t) { order[next[triplets[t].row]++] = t; }
+
+    _colIndices.reserve(triplets.size());
+    _values.reserve(triplets.size());
+    std::size_t rowStart = 0;
+    for (std::size_t i = 0; i < _rows; ++i) {
+        const auto first = order.begin() + _rowPointers[i], last = order.begin() + _rowPointers[i + 1];
+        std::sort(first, last, [&triplets](std::size_t lhs, std::size_t rhs) {
+            return triplets[lhs].col < triplets[rhs].col || (triplets[lhs].col == triplets[rhs].col && lhs < rhs);
+        });
+        for (auto t = first; t != last; ++t) {
+            const Triplet<T>& triplet = triplets[*t];
+            if (_colIndices.size() > rowStart && _colIndices.back() == triplet.col) {
+                _values.back() += triplet.value;
+            } else {
+                _colIndices.push_back(triplet.col);
+                _values.push_back(triplet.value);
+            }
+        }
+        _rowPointers[i] = rowStart;
+        rowStart = _colIndices.size();
+    }
+    _rowPointers[_rows] = rowStart;
+}
+
+template <typename T>
+inline LinAlg::SparseMatrix<T>::SparseMatrix(std::size_t rows, std::size_t cols, std::vector<std::size_t> rowPointers,
+                                             std::vector<std::size_t> colIndices, std::vector<T> values)
+    : _rows(rows), _cols(cols), _rowPointers(std::move(rowPointers)), _colIndices(std::move(colIndices)), _values(std::move(values))
+{
+    check_structure();
+}
+
+template <typename T>
+inline LinAlg::SparseMatrix<T>::SparseMatrix(std::size_t rows, std::size_t cols, const CscStorage<T>& csc)
+    : _rows(rows), _cols(cols), _rowPointers(), _colIndices(), _values()
+{
+    // The CSC arrays of this matrix are the CSR arrays of its transpose.
+    const SparseMatrix<T> transposeMatrix(cols, rows, csc.pointers, csc.indices, csc.values);
+    *this = transposeMatrix.transposed();
+}
+
+template <typename T>
+template <typename E>
+inline LinAlg::SparseMatrix<T>::SparseMatrix(const MatrixExpression<E>& expression)
+    : _rows(expression.rows()), _cols(expression.cols()), _rowPointers(expression.rows() + 1, 0), _colIndices(), _values()
+{
+    const E& source = expression.derived();
+    for (std::size_t i = 0; i < _rows; ++i) {
+        for (std::size_t j = 0; j < _cols; ++j) {
+            const T value = source(i, j);
+            if (value != T()) {
+                _colIndices.push_back(j);
+                _values.push_back(value);
+            }
+        }
+        _rowPointers[i + 1] = _values.size();
+    }
+}
+
+template <typename T>
+inline void LinAlg::SparseMatrix<T>::check_structure() const
+{
+    if (_rowPointers.size() != _rows + 1 || _rowPointers.front() != 0 ||
+        _rowPointers.back() != _colIndices.size() || _colIndices.size() != _values.size()) {
+        throw std::invalid_argument("invalid sparse Matrix structure");
+    }
+    for (std::size_t i = 0; i < _rows; ++i) {
+        if (_rowPointers[i] > _rowPointers[i + 1]) { throw std::invalid_argument("invalid sparse Matrix structure"); }
+        for (std::size_t p = _rowPointers[i]; p < _rowPointers[i + 1]; ++p) {
+            if (_colIndices[p] >= _cols || (p > _rowPointers[i] && _colIndices[p] <= _colIndices[p - 1])) {
+                throw std::invalid_argument("invalid sparse Matrix structure");
+            }
+        }
+    }
+}
+
+template <typename T>
+inline T LinAlg::SparseMatrix<T>::operator()(std::size_t row, std::size_t col) const
+{
+    const auto first = _colIndices.begin() + _rowPointers[row], last = _colIndices.begin() + _rowPointers[row + 1];
+    const auto position = std::lower_bound(first, last, col);
+    return (position != last && *position == col) ? _values[position - _colIndices.begin()] : T();
+}
+
+template <typename T>
+inline T LinAlg::SparseMatrix<T>::at(std::size_t row, std::size_t col) const
+{
+    if (row >= _rows) { throw std::out_of_range("invalid Matrix row subscript"); }
+    if (col >= _cols) { throw std::out_of_range("invalid Matrix column subscript"); }
+
+    return (*this)(row, col);
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::SparseMatrix<T>::diagonal() const
+{
+    std::vector<T> diagonalVector(std::min(_rows, _cols));
+    for (std::size_t i = 0; i < diagonalVector.size(); ++i) { diagonalVector[i] = (*this)(i, i); }
+    return diagonalVector;
+}
+
+template <typename T>
+inline LinAlg::SparseMatrix<T> LinAlg::SparseMatrix<T>::transposed() const
+{
+    std::vector<std::size_t> pointers(_cols + 1), indices(nnz());
+    std::vector<T> values(nnz());
+    LinAlg::Kernels::csr_transpose(_rows, _cols, _rowPointers.data(), _colIndices.data(), _values.data(),
+                                   pointers.data(), indices.data(), values.data());
+
+    SparseMatrix<T> transposeMatrix;
+    transposeMatrix._rows = _cols;
+    transposeMatrix._cols = _rows;
+    transposeMatrix._rowPointers.swap(pointers);
+    transposeMatrix._colIndices.swap(indices);
+    transposeMatrix._values.swap(values);
+    return transposeMatrix;
+}
+
+template <typename T>
+inline LinAlg::CscStorage<T> LinAlg::SparseMatrix<T>::to_csc() const
+{
+    SparseMatrix<T> transposeMatrix = transposed();
+
+    CscStorage<T> csc;
+    csc.pointers.swap(transposeMatrix._rowPointers);
+    csc.indices.swap(transposeMatrix._colIndices);
+    csc.values.swap(transposeMatrix._values);
+    return csc;
+}
+
+template <typename T>
+inline LinAlg::Matrix<T> LinAlg::SparseMatrix<T>::to_dense() const
+{
+    LinAlg::Matrix<T> denseMatrix(_rows, _cols);
+    for (std::size_t i = 0; i < _rows; ++i) {
+        for (std::size_t p = _rowPointers[i]; p < _rowPointers[i + 1]; ++p) { denseMatrix(i, _colIndices[p]) = _values[p]; }
+    }
+    return denseMatrix;
+}
+
+template <typename T>
+inline void LinAlg::SparseMatrix<T>::multiply(const T* x, T* y) const
+{
+    const std::size_t* pointers = _rowPointers.data();
+    const std::size_t* indices = _colIndices.data();
+    const T* values = _values.data();
+    LinAlg::parallel_for(nnz(), 0, _rows, LinAlg::Detail::sparse_row_grain(_rows, nnz()), [=](std::size_t first, std::size_t last) {
+        LinAlg::Kernels::csr_gemv(first, last, pointers, indices, values, x, y);
+    });
+}
+
+template <typename T>
+inline void LinAlg::SparseMatrix<T>::multiply_transposed(const T* x, T* y) const
+{
+    LinAlg::Kernels::csr_gemv_transposed(_rows, _cols, _rowPointers.data(), _colIndices.data(), _values.data(), x, y);
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::operator* (const SparseMatrix<T>& lhs, const std::vector<T>& rhs)
+{
+    if (lhs.cols() != rhs.size()) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+    std::vector<T> result(lhs.rows());
+    lhs.multiply(rhs.data(), result.data());
+    return result;
+}
+
+template <typename T, typename E>
+inline LinAlg::Matrix<T> LinAlg::operator* (const SparseMatrix<T>& lhs, const MatrixExpression<E>& rhs)
+{
+    if (lhs.cols() != rhs.rows()) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+    const Detail::GemmOperand<E> rhsOperand(rhs.derived());
+    const ConstMatrixView<T>& b = rhsOperand.view;
+    Matrix<T> resultMatrix(lhs.rows(), b.cols(), uninitialized);
+    if (b.cols() == 0) { return resultMatrix; }
+
+    const std::size_t n = b.cols();
+    const std::size_t* pointers = lhs.row_pointers().data();
+    const std::size_t* indices = lhs.col_indices().data();
+    const T* values = lhs.values().data();
+    T* c = resultMatrix.data();
+    LinAlg::parallel_for(lhs.nnz() * n, 0, lhs.rows(), Detail::sparse_row_grain(lhs.rows(), lhs.nnz() * n), [=, &b](std::size_t first, std::size_t last) {
+        LinAlg::Kernels::csr_gemm(first, last, n, pointers, indices, values, b.data(), b.row_stride(), b.col_stride(), c, n);
+    });
+    return resultMatrix;
+}
+
+template <typename E, typename T>
+inline LinAlg::Matrix<T> LinAlg::operator* (const MatrixExpression<E>& lhs, const SparseMatrix<T>& rhs)
+{
+    if (lhs.cols() != rhs.rows()) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+    const Detail::GemmOperand<E> lhsOperand(lhs.derived());
+    const ConstMatrixView<T>& a = lhsOperand.view;
+    Matrix<T> resultMatrix(a.rows(), rhs.cols(), uninitialized);
+    if (rhs.cols() == 0) { return resultMatrix; }
+
+    const std::size_t k = a.cols(), n = rhs.cols();
+    const std::size_t* pointers = rhs.row_pointers().data();
+    const std::size_t* indices = rhs.col_indices().data();
+    const T* values = rhs.values().data();
+    T* c = resultMatrix.data();
+    const std::size_t work = a.rows() * (rhs.nnz() + n);
+    LinAlg::parallel_for(work, 0, a.rows(), Detail::sparse_row_grain(a.rows(), work), [=, &a](std::size_t first, std::size_t last) {
+        LinAlg::Kernels::gemm_csr(first, last, k, n, a.data(), a.row_stride(), a.col_stride(), pointers, indices, values, c, n);
+    });
+    return resultMatrix;
+}
+
+// Gustavson's row-by-row product: a symbolic pass counts the distinct columns
+// of every result row, a numeric pass then fills them through a dense accumulator.
+template <typename T>
+inline LinAlg::SparseMatrix<T> LinAlg::operator* (const SparseMatrix<T>& lhs, const SparseMatrix<T>& rhs)
+{
+    if (lhs.cols() != rhs.rows()) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+    const std::size_t rows = lhs.rows(), cols = rhs.cols();
+    const std::size_t* aPointers = lhs.row_pointers().data();
+    const std::size_t* aIndices = lhs.col_indices().data();
+    const T* aValues = lhs.values().data();
+    const std::size_t* bPointers = rhs.row_pointers().data();
+    const std::size_t* bIndices = rhs.col_indices().data();
+    const T* bValues = rhs.values().data();
+
+    const std::size_t none = std::numeric_limits<std::size_t>::max();
+    const std::size_t work = lhs.nnz() * (rhs.rows() == 0 ? 1 : rhs.nnz() / rhs.rows() + 1);
+    const std::size_t grain = Detail::sparse_row_grain(rows, work);
+
+    std::vector<std::size_t> pointers(rows + 1, 0);
+    std::size_t* counts = pointers.data() + 1;
+    LinAlg::parallel_for(work, 0, rows, grain, [=](std::size_t first, std::size_t last) {
+        std::vector<std::size_t> marker(cols, none);
+        for (std::size_t i = first; i < last; ++i) {
+            std::size_t count = 0;
+            for (std::size_t p = aPointers[i]; p < aPointers[i + 1]; ++p) {
+                const std::size_t k = aIndices[p];
+                for (std::size_t q = bPointers[k]; q < bPointers[k + 1]; ++q) {
+                    if (marker[bIndices[q]] != i) {
+                        marker[bIndices[q]] = i;
+                        ++count;
+                    }
+                }
+            }
+            counts[i] = count;
+        }
+    });
+    for (std::size_t i = 0; i < rows; ++i) { pointers[i + 1] += pointers[i]; }
+
+    std::vector<std::size_t> indices(pointers[rows]);
+    std::vector<T> values(pointers[rows]);
+    const std::size_t* cPointers = pointers.data();
+    std::size_t* cIndices = indices.data();
+    T* cValues = values.data();
+    LinAlg::parallel_for(work, 0, rows, grain, [=](std::size_t first, std::size_t last) {
+        std::vector<std::size_t> marker(cols, none);
+        std::vector<T> accumulator(cols);
+        for (std::size_t i = first; i < last; ++i) {
+            std::size_t position = cPointers[i];
+            for (std::size_t p = aPointers[i]; p < aPointers[i + 1]; ++p) {
+                const std::size_t k = aIndices[p];
+                const T aValue = aValues[p];
+                for (std::size_t q = bPointers[k]; q < bPointers[k + 1]; ++q) {
+                    const std::size_t j = bIndices[q];
+                    if (marker[j] != i) {
+                        marker[j] = i;
+                        accumulator[j] = aValue * bValues[q];
+                        cIndices[position++] = j;
+                    } else {
+                        accumulator[j] += aValue * bValues[q];
+                    }
+                }
+            }
+            std::sort(cIndices + cPointers[i], cIndices + position);
+            for (std::size_t r = cPointers[i]; r < position; ++r) { cValues[r] = accumulator[cIndices[r]]; }
+        }
+    });
+
+    return SparseMatrix<T>(rows, cols, std::move(pointers), std::move(indices), std::move(values));
+}
+
+#endif // SPARSE_MATRIX_HPP
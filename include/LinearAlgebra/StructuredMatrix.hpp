@@ -0,0 +1,805 @@
+#ifndef STRUCTURED_MATRIX_HPP
+#define STRUCTURED_MATRIX_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ExecutionPolicy.hpp"
+#include "Matrix.hpp"
+#include "MatrixVector.hpp"
+#include "Kernels/structured.hpp"
+
+namespace LinAlg
+{
+    // Square matrices whose zero pattern is known up front, stored without the
+    // zeros. Products, solves and determinants touch only the stored entries:
+    // O(n) for a diagonal, O(n (kl + ku)) for a band and O(n^2 / 2) for a
+    // triangle. Solves and determinants need a floating point T.
+
+    // Diagonal matrix of n stored values.
+    template <typename T>
+    class DiagonalMatrix
+    {
+    public:
+        typedef T value_type;
+
+        DiagonalMatrix();
+        explicit DiagonalMatrix(std::size_t size, T value = T());
+        explicit DiagonalMatrix(std::vector<T> diagonal);
+        DiagonalMatrix(std::initializer_list<T> il);
+
+        std::size_t rows() const { return _diagonal.size(); }
+        std::size_t cols() const { return _diagonal.size(); }
+        std::size_t size() const { return _diagonal.size(); }
+        const std::vector<T>& diagonal() const { return _diagonal; }
+
+        T& operator[](std::size_t index) { return _diagonal[index]; }
+        const T& operator[](std::size_t index) const { return _diagonal[index]; }
+        T operator()(std::size_t row, std::size_t col) const { return row == col ? _diagonal[row] : T(); }
+        T at(std::size_t row, std::size_t col) const;
+
+        T determinant() const;
+        DiagonalMatrix<T> inverse() const;
+        std::vector<T> solve(const std::vector<T>& b) const;
+        template <typename E>
+        Matrix<T> solve(const MatrixExpression<E>& b) const;
+        Matrix<T> to_dense() const;
+
+    private:
+        std::vector<T> _diagonal;
+
+        void check_solvable(std::size_t rows) const;
+    };
+
+    // Band matrix with lower and upper bandwidths kl and ku, kept in the band
+    // storage of Kernels/structured.hpp; a tridiagonal matrix has kl = ku = 1.
+    // Bandwidths are clamped to n - 1. Systems are solved by BandedLUDecomposition.
+    template <typename T>
+    class BandedMatrix
+    {
+    public:
+        typedef T value_type;
+
+        BandedMatrix();
+        BandedMatrix(std::size_t size, std::size_t lowerBandwidth, std::size_t upperBandwidth);
+        // Keeps the band of a square expression and drops everything outside it.
+        template <typename E>
+        BandedMatrix(std::size_t lowerBandwidth, std::size_t upperBandwidth, const MatrixExpression<E>& expression);
+
+        // Subdiagonal and superdiagonal have one element less than the diagonal.
+        static BandedMatrix<T> tridiagonal(const std::vector<T>& lower, const std::vector<T>& diagonal, const std::vector<T>& upper);
+
+        std::size_t rows() const { return _size; }
+        std::size_t cols() const { return _size; }
+        std::size_t size() const { return _size; }
+        std::size_t lower_bandwidth() const { return _lower; }
+        std::size_t upper_bandwidth() const { return _upper; }
+        std::size_t leading_dimension() const { return _lower + _upper + 1; }
+        const std::vector<T>& band() const { return _band; }
+
+        bool in_band(std::size_t row, std::size_t col) const { return row <= col + _lower && col <= row + _upper; }
+        T operator()(std::size_t row, std::size_t col) const;
+        T at(std::size_t row, std::size_t col) const;
+        void set(std::size_t row, std::size_t col, T value);
+
+        T determinant() const;
+        Matrix<T> to_dense() const;
+
+        // Band storage with the upper bandwidth widened to kl + ku, the layout
+        // Kernels::band_lu_factor works in.
+        std::vector<T> factor_storage() const;
+
+        // y = A x for x and y with size() elements.
+        void multiply(const T* x, T* y) const;
+
+    private:
+        std::size_t _size;
+        std::size_t _lower;
+        std::size_t _upper;
+        std::vector<T> _band;
+
+        void check_subscript(std::size_t row, std::size_t col) const;
+    };
+
+    // Lower or upper triangular matrix in packed row-major storage of n (n + 1) / 2 entries.
+    template <typename T>
+    class TriangularMatrix
+    {
+    public:
+        typedef T value_type;
+
+        TriangularMatrix();
+        TriangularMatrix(Triangle triangle, std::size_t size);
+        TriangularMatrix(Triangle triangle, std::size_t size, std::vector<T> packed);
+        // Keeps the selected triangle of a square expression.
+        template <typename E>
+        TriangularMatrix(Triangle triangle, const MatrixExpression<E>& expression);
+
+        Triangle triangle() const { return _triangle; }
+        std::size_t rows() const { return _size; }
+        std::size_t cols() const { return _size; }
+        std::size_t size() const { return _size; }
+        const std::vector<T>& packed() const { return _packed; }
+
+        bool in_triangle(std::size_t row, std::size_t col) const { return _triangle == Triangle::lower ? col <= row : row <= col; }
+        T operator()(std::size_t row, std::size_t col) const;
+        T at(std::size_t row, std::size_t col) const;
+        void set(std::size_t row, std::size_t col, T value);
+
+        T determinant() const;
+        std::vector<T> solve(const std::vector<T>& b) const;
+        template <typename E>
+        Matrix<T> solve(const MatrixExpression<E>& b) const;
+        void solve_in_place(std::vector<T>& b) const;
+        void solve_in_place(Matrix<T>& b) const;
+
+        TriangularMatrix<T> transposed() const;
+        Matrix<T> to_dense() const;
+
+        // y = T x for x and y with size() elements.
+        void multiply(const T* x, T* y) const;
+
+    private:
+        Triangle _triangle;
+        std::size_t _size;
+        std::vector<T> _packed;
+
+        std::size_t index(std::size_t row, std::size_t col) const;
+        void check_subscript(std::size_t row, std::size_t col) const;
+        void check_solvable(std::size_t rows) const;
+    };
+
+    // Symmetric matrix kept as its packed lower triangle. Solved through
+    // CholeskyDecomposition or LDLTDecomposition.
+    template <typename T>
+    class SymmetricMatrix
+    {
+    public:
+        typedef T value_type;
+
+        SymmetricMatrix();
+        explicit SymmetricMatrix(std::size_t size);
+        SymmetricMatrix(std::size_t size, std::vector<T> packed);
+        // Reads only the lower triangle of a square expression.
+        template <typename E>
+        explicit SymmetricMatrix(const MatrixExpression<E>& expression);
+
+        std::size_t rows() const { return _size; }
+        std::size_t cols() const { return _size; }
+        std::size_t size() const { return _size; }
+        const std::vector<T>& packed() const { return _packed; }
+
+        T operator()(std::size_t row, std::size_t col) const;
+        T at(std::size_t row, std::size_t col) const;
+        // Sets both A(row, col) and A(col, row).
+        void set(std::size_t row, std::size_t col, T value);
+
+        Matrix<T> to_dense() const;
+
+        // y = A x for x and y with size() elements.
+        void multiply(const T* x, T* y) const;
+
+    private:
+        std::size_t _size;
+        std::vector<T> _packed;
+    };
+
+    template <typename T>
+    std::vector<T> operator* (const DiagonalMatrix<T>& lhs, const std::vector<T>& rhs);
+
+    template <typename T, typename E>
+    Matrix<T> operator* (const DiagonalMatrix<T>& lhs, const MatrixExpression<E>& rhs);
+
+    template <typename E, typename T>
+    Matrix<T> operator* (const MatrixExpression<E>& lhs, const DiagonalMatrix<T>& rhs);
+
+    template <typename T>
+    DiagonalMatrix<T> operator* (const DiagonalMatrix<T>& lhs, const DiagonalMatrix<T>& rhs);
+
+    template <typename T>
+    std::vector<T> operator* (const BandedMatrix<T>& lhs, const std::vector<T>& rhs);
+
+    template <typename T, typename E>
+    Matrix<T> operator* (const BandedMatrix<T>& lhs, const MatrixExpression<E>& rhs);
+
+    template <typename T>
+    std::vector<T> operator* (const TriangularMatrix<T>& lhs, const std::vector<T>& rhs);
+
+    template <typename T, typename E>
+    Matrix<T> operator* (const TriangularMatrix<T>& lhs, const MatrixExpression<E>& rhs);
+
+    template <typename T>
+    std::vector<T> operator* (const SymmetricMatrix<T>& lhs, const std::vector<T>& rhs);
+
+    template <typename T, typename E>
+    Matrix<T> operator* (const SymmetricMatrix<T>& lhs, const MatrixExpression<E>& rhs);
+
+    namespace Detail
+    {
+        template <typename T>
+        void check_structured_solve();
+
+        template <typename E>
+        void check_square(const MatrixExpression<E>& expression);
+    }
+}
+
+template <typename T>
+inline void LinAlg::Detail::check_structured_solve()
+{
+    if (!std::is_floating_point<T>::value) { throw std::invalid_argument("invalid Matrix template argument"); }
+}
+
+template <typename E>
+inline void LinAlg::Detail::check_square(const MatrixExpression<E>& expression)
+{
+    if (expression.rows() != expression.cols()) { throw std::invalid_argument("square Matrix required"); }
+}
+
+// DiagonalMatrix
+
+template <typename T>
+inline LinAlg::DiagonalMatrix<T>::DiagonalMatrix()
+    : _diagonal()
+{
+}
+
+template <typename T>
+inline LinAlg::DiagonalMatrix<T>::DiagonalMatrix(std::size_t size, T value)
+    : _diagonal(size, value)
+{
+}
+
+template <typename T>
+inline LinAlg::DiagonalMatrix<T>::DiagonalMatrix(std::vector<T> diagonal)
+    : _diagonal(std::move(diagonal))
+{
+}
+
+template <typename T>
+inline LinAlg::DiagonalMatrix<T>::DiagonalMatrix(std::initializer_list<T> il)
+    : _diagonal(il)
+{
+}
+
+template <typename T>
+inline T LinAlg::DiagonalMatrix<T>::at(std::size_t row, std::size_t col) const
+{
+    if (row >= size()) { throw std::out_of_range("invalid Matrix row subscript"); }
+    if (col >= size()) { throw std::out_of_range("invalid Matrix column subscript"); }
+
+    return (*this)(row, col);
+}
+
+template <typename T>
+inline T LinAlg::DiagonalMatrix<T>::determinant() const
+{
+    if (size() == 0) { return T(); }
+
+    T determinant = T(1);
+    for (const T value : _diagonal) { determinant *= value; }
+    return determinant;
+}
+
+template <typename T>
+inline void LinAlg::DiagonalMatrix<T>::check_solvable(std::size_t rows) const
+{
+    Detail::check_structured_solve<T>();
+    if (rows != size()) { throw std::invalid_argument("invalid Matrix argument size"); }
+    if (std::find(_diagonal.begin(), _diagonal.end(), T()) != _diagonal.end()) { throw std::runtime_error("null determinant"); }
+}
+
+template <typename T>
+inline LinAlg::DiagonalMatrix<T> LinAlg::DiagonalMatrix<T>::inverse() const
+{
+    check_solvable(size());
+
+    std::vector<T> inverseDiagonal(size());
+    for (std::size_t i = 0; i < size(); ++i) { inverseDiagonal[i] = T(1) / _diagonal[i]; }
+    return DiagonalMatrix<T>(std::move(inverseDiagonal));
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::DiagonalMatrix<T>::solve(const std::vector<T>& b) const
+{
+    check_solvable(b.size());
+
+    std::vector<T> x(b.size());
+    for (std::size_t i = 0; i < size(); ++i) { x[i] = b[i] / _diagonal[i]; }
+    return x;
+}
+
+template <typename T>
+template <typename E>
+inline LinAlg::Matrix<T> LinAlg::DiagonalMatrix<T>::solve(const MatrixExpression<E>& b) const
+{
+    check_solvable(b.rows());
+
+    Matrix<T> x(b);
+    for (std::size_t i = 0; i < size(); ++i) { Kernels::divide(x.cols(), _diagonal[i], x.data() + i * x.cols()); }
+    return x;
+}
+
+template <typename T>
+inline LinAlg::Matrix<T> LinAlg::DiagonalMatrix<T>::to_dense() const
+{
+    Matrix<T> denseMatrix(size(), size());
+    for (std::size_t i = 0; i < size(); ++i) { denseMatrix(i, i) = _diagonal[i]; }
+    return denseMatrix;
+}
+
+// BandedMatrix
+
+template <typename T>
+inline LinAlg::BandedMatrix<T>::BandedMatrix()
+    : _size(0), _lower(0), _upper(0), _band()
+{
+}
+
+template <typename T>
+inline LinAlg::BandedMatrix<T>::BandedMatrix(std::size_t size, std::size_t lowerBandwidth, std::size_t upperBandwidth)
+    : _size(size), _lower(size == 0 ? 0 : std::min(lowerBandwidth, size - 1)), _upper(size == 0 ? 0 : std::min(upperBandwidth, size - 1)),
+      _band(size * (_lower + _upper + 1))
+{
+}
+
+template <typename T>
+template <typename E>
+inline LinAlg::BandedMatrix<T>::BandedMatrix(std::size_t lowerBandwidth, std::size_t upperBandwidth, const MatrixExpression<E>& expression)
+    : BandedMatrix(expression.rows(), lowerBandwidth, upperBandwidth)
+{
+    Detail::check_square(expression);
+
+    const E& source = expression.derived();
+    for (std::size_t i = 0; i < _size; ++i) {
+        const std::size_t begin = (i > _lower) ? i - _lower : 0, end = std::min(_size, i + _upper + 1);
+        for (std::size_t j = begin; j < end; ++j) { _band[Kernels::band_index(_lower, leading_dimension(), i, j)] = source(i, j); }
+    }
+}
+
+template <typename T>
+inline LinAlg::BandedMatrix<T> LinAlg::BandedMatrix<T>::tridiagonal(const std::vector<T>& lower, const std::vector<T>& diagonal, const std::vector<T>& upper)
+{
+    const std::size_t size = diagonal.size();
+    if (size == 0 ? !lower.empty() || !upper.empty() : lower.size() != size - 1 || upper.size() != size - 1) {
+        throw std::invalid_argument("invalid vector argument size");
+    }
+
+    BandedMatrix<T> tridiagonalMatrix(size, 1, 1);
+    for (std::size_t i = 0; i < size; ++i) {
+        if (i > 0) { tridiagonalMatrix.set(i, i - 1, lower[i - 1]); }
+        tridiagonalMatrix.set(i, i, diagonal[i]);
+        if (i + 1 < size) { tridiagonalMatrix.set(i, i + 1, upper[i]); }
+    }
+    return tridiagonalMatrix;
+}
+
+template <typename T>
+inline T LinAlg::BandedMatrix<T>::operator()(std::size_t row, std::size_t col) const
+{
+    return in_band(row, col) ? _band[Kernels::band_index(_lower, leading_dimension(), row, col)] : T();
+}
+
+template <typename T>
+inline void LinAlg::BandedMatrix<T>::check_subscript(std::size_t row, std::size_t col) const
+{
+    if (row >= _size) { throw std::out_of_range("invalid Matrix row subscript"); }
+    if (col >= _size) { throw std::out_of_range("invalid Matrix column subscript"); }
+}
+
+template <typename T>
+inline T LinAlg::BandedMatrix<T>::at(std::size_t row, std::size_t col) const
+{
+    check_subscript(row, col);
+    return (*this)(row, col);
+}
+
+template <typename T>
+inline void LinAlg::BandedMatrix<T>::set(std::size_t row, std::size_t col, T value)
+{
+    check_subscript(row, col);
+    if (!in_band(row, col)) { throw std::out_of_range("invalid Matrix column subscript"); }
+
+    _band[Kernels::band_index(_lower, leading_dimension(), row, col)] = value;
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::BandedMatrix<T>::factor_storage() const
+{
+    const std::size_t ld = leading_dimension(), factorLd = ld + _lower;
+    std::vector<T> factors(_size * factorLd);
+    for (std::size_t i = 0; i < _size; ++i) { std::copy(_band.begin() + i * ld, _band.begin() + (i + 1) * ld, factors.begin() + i * factorLd); }
+    return factors;
+}
+
+template <typename T>
+inline T LinAlg::BandedMatrix<T>::determinant() const
+{
+    Detail::check_structured_solve<T>();
+    if (_size == 0) { return T(); }
+
+    std::vector<T> factors = factor_storage();
+    std::vector<std::size_t> pivots(_size);
+    const std::size_t factorLd = leading_dimension() + _lower;
+    if (Kernels::band_lu_factor(_size, _lower, _upper, factors.data(), factorLd, pivots.data()) != 0) { return T(); }
+
+    T determinant = T(1);
+    for (std::size_t i = 0; i < _size; ++i) {
+        determinant *= factors[Kernels::band_index(_lower, factorLd, i, i)];
+        if (pivots[i] != i) { determinant = -determinant; }
+    }
+    return determinant;
+}
+
+template <typename T>
+inline LinAlg::Matrix<T> LinAlg::BandedMatrix<T>::to_dense() const
+{
+    Matrix<T> denseMatrix(_size, _size);
+    for (std::size_t i = 0; i < _size; ++i) {
+        const std::size_t begin = (i > _lower) ? i - _lower : 0, end = std::min(_size, i + _upper + 1);
+        for (std::size_t j = begin; j < end; ++j) { denseMatrix(i, j) = (*this)(i, j); }
+    }
+    return denseMatrix;
+}
+
+template <typename T>
+inline void LinAlg::BandedMatrix<T>::multiply(const T* x, T* y) const
+{
+    Kernels::band_gemv(0, _size, _size, _lower, _upper, _band.data(), leading_dimension(), x, y);
+}
+
+// TriangularMatrix
+
+template <typename T>
+inline LinAlg::TriangularMatrix<T>::TriangularMatrix()
+    : _triangle(Triangle::lower), _size(0), _packed()
+{
+}
+
+template <typename T>
+inline LinAlg::TriangularMatrix<T>::TriangularMatrix(Triangle triangle, std::size_t size)
+    : _triangle(triangle), _size(size), _packed(Kernels::packed_size(size))
+{
+}
+
+template <typename T>
+inline LinAlg::TriangularMatrix<T>::TriangularMatrix(Triangle triangle, std::size_t size, std::vector<T> packed)
+    : _triangle(triangle), _size(size), _packed(std::move(packed))
+{
+    if (_packed.size() != Kernels::packed_size(size)) { throw std::invalid_argument("invalid vector argument size"); }
+}
+
+template <typename T>
+template <typename E>
+inline LinAlg::TriangularMatrix<T>::TriangularMatrix(Triangle triangle, const MatrixExpression<E>& expression)
+    : TriangularMatrix(triangle, expression.rows())
+{
+    Detail::check_square(expression);
+
+    const E& source = expression.derived();
+    for (std::size_t i = 0; i < _size; ++i) {
+        const std::size_t begin = (_triangle == Triangle::lower) ? 0 : i, end = (_triangle == Triangle::lower) ? i + 1 : _size;
+        for (std::size_t j = begin; j < end; ++j) { _packed[index(i, j)] = source(i, j); }
+    }
+}
+
+template <typename T>
+inline std::size_t LinAlg::TriangularMatrix<T>::index(std::size_t row, std::size_t col) const
+{
+    return _triangle == Triangle::lower ? Kernels::packed_index(row, col) : Kernels::packed_upper_index(_size, row, col);
+}
+
+template <typename T>
+inline T LinAlg::TriangularMatrix<T>::operator()(std::size_t row, std::size_t col) const
+{
+    return in_triangle(row, col) ? _packed[index(row, col)] : T();
+}
+
+template <typename T>
+inline void LinAlg::TriangularMatrix<T>::check_subscript(std::size_t row, std::size_t col) const
+{
+    if (row >= _size) { throw std::out_of_range("invalid Matrix row subscript"); }
+    if (col >= _size) { throw std::out_of_range("invalid Matrix column subscript"); }
+}
+
+template <typename T>
+inline T LinAlg::TriangularMatrix<T>::at(std::size_t row, std::size_t col) const
+{
+    check_subscript(row, col);
+    return (*this)(row, col);
+}
+
+template <typename T>
+inline void LinAlg::TriangularMatrix<T>::set(std::size_t row, std::size_t col, T value)
+{
+    check_subscript(row, col);
+    if (!in_triangle(row, col)) { throw std::out_of_range("invalid Matrix column subscript"); }
+
+    _packed[index(row, col)] = value;
+}
+
+template <typename T>
+inline T LinAlg::TriangularMatrix<T>::determinant() const
+{
+    if (_size == 0) { return T(); }
+
+    T determinant = T(1);
+    for (std::size_t i = 0; i < _size; ++i) { determinant *= _packed[index(i, i)]; }
+    return determinant;
+}
+
+template <typename T>
+inline void LinAlg::TriangularMatrix<T>::check_solvable(std::size_t rows) const
+{
+    Detail::check_structured_solve<T>();
+    if (rows != _size) { throw std::invalid_argument("invalid Matrix argument size"); }
+    for (std::size_t i = 0; i < _size; ++i) {
+        if (_packed[index(i, i)] == T()) { throw std::runtime_error("null determinant"); }
+    }
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::TriangularMatrix<T>::solve(const std::vector<T>& b) const
+{
+    std::vector<T> x(b);
+    solve_in_place(x);
+    return x;
+}
+
+template <typename T>
+template <typename E>
+inline LinAlg::Matrix<T> LinAlg::TriangularMatrix<T>::solve(const MatrixExpression<E>& b) const
+{
+    Matrix<T> x(b);
+    solve_in_place(x);
+    return x;
+}
+
+template <typename T>
+inline void LinAlg::TriangularMatrix<T>::solve_in_place(std::vector<T>& b) const
+{
+    check_solvable(b.size());
+    Kernels::tp_solve(_triangle == Triangle::lower, _size, _packed.data(), 1, b.data(), 1);
+}
+
+template <typename T>
+inline void LinAlg::TriangularMatrix<T>::solve_in_place(Matrix<T>& b) const
+{
+    check_solvable(b.rows());
+    if (b.cols() == 0) { return; }
+    Kernels::tp_solve(_triangle == Triangle::lower, _size, _packed.data(), b.cols(), b.data(), b.cols());
+}
+
+template <typename T>
+inline LinAlg::TriangularMatrix<T> LinAlg::TriangularMatrix<T>::transposed() const
+{
+    TriangularMatrix<T> transposeMatrix(_triangle == Triangle::lower ? Triangle::upper : Triangle::lower, _size);
+    for (std::size_t i = 0; i < _size; ++i) {
+        const std::size_t begin = (_triangle == Triangle::lower) ? 0 : i, end = (_triangle == Triangle::lower) ? i + 1 : _size;
+        for (std::size_t j = begin; j < end; ++j) { transposeMatrix._packed[transposeMatrix.index(j, i)] = _packed[index(i, j)]; }
+    }
+    return transposeMatrix;
+}
+
+template <typename T>
+inline LinAlg::Matrix<T> LinAlg::TriangularMatrix<T>::to_dense() const
+{
+    Matrix<T> denseMatrix(_size, _size);
+    for (std::size_t i = 0; i < _size; ++i) {
+        const std::size_t begin = (_triangle == Triangle::lower) ? 0 : i, end = (_triangle == Triangle::lower) ? i + 1 : _size;
+        for (std::size_t j = begin; j < end; ++j) { denseMatrix(i, j) = _packed[index(i, j)]; }
+    }
+    return denseMatrix;
+}
+
+template <typename T>
+inline void LinAlg::TriangularMatrix<T>::multiply(const T* x, T* y) const
+{
+    Kernels::tp_gemv(_triangle == Triangle::lower, 0, _size, _size, _packed.data(), x, y);
+}
+
+// SymmetricMatrix
+
+template <typename T>
+inline LinAlg::SymmetricMatrix<T>::SymmetricMatrix()
+    : _size(0), _packed()
+{
+}
+
+template <typename T>
+inline LinAlg::SymmetricMatrix<T>::SymmetricMatrix(std::size_t size)
+    : _size(size), _packed(Kernels::packed_size(size))
+{
+}
+
+template <typename T>
+inline LinAlg::SymmetricMatrix<T>::SymmetricMatrix(std::size_t size, std::vector<T> packed)
+    : _size(size), _packed(std::move(packed))
+{
+    if (_packed.size() != Kernels::packed_size(size)) { throw std::invalid_argument("invalid vector argument size"); }
+}
+
+template <typename T>
+template <typename E>
+inline LinAlg::SymmetricMatrix<T>::SymmetricMatrix(const MatrixExpression<E>& expression)
+    : SymmetricMatrix(expression.rows())
+{
+    Detail::check_square(expression);
+
+    const E& source = expression.derived();
+    for (std::size_t i = 0; i < _size; ++i) {
+        for (std::size_t j = 0; j <= i; ++j) { _packed[Kernels::packed_index(i, j)] = source(i, j); }
+    }
+}
+
+template <typename T>
+inline T LinAlg::SymmetricMatrix<T>::operator()(std::size_t row, std::size_t col) const
+{
+    return row >= col ? _packed[Kernels::packed_index(row, col)] : _packed[Kernels::packed_index(col, row)];
+}
+
+template <typename T>
+inline T LinAlg::SymmetricMatrix<T>::at(std::size_t row, std::size_t col) const
+{
+    if (row >= _size) { throw std::out_of_range("invalid Matrix row subscript"); }
+    if (col >= _size) { throw std::out_of_range("invalid Matrix column subscript"); }
+
+    return (*this)(row, col);
+}
+
+template <typename T>
+inline void LinAlg::SymmetricMatrix<T>::set(std::size_t row, std::size_t col, T value)
+{
+    if (row >= _size) { throw std::out_of_range("invalid Matrix row subscript"); }
+    if (col >= _size) { throw std::out_of_range("invalid Matrix column subscript"); }
+
+    _packed[row >= col ? Kernels::packed_index(row, col) : Kernels::packed_index(col, row)] = value;
+}
+
+template <typename T>
+inline LinAlg::Matrix<T> LinAlg::SymmetricMatrix<T>::to_dense() const
+{
+    Matrix<T> denseMatrix(_size, _size, uninitialized);
+    for (std::size_t i = 0; i < _size; ++i) {
+        for (std::size_t j = 0; j <= i; ++j) { denseMatrix(i, j) = denseMatrix(j, i) = _packed[Kernels::packed_index(i, j)]; }
+    }
+    return denseMatrix;
+}
+
+template <typename T>
+inline void LinAlg::SymmetricMatrix<T>::multiply(const T* x, T* y) const
+{
+    Kernels::sp_gemv(_size, _packed.data(), x, y);
+}
+
+// Products
+
+template <typename T>
+inline std::vector<T> LinAlg::operator* (const DiagonalMatrix<T>& lhs, const std::vector<T>& rhs)
+{
+    if (lhs.cols() != rhs.size()) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+    std::vector<T> result(rhs.size());
+    for (std::size_t i = 0; i < rhs.size(); ++i) { result[i] = lhs[i] * rhs[i]; }
+    return result;
+}
+
+template <typename T, typename E>
+inline LinAlg::Matrix<T> LinAlg::operator* (const DiagonalMatrix<T>& lhs, const MatrixExpression<E>& rhs)
+{
+    if (lhs.cols() != rhs.rows()) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+    Matrix<T> resultMatrix(rhs);
+    for (std::size_t i = 0; i < resultMatrix.rows(); ++i) { Kernels::scale(resultMatrix.cols(), lhs[i], resultMatrix.data() + i * resultMatrix.cols()); }
+    return resultMatrix;
+}
+
+template <typename E, typename T>
+inline LinAlg::Matrix<T> LinAlg::operator* (const MatrixExpression<E>& lhs, const DiagonalMatrix<T>& rhs)
+{
+    if (lhs.cols() != rhs.rows()) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+    Matrix<T> resultMatrix(lhs);
+    const T* diagonal = rhs.diagonal().data();
+    for (std::size_t i = 0; i < resultMatrix.rows(); ++i) {
+        T* row = resultMatrix.data() + i * resultMatrix.cols();
+        for (std::size_t j = 0; j < resultMatrix.cols(); ++j) { row[j] *= diagonal[j]; }
+    }
+    return resultMatrix;
+}
+
+template <typename T>
+inline LinAlg::DiagonalMatrix<T> LinAlg::operator* (const DiagonalMatrix<T>& lhs, const DiagonalMatrix<T>& rhs)
+{
+    return DiagonalMatrix<T>(lhs * rhs.diagonal());
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::operator* (const BandedMatrix<T>& lhs, const std::vector<T>& rhs)
+{
+    if (lhs.cols() != rhs.size()) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+    std::vector<T> result(lhs.rows());
+    lhs.multiply(rhs.data(), result.data());
+    return result;
+}
+
+template <typename T, typename E>
+inline LinAlg::Matrix<T> LinAlg::operator* (const BandedMatrix<T>& lhs, const MatrixExpression<E>& rhs)
+{
+    if (lhs.cols() != rhs.rows()) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+    const Detail::GemmOperand<E> rhsOperand(rhs.derived());
+    const ConstMatrixView<T>& b = rhsOperand.view;
+    Matrix<T> resultMatrix(lhs.rows(), b.cols(), uninitialized);
+    if (b.cols() == 0) { return resultMatrix; }
+
+    const std::size_t n = lhs.size(), kl = lhs.lower_bandwidth(), ku = lhs.upper_bandwidth(), ld = lhs.leading_dimension(), cols = b.cols();
+    const T* band = lhs.band().data();
+    T* c = resultMatrix.data();
+    LinAlg::parallel_for(n * ld * cols, 0, n, Detail::row_grain(ld * cols), [=, &b](std::size_t first, std::size_t last) {
+        LinAlg::Kernels::band_gemm(first, last, n, kl, ku, band, ld, cols, b.data(), b.row_stride(), b.col_stride(), c, cols);
+    });
+    return resultMatrix;
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::operator* (const TriangularMatrix<T>& lhs, const std::vector<T>& rhs)
+{
+    if (lhs.cols() != rhs.size()) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+    std::vector<T> result(lhs.rows());
+    lhs.multiply(rhs.data(), result.data());
+    return result;
+}
+
+template <typename T, typename E>
+inline LinAlg::Matrix<T> LinAlg::operator* (const TriangularMatrix<T>& lhs, const MatrixExpression<E>& rhs)
+{
+    if (lhs.cols() != rhs.rows()) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+    const Detail::GemmOperand<E> rhsOperand(rhs.derived());
+    const ConstMatrixView<T>& b = rhsOperand.view;
+    Matrix<T> resultMatrix(lhs.rows(), b.cols(), uninitialized);
+    if (b.cols() == 0) { return resultMatrix; }
+
+    const bool lower = lhs.triangle() == Triangle::lower;
+    const std::size_t n = lhs.size(), cols = b.cols();
+    const T* a = lhs.packed().data();
+    T* c = resultMatrix.data();
+    LinAlg::parallel_for(lhs.packed().size() * cols, 0, n, Detail::row_grain(n * cols / 2 + 1), [=, &b](std::size_t first, std::size_t last) {
+        LinAlg::Kernels::tp_gemm(lower, first, last, n, a, cols, b.data(), b.row_stride(), b.col_stride(), c, cols);
+    });
+    return resultMatrix;
+}
+
+template <typename T>
+inline std::vector<T> LinAlg::operator* (const SymmetricMatrix<T>& lhs, const std::vector<T>& rhs)
+{
+    if (lhs.cols() != rhs.size()) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+    std::vector<T> result(lhs.rows());
+    lhs.multiply(rhs.data(), result.data());
+    return result;
+}
+
+template <typename T, typename E>
+inline LinAlg::Matrix<T> LinAlg::operator* (const SymmetricMatrix<T>& lhs, const MatrixExpression<E>& rhs)
+{
+    if (lhs.cols() != rhs.rows()) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+    const Detail::GemmOperand<E> rhsOperand(rhs.derived());
+    const ConstMatrixView<T>& b = rhsOperand.view;
+    Matrix<T> resultMatrix(lhs.rows(), b.cols(), uninitialized);
+    if (b.cols() == 0) { return resultMatrix; }
+
+    Kernels::sp_gemm(lhs.size(), lhs.packed().data(), b.cols(), b.data(), b.row_stride(), b.col_stride(), resultMatrix.data(), b.cols());
+    return resultMatrix;
+}
+
+#endif // STRUCTURED_MATRIX_HPP
@@ -0,0 +1,526 @@
+#ifndef TASK_GRAPH_HPP
+#define TASK_GRAPH_HPP
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ExecutionPolicy.hpp"
+#include "Matrix.hpp"
+#include "MatrixBatch.hpp"
+#include "SolutionSLE/batch_lu_decomposition.hpp"
+#include "SolutionSLE/lu_decomposition.hpp"
+
+namespace LinAlg
+{
+    template <typename T>
+    class TaskGraph;
+
+    namespace Detail
+    {
+        enum class TaskKind { value, function, multiply, solve };
+
+        // One operation of a TaskGraph. Everything but result and error is
+        // guarded by the mutex of the owning TaskState.
+        template <typename T>
+        struct TaskNode
+        {
+            TaskKind kind;
+            std::vector< std::shared_ptr<TaskNode> > inputs;
+            std::function<Matrix<T>(const std::vector<const Matrix<T>*>&)> function;
+            std::vector< std::shared_ptr<TaskNode> > dependents;
+            std::size_t waiting = 0;
+            bool done = false;
+            Matrix<T> result;
+            std::exception_ptr error;
+        };
+
+        // Scheduler shared by a TaskGraph and its futures. A unit is either one
+        // operation or a bucket of batched ones; running counts the units handed
+        // to the policy that have not completed yet. Tasks refer to the state by
+        // pointer, kept valid by the TaskGraph destructor waiting for them: a
+        // task holding the last reference would destroy the pool on one of its
+        // own workers.
+        template <typename T>
+        class TaskState
+        {
+        public:
+            typedef std::shared_ptr< TaskNode<T> > Node;
+            typedef std::vector<Node> Unit;
+
+            TaskState(std::shared_ptr<ExecutionPolicy> policy, std::size_t batchSize);
+
+            std::size_t batch_size() const { return _batchSize; }
+
+            void add(const Node& node);
+            bool done(const TaskNode<T>& node);
+            void flush();
+            void wait();
+            void wait(const TaskNode<T>& node);
+
+        private:
+            typedef std::tuple<TaskKind, std::size_t, std::size_t, std::size_t> BatchKey;
+
+            std::shared_ptr<ExecutionPolicy> _policy;
+            ThreadPool* _pool;
+            std::size_t _batchSize;
+            std::mutex _mutex;
+            std::condition_variable _changed;
+            std::size_t _running;
+            std::map<BatchKey, Unit> _buckets;
+            std::deque<Unit> _inline;
+            bool _draining;
+
+            bool batch_key(const TaskNode<T>& node, BatchKey& key) const;
+            void ready(const Node& node, std::vector<Unit>& units);
+            void take_buckets(std::vector<Unit>& units);
+            void start(std::vector<Unit>& units);
+            void run(const Unit& unit);
+            void complete(const Unit& unit);
+
+            static void evaluate(TaskNode<T>& node);
+            static void evaluate_batch(const Unit& unit);
+        };
+
+        // Orders up to which products and solves are gathered into a MatrixBatch.
+        const std::size_t task_batch_order = 32;
+    }
+
+    // Handle to the result of a TaskGraph operation. get() and wait() first
+    // flush the graph, so they never wait on a bucket that nothing else would
+    // release; they must not be called from inside a task of the same graph.
+    template <typename T>
+    class MatrixFuture
+    {
+    public:
+        MatrixFuture() = default;
+
+        bool valid() const { return static_cast<bool>(_node); }
+        bool ready() const;
+        void wait() const;
+        // Rethrows the exception of the operation or of the first failed
+        // operation it depends on.
+        const Matrix<T>& get() const;
+
+    private:
+        std::shared_ptr< Detail::TaskState<T> > _state;
+        std::shared_ptr< Detail::TaskNode<T> > _node;
+
+        MatrixFuture(std::shared_ptr< Detail::TaskState<T> > state, std::shared_ptr< Detail::TaskNode<T> > node)
+            : _state(std::move(state)), _node(std::move(node)) {}
+
+        friend class TaskGraph<T>;
+    };
+
+    // Asynchronous Matrix operations on an execution policy, ordered by the
+    // futures they take: an operation starts once its inputs are available,
+    // without blocking the caller or a worker. Tasks run through
+    // ThreadPool::submit, the same pool that parallel_for uses inside them;
+    // any other policy runs them on the submitting thread.
+    //
+    // Products and solves of orders up to 32 are not started one by one. Once
+    // ready they wait in a bucket per operation and shape, and the bucket runs
+    // as one MatrixBatch product or BatchLUDecomposition solve when it holds
+    // batch_size() operations, on flush(), or when the last running task
+    // finishes. A batch size below 2 starts every operation on its own.
+    template <typename T>
+    class TaskGraph
+    {
+    public:
+        explicit TaskGraph(std::shared_ptr<ExecutionPolicy> policy = execution_policy(),
+                           std::size_t batchSize = 4 * Kernels::batch_lanes);
+        TaskGraph(const TaskGraph&) = delete;
+        TaskGraph& operator= (const TaskGraph&) = delete;
+        // Waits for every operation submitted.
+        ~TaskGraph();
+
+        std::size_t batch_size() const { return _state->batch_size(); }
+
+        MatrixFuture<T> value(Matrix<T> matrix);
+        MatrixFuture<T> multiply(const MatrixFuture<T>& lhs, const MatrixFuture<T>& rhs);
+        // X = A^-1 B by LU decomposition.
+        MatrixFuture<T> solve(const MatrixFuture<T>& matrix, const MatrixFuture<T>& b);
+
+        // function() or function(inputs...) must return a Matrix<T> expression.
+        template <typename F>
+        MatrixFuture<T> submit(F function);
+        template <typename F>
+        MatrixFuture<T> submit(F function, const MatrixFuture<T>& input);
+        template <typename F>
+        MatrixFuture<T> submit(F function, const MatrixFuture<T>& lhs, const MatrixFuture<T>& rhs);
+
+        // Starts every queued bucket, however few operations it holds.
+        void flush();
+        // Flushes and returns once every operation submitted has completed.
+        void wait();
+
+    private:
+        std::shared_ptr< Detail::TaskState<T> > _state;
+
+        MatrixFuture<T> add(Detail::TaskKind kind, std::vector< std::shared_ptr< Detail::TaskNode<T> > > inputs,
+                            std::function<Matrix<T>(const std::vector<const Matrix<T>*>&)> function);
+        std::shared_ptr< Detail::TaskNode<T> > input(const MatrixFuture<T>& future) const;
+    };
+}
+
+template <typename T>
+inline LinAlg::Detail::TaskState<T>::TaskState(std::shared_ptr<ExecutionPolicy> policy, std::size_t batchSize)
+    : _policy(policy ? std::move(policy) : std::make_shared<SequentialPolicy>()), _pool(nullptr),
+      _batchSize(batchSize), _running(0), _draining(false)
+{
+    ThreadPool* pool = dynamic_cast<ThreadPool*>(_policy.get());
+    if (pool && pool->concurrency() > 1) { _pool = pool; }
+}
+
+template <typename T>
+inline void LinAlg::Detail::TaskState<T>::add(const Node& node)
+{
+    std::vector<Unit> units;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (const Node& input : node->inputs) {
+            if (!input->done) {
+                input->dependents.push_back(node);
+                ++node->waiting;
+            }
+        }
+        if (node->waiting == 0) { ready(node, units); }
+    }
+    start(units);
+}
+
+template <typename T>
+inline bool LinAlg::Detail::TaskState<T>::done(const TaskNode<T>& node)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return node.done;
+}
+
+template <typename T>
+inline void LinAlg::Detail::TaskState<T>::flush()
+{
+    std::vector<Unit> units;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        take_buckets(units);
+    }
+    start(units);
+}
+
+template <typename T>
+inline void LinAlg::Detail::TaskState<T>::wait()
+{
+    flush();
+    std::unique_lock<std::mutex> lock(_mutex);
+    _changed.wait(lock, [this]() { return _running == 0 && _buckets.empty(); });
+}
+
+template <typename T>
+inline void LinAlg::Detail::TaskState<T>::wait(const TaskNode<T>& node)
+{
+    flush();
+    std::unique_lock<std::mutex> lock(_mutex);
+    _changed.wait(lock, [&node]() { return node.done; });
+}
+
+template <typename T>
+inline bool LinAlg::Detail::TaskState<T>::batch_key(const TaskNode<T>& node, BatchKey& key) const
+{
+    if (_batchSize < 2 || (node.kind != TaskKind::multiply && node.kind != TaskKind::solve)) { return false; }
+    if (node.inputs[0]->error || node.inputs[1]->error) { return false; }
+
+    const Matrix<T>& lhs = node.inputs[0]->result;
+    const Matrix<T>& rhs = node.inputs[1]->result;
+    const std::size_t m = lhs.rows(), k = lhs.cols(), n = rhs.cols();
+    if (lhs.cols() != rhs.rows() || m == 0 || k == 0 || n == 0) { return false; }
+    if (m > task_batch_order || k > task_batch_order || n > task_batch_order) { return false; }
+    if (node.kind == TaskKind::solve && (m != k || !std::is_floating_point<T>::value)) { return false; }
+
+    key = BatchKey(node.kind, m, k, n);
+    return true;
+}
+
+template <typename T>
+inline void LinAlg::Detail::TaskState<T>::ready(const Node& node, std::vector<Unit>& units)
+{
+    BatchKey key;
+    if (!batch_key(*node, key)) {
+        units.push_back(Unit(1, node));
+        ++_running;
+        return;
+    }
+
+    Unit& bucket = _buckets[key];
+    bucket.push_back(node);
+    if (bucket.size() >= _batchSize) {
+        units.push_back(std::move(bucket));
+        _buckets.erase(key);
+        ++_running;
+    }
+}
+
+template <typename T>
+inline void LinAlg::Detail::TaskState<T>::take_buckets(std::vector<Unit>& units)
+{
+    for (auto& bucket : _buckets) {
+        units.push_back(std::move(bucket.second));
+        ++_running;
+    }
+    _buckets.clear();
+}
+
+template <typename T>
+inline void LinAlg::Detail::TaskState<T>::start(std::vector<Unit>& units)
+{
+    if (units.empty()) { return; }
+
+    if (_pool) {
+        TaskState* self = this;
+        for (Unit& unit : units) {
+            _pool->submit([self, unit]() { self->run(unit); });
+        }
+        return;
+    }
+
+    // Without workers the units run here, from a queue rather than by
+    // recursion, so a long chain of dependents does not grow the stack.
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        for (Unit& unit : units) { _inline.push_back(std::move(unit)); }
+        if (_draining) { return; }
+        _draining = true;
+    }
+    for (;;) {
+        Unit unit;
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            if (_inline.empty()) {
+                _draining = false;
+                return;
+            }
+            unit = std::move(_inline.front());
+            _inline.pop_front();
+        }
+        run(unit);
+    }
+}
+
+template <typename T>
+inline void LinAlg::Detail::TaskState<T>::run(const Unit& unit)
+{
+    {
+        ScopedExecutionPolicy scopedPolicy(_policy);
+        if (unit.size() == 1) {
+            evaluate(*unit.front());
+        } else {
+            evaluate_batch(unit);
+        }
+    }
+    complete(unit);
+}
+
+template <typename T>
+inline void LinAlg::Detail::TaskState<T>::complete(const Unit& unit)
+{
+    std::vector<Unit> units;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        --_running;
+        for (const Node& node : unit) {
+            node->done = true;
+            node->inputs.clear();
+            node->function = nullptr;
+            for (const Node& dependent : node->dependents) {
+                if (--dependent->waiting == 0) { ready(dependent, units); }
+            }
+            node->dependents.clear();
+        }
+        if (_running == 0) { take_buckets(units); }
+        _changed.notify_all();
+    }
+    start(units);
+}
+
+template <typename T>
+inline void LinAlg::Detail::TaskState<T>::evaluate(TaskNode<T>& node)
+{
+    for (const Node& input : node.inputs) {
+        if (input->error) {
+            node.error = input->error;
+            return;
+        }
+    }
+
+    try {
+        switch (node.kind) {
+        case TaskKind::multiply:
+            node.result = node.inputs[0]->result * node.inputs[1]->result;
+            break;
+        case TaskKind::solve:
+            node.result = LUDecomposition<T>(node.inputs[0]->result).solve(node.inputs[1]->result);
+            break;
+        default: {
+            std::vector<const Matrix<T>*> inputs;
+            for (const Node& input : node.inputs) { inputs.push_back(&input->result); }
+            node.result = node.function(inputs);
+            break;
+        }
+        }
+    } catch (...) {
+        node.error = std::current_exception();
+    }
+}
+
+template <typename T>
+inline void LinAlg::Detail::TaskState<T>::evaluate_batch(const Unit& unit)
+{
+    const TaskNode<T>& first = *unit.front();
+    const std::size_t count = unit.size();
+    const std::size_t m = first.inputs[0]->result.rows(), k = first.inputs[0]->result.cols(), n = first.inputs[1]->result.cols();
+
+    try {
+        MatrixBatch<T> lhs(count, m, k), rhs(count, k, n);
+        for (std::size_t index = 0; index < count; ++index) {
+            lhs.set_matrix(index, unit[index]->inputs[0]->result);
+            rhs.set_matrix(index, unit[index]->inputs[1]->result);
+        }
+
+        MatrixBatch<T> result;
+        if (first.kind == TaskKind::multiply) {
+            result = lhs * rhs;
+        } else {
+            const BatchLUDecomposition<T> decomposition(std::move(lhs));
+            if (decomposition.any_singular()) {
+                // Only the singular systems fail, with the error of a single solve.
+                for (const Node& node : unit) { evaluate(*node); }
+                return;
+            }
+            result = decomposition.solve(rhs);
+        }
+        for (std::size_t index = 0; index < count; ++index) { unit[index]->result = result.get_matrix(index); }
+    } catch (...) {
+        for (const Node& node : unit) { node->error = std::current_exception(); }
+    }
+}
+
+template <typename T>
+inline bool LinAlg::MatrixFuture<T>::ready() const
+{
+    if (!_node) { return false; }
+    return _state->done(*_node);
+}
+
+template <typename T>
+inline void LinAlg::MatrixFuture<T>::wait() const
+{
+    if (!_node) { throw std::invalid_argument("invalid Matrix task argument"); }
+    _state->wait(*_node);
+}
+
+template <typename T>
+inline const LinAlg::Matrix<T>& LinAlg::MatrixFuture<T>::get() const
+{
+    wait();
+    if (_node->error) { std::rethrow_exception(_node->error); }
+    return _node->result;
+}
+
+template <typename T>
+inline LinAlg::TaskGraph<T>::TaskGraph(std::shared_ptr<ExecutionPolicy> policy, std::size_t batchSize)
+    : _state(std::make_shared< Detail::TaskState<T> >(std::move(policy), batchSize))
+{
+}
+
+template <typename T>
+inline LinAlg::TaskGraph<T>::~TaskGraph()
+{
+    _state->wait();
+}
+
+template <typename T>
+inline std::shared_ptr< LinAlg::Detail::TaskNode<T> > LinAlg::TaskGraph<T>::input(const MatrixFuture<T>& future) const
+{
+    if (!future._node || future._state != _state) { throw std::invalid_argument("invalid Matrix task argument"); }
+    return future._node;
+}
+
+template <typename T>
+inline LinAlg::MatrixFuture<T> LinAlg::TaskGraph<T>::add(Detail::TaskKind kind, std::vector< std::shared_ptr< Detail::TaskNode<T> > > inputs,
+                                                         std::function<Matrix<T>(const std::vector<const Matrix<T>*>&)> function)
+{
+    std::shared_ptr< Detail::TaskNode<T> > node = std::make_shared< Detail::TaskNode<T> >();
+    node->kind = kind;
+    node->inputs = std::move(inputs);
+    node->function = std::move(function);
+    _state->add(node);
+    return MatrixFuture<T>(_state, node);
+}
+
+template <typename T>
+inline LinAlg::MatrixFuture<T> LinAlg::TaskGraph<T>::value(Matrix<T> matrix)
+{
+    std::shared_ptr< Detail::TaskNode<T> > node = std::make_shared< Detail::TaskNode<T> >();
+    node->kind = Detail::TaskKind::value;
+    node->result = std::move(matrix);
+    node->done = true;
+    return MatrixFuture<T>(_state, node);
+}
+
+template <typename T>
+inline LinAlg::MatrixFuture<T> LinAlg::TaskGraph<T>::multiply(const MatrixFuture<T>& lhs, const MatrixFuture<T>& rhs)
+{
+    return add(Detail::TaskKind::multiply, { input(lhs), input(rhs) }, nullptr);
+}
+
+template <typename T>
+inline LinAlg::MatrixFuture<T> LinAlg::TaskGraph<T>::solve(const MatrixFuture<T>& matrix, const MatrixFuture<T>& b)
+{
+    return add(Detail::TaskKind::solve, { input(matrix), input(b) }, nullptr);
+}
+
+template <typename T>
+template <typename F>
+inline LinAlg::MatrixFuture<T> LinAlg::TaskGraph<T>::submit(F function)
+{
+    return add(Detail::TaskKind::function, {}, [function](const std::vector<const Matrix<T>*>&) { return Matrix<T>(function()); });
+}
+
+template <typename T>
+template <typename F>
+inline LinAlg::MatrixFuture<T> LinAlg::TaskGraph<T>::submit(F function, const MatrixFuture<T>& input)
+{
+    return add(Detail::TaskKind::function, { this->input(input) },
+               [function](const std::vector<const Matrix<T>*>& inputs) { return Matrix<T>(function(*inputs[0])); });
+}
+
+template <typename T>
+template <typename F>
+inline LinAlg::MatrixFuture<T> LinAlg::TaskGraph<T>::submit(F function, const MatrixFuture<T>& lhs, const MatrixFuture<T>& rhs)
+{
+    return add(Detail::TaskKind::function, { input(lhs), input(rhs) },
+               [function](const std::vector<const Matrix<T>*>& inputs) { return Matrix<T>(function(*inputs[0], *inputs[1])); });
+}
+
+template <typename T>
+inline void LinAlg::TaskGraph<T>::flush()
+{
+    _state->flush();
+}
+
+template <typename T>
+inline void LinAlg::TaskGraph<T>::wait()
+{
+    _state->wait();
+}
+
+#endif // TASK_GRAPH_HPP
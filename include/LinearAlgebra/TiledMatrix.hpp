@@ -0,0 +1,509 @@
+#ifndef TILED_MATRIX_HPP
+#define TILED_MATRIX_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <future>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Allocator.hpp"
+#include "ExecutionPolicy.hpp"
+#include "Instrumentation.hpp"
+#include "Matrix.hpp"
+#include "Serialization.hpp"
+#include "Kernels/gemm.hpp"
+#include "Kernels/transpose.hpp"
+
+namespace LinAlg
+{
+    namespace Detail
+    {
+        // Positional reads and writes of a file, safe to issue from several threads.
+        class MatrixFile
+        {
+        public:
+            MatrixFile();
+            MatrixFile(const std::string& path, bool create, bool writable);
+            MatrixFile(const MatrixFile&) = delete;
+            MatrixFile(MatrixFile&& other) noexcept;
+            MatrixFile& operator= (const MatrixFile&) = delete;
+            MatrixFile& operator= (MatrixFile&& other) noexcept;
+            ~MatrixFile();
+
+            std::uint64_t size() const;
+            void resize(std::uint64_t bytes) const;
+            void read(std::uint64_t offset, void* data, std::size_t bytes) const;
+            void write(std::uint64_t offset, const void* data, std::size_t bytes) const;
+
+        private:
+#if defined(_WIN32)
+            HANDLE _handle;
+#else
+            int _descriptor;
+#endif
+
+            void close() noexcept;
+        };
+    }
+
+    // Matrix kept in a tiled Matrix file instead of memory. Tiles are square,
+    // tile_size() on a side, and are read and written whole, zero padded past
+    // the last row and column; only the tiles in flight are ever resident.
+    template <typename T>
+    class TiledMatrix
+    {
+    public:
+        typedef T value_type;
+        typedef std::vector< T, AlignedAllocator<T> > tile_type;
+
+        static const std::size_t default_tile_size = 512;
+
+        // Creates path, replacing any file there, holding a zero rows x cols Matrix.
+        static TiledMatrix create(const std::string& path, std::size_t rows, std::size_t cols, std::size_t tileSize = default_tile_size);
+
+        template <typename A>
+        static TiledMatrix create(const std::string& path, const Matrix<T, A>& matrix, std::size_t tileSize = default_tile_size);
+
+        static TiledMatrix open(const std::string& path, bool writable = false);
+
+        TiledMatrix(const TiledMatrix&) = delete;
+        TiledMatrix(TiledMatrix&& other) noexcept = default;
+        TiledMatrix& operator= (const TiledMatrix&) = delete;
+        TiledMatrix& operator= (TiledMatrix&& other) noexcept = default;
+
+        std::size_t rows() const { return _rows; }
+        std::size_t cols() const { return _cols; }
+        std::size_t tile_size() const { return _tileSize; }
+        std::size_t tile_rows() const { return (_rows + _tileSize - 1) / _tileSize; }
+        std::size_t tile_cols() const { return (_cols + _tileSize - 1) / _tileSize; }
+        std::size_t tile_elements() const { return _tileSize * _tileSize; }
+
+        // Rows and columns of a tile that lie inside the Matrix.
+        std::size_t tile_height(std::size_t tileRow) const { return std::min(_tileSize, _rows - tileRow * _tileSize); }
+        std::size_t tile_width(std::size_t tileCol) const { return std::min(_tileSize, _cols - tileCol * _tileSize); }
+
+        // Whole padded tiles of tile_elements(), row-major with row stride tile_size().
+        void read_tile(std::size_t tileRow, std::size_t tileCol, T* tile) const;
+        void write_tile(std::size_t tileRow, std::size_t tileCol, const T* tile);
+
+        Matrix<T> tile(std::size_t tileRow, std::size_t tileCol) const;
+
+        template <typename A>
+        void set_tile(std::size_t tileRow, std::size_t tileCol, const Matrix<T, A>& tile);
+
+        // Loads the whole Matrix, which must then fit in memory.
+        Matrix<T> to_matrix() const;
+
+    private:
+        Detail::MatrixFile _file;
+        std::size_t _rows;
+        std::size_t _cols;
+        std::size_t _tileSize;
+        std::uint64_t _dataOffset;
+
+        TiledMatrix(Detail::MatrixFile&& file, std::size_t rows, std::size_t cols, std::size_t tileSize, std::uint64_t dataOffset);
+
+        std::uint64_t tile_offset(std::size_t tileRow, std::size_t tileCol) const;
+        void check_tile(std::size_t tileRow, std::size_t tileCol) const;
+    };
+
+    template <typename T>
+    const std::size_t TiledMatrix<T>::default_tile_size;
+
+    // Streaming C = A * B into a new tiled file at path. The next pair of input
+    // tiles is read and the previous result tile written while the current pair
+    // is multiplied, so six tiles are resident whatever the Matrix sizes.
+    template <typename T>
+    TiledMatrix<T> multiply(const TiledMatrix<T>& a, const TiledMatrix<T>& b, const std::string& path);
+
+    // Streaming transpose into a new tiled file at path, overlapped the same way.
+    template <typename T>
+    TiledMatrix<T> transpose(const TiledMatrix<T>& a, const std::string& path);
+
+    namespace Detail
+    {
+        const std::size_t matrix_file_chunk = std::size_t(1) << 30;
+
+        void check_tile_size(std::size_t tileSize);
+    }
+}
+
+inline LinAlg::Detail::MatrixFile::MatrixFile()
+#if defined(_WIN32)
+    : _handle(INVALID_HANDLE_VALUE)
+#else
+    : _descriptor(-1)
+#endif
+{
+}
+
+inline LinAlg::Detail::MatrixFile::MatrixFile(const std::string& path, bool create, bool writable)
+    : MatrixFile()
+{
+#if defined(_WIN32)
+    _handle = CreateFileA(path.c_str(), writable ? GENERIC_READ | GENERIC_WRITE : GENERIC_READ, FILE_SHARE_READ, nullptr,
+                          create ? CREATE_ALWAYS : OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (_handle == INVALID_HANDLE_VALUE) { throw std::runtime_error("cannot open Matrix file"); }
+#else
+    const int flags = (writable ? O_RDWR : O_RDONLY) | (create ? O_CREAT | O_TRUNC : 0);
+    _descriptor = ::open(path.c_str(), flags, 0644);
+    if (_descriptor < 0) { throw std::runtime_error("cannot open Matrix file"); }
+#endif
+}
+
+inline LinAlg::Detail::MatrixFile::MatrixFile(MatrixFile&& other) noexcept
+    : MatrixFile()
+{
+#if defined(_WIN32)
+    std::swap(_handle, other._handle);
+#else
+    std::swap(_descriptor, other._descriptor);
+#endif
+}
+
+inline LinAlg::Detail::MatrixFile& LinAlg::Detail::MatrixFile::operator= (MatrixFile&& other) noexcept
+{
+    if (this != &other) {
+        close();
+#if defined(_WIN32)
+        std::swap(_handle, other._handle);
+#else
+        std::swap(_descriptor, other._descriptor);
+#endif
+    }
+    return *this;
+}
+
+inline LinAlg::Detail::MatrixFile::~MatrixFile()
+{
+    close();
+}
+
+inline void LinAlg::Detail::MatrixFile::close() noexcept
+{
+#if defined(_WIN32)
+    if (_handle != INVALID_HANDLE_VALUE) { CloseHandle(_handle); }
+    _handle = INVALID_HANDLE_VALUE;
+#else
+    if (_descriptor >= 0) { ::close(_descriptor); }
+    _descriptor = -1;
+#endif
+}
+
+inline std::uint64_t LinAlg::Detail::MatrixFile::size() const
+{
+#if defined(_WIN32)
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(_handle, &fileSize)) { throw std::runtime_error("Matrix file read failed"); }
+    return static_cast<std::uint64_t>(fileSize.QuadPart);
+#else
+    struct stat status;
+    if (::fstat(_descriptor, &status) != 0) { throw std::runtime_error("Matrix file read failed"); }
+    return static_cast<std::uint64_t>(status.st_size);
+#endif
+}
+
+// Extending leaves a sparse hole where the file system supports one, which
+// reads back as zero tiles.
+inline void LinAlg::Detail::MatrixFile::resize(std::uint64_t bytes) const
+{
+#if defined(_WIN32)
+    FILE_END_OF_FILE_INFO endOfFile;
+    endOfFile.EndOfFile.QuadPart = static_cast<LONGLONG>(bytes);
+    if (!SetFileInformationByHandle(_handle, FileEndOfFileInfo, &endOfFile, sizeof(endOfFile))) {
+        throw std::runtime_error("Matrix file write failed");
+    }
+#else
+    if (::ftruncate(_descriptor, static_cast<off_t>(bytes)) != 0) { throw std::runtime_error("Matrix file write failed"); }
+#endif
+}
+
+inline void LinAlg::Detail::MatrixFile::read(std::uint64_t offset, void* data, std::size_t bytes) const
+{
+    char* out = static_cast<char*>(data);
+    while (bytes > 0) {
+        const std::size_t chunk = std::min(bytes, matrix_file_chunk);
+#if defined(_WIN32)
+        OVERLAPPED position = {};
+        position.Offset = static_cast<DWORD>(offset);
+        position.OffsetHigh = static_cast<DWORD>(offset >> 32);
+        DWORD done = 0;
+        if (!ReadFile(_handle, out, static_cast<DWORD>(chunk), &done, &position) || done == 0) {
+            throw std::runtime_error("Matrix file read failed");
+        }
+#else
+        const ssize_t done = ::pread(_descriptor, out, chunk, static_cast<off_t>(offset));
+        if (done <= 0) { throw std::runtime_error("Matrix file read failed"); }
+#endif
+        out += done;
+        offset += static_cast<std::uint64_t>(done);
+        bytes -= static_cast<std::size_t>(done);
+    }
+}
+
+inline void LinAlg::Detail::MatrixFile::write(std::uint64_t offset, const void* data, std::size_t bytes) const
+{
+    const char* in = static_cast<const char*>(data);
+    while (bytes > 0) {
+        const std::size_t chunk = std::min(bytes, matrix_file_chunk);
+#if defined(_WIN32)
+        OVERLAPPED position = {};
+        position.Offset = static_cast<DWORD>(offset);
+        position.OffsetHigh = static_cast<DWORD>(offset >> 32);
+        DWORD done = 0;
+        if (!WriteFile(_handle, in, static_cast<DWORD>(chunk), &done, &position) || done == 0) {
+            throw std::runtime_error("Matrix file write failed");
+        }
+#else
+        const ssize_t done = ::pwrite(_descriptor, in, chunk, static_cast<off_t>(offset));
+        if (done <= 0) { throw std::runtime_error("Matrix file write failed"); }
+#endif
+        in += done;
+        offset += static_cast<std::uint64_t>(done);
+        bytes -= static_cast<std::size_t>(done);
+    }
+}
+
+inline void LinAlg::Detail::check_tile_size(std::size_t tileSize)
+{
+    if (tileSize == 0 || tileSize > std::numeric_limits<std::uint32_t>::max()) { throw std::invalid_argument("invalid Matrix tile size"); }
+}
+
+template <typename T>
+inline LinAlg::TiledMatrix<T>::TiledMatrix(Detail::MatrixFile&& file, std::size_t rows, std::size_t cols,
+                                           std::size_t tileSize, std::uint64_t dataOffset)
+    : _file(std::move(file)), _rows(rows), _cols(cols), _tileSize(tileSize), _dataOffset(dataOffset)
+{
+}
+
+template <typename T>
+inline LinAlg::TiledMatrix<T> LinAlg::TiledMatrix<T>::create(const std::string& path, std::size_t rows, std::size_t cols, std::size_t tileSize)
+{
+    Detail::check_tile_size(tileSize);
+    const MatrixFileHeader header = Detail::native_matrix_header<T>(rows, cols, static_cast<std::uint32_t>(tileSize), static_cast<std::uint32_t>(tileSize));
+
+    TiledMatrix matrix(Detail::MatrixFile(path, true, true), rows, cols, tileSize, header.dataOffset);
+    unsigned char bytes[Detail::matrix_file_header_size];
+    Detail::encode_matrix_header(header, bytes);
+    matrix._file.write(0, bytes, sizeof(bytes));
+    matrix._file.resize(matrix.tile_offset(matrix.tile_rows(), 0));
+    return matrix;
+}
+
+template <typename T>
+template <typename A>
+inline LinAlg::TiledMatrix<T> LinAlg::TiledMatrix<T>::create(const std::string& path, const Matrix<T, A>& matrix, std::size_t tileSize)
+{
+    TiledMatrix tiled = create(path, matrix.rows(), matrix.cols(), tileSize);
+    tile_type tile(tiled.tile_elements());
+    for (std::size_t tileRow = 0; tileRow < tiled.tile_rows(); ++tileRow) {
+        for (std::size_t tileCol = 0; tileCol < tiled.tile_cols(); ++tileCol) {
+            std::fill(tile.begin(), tile.end(), T());
+            const T* source = matrix.data() + tileRow * tileSize * matrix.cols() + tileCol * tileSize;
+            for (std::size_t i = 0; i < tiled.tile_height(tileRow); ++i) {
+                std::copy(source + i * matrix.cols(), source + i * matrix.cols() + tiled.tile_width(tileCol), tile.data() + i * tileSize);
+            }
+            tiled.write_tile(tileRow, tileCol, tile.data());
+        }
+    }
+    return tiled;
+}
+
+template <typename T>
+inline LinAlg::TiledMatrix<T> LinAlg::TiledMatrix<T>::open(const std::string& path, bool writable)
+{
+    Detail::MatrixFile file(path, false, writable);
+    const std::uint64_t fileSize = file.size();
+    unsigned char bytes[Detail::matrix_file_header_size];
+    if (fileSize < sizeof(bytes)) { throw std::runtime_error("invalid Matrix file format"); }
+    file.read(0, bytes, sizeof(bytes));
+
+    const MatrixFileHeader header = Detail::parse_matrix_header(bytes, sizeof(bytes));
+    Detail::check_matrix_file_type<T>(header);
+    if (header.littleEndian != Detail::native_little_endian()) { throw std::runtime_error("incompatible Matrix file byte order"); }
+    if (header.tileRows == 0 || header.tileRows != header.tileCols) { throw std::runtime_error("unsupported Matrix file layout"); }
+
+    TiledMatrix matrix(std::move(file), static_cast<std::size_t>(header.rows), static_cast<std::size_t>(header.cols),
+                       header.tileRows, header.dataOffset);
+    const std::uint64_t tiles = static_cast<std::uint64_t>(matrix.tile_rows()) * matrix.tile_cols();
+    if (header.dataOffset > fileSize) { throw std::runtime_error("invalid Matrix file format"); }
+    if (tiles != 0 && (fileSize - header.dataOffset) / tiles / sizeof(T) < matrix.tile_elements()) {
+        throw std::runtime_error("invalid Matrix file format");
+    }
+    return matrix;
+}
+
+template <typename T>
+inline std::uint64_t LinAlg::TiledMatrix<T>::tile_offset(std::size_t tileRow, std::size_t tileCol) const
+{
+    const std::uint64_t tile = static_cast<std::uint64_t>(tileRow) * tile_cols() + tileCol;
+    return _dataOffset + tile * tile_elements() * sizeof(T);
+}
+
+template <typename T>
+inline void LinAlg::TiledMatrix<T>::check_tile(std::size_t tileRow, std::size_t tileCol) const
+{
+    if (tileRow >= tile_rows()) { throw std::out_of_range("invalid Matrix row subscript"); }
+    if (tileCol >= tile_cols()) { throw std::out_of_range("invalid Matrix column subscript"); }
+}
+
+template <typename T>
+inline void LinAlg::TiledMatrix<T>::read_tile(std::size_t tileRow, std::size_t tileCol, T* tile) const
+{
+    check_tile(tileRow, tileCol);
+    _file.read(tile_offset(tileRow, tileCol), tile, tile_elements() * sizeof(T));
+}
+
+template <typename T>
+inline void LinAlg::TiledMatrix<T>::write_tile(std::size_t tileRow, std::size_t tileCol, const T* tile)
+{
+    check_tile(tileRow, tileCol);
+    _file.write(tile_offset(tileRow, tileCol), tile, tile_elements() * sizeof(T));
+}
+
+template <typename T>
+inline LinAlg::Matrix<T> LinAlg::TiledMatrix<T>::tile(std::size_t tileRow, std::size_t tileCol) const
+{
+    tile_type buffer(tile_elements());
+    read_tile(tileRow, tileCol, buffer.data());
+
+    Matrix<T> result(tile_height(tileRow), tile_width(tileCol), uninitialized);
+    for (std::size_t i = 0; i < result.rows(); ++i) {
+        std::copy(buffer.data() + i * _tileSize, buffer.data() + i * _tileSize + result.cols(), result.data() + i * result.cols());
+    }
+    return result;
+}
+
+template <typename T>
+template <typename A>
+inline void LinAlg::TiledMatrix<T>::set_tile(std::size_t tileRow, std::size_t tileCol, const Matrix<T, A>& tile)
+{
+    check_tile(tileRow, tileCol);
+    if (tile.rows() != tile_height(tileRow) || tile.cols() != tile_width(tileCol)) { throw std::invalid_argument("invalid Matrix argument size"); }
+
+    // The padding of edge tiles takes part in multiply() and must stay zero.
+    tile_type buffer(tile_elements(), T());
+    for (std::size_t i = 0; i < tile.rows(); ++i) {
+        std::copy(tile.data() + i * tile.cols(), tile.data() + (i + 1) * tile.cols(), buffer.data() + i * _tileSize);
+    }
+    write_tile(tileRow, tileCol, buffer.data());
+}
+
+template <typename T>
+inline LinAlg::Matrix<T> LinAlg::TiledMatrix<T>::to_matrix() const
+{
+    if (_rows == 0 || _cols == 0) { return Matrix<T>(); }
+
+    Matrix<T> result(_rows, _cols, uninitialized);
+    tile_type buffer(tile_elements());
+    for (std::size_t tileRow = 0; tileRow < tile_rows(); ++tileRow) {
+        for (std::size_t tileCol = 0; tileCol < tile_cols(); ++tileCol) {
+            read_tile(tileRow, tileCol, buffer.data());
+            T* target = result.data() + tileRow * _tileSize * _cols + tileCol * _tileSize;
+            for (std::size_t i = 0; i < tile_height(tileRow); ++i) {
+                std::copy(buffer.data() + i * _tileSize, buffer.data() + i * _tileSize + tile_width(tileCol), target + i * _cols);
+            }
+        }
+    }
+    return result;
+}
+
+template <typename T>
+inline LinAlg::TiledMatrix<T> LinAlg::multiply(const TiledMatrix<T>& a, const TiledMatrix<T>& b, const std::string& path)
+{
+    if (a.cols() != b.rows()) { throw std::invalid_argument("invalid Matrix argument size"); }
+    if (a.tile_size() != b.tile_size()) { throw std::invalid_argument("invalid Matrix tile size"); }
+
+    const std::size_t n = a.tile_size();
+    const std::size_t tileRows = a.tile_rows(), tileCols = b.tile_cols(), inner = a.tile_cols();
+    TiledMatrix<T> result = TiledMatrix<T>::create(path, a.rows(), b.cols(), n);
+    if (tileRows == 0 || tileCols == 0 || inner == 0) { return result; }
+
+    LINALG_INSTRUMENT_OPERATION(Operation::gemm, 2 * a.rows() * b.cols() * a.cols(), (a.rows() * a.cols() + b.rows() * b.cols() + a.rows() * b.cols()) * sizeof(T));
+
+    // Step s multiplies A(i, k) by B(k, j) for s = (i * tileCols + j) * inner + k.
+    typename TiledMatrix<T>::tile_type aTiles[2], bTiles[2], cTiles[2];
+    for (std::size_t slot = 0; slot < 2; ++slot) {
+        aTiles[slot].resize(n * n);
+        bTiles[slot].resize(n * n);
+        cTiles[slot].resize(n * n);
+    }
+    auto load = [&](std::size_t step, std::size_t slot) {
+        const std::size_t k = step % inner, j = step / inner % tileCols, i = step / inner / tileCols;
+        a.read_tile(i, k, aTiles[slot].data());
+        b.read_tile(k, j, bTiles[slot].data());
+    };
+
+    const std::size_t steps = tileRows * tileCols * inner;
+    const std::size_t rowGrain = 8 * Kernels::GemmBlocking<T>::MR;
+    std::future<void> loaded = std::async(std::launch::async, load, 0, 0);
+    std::future<void> stored;
+    std::size_t cSlot = 0;
+    for (std::size_t step = 0; step < steps; ++step) {
+        const std::size_t slot = step % 2, k = step % inner;
+        loaded.get();
+        if (step + 1 < steps) { loaded = std::async(std::launch::async, load, step + 1, 1 - slot); }
+
+        const T* aTile = aTiles[slot].data();
+        const T* bTile = bTiles[slot].data();
+        T* cTile = cTiles[cSlot].data();
+        const T beta = k == 0 ? T() : T(1);
+        parallel_for(n * n * n, 0, n, rowGrain, [=](std::size_t first, std::size_t last) {
+            Kernels::gemm<T>(last - first, n, n, T(1), aTile + first * n, static_cast<std::ptrdiff_t>(n), 1,
+                             bTile, static_cast<std::ptrdiff_t>(n), 1, beta, cTile + first * n, static_cast<std::ptrdiff_t>(n));
+        });
+
+        if (k + 1 == inner) {
+            if (stored.valid()) { stored.get(); }
+            const std::size_t j = step / inner % tileCols, i = step / inner / tileCols;
+            stored = std::async(std::launch::async, [&result, cTile, i, j]() { result.write_tile(i, j, cTile); });
+            cSlot = 1 - cSlot;
+        }
+    }
+    stored.get();
+    return result;
+}
+
+template <typename T>
+inline LinAlg::TiledMatrix<T> LinAlg::transpose(const TiledMatrix<T>& a, const std::string& path)
+{
+    const std::size_t n = a.tile_size();
+    const std::size_t tileRows = a.tile_rows(), tileCols = a.tile_cols();
+    TiledMatrix<T> result = TiledMatrix<T>::create(path, a.cols(), a.rows(), n);
+    if (tileRows == 0 || tileCols == 0) { return result; }
+
+    LINALG_INSTRUMENT_OPERATION(Operation::transpose, 0, 2 * a.rows() * a.cols() * sizeof(T));
+
+    typename TiledMatrix<T>::tile_type sourceTiles[2], targetTiles[2];
+    for (std::size_t slot = 0; slot < 2; ++slot) {
+        sourceTiles[slot].resize(n * n);
+        targetTiles[slot].resize(n * n);
+    }
+    auto load = [&](std::size_t step, std::size_t slot) { a.read_tile(step / tileCols, step % tileCols, sourceTiles[slot].data()); };
+
+    const std::size_t steps = tileRows * tileCols;
+    std::future<void> loaded = std::async(std::launch::async, load, 0, 0);
+    std::future<void> stored;
+    for (std::size_t step = 0; step < steps; ++step) {
+        const std::size_t slot = step % 2;
+        loaded.get();
+        if (step + 1 < steps) { loaded = std::async(std::launch::async, load, step + 1, 1 - slot); }
+
+        // The write of this slot was waited for before the previous step's write started.
+        T* target = targetTiles[slot].data();
+        Kernels::copy_strided(n, n, sourceTiles[slot].data(), 1, static_cast<std::ptrdiff_t>(n), target, static_cast<std::ptrdiff_t>(n));
+
+        if (stored.valid()) { stored.get(); }
+        const std::size_t i = step / tileCols, j = step % tileCols;
+        stored = std::async(std::launch::async, [&result, target, i, j]() { result.write_tile(j, i, target); });
+    }
+    stored.get();
+    return result;
+}
+
+#endif // TILED_MATRIX_HPP
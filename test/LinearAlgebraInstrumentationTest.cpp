@@ -0,0 +1,73 @@
+#define LINALG_INSTRUMENTATION
+
+#include <gtest/gtest.h>
+#include <LinearAlgebra.hpp>
+
+TEST(LinearAlgebraInstrumentationTest, LibraryOperations)
+{
+    // COMPILED IN TEST
+    EXPECT_TRUE(LinAlg::instrumentation_enabled());
+
+    // GEMM COUNTERS TEST
+    LinAlg::Matrix<double> leftMatrix(6, 4, 1.0);
+    LinAlg::Matrix<double> rightMatrix(4, 5, 2.0);
+    LinAlg::reset_instrumentation();
+    LinAlg::Matrix<double> productMatrix = leftMatrix * rightMatrix;
+    LinAlg::InstrumentationSnapshot snapshot1 = LinAlg::instrumentation_snapshot();
+    EXPECT_EQ(productMatrix(5, 4), 8.0);
+    EXPECT_GE(snapshot1[LinAlg::Operation::gemm].calls, 1u);
+    EXPECT_GE(snapshot1[LinAlg::Operation::gemm].flops, 2u * 6u * 5u * 4u);
+    EXPECT_GE(snapshot1[LinAlg::Operation::gemm].bytes, (6u * 4u + 4u * 5u + 6u * 5u) * sizeof(double));
+
+    // STORAGE ALLOCATION COUNTERS TEST
+    LinAlg::reset_instrumentation();
+    LinAlg::Matrix<double> allocatedMatrix(16, 16);
+    LinAlg::InstrumentationSnapshot snapshot2 = LinAlg::instrumentation_snapshot();
+    EXPECT_GE(snapshot2.allocations, 1u);
+    EXPECT_GE(snapshot2.allocated_bytes, allocatedMatrix.vector_size() * sizeof(double));
+    EXPECT_EQ(snapshot2[LinAlg::Operation::gemm].calls, 0u);
+
+    // TRANSPOSE AND INVERSE COUNTERS TEST
+    LinAlg::Matrix<double> squareMatrix = { { 4.0, 1.0, 0.0 }, { 1.0, 3.0, 1.0 }, { 0.0, 1.0, 2.0 } };
+    LinAlg::reset_instrumentation();
+    leftMatrix.transpose();
+    LinAlg::Matrix<double> inverseMatrix = squareMatrix.inverse();
+    LinAlg::InstrumentationSnapshot snapshot3 = LinAlg::instrumentation_snapshot();
+    EXPECT_EQ(snapshot3[LinAlg::Operation::transpose].calls, 1u);
+    EXPECT_EQ(snapshot3[LinAlg::Operation::inverse].calls, 1u);
+    EXPECT_GE(snapshot3[LinAlg::Operation::inverse].allocations, 1u);
+    EXPECT_LE(snapshot3[LinAlg::Operation::inverse].allocations, snapshot3.allocations);
+    EXPECT_NEAR((inverseMatrix * squareMatrix)(1, 1), 1.0, 1e-12);
+
+    // INVERSE MATRIX METHOD SINGLE COPY TEST
+    LinAlg::Matrix<double> systemMatrix(8, 8, 1.0);
+    for (std::size_t i = 0; i < systemMatrix.rows(); ++i) { systemMatrix(i, i) = 9.0; }
+    LinAlg::reset_instrumentation();
+    LinAlg::InverseMatrixMethod<double> method(systemMatrix);
+    EXPECT_EQ(LinAlg::instrumentation_snapshot().allocations, 1u);
+    EXPECT_EQ(LinAlg::instrumentation_snapshot()[LinAlg::Operation::inverse].calls, 1u);
+    EXPECT_NEAR((method.inverse() * systemMatrix)(7, 7), 1.0, 1e-12);
+
+    // FIXED MATRIX INTEGRAL INVERSE ON THE STACK TEST
+    LinAlg::FixedMatrix<int, 6, 6> fixedMatrix = LinAlg::FixedMatrix<int, 6, 6>::identity();
+    for (std::size_t i = 0; i + 1 < 6; ++i) { fixedMatrix(i, i + 1) = 2; }
+    LinAlg::reset_instrumentation();
+    LinAlg::FixedMatrix<int, 6, 6> fixedInverse = fixedMatrix.inverse();
+    EXPECT_EQ(LinAlg::instrumentation_snapshot().allocations, 0u);
+    EXPECT_TRUE(fixedMatrix * fixedInverse == (LinAlg::FixedMatrix<int, 6, 6>::identity()));
+
+    // RECTANGULAR TRANSPOSE BUFFER REUSE TEST
+    LinAlg::Matrix<double> rectangularMatrix(37, 129, 1.5);
+    rectangularMatrix(3, 100) = -2.0;
+    rectangularMatrix.transpose();
+    LinAlg::reset_instrumentation();
+    for (std::size_t i = 0; i < 4; ++i) { rectangularMatrix.transpose(); }
+    EXPECT_EQ(LinAlg::instrumentation_snapshot()[LinAlg::Operation::transpose].calls, 4u);
+    EXPECT_EQ(LinAlg::instrumentation_snapshot().allocations, 0u);
+    EXPECT_EQ(rectangularMatrix(100, 3), -2.0);
+}
+
+int main(int argc, char** argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
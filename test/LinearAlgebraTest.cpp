@@ -1,6 +1,40 @@
 #include <gtest/gtest.h>
 #include <LinearAlgebra.hpp>
 
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+namespace
+{
+    // Pseudo-random value in [-10, 10] with one decimal, advancing seed.
+    double random_value(unsigned int& seed)
+    {
+        seed = seed * 1103515245u + 12345u;
+        return ((seed >> 16) % 201) / 10.0 - 10.0;
+    }
+
+    // rows x cols matrix of random_value entries, diagonal added to its diagonal.
+    LinAlg::Matrix<double> random_matrix(unsigned int& seed, std::size_t rows, std::size_t cols, double diagonal = 0.0)
+    {
+        LinAlg::Matrix<double> matrix(rows, cols, LinAlg::uninitialized);
+        for (std::size_t i = 0; i < matrix.vector_size(); ++i) { matrix.data()[i] = random_value(seed); }
+        for (std::size_t i = 0; i < std::min(rows, cols); ++i) { matrix(i, i) += diagonal; }
+        return matrix;
+    }
+
+    // Element-wise comparison within tolerance, relative for entries above one.
+    void expect_near(const LinAlg::Matrix<double>& actual, const LinAlg::Matrix<double>& expected, double tolerance = 1e-9)
+    {
+        ASSERT_EQ(actual.rows(), expected.rows());
+        ASSERT_EQ(actual.cols(), expected.cols());
+        for (std::size_t i = 0; i < expected.vector_size(); ++i) {
+            EXPECT_NEAR(actual.data()[i], expected.data()[i], tolerance * std::max(1.0, std::fabs(expected.data()[i])));
+        }
+    }
+}
+
 TEST(LinearAlgebraTest, DefaultConstructor)
 {
     // DIFFERENT TYPES MATRIX DEFAULT CONSTRUCTOR TEST
@@ -999,13 +1033,26 @@ TEST(LinearAlgebraTest, MethodInverse)
     LinAlg::Matrix<double> checkInverseMatrix3 = { { -3, -0.5, 1.5, 1 }, { 1, 0.25, -0.25, -0.5 }, { 3, 0.25, -1.25, -0.5 }, { -3, 0, 1, 1 } };
     EXPECT_TRUE(inverseDoubleMatrix == checkInverseMatrix3);
 
+    // IN-PLACE INVERSE TEST
+    shortMatrix.invert_in_place();
+    doubleMatrix.invert_in_place();
+    EXPECT_TRUE(shortMatrix == checkInverseMatrix1);
+    EXPECT_TRUE(doubleMatrix == checkInverseMatrix3);
+    LinAlg::Matrix<double> largeMatrix(6, 6, 1.0);
+    for (std::size_t i = 0; i < largeMatrix.rows(); ++i) { largeMatrix(i, i) = 7.0; }
+    LinAlg::Matrix<double> largeInverse = largeMatrix.inverse();
+    largeMatrix.invert_in_place();
+    EXPECT_TRUE(largeMatrix == largeInverse);
+
     // NOT SQUARE MATRIX TEST
     LinAlg::Matrix<int> intMatrix = { { 51, 100, 42 }, { 739, 0, 68 } };
     ASSERT_THROW(intMatrix.inverse(), std::invalid_argument);
+    ASSERT_THROW(intMatrix.invert_in_place(), std::invalid_argument);
 
     // NULL DETERMINANT TEST
     LinAlg::Matrix<long> longMatrix = { { 5, 7, 8 }, { 9, 11, 12 }, { 13, 15, 16 } };
     ASSERT_THROW(longMatrix.inverse(), std::runtime_error);
+    ASSERT_THROW(longMatrix.invert_in_place(), std::runtime_error);
 }
 
 TEST(LinearAlgebraTest, OperatorUnaryMinus)
@@ -1084,6 +1131,36 @@ TEST(LinearAlgebraTest, OperatorMultiplicationMatrix)
     ASSERT_THROW(longMatrix1 * longMatrix2, std::invalid_argument);
 }
 
+TEST(LinearAlgebraTest, OperatorMultiplicationMatrixBlocked)
+{
+    // MATRICES LARGER THAN ONE CACHE BLOCK WITH ODD EDGES TEST
+    std::size_t m = 143, k = 301, n = 77;
+    std::vector<long> lhsVector(m * k), rhsVector(k * n);
+    for (std::size_t i = 0; i < lhsVector.size(); ++i) { lhsVector[i] = static_cast<long>(i % 17) - 8; }
+    for (std::size_t i = 0; i < rhsVector.size(); ++i) { rhsVector[i] = static_cast<long>(i % 13) - 6; }
+    LinAlg::Matrix<long> longMatrix1(m, k, lhsVector);
+    LinAlg::Matrix<long> longMatrix2(k, n, rhsVector);
+    LinAlg::Matrix<long> longMatrix3 = longMatrix1 * longMatrix2;
+    EXPECT_EQ(longMatrix3.rows(), m);
+    EXPECT_EQ(longMatrix3.cols(), n);
+
+    bool equalToNaive = true;
+    for (std::size_t i = 0; i < m; ++i) {
+        for (std::size_t j = 0; j < n; ++j) {
+            long expected = 0;
+            for (std::size_t p = 0; p < k; ++p) { expected += longMatrix1(i, p) * longMatrix2(p, j); }
+            if (longMatrix3(i, j) != expected) { equalToNaive = false; }
+        }
+    }
+    EXPECT_TRUE(equalToNaive);
+
+    // ROW VECTOR BY COLUMN VECTOR TEST
+    LinAlg::Matrix<double> doubleMatrix1(1, 600, 0.5);
+    LinAlg::Matrix<double> doubleMatrix2(600, 1, 2.0);
+    LinAlg::Matrix<double> doubleMatrix3 = doubleMatrix1 * doubleMatrix2;
+    EXPECT_DOUBLE_EQ(doubleMatrix3(0, 0), 600.0);
+}
+
 TEST(LinearAlgebraTest, OperatorDivisionMatrix)
 {
     // DIFFERENT MATRICES TEST
@@ -1463,6 +1540,2029 @@ TEST(LinearAlgebraTest, MethodAddCol)
     ASSERT_THROW(floatMatrix.add_col(-1, 2, 9), std::out_of_range);
 }
 
+TEST(LinearAlgebraTest, ElementwiseKernels)
+{
+    // VECTORIZED BODY AND SCALAR TAIL TEST
+    std::vector<double> doubleVector1(3 * 37), doubleVector2(3 * 37);
+    for (std::size_t i = 0; i < doubleVector1.size(); ++i) {
+        doubleVector1[i] = 0.5 * static_cast<double>(i);
+        doubleVector2[i] = 2.0 - static_cast<double>(i);
+    }
+    LinAlg::Matrix<double> doubleMatrix1(3, 37, doubleVector1);
+    LinAlg::Matrix<double> doubleMatrix2(3, 37, doubleVector2);
+    LinAlg::Matrix<double> sumMatrix = doubleMatrix1 + doubleMatrix2;
+    LinAlg::Matrix<double> differenceMatrix = doubleMatrix1 - doubleMatrix2;
+    LinAlg::Matrix<double> scaledMatrix = doubleMatrix1 * 4.0;
+    bool elementsMatch = true;
+    for (std::size_t i = 0; i < doubleVector1.size(); ++i) {
+        std::size_t row = i / 37, col = i % 37;
+        if (sumMatrix(row, col) != doubleVector1[i] + doubleVector2[i]) { elementsMatch = false; }
+        if (differenceMatrix(row, col) != doubleVector1[i] - doubleVector2[i]) { elementsMatch = false; }
+        if (scaledMatrix(row, col) != doubleVector1[i] * 4.0) { elementsMatch = false; }
+    }
+    EXPECT_TRUE(elementsMatch);
+
+    LinAlg::Matrix<float> floatMatrix(2, 35, 1.5f);
+    floatMatrix.set_row(1, 2.0f);
+    floatMatrix.add_row(0, 1, -0.25f);
+    std::vector<float> floatRow = floatMatrix.get_row(0);
+    EXPECT_TRUE(std::all_of(floatRow.begin(), floatRow.end(), [](float value) { return value == 1.0f; }));
+    floatMatrix /= 2.0f;
+    EXPECT_FLOAT_EQ(floatMatrix(0, 34), 0.5f);
+    EXPECT_FLOAT_EQ(floatMatrix(1, 17), 1.0f);
+
+    // COMPARISON MISMATCH IN VECTORIZED BODY AND IN SCALAR TAIL TEST
+    LinAlg::Matrix<float> floatMatrix1(1, 35, 3.0f);
+    LinAlg::Matrix<float> floatMatrix2(floatMatrix1);
+    EXPECT_TRUE(floatMatrix1 == floatMatrix2);
+    floatMatrix2(0, 34) = 3.001f;
+    EXPECT_FALSE(floatMatrix1 == floatMatrix2);
+    floatMatrix2(0, 34) = 3.0f;
+    floatMatrix2(0, 2) = -3.0f;
+    EXPECT_FALSE(floatMatrix1 == floatMatrix2);
+}
+
+TEST(LinearAlgebraTest, ParallelExecutionPolicy)
+{
+    // EVERY INDEX OF THE RANGE IS VISITED EXACTLY ONCE TEST
+    std::shared_ptr<LinAlg::ThreadPool> threadPool = std::make_shared<LinAlg::ThreadPool>(4);
+    EXPECT_EQ(threadPool->concurrency(), 4);
+    std::vector<int> visits(1000);
+    threadPool->parallel_for(0, visits.size(), 7, [&visits](std::size_t first, std::size_t last) {
+        for (std::size_t i = first; i < last; ++i) { ++visits[i]; }
+    });
+    EXPECT_TRUE(std::all_of(visits.begin(), visits.end(), [](int count) { return count == 1; }));
+
+    // EXCEPTION PROPAGATION TEST
+    ASSERT_THROW(threadPool->parallel_for(0, 100, 1, [](std::size_t first, std::size_t) {
+        if (first == 42) { throw std::runtime_error("parallel failure"); }
+    }), std::runtime_error);
+
+    // PARALLEL RESULTS EQUAL SEQUENTIAL RESULTS TEST
+    std::vector<long> valueVector(97 * 83);
+    for (std::size_t i = 0; i < valueVector.size(); ++i) { valueVector[i] = static_cast<long>(i % 23) - 11; }
+    LinAlg::Matrix<long> longMatrix1(97, 83, valueVector);
+    LinAlg::Matrix<long> longMatrix2(longMatrix1);
+    longMatrix2.transpose();
+    LinAlg::Matrix<long> productMatrix = longMatrix1 * longMatrix2;
+    LinAlg::Matrix<long> sumMatrix = longMatrix1 + longMatrix1;
+    LinAlg::Matrix<int> intMatrix = { { 2, -4, 1, 12 }, { 11, 10, 6, 0 }, { -6, 21, 7, -1 }, { 7, 1, -8, 19 } };
+    LinAlg::Matrix<int> adjointMatrix = intMatrix.adjoint();
+
+    std::size_t threshold = LinAlg::parallel_threshold();
+    LinAlg::set_parallel_threshold(0);
+    {
+        LinAlg::ScopedExecutionPolicy scopedPolicy(threadPool);
+        EXPECT_EQ(LinAlg::execution_policy(), threadPool);
+
+        LinAlg::Matrix<long> longMatrix3(longMatrix1);
+        longMatrix3.transpose();
+        EXPECT_TRUE(longMatrix3 == longMatrix2);
+        EXPECT_TRUE(longMatrix1 * longMatrix3 == productMatrix);
+        EXPECT_TRUE(longMatrix1 + longMatrix1 == sumMatrix);
+        EXPECT_TRUE(intMatrix.adjoint() == adjointMatrix);
+    }
+    LinAlg::set_parallel_threshold(threshold);
+    EXPECT_NE(LinAlg::execution_policy(), threadPool);
+
+    // SCOPED POLICY ACTIVE ON POOL WORKERS TEST
+    std::shared_ptr<LinAlg::ThreadPool> otherPool = std::make_shared<LinAlg::ThreadPool>(2);
+    std::atomic<int> scopedChunks(0), otherScopedTasks(0);
+    {
+        LinAlg::ScopedExecutionPolicy scopedPolicy(threadPool);
+        threadPool->parallel_for(0, 64, 1, [&scopedChunks, &threadPool](std::size_t, std::size_t) {
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            if (LinAlg::execution_policy() == threadPool) { ++scopedChunks; }
+        });
+        otherPool->submit([&otherScopedTasks, &threadPool]() {
+            if (LinAlg::execution_policy() == threadPool) { ++otherScopedTasks; }
+        });
+    }
+    otherPool.reset();
+    EXPECT_EQ(scopedChunks.load(), 64);
+    EXPECT_EQ(otherScopedTasks.load(), 1);
+}
+
+TEST(LinearAlgebraTest, ExpressionTemplates)
+{
+    // LAZY EVALUATION OF CHAINED ELEMENT-WISE EXPRESSIONS TEST
+    const LinAlg::Matrix<int> intMatrix1 = { { 1, 2, 3 }, { 4, 5, 6 } };
+    const LinAlg::Matrix<int> intMatrix2 = { { 6, 5, 4 }, { 3, 2, 1 } };
+    const LinAlg::Matrix<int> intMatrix3 = { { 1, 0, -1 }, { 2, 0, -2 } };
+    auto expression = intMatrix1 + intMatrix2 - intMatrix3 * 2;
+    EXPECT_FALSE((std::is_same<decltype(expression), LinAlg::Matrix<int> >::value));
+    EXPECT_EQ(expression.rows(), 2);
+    EXPECT_EQ(expression.cols(), 3);
+    LinAlg::Matrix<int> intMatrix4 = expression;
+    LinAlg::Matrix<int> checkMatrix1 = { { 5, 7, 9 }, { 3, 7, 11 } };
+    EXPECT_TRUE(intMatrix4 == checkMatrix1);
+    EXPECT_TRUE(intMatrix1 + intMatrix2 - intMatrix3 * 2 == checkMatrix1);
+
+    // IN-PLACE EVALUATION WHEN THE TARGET IS AN OPERAND TEST
+    LinAlg::Matrix<int> intMatrix5(intMatrix1);
+    intMatrix5 = intMatrix2 - intMatrix5;
+    LinAlg::Matrix<int> checkMatrix2 = { { 5, 3, 1 }, { -1, -3, -5 } };
+    EXPECT_TRUE(intMatrix5 == checkMatrix2);
+    intMatrix5 += -intMatrix3 * 3;
+    LinAlg::Matrix<int> checkMatrix3 = { { 2, 3, 4 }, { -7, -3, 1 } };
+    EXPECT_TRUE(intMatrix5 == checkMatrix3);
+    intMatrix5 -= intMatrix5;
+    EXPECT_TRUE(intMatrix5.zero());
+
+    // EXPRESSION OPERANDS OF MATRIX MULTIPLICATION TEST
+    LinAlg::Matrix<double> doubleMatrix1 = { { 1.5, -2.0 }, { 0.5, 4.0 } };
+    LinAlg::Matrix<double> doubleMatrix2 = { { 2.0, 1.0 }, { -1.0, 3.0 } };
+    LinAlg::Matrix<double> doubleMatrix3 = (doubleMatrix1 + doubleMatrix2) * (doubleMatrix2 / 2.0);
+    LinAlg::Matrix<double> checkMatrix4 = { { 4.0, 0.25 }, { -4.0, 10.25 } };
+    EXPECT_TRUE(doubleMatrix3 == checkMatrix4);
+
+    // INVALID MATRIX ARGUMENT SIZE IN A CHAIN TEST
+    LinAlg::Matrix<int> intMatrix6 = { { 1, 2 }, { 3, 4 } };
+    ASSERT_THROW(intMatrix1 + intMatrix2 - intMatrix6, std::invalid_argument);
+    ASSERT_THROW(intMatrix6 += intMatrix1 * 2, std::invalid_argument);
+}
+
+TEST(LinearAlgebraTest, LUDecomposition)
+{
+    // SMALL SYSTEM WITH ROW EXCHANGES TEST
+    LinAlg::Matrix<double> doubleMatrix1 = { { 0.0, 2.0, 1.0 }, { 1.0, 1.0, 1.0 }, { 2.0, 1.0, 3.0 } };
+    LinAlg::LUDecomposition<double> decomposition1(doubleMatrix1);
+    EXPECT_FALSE(decomposition1.singular());
+    EXPECT_EQ(decomposition1.size(), 3);
+    EXPECT_TRUE(LinAlg::areEqual(decomposition1.determinant(), -3.0));
+    std::vector<double> solution1 = decomposition1.solve(std::vector<double>{ 5.0, 5.0, 12.0 });
+    EXPECT_TRUE(LinAlg::areEqual(solution1[0], 1.0));
+    EXPECT_TRUE(LinAlg::areEqual(solution1[1], 1.0));
+    EXPECT_TRUE(LinAlg::areEqual(solution1[2], 3.0));
+
+    LinAlg::Matrix<double> permutedMatrix1(doubleMatrix1);
+    for (std::size_t i = 0; i < permutedMatrix1.rows(); ++i) { permutedMatrix1.swap_row(i, decomposition1.pivots()[i]); }
+    EXPECT_TRUE(decomposition1.lower() * decomposition1.upper() == permutedMatrix1);
+
+    // BLOCKED FACTORIZATION WITH MULTIPLE RIGHT-HAND SIDES TEST
+    const std::size_t size = 150;
+    LinAlg::Matrix<double> doubleMatrix2(size, size);
+    LinAlg::Matrix<double> expectedMatrix(size, 3);
+    unsigned int seed = 12345;
+    for (std::size_t i = 0; i < size; ++i) {
+        for (std::size_t j = 0; j < size; ++j) {
+            seed = seed * 1103515245u + 12345u;
+            doubleMatrix2(i, j) = static_cast<double>((seed >> 16) % 201) / 10.0 - 10.0;
+        }
+        for (std::size_t j = 0; j < 3; ++j) { expectedMatrix(i, j) = static_cast<double>((i + 1) * (j + 1) % 7) - 3.0; }
+    }
+    const LinAlg::Matrix<double> rhsMatrix = doubleMatrix2 * expectedMatrix;
+    LinAlg::LUDecomposition<double> decomposition2(doubleMatrix2);
+    LinAlg::Matrix<double> solutionMatrix = decomposition2.solve(rhsMatrix);
+    std::vector<double> solution2 = decomposition2.solve(rhsMatrix.get_col(1));
+    for (std::size_t i = 0; i < size; ++i) {
+        for (std::size_t j = 0; j < 3; ++j) { EXPECT_NEAR(solutionMatrix(i, j), expectedMatrix(i, j), 1e-8); }
+        EXPECT_NEAR(solution2[i], expectedMatrix(i, 1), 1e-8);
+    }
+
+    LinAlg::Matrix<double> inPlaceMatrix(rhsMatrix);
+    LinAlg::LUDecomposition<double>(std::move(doubleMatrix2)).solve_in_place(inPlaceMatrix);
+    EXPECT_TRUE(inPlaceMatrix == solutionMatrix);
+
+    // SINGULAR AND INVALID MATRIX EXCEPTION THROWING TEST
+    LinAlg::Matrix<double> singularMatrix = { { 1.0, 2.0 }, { 2.0, 4.0 } };
+    LinAlg::LUDecomposition<double> decomposition3(singularMatrix);
+    EXPECT_TRUE(decomposition3.singular());
+    EXPECT_EQ(decomposition3.determinant(), 0.0);
+    ASSERT_THROW(decomposition3.solve(std::vector<double>{ 1.0, 2.0 }), std::runtime_error);
+    ASSERT_THROW(decomposition1.solve(std::vector<double>{ 1.0, 2.0 }), std::invalid_argument);
+    ASSERT_THROW(LinAlg::LUDecomposition<double>(LinAlg::Matrix<double>(2, 3)), std::invalid_argument);
+    ASSERT_THROW(LinAlg::LUDecomposition<int>(LinAlg::Matrix<int>(2, 2)), std::invalid_argument);
+}
+
+TEST(LinearAlgebraTest, GaussianElimination)
+{
+    // SINGLE RIGHT-HAND SIDE WITH ROW EXCHANGES TEST
+    LinAlg::Matrix<double> doubleMatrix1 = { { 0.0, 2.0, 1.0 }, { 1.0, 1.0, 1.0 }, { 2.0, 1.0, 3.0 } };
+    std::vector<double> solution1 = LinAlg::solve_gauss(doubleMatrix1, std::vector<double>{ 5.0, 5.0, 12.0 });
+    EXPECT_TRUE(LinAlg::areEqual(solution1[0], 1.0));
+    EXPECT_TRUE(LinAlg::areEqual(solution1[1], 1.0));
+    EXPECT_TRUE(LinAlg::areEqual(solution1[2], 3.0));
+
+    // MULTIPLE RIGHT-HAND SIDES TEST
+    LinAlg::Matrix<float> floatMatrix1 = { { 2.0f, 1.0f }, { 4.0f, -1.0f } };
+    LinAlg::Matrix<float> rhsMatrix1 = { { 3.0f, 1.0f, 0.0f }, { 3.0f, 5.0f, 6.0f } };
+    LinAlg::Matrix<float> solutionMatrix1 = LinAlg::solve_gauss(floatMatrix1, rhsMatrix1);
+    LinAlg::Matrix<float> checkMatrix1 = { { 1.0f, 1.0f, 1.0f }, { 1.0f, -1.0f, -2.0f } };
+    EXPECT_TRUE(solutionMatrix1 == checkMatrix1);
+
+    // IN-PLACE MODE TEST
+    const std::size_t size = 60;
+    LinAlg::Matrix<double> doubleMatrix2(size, size);
+    LinAlg::Matrix<double> expectedMatrix(size, 2);
+    unsigned int seed = 777;
+    for (std::size_t i = 0; i < size; ++i) {
+        for (std::size_t j = 0; j < size; ++j) {
+            seed = seed * 1103515245u + 12345u;
+            doubleMatrix2(i, j) = static_cast<double>((seed >> 16) % 201) / 10.0 - 10.0;
+        }
+        expectedMatrix(i, 0) = static_cast<double>(i % 5) - 2.0;
+        expectedMatrix(i, 1) = static_cast<double>(i) / 4.0;
+    }
+    LinAlg::Matrix<double> rhsMatrix2 = doubleMatrix2 * expectedMatrix;
+    std::vector<double> rhsVector2 = rhsMatrix2.get_col(0);
+    LinAlg::Matrix<double> workMatrix(doubleMatrix2);
+    LinAlg::solve_gauss_in_place(workMatrix, rhsVector2);
+    LinAlg::solve_gauss_in_place(doubleMatrix2, rhsMatrix2);
+    for (std::size_t i = 0; i < size; ++i) {
+        EXPECT_NEAR(rhsVector2[i], expectedMatrix(i, 0), 1e-9);
+        EXPECT_NEAR(rhsMatrix2(i, 0), expectedMatrix(i, 0), 1e-9);
+        EXPECT_NEAR(rhsMatrix2(i, 1), expectedMatrix(i, 1), 1e-9);
+        for (std::size_t j = 0; j < i; ++j) { EXPECT_EQ(doubleMatrix2(i, j), 0.0); }
+    }
+
+    // SINGULAR AND INVALID SYSTEM EXCEPTION THROWING TEST
+    LinAlg::Matrix<double> singularMatrix = { { 1.0, 2.0 }, { 2.0, 4.0 } };
+    ASSERT_THROW(LinAlg::solve_gauss(singularMatrix, std::vector<double>{ 1.0, 2.0 }), std::runtime_error);
+    ASSERT_THROW(LinAlg::solve_gauss(doubleMatrix1, std::vector<double>{ 1.0, 2.0 }), std::invalid_argument);
+    ASSERT_THROW(LinAlg::solve_gauss(LinAlg::Matrix<double>(2, 3), std::vector<double>{ 1.0, 2.0 }), std::invalid_argument);
+    ASSERT_THROW(LinAlg::solve_gauss(LinAlg::Matrix<int>(2, 2), std::vector<int>{ 1, 2 }), std::invalid_argument);
+}
+
+TEST(LinearAlgebraTest, DeterminantElimination)
+{
+    // FRACTION-FREE INTEGRAL DETERMINANT WITH A ZERO LEADING PIVOT TEST
+    LinAlg::Matrix<int> intMatrix = { { 0, 3, -1, 2, 5 }, { 4, 1, 0, -2, 3 }, { 2, -5, 6, 1, 0 }, { -3, 2, 1, 4, -1 }, { 1, 0, 2, -3, 7 } };
+    EXPECT_EQ(intMatrix.determinant(), 1999);
+
+    LinAlg::Matrix<long> longMatrix(12, 12);
+    unsigned int seed = 42;
+    for (std::size_t i = 0; i < longMatrix.rows(); ++i) {
+        for (std::size_t j = 0; j < longMatrix.cols(); ++j) {
+            seed = seed * 1103515245u + 12345u;
+            longMatrix(i, j) = static_cast<long>((seed >> 16) % 19) - 9;
+        }
+    }
+    EXPECT_EQ(longMatrix.determinant(), 536701917297L);
+
+    LinAlg::Matrix<short> singularShortMatrix(6, 6, 3);
+    EXPECT_EQ(singularShortMatrix.determinant(), 0);
+
+    // BAREISS STEP RANGE TEST
+    typedef LinAlg::Kernels::bareiss_integer Wide;
+    const Wide large = static_cast<Wide>(3037000500LL);
+    EXPECT_EQ(LinAlg::Kernels::bareiss_step(7, -6, 4, 3, 2), -27);
+    EXPECT_EQ(LinAlg::Kernels::bareiss_step(large - 1, large - 1, -1, 1, 1), (large - 1) * (large - 1) + 1);
+    if (sizeof(Wide) > sizeof(long long)) {
+        EXPECT_EQ(LinAlg::Kernels::bareiss_step(large, large, large, large - 1, large), 1);
+    } else {
+        ASSERT_THROW(LinAlg::Kernels::bareiss_step(large, large, large, large - 1, large), std::overflow_error);
+    }
+
+    // FLOATING POINT DETERMINANT THROUGH LU DECOMPOSITION TEST
+    LinAlg::Matrix<double> doubleMatrix(200, 200);
+    for (std::size_t i = 0; i < doubleMatrix.rows(); ++i) {
+        doubleMatrix(i, i) = 2.0;
+        if (i > 0) { doubleMatrix(i, i - 1) = -1.0; }
+        if (i + 1 < doubleMatrix.rows()) { doubleMatrix(i, i + 1) = -1.0; }
+    }
+    EXPECT_NEAR(doubleMatrix.determinant(), 201.0, 1e-9);
+    doubleMatrix.swap_row(0, 1);
+    EXPECT_NEAR(doubleMatrix.determinant(), -201.0, 1e-9);
+
+    LinAlg::Matrix<float> floatMatrix = { { 2.0f, 0.0f, 0.0f, 0.0f, 0.0f }, { 1.0f, 3.0f, 0.0f, 0.0f, 0.0f }, { 0.0f, 1.0f, 0.5f, 0.0f, 0.0f },
+                                          { 0.0f, 0.0f, 1.0f, 4.0f, 0.0f }, { 1.0f, 0.0f, 0.0f, 1.0f, -1.0f } };
+    EXPECT_FLOAT_EQ(floatMatrix.determinant(), -12.0f);
+}
+
+TEST(LinearAlgebraTest, InverseMatrixMethod)
+{
+    // GAUSS-JORDAN INVERSE OF A LARGER MATRIX TEST
+    const std::size_t size = 40;
+    LinAlg::Matrix<double> doubleMatrix(size, size);
+    unsigned int seed = 2024;
+    for (std::size_t i = 0; i < size; ++i) {
+        for (std::size_t j = 0; j < size; ++j) {
+            seed = seed * 1103515245u + 12345u;
+            doubleMatrix(i, j) = static_cast<double>((seed >> 16) % 201) / 10.0 - 10.0;
+        }
+    }
+    LinAlg::Matrix<double> inverseMatrix = doubleMatrix.inverse();
+    LinAlg::Matrix<double> identityMatrix = doubleMatrix * inverseMatrix;
+    for (std::size_t i = 0; i < size; ++i) {
+        for (std::size_t j = 0; j < size; ++j) { EXPECT_NEAR(identityMatrix(i, j), (i == j) ? 1.0 : 0.0, 1e-10); }
+    }
+
+    LinAlg::Matrix<double> singularMatrix(6, 6, 1.5);
+    ASSERT_THROW(singularMatrix.inverse(), std::runtime_error);
+
+    // CACHED INVERSE SOLVES TEST
+    LinAlg::InverseMatrixMethod<double> method(doubleMatrix);
+    EXPECT_EQ(method.size(), size);
+    std::vector<double> expected(size);
+    for (std::size_t i = 0; i < size; ++i) { expected[i] = static_cast<double>(i % 7) - 3.0; }
+    std::vector<double> b(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        for (std::size_t j = 0; j < size; ++j) { b[i] += doubleMatrix(i, j) * expected[j]; }
+    }
+    std::vector<double> x = method.solve(b);
+    LinAlg::Matrix<double> xMatrix = method.solve(LinAlg::Matrix<double>(size, 1, b));
+    for (std::size_t i = 0; i < size; ++i) {
+        EXPECT_NEAR(x[i], expected[i], 1e-9);
+        EXPECT_NEAR(xMatrix(i, 0), expected[i], 1e-9);
+    }
+
+    LinAlg::Matrix<short> shortMatrix = { { 5, 2 }, { -7, -3 } };
+    std::vector<short> shortSolution = LinAlg::solve_inverse(shortMatrix, std::vector<short>{ 9, -13 });
+    EXPECT_EQ(shortSolution[0], 1);
+    EXPECT_EQ(shortSolution[1], 2);
+
+    // INVALID SYSTEM EXCEPTION THROWING TEST
+    ASSERT_THROW(method.solve(std::vector<double>{ 1.0, 2.0 }), std::invalid_argument);
+    ASSERT_THROW(LinAlg::InverseMatrixMethod<int>(LinAlg::Matrix<int>(2, 3)), std::invalid_argument);
+    ASSERT_THROW(LinAlg::solve_inverse(singularMatrix, std::vector<double>(6, 1.0)), std::runtime_error);
+}
+
+TEST(LinearAlgebraTest, MethodPowSquaring)
+{
+    // BINARY EXPONENTIATION AGAINST REPEATED MULTIPLICATION TEST
+    LinAlg::Matrix<long> longMatrix = { { 1, 1, 0 }, { 1, 0, 1 }, { 0, 1, -1 } };
+    LinAlg::Matrix<long> checkMatrix(longMatrix);
+    for (int i = 1; i < 13; ++i) { checkMatrix = checkMatrix * longMatrix; }
+    longMatrix.pow(13);
+    EXPECT_TRUE(longMatrix == checkMatrix);
+
+    // LARGE POWER OF A TRANSITION MATRIX TEST
+    LinAlg::Matrix<double> transitionMatrix = { { 0.9, 0.1 }, { 0.5, 0.5 } };
+    transitionMatrix.pow(4000);
+    EXPECT_NEAR(transitionMatrix(0, 0), 5.0 / 6.0, 1e-12);
+    EXPECT_NEAR(transitionMatrix(1, 1), 1.0 / 6.0, 1e-12);
+
+    // NEGATIVE POWER WITH A SINGLE INVERSE TEST
+    LinAlg::Matrix<double> doubleMatrix = { { 2.0, 1.0, 0.0, 0.0, 0.0 }, { 0.0, 2.0, 1.0, 0.0, 0.0 }, { 0.0, 0.0, 2.0, 1.0, 0.0 },
+                                            { 0.0, 0.0, 0.0, 2.0, 1.0 }, { 1.0, 0.0, 0.0, 0.0, 2.0 } };
+    LinAlg::Matrix<double> positiveMatrix(doubleMatrix);
+    positiveMatrix.pow(6);
+    doubleMatrix.pow(-6);
+    LinAlg::Matrix<double> productMatrix = positiveMatrix * doubleMatrix;
+    for (std::size_t i = 0; i < productMatrix.rows(); ++i) {
+        for (std::size_t j = 0; j < productMatrix.cols(); ++j) { EXPECT_NEAR(productMatrix(i, j), (i == j) ? 1.0 : 0.0, 1e-9); }
+    }
+
+    // DIAGONAL MATRIX FAST PATH TEST
+    LinAlg::Matrix<int> diagonalMatrix(3, 3);
+    diagonalMatrix.set_diag({ 2, -3, 1 });
+    diagonalMatrix.pow(9);
+    LinAlg::Matrix<int> checkDiagonalMatrix(3, 3);
+    checkDiagonalMatrix.set_diag({ 512, -19683, 1 });
+    EXPECT_TRUE(diagonalMatrix == checkDiagonalMatrix);
+}
+
+TEST(LinearAlgebraTest, TransposeTiled)
+{
+    // IN-PLACE SQUARE AND OUT-OF-PLACE RECTANGULAR TRANSPOSE TEST
+    LinAlg::Matrix<int> squareMatrix(100, 100);
+    LinAlg::Matrix<double> rectangularMatrix(37, 129);
+    for (std::size_t i = 0; i < squareMatrix.rows(); ++i) {
+        for (std::size_t j = 0; j < squareMatrix.cols(); ++j) { squareMatrix(i, j) = static_cast<int>(i * 1000 + j); }
+    }
+    for (std::size_t i = 0; i < rectangularMatrix.rows(); ++i) {
+        for (std::size_t j = 0; j < rectangularMatrix.cols(); ++j) { rectangularMatrix(i, j) = static_cast<double>(i) - 0.5 * j; }
+    }
+    LinAlg::Matrix<int> squareCopy(squareMatrix);
+    LinAlg::Matrix<double> rectangularCopy(rectangularMatrix);
+    squareMatrix.transpose();
+    rectangularMatrix.transpose();
+    EXPECT_EQ(rectangularMatrix.rows(), 129);
+    EXPECT_EQ(rectangularMatrix.cols(), 37);
+    for (std::size_t i = 0; i < squareMatrix.rows(); ++i) {
+        for (std::size_t j = 0; j < squareMatrix.cols(); ++j) { EXPECT_EQ(squareMatrix(i, j), squareCopy(j, i)); }
+    }
+    for (std::size_t i = 0; i < rectangularMatrix.rows(); ++i) {
+        for (std::size_t j = 0; j < rectangularMatrix.cols(); ++j) { EXPECT_EQ(rectangularMatrix(i, j), rectangularCopy(j, i)); }
+    }
+
+    // NON-MUTATING TRANSPOSED VIEW TEST
+    LinAlg::ConstMatrixView<double> transposedView = rectangularCopy.transposed();
+    EXPECT_EQ(transposedView.rows(), 129);
+    EXPECT_EQ(transposedView.cols(), 37);
+    EXPECT_TRUE(LinAlg::Matrix<double>(transposedView) == rectangularMatrix);
+    EXPECT_TRUE(transposedView.transposed() == rectangularCopy);
+    EXPECT_TRUE(rectangularCopy.transposed() * rectangularCopy == rectangularMatrix * rectangularCopy);
+    EXPECT_TRUE(rectangularCopy * rectangularCopy.transposed() == rectangularCopy * rectangularMatrix);
+    EXPECT_TRUE(rectangularCopy.transposed() + rectangularMatrix == rectangularMatrix * 2.0);
+
+    // TRANSPOSED VIEW ALIASING ITS TARGET TEST
+    squareCopy = squareCopy.transposed();
+    EXPECT_TRUE(squareCopy == squareMatrix);
+    squareCopy -= squareMatrix.transposed();
+    squareMatrix.transpose();
+    EXPECT_TRUE(squareCopy == squareMatrix.transposed() - squareMatrix);
+}
+
+TEST(LinearAlgebraTest, FixedMatrix)
+{
+    // CONSTEXPR CONSTRUCTION AND ACCESS TEST
+    constexpr LinAlg::FixedMatrix<int, 2, 3> intMatrix1 = { { 1, 2, 3 }, { 4, 5, 6 } };
+    static_assert(intMatrix1(1, 2) == 6, "constexpr element access");
+    static_assert(LinAlg::FixedMatrix<int, 2, 3>::rows() == 2 && LinAlg::FixedMatrix<int, 2, 3>::cols() == 3, "constexpr dimensions");
+    constexpr LinAlg::FixedMatrix<int, 3, 2> intMatrix2 = intMatrix1.transposed();
+    static_assert(intMatrix2(2, 0) == 3, "constexpr transpose");
+    constexpr LinAlg::FixedMatrix<int, 2, 2> intMatrix3 = intMatrix1 * intMatrix2;
+    static_assert(intMatrix3(0, 0) == 14 && intMatrix3(0, 1) == 32 && intMatrix3(1, 1) == 77, "constexpr multiplication");
+    EXPECT_EQ(sizeof(intMatrix1), 6 * sizeof(int));
+    ASSERT_THROW((LinAlg::FixedMatrix<int, 2, 2>({ { 1, 2 } })), std::invalid_argument);
+    ASSERT_THROW(intMatrix1.at(2, 0), std::out_of_range);
+
+    // ARITHMETIC OPERATORS TEST
+    LinAlg::FixedMatrix<double, 2, 2> doubleMatrix1 = { { 1.5, -2.0 }, { 0.5, 4.0 } };
+    LinAlg::FixedMatrix<double, 2, 2> doubleMatrix2 = { { 2.0, 1.0 }, { -1.0, 3.0 } };
+    LinAlg::FixedMatrix<double, 2, 2> checkMatrix1 = { { 4.0, 0.25 }, { -4.0, 10.25 } };
+    EXPECT_TRUE((doubleMatrix1 + doubleMatrix2) * (doubleMatrix2 / 2.0) == checkMatrix1);
+    EXPECT_TRUE(-doubleMatrix1 + doubleMatrix1 * 2.0 == doubleMatrix1);
+    ASSERT_THROW(doubleMatrix1 / 0.0, std::invalid_argument);
+
+    // DETERMINANT AND INVERSE TEST
+    LinAlg::FixedMatrix<int, 4, 4> intMatrix4 = { { 2, -4, 1, 12 }, { 11, 10, 6, 0 }, { -6, 21, 7, -1 }, { 7, 1, -8, 19 } };
+    EXPECT_EQ(intMatrix4.determinant(), 45234);
+    LinAlg::FixedMatrix<double, 4, 4> doubleMatrix3 = { { 1, 1, 1, 0 }, { 0, 3, 1, 2 }, { 2, 3, 1, 0 }, { 1, 0, 2, 1 } };
+    LinAlg::FixedMatrix<double, 4, 4> checkMatrix2 = { { -3, -0.5, 1.5, 1 }, { 1, 0.25, -0.25, -0.5 }, { 3, 0.25, -1.25, -0.5 }, { -3, 0, 1, 1 } };
+    EXPECT_TRUE(doubleMatrix3.inverse() == checkMatrix2);
+    LinAlg::FixedMatrix<float, 3, 3> floatMatrix = { { 1, 2, -1 }, { 2, 1, 2 }, { -1, 2, 1 } };
+    LinAlg::FixedMatrix<float, 3, 3> checkMatrix3 = { { 0.1875, 0.25, -0.3125 }, { 0.25, 0, 0.25 }, { -0.3125, 0.25, 0.1875 } };
+    EXPECT_TRUE(floatMatrix.inverse() == checkMatrix3);
+    EXPECT_TRUE(floatMatrix * floatMatrix.inverse() == (LinAlg::FixedMatrix<float, 3, 3>::identity()));
+
+    LinAlg::FixedMatrix<double, 6, 6> doubleMatrix4;
+    for (std::size_t i = 0; i < 6; ++i) {
+        doubleMatrix4(i, i) = 2.0;
+        if (i > 0) { doubleMatrix4(i, i - 1) = -1.0; }
+        if (i < 5) { doubleMatrix4(i, i + 1) = -1.0; }
+    }
+    EXPECT_NEAR(doubleMatrix4.determinant(), 7.0, 1e-12);
+    LinAlg::FixedMatrix<double, 6, 6> identityMatrix = doubleMatrix4 * doubleMatrix4.inverse();
+    for (std::size_t i = 0; i < 6; ++i) {
+        for (std::size_t j = 0; j < 6; ++j) { EXPECT_NEAR(identityMatrix(i, j), (i == j) ? 1.0 : 0.0, 1e-12); }
+    }
+    ASSERT_THROW((LinAlg::FixedMatrix<long, 2, 2>({ { 2, 4 }, { 1, 2 } }).inverse()), std::runtime_error);
+
+    LinAlg::FixedMatrix<int, 5, 5> lowerMatrix = LinAlg::FixedMatrix<int, 5, 5>::identity();
+    LinAlg::FixedMatrix<int, 5, 5> upperMatrix = LinAlg::FixedMatrix<int, 5, 5>::identity();
+    for (std::size_t i = 0; i < 5; ++i) {
+        for (std::size_t j = 0; j < i; ++j) {
+            lowerMatrix(i, j) = static_cast<int>(i + 2 * j) % 5 - 2;
+            upperMatrix(j, i) = static_cast<int>(3 * i + j) % 4 - 1;
+        }
+    }
+    LinAlg::FixedMatrix<int, 5, 5> unimodularMatrix = lowerMatrix * upperMatrix;
+    LinAlg::FixedMatrix<int, 5, 5> inverseUnimodular = unimodularMatrix.inverse();
+    EXPECT_TRUE(unimodularMatrix * inverseUnimodular == (LinAlg::FixedMatrix<int, 5, 5>::identity()));
+    EXPECT_TRUE(LinAlg::Matrix<int>(inverseUnimodular) == LinAlg::Matrix<int>(unimodularMatrix).inverse());
+    LinAlg::FixedMatrix<long, 6, 6> singularLongMatrix;
+    for (std::size_t i = 0; i < 6; ++i) {
+        for (std::size_t j = 0; j < 6; ++j) { singularLongMatrix(i, j) = static_cast<long>(i + j); }
+    }
+    ASSERT_THROW(singularLongMatrix.inverse(), std::runtime_error);
+
+    // INTEROPERABILITY WITH DYNAMIC MATRIX TEST
+    LinAlg::Matrix<int> dynamicMatrix = intMatrix1;
+    LinAlg::Matrix<int> checkMatrix4 = { { 1, 2, 3 }, { 4, 5, 6 } };
+    EXPECT_TRUE(dynamicMatrix == checkMatrix4);
+    LinAlg::FixedMatrix<int, 2, 3> intMatrix5(dynamicMatrix + dynamicMatrix);
+    EXPECT_TRUE(intMatrix5 == intMatrix1 * 2);
+    LinAlg::Matrix<int> productMatrix = intMatrix1 * LinAlg::Matrix<int>(intMatrix2);
+    EXPECT_TRUE(productMatrix == LinAlg::Matrix<int>(intMatrix3));
+    ASSERT_THROW((LinAlg::FixedMatrix<int, 3, 3>(dynamicMatrix)), std::invalid_argument);
+}
+
+TEST(LinearAlgebraTest, MatrixViews)
+{
+    // ROW, COLUMN, BLOCK AND TRANSPOSED VIEWS TEST
+    LinAlg::Matrix<int> intMatrix = { { 1, 2, 3, 4 }, { 5, 6, 7, 8 }, { 9, 10, 11, 12 } };
+    EXPECT_TRUE(intMatrix.row_view(1) == (LinAlg::Matrix<int>{ { 5, 6, 7, 8 } }));
+    EXPECT_TRUE(intMatrix.col_view(2) == (LinAlg::Matrix<int>{ { 3 }, { 7 }, { 11 } }));
+    LinAlg::ConstMatrixView<int> blockView = static_cast<const LinAlg::Matrix<int>&>(intMatrix).block(1, 1, 2, 3);
+    EXPECT_EQ(blockView.rows(), 2);
+    EXPECT_EQ(blockView.cols(), 3);
+    EXPECT_EQ(blockView(1, 2), 12);
+    EXPECT_TRUE(blockView.transposed() == (LinAlg::Matrix<int>{ { 6, 10 }, { 7, 11 }, { 8, 12 } }));
+    EXPECT_TRUE(blockView.col(0).transposed() == (LinAlg::Matrix<int>{ { 6, 10 } }));
+    ASSERT_THROW(intMatrix.block(2, 0, 2, 1), std::out_of_range);
+    ASSERT_THROW(intMatrix.col_view(4), std::out_of_range);
+    ASSERT_THROW(blockView.at(0, 3), std::out_of_range);
+
+    // WRITING THROUGH MUTABLE VIEWS TEST
+    intMatrix.block(0, 0, 2, 2) += intMatrix.block(1, 2, 2, 2);
+    intMatrix.row_view(2) *= 2;
+    intMatrix.col_view(3) = intMatrix.col_view(0) - intMatrix.col_view(1);
+    LinAlg::Matrix<int> checkMatrix1 = { { 8, 10, 3, -2 }, { 16, 18, 7, -2 }, { 18, 20, 22, -2 } };
+    EXPECT_TRUE(intMatrix == checkMatrix1);
+    LinAlg::MatrixView<int> diagonalBlock = intMatrix.block(0, 0, 2, 2);
+    diagonalBlock = diagonalBlock.transposed();
+    LinAlg::Matrix<int> checkMatrix2 = { { 8, 16, 3, -2 }, { 10, 18, 7, -2 }, { 18, 20, 22, -2 } };
+    EXPECT_TRUE(intMatrix == checkMatrix2);
+    ASSERT_THROW(intMatrix.row_view(0) = intMatrix.col_view(0), std::invalid_argument);
+
+    // VIEW ASSIGNMENT ALIASING ITS OWN MATRIX TEST
+    LinAlg::Matrix<int> aliasMatrix = { { 1, 2, 3 }, { 4, 5, 6 }, { 7, 8, 9 } };
+    aliasMatrix.view().transposed() = aliasMatrix;
+    EXPECT_TRUE(aliasMatrix == (LinAlg::Matrix<int>{ { 1, 4, 7 }, { 2, 5, 8 }, { 3, 6, 9 } }));
+    aliasMatrix.view().transposed() += aliasMatrix * 2;
+    EXPECT_TRUE(aliasMatrix == (LinAlg::Matrix<int>{ { 3, 8, 13 }, { 10, 15, 20 }, { 17, 22, 27 } }));
+    aliasMatrix.block(0, 1, 3, 2) = aliasMatrix.block(0, 0, 3, 2);
+    EXPECT_TRUE(aliasMatrix == (LinAlg::Matrix<int>{ { 3, 3, 8 }, { 10, 10, 15 }, { 17, 17, 22 } }));
+    aliasMatrix.col_view(2) = aliasMatrix.row_view(0).transposed();
+    EXPECT_TRUE(aliasMatrix == (LinAlg::Matrix<int>{ { 3, 3, 3 }, { 10, 10, 3 }, { 17, 17, 8 } }));
+
+    // WRAPPING EXTERNAL BUFFERS TEST
+    double buffer[6] = { 2.0, 1.0, 0.0, 1.0, 3.0, 0.0 };
+    LinAlg::MatrixView<double> bufferView(buffer, 2, 2, 3, 1);
+    LinAlg::Matrix<double> productMatrix = bufferView * bufferView.transposed();
+    LinAlg::Matrix<double> checkMatrix3 = { { 5.0, 5.0 }, { 5.0, 10.0 } };
+    EXPECT_TRUE(productMatrix == checkMatrix3);
+    bufferView.col(1).fill(-1.0);
+    EXPECT_EQ(buffer[1], -1.0);
+    EXPECT_EQ(buffer[4], -1.0);
+    EXPECT_EQ(buffer[2], 0.0);
+
+    // SOLVERS ON VIEWS TEST
+    LinAlg::Matrix<double> systemMatrix = { { 4.0, 1.0, 9.0 }, { 1.0, 3.0, 9.0 }, { 9.0, 9.0, 9.0 } };
+    std::vector<double> solution1 = LinAlg::solve_lu(systemMatrix.block(0, 0, 2, 2), std::vector<double>{ 6.0, 7.0 });
+    std::vector<double> solution2 = LinAlg::solve_gauss(systemMatrix.block(0, 0, 2, 2), std::vector<double>{ 6.0, 7.0 });
+    EXPECT_TRUE(LinAlg::areEqual(solution1[0], 1.0) && LinAlg::areEqual(solution1[1], 2.0));
+    EXPECT_NEAR(solution2[0], 1.0, 1e-12);
+    EXPECT_NEAR(solution2[1], 2.0, 1e-12);
+    LinAlg::LUDecomposition<double> decomposition(systemMatrix.block(0, 0, 2, 2));
+    LinAlg::Matrix<double> rhsMatrix = { { 6.0, 0.0, 5.0 }, { 7.0, 0.0, 4.0 } };
+    decomposition.solve_in_place(rhsMatrix.col_view(0));
+    decomposition.solve_in_place(rhsMatrix.block(0, 2, 2, 1));
+    EXPECT_NEAR(rhsMatrix(0, 0), 1.0, 1e-12);
+    EXPECT_NEAR(rhsMatrix(1, 0), 2.0, 1e-12);
+    EXPECT_NEAR(rhsMatrix(0, 2), 1.0, 1e-12);
+    EXPECT_NEAR(rhsMatrix(1, 2), 1.0, 1e-12);
+}
+
+TEST(LinearAlgebraTest, Allocators)
+{
+    // ALIGNED DEFAULT STORAGE TEST
+    for (std::size_t size = 1; size < 40; size += 3) {
+        LinAlg::Matrix<double> doubleMatrix(size, size + 1);
+        LinAlg::Matrix<float> floatMatrix(size, 1, 1.0f);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(doubleMatrix.data()) % LinAlg::Detail::storage_alignment, 0u);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(floatMatrix.data()) % LinAlg::Detail::storage_alignment, 0u);
+    }
+
+    // ARENA BACKED MATRICES TEST
+    typedef LinAlg::Matrix< double, LinAlg::ArenaAllocator<double> > ArenaMatrix;
+    LinAlg::MatrixArena& arena = LinAlg::MatrixArena::local();
+    arena.release();
+
+    LinAlg::Matrix<double> lhsMatrix(24, 16), rhsMatrix(16, 24);
+    unsigned int seed = 17u;
+    for (std::size_t i = 0; i < lhsMatrix.vector_size(); ++i) {
+        seed = seed * 1103515245u + 12345u;
+        lhsMatrix.data()[i] = ((seed >> 16) % 201) / 10.0 - 10.0;
+        seed = seed * 1103515245u + 12345u;
+        rhsMatrix.data()[i] = ((seed >> 16) % 201) / 10.0 - 10.0;
+    }
+    const LinAlg::Matrix<double> productMatrix = lhsMatrix * rhsMatrix;
+    const LinAlg::Matrix<double> sumMatrix = productMatrix + productMatrix.transposed();
+
+    std::size_t reserved = 0;
+    for (int request = 0; request < 3; ++request) {
+        {
+            ArenaMatrix lhsArenaMatrix(lhsMatrix), rhsArenaMatrix(rhsMatrix);
+            ArenaMatrix productArenaMatrix = lhsArenaMatrix * rhsArenaMatrix;
+            ArenaMatrix sumArenaMatrix = productArenaMatrix + productArenaMatrix.transposed();
+            EXPECT_EQ(reinterpret_cast<std::uintptr_t>(sumArenaMatrix.data()) % LinAlg::Detail::storage_alignment, 0u);
+            EXPECT_TRUE(LinAlg::Matrix<double>(productArenaMatrix) == productMatrix);
+            EXPECT_TRUE(LinAlg::Matrix<double>(sumArenaMatrix) == sumMatrix);
+            EXPECT_GT(arena.used_bytes(), 0u);
+            ArenaMatrix minorArenaMatrix = sumArenaMatrix.minor(0, 0);
+            EXPECT_EQ(minorArenaMatrix(0, 0), sumMatrix(1, 1));
+        }
+        EXPECT_EQ(arena.used_bytes(), 0u);
+        if (request == 0) { reserved = arena.reserved_bytes(); }
+        EXPECT_EQ(arena.reserved_bytes(), reserved);
+        arena.reset();
+    }
+
+    // ARENA BLOCK REUSE TEST
+    LinAlg::MatrixArena localArena(1024);
+    void* block1 = localArena.allocate(100);
+    void* block2 = localArena.allocate(64);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(block1) % LinAlg::Detail::storage_alignment, 0u);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(block2) % LinAlg::Detail::storage_alignment, 0u);
+    EXPECT_EQ(localArena.used_bytes(), 192u);
+    localArena.deallocate(block1, 100);
+    EXPECT_EQ(localArena.allocate(128), block1);
+    void* largeBlock = localArena.allocate(4000);
+    EXPECT_EQ(localArena.reserved_bytes(), 1024u + 4096u);
+    localArena.reset();
+    EXPECT_EQ(localArena.allocate(4096), largeBlock);
+    const LinAlg::ArenaAllocator<double> localAllocator(localArena);
+    std::vector< double, LinAlg::ArenaAllocator<double> > arenaVector(localAllocator);
+    arenaVector.assign(16, 1.0);
+    EXPECT_EQ(localArena.used_bytes(), 4096u + 128u);
+}
+
+TEST(LinearAlgebraTest, StorageConstruction)
+{
+    // UNINITIALIZED CONSTRUCTION TEST
+    LinAlg::Matrix<double> uninitializedMatrix(3, 4, LinAlg::uninitialized);
+    EXPECT_EQ(uninitializedMatrix.rows(), 3);
+    EXPECT_EQ(uninitializedMatrix.cols(), 4);
+    EXPECT_EQ(uninitializedMatrix.vector_size(), 12);
+    uninitializedMatrix.set_row(0, 1.0);
+    uninitializedMatrix.set_row(1, 2.0);
+    uninitializedMatrix.set_row(2, 3.0);
+    EXPECT_TRUE(uninitializedMatrix == LinAlg::Matrix<double>({ { 1, 1, 1, 1 }, { 2, 2, 2, 2 }, { 3, 3, 3, 3 } }));
+    ASSERT_THROW(LinAlg::Matrix<double>(0, 4, LinAlg::uninitialized), std::invalid_argument);
+
+    // SIZED STORAGE VALUE INITIALIZATION TEST
+    {
+        LinAlg::Matrix<double> dirtyMatrix(16, 16, 7.0);
+    }
+    LinAlg::Matrix<double>::storage_type sizedStorage(256);
+    EXPECT_TRUE(std::all_of(sizedStorage.begin(), sizedStorage.end(), [](double value) { return value == 0.0; }));
+    sizedStorage.assign(256, 7.0);
+    sizedStorage.resize(128);
+    sizedStorage.resize(512);
+    EXPECT_TRUE(std::all_of(sizedStorage.begin() + 128, sizedStorage.end(), [](double value) { return value == 0.0; }));
+    LinAlg::MatrixArena storageArena;
+    {
+        std::vector< double, LinAlg::ArenaAllocator<double> > dirtyStorage(64, 7.0, LinAlg::ArenaAllocator<double>(storageArena));
+    }
+    std::vector< double, LinAlg::ArenaAllocator<double> > arenaStorage(64, LinAlg::ArenaAllocator<double>(storageArena));
+    EXPECT_TRUE(std::all_of(arenaStorage.begin(), arenaStorage.end(), [](double value) { return value == 0.0; }));
+    EXPECT_TRUE(LinAlg::Matrix<int>(2, 3).zero());
+    EXPECT_TRUE(LinAlg::Matrix<int>(2, 3, 7) == LinAlg::Matrix<int>({ { 7, 7, 7 }, { 7, 7, 7 } }));
+
+    // ADOPTED STORAGE TEST
+    LinAlg::Matrix<int>::storage_type storage = { 1, 2, 3, 4, 5, 6 };
+    const int* storageData = storage.data();
+    LinAlg::Matrix<int> adoptedMatrix(2, 3, std::move(storage));
+    EXPECT_EQ(adoptedMatrix.data(), storageData);
+    EXPECT_TRUE(adoptedMatrix == LinAlg::Matrix<int>({ { 1, 2, 3 }, { 4, 5, 6 } }));
+    LinAlg::Matrix<int>::storage_type shortStorage = { 1, 2, 3 };
+    ASSERT_THROW(LinAlg::Matrix<int>(2, 3, std::move(shortStorage)), std::invalid_argument);
+    const std::vector<int> copiedVector = { 1, 2, 3, 4, 5, 6 };
+    EXPECT_TRUE(LinAlg::Matrix<int>(3, 2, copiedVector) == LinAlg::Matrix<int>({ { 1, 2 }, { 3, 4 }, { 5, 6 } }));
+
+    // IN PLACE SETTERS TEST
+    LinAlg::Matrix<double> squareMatrix(3, 3, 5.0);
+    const double* squareData = squareMatrix.data();
+    squareMatrix.set_identity();
+    EXPECT_EQ(squareMatrix.data(), squareData);
+    EXPECT_TRUE(squareMatrix == LinAlg::Matrix<double>({ { 1, 0, 0 }, { 0, 1, 0 }, { 0, 0, 1 } }));
+    squareMatrix.set_diag({ 2.0, 3.0, 4.0 });
+    EXPECT_EQ(squareMatrix.data(), squareData);
+    EXPECT_TRUE(squareMatrix == LinAlg::Matrix<double>({ { 2, 0, 0 }, { 0, 3, 0 }, { 0, 0, 4 } }));
+    squareMatrix.set_zero();
+    EXPECT_EQ(squareMatrix.data(), squareData);
+    EXPECT_TRUE(squareMatrix.zero());
+}
+
+TEST(LinearAlgebraTest, RvalueOperators)
+{
+    // RESULT IN EXPIRING BUFFER TEST
+    const LinAlg::Matrix<double> aMatrix = { { 1, 2 }, { 3, 4 }, { 5, 6 } };
+    const LinAlg::Matrix<double> bMatrix = { { 2, 0, 1 }, { 1, 3, 0 } };
+    const LinAlg::Matrix<double> cMatrix = { { 1, 1, 1 }, { 2, 2, 2 }, { 3, 3, 3 } };
+    const LinAlg::Matrix<double> productMatrix = { { 4, 6, 1 }, { 10, 12, 3 }, { 16, 18, 5 } };
+
+    LinAlg::Matrix<double> tempMatrix = aMatrix * bMatrix;
+    const double* tempData = tempMatrix.data();
+    LinAlg::Matrix<double> sumMatrix = std::move(tempMatrix) + cMatrix;
+    EXPECT_EQ(sumMatrix.data(), tempData);
+    EXPECT_TRUE(sumMatrix == (LinAlg::Matrix<double>{ { 5, 7, 2 }, { 12, 14, 5 }, { 19, 21, 8 } }));
+
+    tempMatrix = aMatrix * bMatrix;
+    tempData = tempMatrix.data();
+    LinAlg::Matrix<double> differenceMatrix = cMatrix - std::move(tempMatrix);
+    EXPECT_EQ(differenceMatrix.data(), tempData);
+    EXPECT_TRUE(differenceMatrix == (LinAlg::Matrix<double>{ { -3, -5, 0 }, { -8, -10, -1 }, { -13, -15, -2 } }));
+
+    tempMatrix = aMatrix * bMatrix;
+    tempData = tempMatrix.data();
+    LinAlg::Matrix<double> scaledMatrix = -(2.0 * (std::move(tempMatrix) / 4.0));
+    EXPECT_EQ(scaledMatrix.data(), tempData);
+    EXPECT_TRUE(scaledMatrix == (LinAlg::Matrix<double>{ { -2, -3, -0.5 }, { -5, -6, -1.5 }, { -8, -9, -2.5 } }));
+
+    // CHAINED TEMPORARIES TEST
+    EXPECT_TRUE((aMatrix * bMatrix) + cMatrix.transposed() == (LinAlg::Matrix<double>{ { 5, 8, 4 }, { 11, 14, 6 }, { 17, 20, 8 } }));
+    EXPECT_TRUE((aMatrix * bMatrix) - (bMatrix.transposed() * aMatrix.transposed()) ==
+                (LinAlg::Matrix<double>{ { 0, -4, -15 }, { 4, 0, -15 }, { 15, 15, 0 } }));
+    EXPECT_TRUE((aMatrix * bMatrix) * 0.5 + (aMatrix * bMatrix) * 0.5 == productMatrix);
+    EXPECT_TRUE(LinAlg::Matrix<int>({ { 1, 2 } }) + LinAlg::Matrix<int>({ { 3, 4 } }) == LinAlg::Matrix<int>({ { 4, 6 } }));
+    ASSERT_THROW(aMatrix * bMatrix + aMatrix, std::invalid_argument);
+    ASSERT_THROW(aMatrix - aMatrix * bMatrix, std::invalid_argument);
+    ASSERT_THROW(LinAlg::Matrix<double>(aMatrix) / 0.0, std::invalid_argument);
+}
+
+TEST(LinearAlgebraTest, SparseMatrix)
+{
+    // CONSTRUCTION FROM TRIPLETS TEST
+    std::vector< LinAlg::Triplet<double> > triplets = {
+        { 2, 1, 4.0 }, { 0, 0, 1.0 }, { 1, 2, 3.0 }, { 2, 1, 1.0 }, { 0, 3, 2.0 }, { 2, 0, -1.0 }
+    };
+    const LinAlg::SparseMatrix<double> sparseMatrix(3, 4, triplets);
+    const LinAlg::Matrix<double> denseMatrix = { { 1, 0, 0, 2 }, { 0, 0, 3, 0 }, { -1, 5, 0, 0 } };
+    EXPECT_EQ(sparseMatrix.nnz(), 5);
+    EXPECT_TRUE(sparseMatrix.to_dense() == denseMatrix);
+    EXPECT_EQ(sparseMatrix(2, 1), 5.0);
+    EXPECT_EQ(sparseMatrix(1, 1), 0.0);
+    EXPECT_TRUE(sparseMatrix.row_pointers() == (std::vector<std::size_t>{ 0, 2, 3, 5 }));
+    EXPECT_TRUE(sparseMatrix.col_indices() == (std::vector<std::size_t>{ 0, 3, 2, 0, 1 }));
+    ASSERT_THROW(sparseMatrix.at(3, 0), std::out_of_range);
+    triplets.push_back({ 0, 4, 1.0 });
+    ASSERT_THROW(LinAlg::SparseMatrix<double>(3, 4, triplets), std::out_of_range);
+    ASSERT_THROW(LinAlg::SparseMatrix<double>(2, 2, { 0, 1, 1 }, { 1, 0 }, { 1.0, 2.0 }), std::invalid_argument);
+    ASSERT_THROW(LinAlg::SparseMatrix<double>(1, 2, { 0, 2 }, { 1, 0 }, { 1.0, 2.0 }), std::invalid_argument);
+
+    // DENSE, TRANSPOSE AND CSC CONVERSION TEST
+    const LinAlg::SparseMatrix<double> fromDense(denseMatrix);
+    EXPECT_TRUE(fromDense.values() == sparseMatrix.values());
+    EXPECT_TRUE(sparseMatrix.transposed().to_dense() == LinAlg::Matrix<double>(denseMatrix.transposed()));
+    const LinAlg::CscStorage<double> csc = sparseMatrix.to_csc();
+    EXPECT_TRUE(csc.pointers == (std::vector<std::size_t>{ 0, 2, 3, 4, 5 }));
+    EXPECT_TRUE(csc.indices == (std::vector<std::size_t>{ 0, 2, 2, 1, 0 }));
+    EXPECT_TRUE(LinAlg::SparseMatrix<double>(3, 4, csc).to_dense() == denseMatrix);
+    EXPECT_TRUE(sparseMatrix.diagonal() == (std::vector<double>{ 1.0, 0.0, 0.0 }));
+
+    // SPARSE PRODUCTS TEST
+    EXPECT_TRUE((sparseMatrix * std::vector<double>{ 1.0, 2.0, 3.0, 4.0 }) == (std::vector<double>{ 9.0, 9.0, 9.0 }));
+    ASSERT_THROW((sparseMatrix * std::vector<double>{ 1.0, 2.0 }), std::invalid_argument);
+
+    const std::size_t rows = 70, inner = 90, cols = 50;
+    unsigned int seed = 5u;
+    std::vector< LinAlg::Triplet<double> > lhsTriplets, rhsTriplets;
+    for (std::size_t i = 0; i < rows * inner / 10; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        const std::size_t position = (seed >> 8) % (rows * inner);
+        seed = seed * 1103515245u + 12345u;
+        lhsTriplets.push_back({ position / inner, position % inner, ((seed >> 16) % 201) / 10.0 - 10.0 });
+    }
+    for (std::size_t i = 0; i < inner * cols / 10; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        const std::size_t position = (seed >> 8) % (inner * cols);
+        seed = seed * 1103515245u + 12345u;
+        rhsTriplets.push_back({ position / cols, position % cols, ((seed >> 16) % 201) / 10.0 - 10.0 });
+    }
+    const LinAlg::SparseMatrix<double> lhsSparse(rows, inner, lhsTriplets), rhsSparse(inner, cols, rhsTriplets);
+    const LinAlg::Matrix<double> lhsDense = lhsSparse.to_dense(), rhsDense = rhsSparse.to_dense();
+    const LinAlg::Matrix<double> productDense = lhsDense * rhsDense;
+    const LinAlg::Matrix<double> sparseDense = lhsSparse * rhsDense;
+    const LinAlg::Matrix<double> denseSparse = lhsDense * rhsSparse;
+    const LinAlg::Matrix<double> sparseSparse = (lhsSparse * rhsSparse).to_dense();
+    const LinAlg::Matrix<double> transposedProduct = lhsSparse * rhsDense.transposed().transposed();
+    double maxError = 0.0;
+    for (std::size_t i = 0; i < rows; ++i) {
+        for (std::size_t j = 0; j < cols; ++j) {
+            maxError = std::max(maxError, std::fabs(sparseDense(i, j) - productDense(i, j)));
+            maxError = std::max(maxError, std::fabs(denseSparse(i, j) - productDense(i, j)));
+            maxError = std::max(maxError, std::fabs(sparseSparse(i, j) - productDense(i, j)));
+            maxError = std::max(maxError, std::fabs(transposedProduct(i, j) - productDense(i, j)));
+        }
+    }
+    EXPECT_LT(maxError, 1e-10);
+    ASSERT_THROW(rhsSparse * lhsSparse, std::invalid_argument);
+    ASSERT_THROW(lhsSparse * lhsDense, std::invalid_argument);
+
+    // SPARSE SOLVERS TEST
+    const LinAlg::SparseMatrix<double> systemMatrix(LinAlg::Matrix<double>{ { 4, 1, 0 }, { 1, 3, 0 }, { 0, 0, 2 } });
+    const std::vector<double> solution1 = LinAlg::solve_lu(systemMatrix, std::vector<double>{ 6.0, 7.0, 4.0 });
+    const std::vector<double> solution2 = LinAlg::solve_gauss(systemMatrix, std::vector<double>{ 6.0, 7.0, 4.0 });
+    for (std::size_t i = 0; i < 3; ++i) {
+        EXPECT_NEAR(solution1[i], (std::vector<double>{ 1.0, 2.0, 2.0 })[i], 1e-12);
+        EXPECT_NEAR(solution2[i], (std::vector<double>{ 1.0, 2.0, 2.0 })[i], 1e-12);
+    }
+}
+
+TEST(LinearAlgebraTest, IterativeMethods)
+{
+    // SPARSE SYMMETRIC POSITIVE DEFINITE SYSTEM TEST
+    const std::size_t grid = 20, size = grid * grid;
+    std::vector< LinAlg::Triplet<double> > triplets;
+    for (std::size_t i = 0; i < grid; ++i) {
+        for (std::size_t j = 0; j < grid; ++j) {
+            const std::size_t row = i * grid + j;
+            triplets.push_back({ row, row, 4.0 });
+            if (i > 0) { triplets.push_back({ row, row - grid, -1.0 }); }
+            if (i + 1 < grid) { triplets.push_back({ row, row + grid, -1.0 }); }
+            if (j > 0) { triplets.push_back({ row, row - 1, -1.0 }); }
+            if (j + 1 < grid) { triplets.push_back({ row, row + 1, -1.0 }); }
+        }
+    }
+    const LinAlg::SparseMatrix<double> laplacian(size, size, triplets);
+    std::vector<double> expected(size);
+    unsigned int seed = 17u;
+    for (std::size_t i = 0; i < size; ++i) {
+        seed = seed * 1103515245u + 12345u;
+        expected[i] = ((seed >> 16) % 201) / 10.0 - 10.0;
+    }
+    const std::vector<double> b = laplacian * expected;
+    const auto maxError = [&](const std::vector<double>& x) {
+        double error = 0.0;
+        for (std::size_t i = 0; i < x.size(); ++i) { error = std::max(error, std::fabs(x[i] - expected[i])); }
+        return error;
+    };
+
+    LinAlg::IterativeSettings<double> settings;
+    settings.tolerance = 1e-12;
+    std::vector<double> x;
+    const LinAlg::IterativeResult<double> plain = LinAlg::solve_cg(laplacian, b, x, LinAlg::IdentityPreconditioner<double>(size), settings);
+    EXPECT_TRUE(plain.converged);
+    EXPECT_LT(maxError(x), 1e-8);
+
+    x.clear();
+    const LinAlg::IC0Preconditioner<double> incompleteCholesky(laplacian);
+    const LinAlg::IterativeResult<double> preconditioned = LinAlg::solve_cg(laplacian, b, x, incompleteCholesky, settings);
+    EXPECT_TRUE(preconditioned.converged);
+    EXPECT_LT(preconditioned.iterations, plain.iterations);
+    EXPECT_LT(maxError(x), 1e-8);
+
+    x.clear();
+    const LinAlg::ILU0Preconditioner<double> incompleteLU(laplacian);
+    EXPECT_TRUE(LinAlg::solve_cg(laplacian, b, x, incompleteLU, settings).converged);
+    EXPECT_LT(maxError(x), 1e-8);
+    EXPECT_LT(maxError(LinAlg::solve_cg(laplacian, b)), 1e-6);
+
+    // WARM START TEST
+    std::vector<double> warm(expected);
+    for (std::size_t i = 0; i < size; ++i) { warm[i] += 1e-6 * static_cast<double>(i % 7); }
+    const LinAlg::IterativeResult<double> warmResult = LinAlg::solve_cg(laplacian, b, warm, incompleteCholesky, settings);
+    EXPECT_TRUE(warmResult.converged);
+    EXPECT_LT(warmResult.iterations, preconditioned.iterations);
+    std::vector<double> exact(expected);
+    EXPECT_EQ(LinAlg::solve_cg(laplacian, b, exact, incompleteCholesky, settings).iterations, 0u);
+
+    // NONSYMMETRIC SYSTEM TEST
+    std::vector< LinAlg::Triplet<double> > convectionTriplets = triplets;
+    for (std::size_t row = 1; row < size; ++row) {
+        convectionTriplets.push_back({ row, row - 1, -0.5 });
+        convectionTriplets.push_back({ row, row, 1.0 + static_cast<double>(row % 3) });
+    }
+    const LinAlg::SparseMatrix<double> convection(size, size, convectionTriplets);
+    const std::vector<double> convectionB = convection * expected;
+    for (int method = 0; method < 2; ++method) {
+        std::vector<double> jacobiX, iluX;
+        const LinAlg::JacobiPreconditioner<double> jacobi(convection);
+        const LinAlg::ILU0Preconditioner<double> ilu(convection);
+        const LinAlg::IterativeResult<double> jacobiResult = method == 0
+            ? LinAlg::solve_bicgstab(convection, convectionB, jacobiX, jacobi, settings)
+            : LinAlg::solve_gmres(convection, convectionB, jacobiX, jacobi, settings);
+        const LinAlg::IterativeResult<double> iluResult = method == 0
+            ? LinAlg::solve_bicgstab(convection, convectionB, iluX, ilu, settings)
+            : LinAlg::solve_gmres(convection, convectionB, iluX, ilu, settings);
+        EXPECT_TRUE(jacobiResult.converged);
+        EXPECT_TRUE(iluResult.converged);
+        EXPECT_LE(iluResult.iterations, jacobiResult.iterations);
+        EXPECT_LT(maxError(jacobiX), 1e-8);
+        EXPECT_LT(maxError(iluX), 1e-8);
+    }
+
+    // DENSE SYSTEM TEST
+    const LinAlg::Matrix<double> dense = { { 4, 1, 0, 1 }, { 1, 5, 2, 0 }, { 0, 2, 6, 1 }, { 1, 0, 1, 3 } };
+    const std::vector<double> denseExpected = { 1, -2, 3, -4 };
+    std::vector<double> denseB(4, 0.0);
+    for (std::size_t i = 0; i < 4; ++i) {
+        for (std::size_t j = 0; j < 4; ++j) { denseB[i] += dense(i, j) * denseExpected[j]; }
+    }
+    const std::vector<std::vector<double> > denseSolutions = {
+        LinAlg::solve_cg(dense, denseB), LinAlg::solve_bicgstab(dense, denseB), LinAlg::solve_gmres(dense, denseB)
+    };
+    for (const std::vector<double>& solution : denseSolutions) {
+        for (std::size_t i = 0; i < 4; ++i) { EXPECT_NEAR(solution[i], denseExpected[i], 1e-8); }
+    }
+    std::vector<double> denseX;
+    EXPECT_TRUE(LinAlg::solve_cg(dense, denseB, denseX, LinAlg::IC0Preconditioner<double>(dense)).converged);
+    denseX.clear();
+    EXPECT_TRUE(LinAlg::solve_gmres(dense, denseB, denseX, LinAlg::ILU0Preconditioner<double>(dense)).converged);
+
+    // SINGLE PRECISION DEFAULT SETTINGS TEST
+    std::vector< LinAlg::Triplet<float> > floatTriplets;
+    for (const LinAlg::Triplet<double>& triplet : triplets) { floatTriplets.push_back({ triplet.row, triplet.col, static_cast<float>(triplet.value) }); }
+    const LinAlg::SparseMatrix<float> floatLaplacian(size, size, floatTriplets);
+    const std::vector<float> floatB(b.begin(), b.end());
+    for (int method = 0; method < 3; ++method) {
+        std::vector<float> floatX;
+        const LinAlg::IdentityPreconditioner<float> identity(size);
+        const LinAlg::IterativeResult<float> floatResult = method == 0
+            ? LinAlg::solve_cg(floatLaplacian, floatB, floatX, identity)
+            : method == 1 ? LinAlg::solve_bicgstab(floatLaplacian, floatB, floatX, identity)
+                          : LinAlg::solve_gmres(floatLaplacian, floatB, floatX, identity);
+        EXPECT_TRUE(floatResult.converged);
+        EXPECT_LT(floatResult.iterations, 1000u);
+        for (std::size_t i = 0; i < size; ++i) { EXPECT_NEAR(floatX[i], expected[i], 1e-2); }
+    }
+
+    // INVALID ARGUMENTS TEST
+    std::vector<double> zero;
+    EXPECT_EQ(LinAlg::solve_cg(laplacian, std::vector<double>(size, 0.0), zero, incompleteLU).iterations, 0u);
+    EXPECT_TRUE(zero == std::vector<double>(size, 0.0));
+    std::vector<double> wrongSize(3, 0.0);
+    ASSERT_THROW(LinAlg::solve_cg(laplacian, b, wrongSize, incompleteLU), std::invalid_argument);
+    ASSERT_THROW(LinAlg::solve_gmres(dense, b), std::invalid_argument);
+    ASSERT_THROW(LinAlg::solve_bicgstab(LinAlg::Matrix<double>(2, 3), std::vector<double>(2, 1.0)), std::invalid_argument);
+    ASSERT_THROW((LinAlg::JacobiPreconditioner<double>(LinAlg::Matrix<double>(2, 2))), std::runtime_error);
+    const LinAlg::Matrix<double> indefinite = { { 1, 2 }, { 2, 1 } };
+    ASSERT_THROW((LinAlg::IC0Preconditioner<double>(indefinite)), std::runtime_error);
+}
+
+TEST(LinearAlgebraTest, CholeskyDecomposition)
+{
+    // SMALL SYSTEM TEST
+    const LinAlg::Matrix<double> smallMatrix = { { 4.0, 2.0, -2.0 }, { 2.0, 10.0, 2.0 }, { -2.0, 2.0, 5.0 } };
+    LinAlg::CholeskyDecomposition<double> decomposition1(smallMatrix);
+    EXPECT_EQ(decomposition1.size(), 3);
+    EXPECT_EQ(decomposition1.packed().size(), 6);
+    const LinAlg::Matrix<double> expectedLower = { { 2.0, 0.0, 0.0 }, { 1.0, 3.0, 0.0 }, { -1.0, 1.0, std::sqrt(3.0) } };
+    for (std::size_t i = 0; i < 3; ++i) {
+        for (std::size_t j = 0; j < 3; ++j) { EXPECT_NEAR(decomposition1.lower()(i, j), expectedLower(i, j), 1e-12); }
+    }
+    EXPECT_NEAR(decomposition1.determinant(), 108.0, 1e-10);
+    const std::vector<double> solution1 = LinAlg::solve_cholesky(smallMatrix, std::vector<double>{ 4.0, 14.0, 5.0 });
+    for (std::size_t i = 0; i < 3; ++i) { EXPECT_NEAR(solution1[i], 1.0, 1e-12); }
+
+    // BLOCKED FACTORIZATION WITH MULTIPLE RIGHT-HAND SIDES TEST
+    const std::size_t size = 150;
+    LinAlg::Matrix<double> randomMatrix(size, size);
+    LinAlg::Matrix<double> expectedMatrix(size, 3);
+    unsigned int seed = 321u;
+    for (std::size_t i = 0; i < size; ++i) {
+        for (std::size_t j = 0; j < size; ++j) {
+            seed = seed * 1103515245u + 12345u;
+            randomMatrix(i, j) = static_cast<double>((seed >> 16) % 201) / 10.0 - 10.0;
+        }
+        for (std::size_t j = 0; j < 3; ++j) { expectedMatrix(i, j) = static_cast<double>((i + 1) * (j + 1) % 7) - 3.0; }
+    }
+    LinAlg::Matrix<double> spdMatrix = randomMatrix * randomMatrix.transposed();
+    for (std::size_t i = 0; i < size; ++i) { spdMatrix(i, i) += static_cast<double>(size); }
+    const LinAlg::Matrix<double> rhsMatrix = spdMatrix * expectedMatrix;
+    LinAlg::CholeskyDecomposition<double> decomposition2(spdMatrix);
+    const LinAlg::Matrix<double> solutionMatrix = decomposition2.solve(rhsMatrix);
+    const std::vector<double> solution2 = decomposition2.solve(rhsMatrix.get_col(2));
+    const LinAlg::Matrix<double> lowerMatrix = decomposition2.lower();
+    const LinAlg::Matrix<double> productMatrix = lowerMatrix * lowerMatrix.transposed();
+    double maxError = 0.0;
+    for (std::size_t i = 0; i < size; ++i) {
+        for (std::size_t j = 0; j < size; ++j) { maxError = std::max(maxError, std::fabs(productMatrix(i, j) - spdMatrix(i, j))); }
+        for (std::size_t j = 0; j < 3; ++j) { EXPECT_NEAR(solutionMatrix(i, j), expectedMatrix(i, j), 1e-8); }
+        EXPECT_NEAR(solution2[i], expectedMatrix(i, 2), 1e-8);
+    }
+    EXPECT_LT(maxError, 1e-9);
+
+    // RANK-1 UPDATE AND DOWNDATE TEST
+    std::vector<double> direction(size);
+    for (std::size_t i = 0; i < size; ++i) { direction[i] = static_cast<double>(i % 5) - 2.0; }
+    LinAlg::Matrix<double> updatedMatrix(spdMatrix);
+    for (std::size_t i = 0; i < size; ++i) {
+        for (std::size_t j = 0; j < size; ++j) { updatedMatrix(i, j) += direction[i] * direction[j]; }
+    }
+    decomposition2.update(direction);
+    const std::vector<double> updatedSolution = decomposition2.solve((updatedMatrix * expectedMatrix).get_col(0));
+    const LinAlg::CholeskyDecomposition<double> refactored(updatedMatrix);
+    maxError = 0.0;
+    for (std::size_t i = 0; i < size; ++i) {
+        EXPECT_NEAR(updatedSolution[i], expectedMatrix(i, 0), 1e-8);
+        for (std::size_t j = 0; j <= i; ++j) {
+            const std::size_t index = LinAlg::Kernels::packed_index(i, j);
+            maxError = std::max(maxError, std::fabs(decomposition2.packed()[index] - refactored.packed()[index]));
+        }
+    }
+    EXPECT_LT(maxError, 1e-9);
+    decomposition2.downdate(direction);
+    EXPECT_NEAR(decomposition2.lower()(size - 1, size - 1), lowerMatrix(size - 1, size - 1), 1e-9);
+
+    const std::vector<double> packedBefore = decomposition1.packed();
+    ASSERT_THROW(decomposition1.downdate(std::vector<double>{ 3.0, 0.0, 0.0 }), std::runtime_error);
+    EXPECT_TRUE(decomposition1.packed() == packedBefore);
+    ASSERT_THROW(decomposition1.update(std::vector<double>{ 1.0 }), std::invalid_argument);
+
+    // SPARSE AND INVALID MATRIX EXCEPTION THROWING TEST
+    const std::vector<double> sparseSolution = LinAlg::solve_cholesky(LinAlg::SparseMatrix<double>(smallMatrix), std::vector<double>{ 4.0, 14.0, 5.0 });
+    EXPECT_NEAR(sparseSolution[1], 1.0, 1e-12);
+    const LinAlg::Matrix<double> indefiniteMatrix = { { 1.0, 2.0 }, { 2.0, 1.0 } };
+    ASSERT_THROW((LinAlg::CholeskyDecomposition<double>(indefiniteMatrix)), std::runtime_error);
+    ASSERT_THROW(decomposition1.solve(std::vector<double>{ 1.0, 2.0 }), std::invalid_argument);
+    ASSERT_THROW(LinAlg::CholeskyDecomposition<double>(LinAlg::Matrix<double>(2, 3)), std::invalid_argument);
+    ASSERT_THROW(LinAlg::CholeskyDecomposition<int>(LinAlg::Matrix<int>(2, 2)), std::invalid_argument);
+}
+
+TEST(LinearAlgebraTest, LDLTDecomposition)
+{
+    // 2 x 2 PIVOT TEST
+    const LinAlg::Matrix<double> zeroDiagonalMatrix = { { 0.0, 1.0 }, { 1.0, 0.0 } };
+    LinAlg::LDLTDecomposition<double> decomposition1(zeroDiagonalMatrix);
+    EXPECT_FALSE(decomposition1.singular());
+    EXPECT_TRUE(decomposition1.blocks() == (std::vector<unsigned char>{ 2, 0 }));
+    EXPECT_TRUE(decomposition1.diagonal() == zeroDiagonalMatrix);
+    EXPECT_TRUE(LinAlg::areEqual(decomposition1.determinant(), -1.0));
+    const std::vector<double> solution1 = decomposition1.solve(std::vector<double>{ 2.0, 3.0 });
+    EXPECT_TRUE(LinAlg::areEqual(solution1[0], 3.0));
+    EXPECT_TRUE(LinAlg::areEqual(solution1[1], 2.0));
+
+    // INDEFINITE SYSTEM WITH MULTIPLE RIGHT-HAND SIDES TEST
+    const std::size_t size = 130;
+    LinAlg::Matrix<double> symmetricMatrix(size, size);
+    LinAlg::Matrix<double> expectedMatrix(size, 2);
+    unsigned int seed = 77u;
+    for (std::size_t i = 0; i < size; ++i) {
+        for (std::size_t j = 0; j <= i; ++j) {
+            seed = seed * 1103515245u + 12345u;
+            symmetricMatrix(i, j) = static_cast<double>((seed >> 16) % 201) / 10.0 - 10.0;
+            symmetricMatrix(j, i) = symmetricMatrix(i, j);
+        }
+        symmetricMatrix(i, i) = i % 3 == 0 ? 0.0 : symmetricMatrix(i, i);
+        for (std::size_t j = 0; j < 2; ++j) { expectedMatrix(i, j) = static_cast<double>((i + 2) * (j + 1) % 5) - 2.0; }
+    }
+    LinAlg::LDLTDecomposition<double> decomposition2(symmetricMatrix);
+    EXPECT_FALSE(decomposition2.singular());
+    EXPECT_TRUE(std::count(decomposition2.blocks().begin(), decomposition2.blocks().end(), 2) > 0);
+    const LinAlg::Matrix<double> solutionMatrix = decomposition2.solve(symmetricMatrix * expectedMatrix);
+    for (std::size_t i = 0; i < size; ++i) {
+        for (std::size_t j = 0; j < 2; ++j) { EXPECT_NEAR(solutionMatrix(i, j), expectedMatrix(i, j), 1e-8); }
+    }
+
+    const LinAlg::Matrix<double> smallMatrix = { { 1.0, 2.0, 3.0 }, { 2.0, 4.0, 5.0 }, { 3.0, 5.0, 6.0 } };
+    EXPECT_NEAR(LinAlg::LDLTDecomposition<double>(smallMatrix).determinant(), -1.0, 1e-12);
+    const std::vector<double> solution2 = LinAlg::solve_ldlt(smallMatrix, std::vector<double>{ 6.0, 11.0, 14.0 });
+    for (std::size_t i = 0; i < 3; ++i) { EXPECT_NEAR(solution2[i], 1.0, 1e-12); }
+    const std::vector<double> sparseSolution = LinAlg::solve_ldlt(LinAlg::SparseMatrix<double>(smallMatrix), std::vector<double>{ 6.0, 11.0, 14.0 });
+    EXPECT_NEAR(sparseSolution[2], 1.0, 1e-12);
+
+    // SINGULAR AND INVALID MATRIX EXCEPTION THROWING TEST
+    const LinAlg::Matrix<double> singularMatrix = { { 1.0, 2.0 }, { 2.0, 4.0 } };
+    LinAlg::LDLTDecomposition<double> decomposition3(singularMatrix);
+    EXPECT_TRUE(decomposition3.singular());
+    EXPECT_EQ(decomposition3.determinant(), 0.0);
+    ASSERT_THROW(decomposition3.solve(std::vector<double>{ 1.0, 2.0 }), std::runtime_error);
+    ASSERT_THROW(decomposition2.solve(std::vector<double>{ 1.0, 2.0 }), std::invalid_argument);
+    ASSERT_THROW(LinAlg::LDLTDecomposition<double>(LinAlg::Matrix<double>(2, 3)), std::invalid_argument);
+    ASSERT_THROW(LinAlg::LDLTDecomposition<int>(LinAlg::Matrix<int>(2, 2)), std::invalid_argument);
+}
+
+TEST(LinearAlgebraTest, MatrixBatch)
+{
+    // FIXED MATRIX ROUND TRIP TEST
+    const std::vector< LinAlg::FixedMatrix<double, 2, 2> > fixedMatrices = {
+        { { 1.0, 2.0 }, { 3.0, 4.0 } }, { { 2.0, 0.0 }, { 0.0, 2.0 } }, { { 0.0, 1.0 }, { 1.0, 0.0 } }
+    };
+    const LinAlg::MatrixBatch<double> fixedBatch(fixedMatrices);
+    EXPECT_EQ(fixedBatch.count(), 3u);
+    EXPECT_EQ(fixedBatch.blocks(), 1u);
+    EXPECT_TRUE((fixedBatch.get_fixed<2, 2>(2) == fixedMatrices[2]));
+    EXPECT_TRUE(fixedBatch.get_matrix(0) == (LinAlg::Matrix<double>{ { 1.0, 2.0 }, { 3.0, 4.0 } }));
+    EXPECT_EQ(fixedBatch.at(1, 1, 1), 2.0);
+    const std::vector<double> fixedDeterminants = fixedBatch.determinants();
+    EXPECT_TRUE(LinAlg::areEqual(fixedDeterminants[0], -2.0));
+    EXPECT_TRUE(LinAlg::areEqual(fixedDeterminants[1], 4.0));
+    EXPECT_TRUE(LinAlg::areEqual(fixedDeterminants[2], -1.0));
+
+    // PRODUCT, SOLUTION AND DETERMINANT AGAINST MATRIX TEST
+    unsigned int seed = 19u;
+    for (std::size_t size : { 4u, 7u }) {
+        const std::size_t count = 37;
+        LinAlg::MatrixBatch<double> matrices(count, size, size);
+        LinAlg::MatrixBatch<double> rightHandSides(count, size, 2);
+        for (std::size_t index = 0; index < count; ++index) {
+            for (std::size_t i = 0; i < size; ++i) {
+                for (std::size_t j = 0; j < size; ++j) {
+                    seed = seed * 1103515245u + 12345u;
+                    matrices(index, i, j) = static_cast<double>((seed >> 16) % 201) / 10.0 - 10.0;
+                }
+                matrices(index, i, i) += 25.0;
+                for (std::size_t j = 0; j < 2; ++j) { rightHandSides(index, i, j) = static_cast<double>((index + i + j) % 5) - 2.0; }
+            }
+        }
+
+        const LinAlg::MatrixBatch<double> products = matrices * rightHandSides;
+        const LinAlg::BatchLUDecomposition<double> decomposition(matrices);
+        EXPECT_FALSE(decomposition.any_singular());
+        const LinAlg::MatrixBatch<double> solutions = decomposition.solve(rightHandSides);
+        const std::vector<double> determinants = decomposition.determinants();
+        ASSERT_EQ(determinants.size(), count);
+        for (std::size_t index = 0; index < count; ++index) {
+            const LinAlg::Matrix<double> matrix = matrices.get_matrix(index);
+            const LinAlg::LUDecomposition<double> expected(matrix);
+            EXPECT_TRUE(products.get_matrix(index) == matrix * rightHandSides.get_matrix(index));
+            const LinAlg::Matrix<double> expectedSolution = expected.solve(rightHandSides.get_matrix(index));
+            for (std::size_t i = 0; i < size; ++i) {
+                for (std::size_t j = 0; j < 2; ++j) { EXPECT_NEAR(solutions(index, i, j), expectedSolution(i, j), 1e-10); }
+            }
+            EXPECT_NEAR(determinants[index] / expected.determinant(), 1.0, 1e-10);
+        }
+        EXPECT_TRUE(LinAlg::solve_lu(matrices, rightHandSides) == solutions);
+    }
+
+    // SINGULAR AND INVALID BATCH EXCEPTION THROWING TEST
+    LinAlg::MatrixBatch<double> singularBatch(fixedBatch);
+    singularBatch.set_matrix(1, LinAlg::Matrix<double>{ { 1.0, 2.0 }, { 2.0, 4.0 } });
+    const LinAlg::BatchLUDecomposition<double> singularDecomposition(singularBatch);
+    EXPECT_TRUE(singularDecomposition.any_singular());
+    EXPECT_FALSE(singularDecomposition.singular(0));
+    EXPECT_TRUE(singularDecomposition.singular(1));
+    EXPECT_EQ(singularDecomposition.determinants()[1], 0.0);
+    ASSERT_THROW(singularDecomposition.solve(LinAlg::MatrixBatch<double>(3, 2, 1)), std::runtime_error);
+    ASSERT_THROW(singularDecomposition.singular(3), std::out_of_range);
+    ASSERT_THROW(fixedBatch.at(3, 0, 0), std::out_of_range);
+    ASSERT_THROW((fixedBatch.get_fixed<3, 2>(0)), std::invalid_argument);
+    ASSERT_THROW(fixedBatch * LinAlg::MatrixBatch<double>(2, 2, 2), std::invalid_argument);
+    ASSERT_THROW(fixedBatch * LinAlg::MatrixBatch<double>(3, 3, 2), std::invalid_argument);
+    ASSERT_THROW(LinAlg::BatchLUDecomposition<double>(LinAlg::MatrixBatch<double>(3, 2, 3)), std::invalid_argument);
+    ASSERT_THROW(LinAlg::BatchLUDecomposition<int>(LinAlg::MatrixBatch<int>(3, 2, 2)), std::invalid_argument);
+}
+
+TEST(LinearAlgebraTest, MatrixVector)
+{
+    // GENERAL PRODUCT AND RANK-1 UPDATE TEST
+    const std::size_t rows = 70, cols = 53;
+    LinAlg::Matrix<double> generalMatrix(rows, cols);
+    std::vector<double> rowVector(rows), colVector(cols);
+    unsigned int seed = 23u;
+    const auto nextValue = [&seed]() {
+        seed = seed * 1103515245u + 12345u;
+        return static_cast<double>((seed >> 16) % 201) / 10.0 - 10.0;
+    };
+    for (std::size_t i = 0; i < rows; ++i) {
+        for (std::size_t j = 0; j < cols; ++j) { generalMatrix(i, j) = nextValue(); }
+        rowVector[i] = nextValue();
+    }
+    for (std::size_t j = 0; j < cols; ++j) { colVector[j] = nextValue(); }
+    const LinAlg::Matrix<double> rowMatrix(rows, 1, rowVector);
+    const LinAlg::Matrix<double> colMatrix(cols, 1, colVector);
+
+    const std::vector<double> expectedProduct = (generalMatrix * colMatrix).get_col(0);
+    const std::vector<double> product = generalMatrix * colVector;
+    std::vector<double> accumulated(rowVector);
+    LinAlg::gemv(2.0, generalMatrix, colVector, -1.0, accumulated);
+    for (std::size_t i = 0; i < rows; ++i) {
+        EXPECT_NEAR(product[i], expectedProduct[i], 1e-10);
+        EXPECT_NEAR(accumulated[i], 2.0 * expectedProduct[i] - rowVector[i], 1e-10);
+    }
+
+    LinAlg::Matrix<double> transposedMatrix(generalMatrix);
+    transposedMatrix.transpose();
+    const std::vector<double> expectedTransposed = (transposedMatrix * rowMatrix).get_col(0);
+    std::vector<double> transposedProduct(cols, std::numeric_limits<double>::quiet_NaN());
+    LinAlg::gemv_transposed(1.0, generalMatrix, rowVector, 0.0, transposedProduct);
+    for (std::size_t j = 0; j < cols; ++j) { EXPECT_NEAR(transposedProduct[j], expectedTransposed[j], 1e-10); }
+
+    LinAlg::Matrix<double> updatedMatrix(generalMatrix);
+    LinAlg::ger(0.5, rowVector, colVector, updatedMatrix);
+    for (std::size_t i = 0; i < rows; ++i) {
+        for (std::size_t j = 0; j < cols; ++j) { EXPECT_NEAR(updatedMatrix(i, j), generalMatrix(i, j) + 0.5 * rowVector[i] * colVector[j], 1e-12); }
+    }
+
+    // TRIANGULAR SOLVE AND SYMMETRIC PRODUCT TEST
+    const std::size_t size = 300;
+    LinAlg::Matrix<double> lowerMatrix(size, size), upperMatrix(size, size), symmetricMatrix(size, size);
+    std::vector<double> expected(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        for (std::size_t j = 0; j <= i; ++j) {
+            lowerMatrix(i, j) = nextValue() / 10.0;
+            upperMatrix(j, i) = nextValue() / 10.0;
+            symmetricMatrix(i, j) = nextValue();
+            symmetricMatrix(j, i) = symmetricMatrix(i, j);
+        }
+        lowerMatrix(i, i) = 5.0 + lowerMatrix(i, i);
+        upperMatrix(i, i) = 5.0 + upperMatrix(i, i);
+        expected[i] = static_cast<double>(i % 7) - 3.0;
+    }
+    const LinAlg::Matrix<double> expectedMatrix(size, 1, expected);
+
+    std::vector<double> lowerSolution = (lowerMatrix * expectedMatrix).get_col(0);
+    LinAlg::trsv(LinAlg::Triangle::lower, LinAlg::Diagonal::non_unit, lowerMatrix, lowerSolution);
+    std::vector<double> upperSolution = (upperMatrix * expectedMatrix).get_col(0);
+    LinAlg::trsv(LinAlg::Triangle::upper, LinAlg::Diagonal::non_unit, upperMatrix, upperSolution);
+    LinAlg::Matrix<double> unitLowerMatrix = lowerMatrix / 100.0;
+    for (std::size_t i = 0; i < size; ++i) { unitLowerMatrix(i, i) = 1.0; }
+    std::vector<double> unitSolution = (unitLowerMatrix * expectedMatrix).get_col(0);
+    for (std::size_t i = 0; i < size; ++i) { unitLowerMatrix(i, i) = 0.0; }
+    LinAlg::trsv(LinAlg::Triangle::lower, LinAlg::Diagonal::unit, unitLowerMatrix, unitSolution);
+    for (std::size_t i = 0; i < size; ++i) {
+        EXPECT_NEAR(lowerSolution[i], expected[i], 1e-10);
+        EXPECT_NEAR(upperSolution[i], expected[i], 1e-10);
+        EXPECT_NEAR(unitSolution[i], expected[i], 1e-10);
+    }
+
+    const std::vector<double> expectedSymmetric = symmetricMatrix * expected;
+    for (std::size_t i = 0; i < size; ++i) {
+        for (std::size_t j = i + 1; j < size; ++j) { symmetricMatrix(i, j) = 0.0; }
+    }
+    std::vector<double> symmetricProduct(size, 1.0);
+    LinAlg::symv(1.0, symmetricMatrix, expected, 1.0, symmetricProduct);
+    for (std::size_t i = 0; i < size; ++i) { EXPECT_NEAR(symmetricProduct[i], expectedSymmetric[i] + 1.0, 1e-10); }
+
+    // PARALLEL RESULTS EQUAL SEQUENTIAL RESULTS TEST
+    std::shared_ptr<LinAlg::ThreadPool> threadPool = std::make_shared<LinAlg::ThreadPool>(4);
+    std::size_t threshold = LinAlg::parallel_threshold();
+    LinAlg::set_parallel_threshold(0);
+    {
+        LinAlg::ScopedExecutionPolicy scopedPolicy(threadPool);
+        std::vector<double> parallelSymmetric(size);
+        LinAlg::symv(1.0, symmetricMatrix, expected.data(), 0.0, parallelSymmetric.data());
+        std::vector<double> parallelTransposed(cols);
+        LinAlg::gemv_transposed(1.0, generalMatrix, rowVector.data(), 0.0, parallelTransposed.data());
+        std::vector<double> parallelSolution = (upperMatrix * expectedMatrix).get_col(0);
+        LinAlg::trsv(LinAlg::Triangle::upper, LinAlg::Diagonal::non_unit, upperMatrix, parallelSolution);
+        for (std::size_t i = 0; i < size; ++i) {
+            EXPECT_NEAR(parallelSymmetric[i], expectedSymmetric[i], 1e-10);
+            EXPECT_NEAR(parallelSolution[i], expected[i], 1e-10);
+        }
+        for (std::size_t j = 0; j < cols; ++j) { EXPECT_NEAR(parallelTransposed[j], expectedTransposed[j], 1e-10); }
+    }
+    LinAlg::set_parallel_threshold(threshold);
+
+    // INVALID ARGUMENT EXCEPTION THROWING TEST
+    ASSERT_THROW(generalMatrix * rowVector, std::invalid_argument);
+    ASSERT_THROW(LinAlg::gemv(1.0, generalMatrix, colVector, 0.0, colVector), std::invalid_argument);
+    ASSERT_THROW(LinAlg::gemv_transposed(1.0, generalMatrix, colVector, 0.0, rowVector), std::invalid_argument);
+    ASSERT_THROW(LinAlg::ger(1.0, colVector, rowVector, updatedMatrix), std::invalid_argument);
+    ASSERT_THROW(LinAlg::trsv(LinAlg::Triangle::lower, LinAlg::Diagonal::unit, generalMatrix, rowVector), std::invalid_argument);
+    ASSERT_THROW(LinAlg::symv(1.0, generalMatrix, colVector, 0.0, rowVector), std::invalid_argument);
+}
+
+TEST(LinearAlgebraTest, Instrumentation)
+{
+    // COMPILED OUT BY DEFAULT TEST
+    EXPECT_FALSE(LinAlg::instrumentation_enabled());
+    LinAlg::reset_instrumentation();
+    LinAlg::Matrix<double> doubleMatrix = { { 2.0, 1.0, 0.0 }, { 1.0, 3.0, 1.0 }, { 0.0, 1.0, 4.0 } };
+    LinAlg::Matrix<double> productMatrix = doubleMatrix * doubleMatrix;
+    productMatrix.transpose();
+    EXPECT_EQ(LinAlg::instrumentation_snapshot()[LinAlg::Operation::gemm].calls, 0u);
+    EXPECT_EQ(LinAlg::instrumentation_snapshot().allocations, 0u);
+
+    // SCOPED OPERATION AND ALLOCATION ATTRIBUTION TEST
+    {
+        LinAlg::ScopedOperation outerOperation(LinAlg::Operation::adjoint, 10, 20);
+        LinAlg::Detail::record_allocation(64);
+        LinAlg::ScopedOperation innerOperation(LinAlg::Operation::minor, 1, 2);
+        LinAlg::Detail::record_allocation(32);
+    }
+    LinAlg::Detail::record_allocation(16);
+    LinAlg::InstrumentationSnapshot snapshot1 = LinAlg::instrumentation_snapshot();
+    EXPECT_EQ(snapshot1[LinAlg::Operation::adjoint].calls, 1u);
+    EXPECT_EQ(snapshot1[LinAlg::Operation::adjoint].flops, 10u);
+    EXPECT_EQ(snapshot1[LinAlg::Operation::adjoint].bytes, 20u);
+    EXPECT_EQ(snapshot1[LinAlg::Operation::adjoint].allocations, 2u);
+    EXPECT_EQ(snapshot1[LinAlg::Operation::adjoint].allocated_bytes, 96u);
+    EXPECT_EQ(snapshot1[LinAlg::Operation::minor].allocations, 1u);
+    EXPECT_EQ(snapshot1[LinAlg::Operation::minor].allocated_bytes, 32u);
+    EXPECT_EQ(snapshot1.allocations, 3u);
+    EXPECT_EQ(snapshot1.allocated_bytes, 112u);
+
+    // PER-THREAD AGGREGATION AND EXPORT TEST
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < 4; ++i) {
+        threads.emplace_back([]() {
+            for (std::size_t j = 0; j < 100; ++j) { LinAlg::ScopedOperation operation(LinAlg::Operation::row_operation, 3, 8); }
+        });
+    }
+    for (std::thread& thread : threads) { thread.join(); }
+    EXPECT_EQ(LinAlg::instrumentation_snapshot()[LinAlg::Operation::row_operation].calls, 400u);
+    EXPECT_EQ(LinAlg::instrumentation_snapshot()[LinAlg::Operation::row_operation].flops, 1200u);
+
+    std::vector<std::string> names;
+    std::uint64_t exportedCalls = 0;
+    LinAlg::export_instrumentation([&names, &exportedCalls](const char* name, const LinAlg::OperationStatistics& statistics) {
+        names.push_back(name);
+        exportedCalls += statistics.calls;
+    });
+    EXPECT_EQ(names.size(), LinAlg::operation_count);
+    EXPECT_EQ(names.front(), "gemm");
+    EXPECT_EQ(exportedCalls, 402u);
+
+    // RESET TEST
+    LinAlg::reset_instrumentation();
+    LinAlg::InstrumentationSnapshot snapshot2 = LinAlg::instrumentation_snapshot();
+    EXPECT_EQ(snapshot2[LinAlg::Operation::row_operation].calls, 0u);
+    EXPECT_EQ(snapshot2[LinAlg::Operation::adjoint].nanoseconds, 0u);
+    EXPECT_EQ(snapshot2.allocations, 0u);
+}
+
+TEST(LinearAlgebraTest, Serialization)
+{
+    LinAlg::Matrix<double> doubleMatrix(5, 7, LinAlg::uninitialized);
+    LinAlg::Matrix<int> intMatrix(4, 3, LinAlg::uninitialized);
+    unsigned int seed = 23u;
+    for (std::size_t i = 0; i < doubleMatrix.vector_size(); ++i) {
+        seed = seed * 1103515245u + 12345u;
+        doubleMatrix.data()[i] = ((seed >> 16) % 201) / 10.0 - 10.0;
+    }
+    for (std::size_t i = 0; i < intMatrix.vector_size(); ++i) { intMatrix.data()[i] = static_cast<int>(i) * 1000 - 5000; }
+
+    // STREAM ROUND TRIP TEST
+    std::stringstream doubleStream, intStream, emptyStream;
+    LinAlg::write_matrix(doubleStream, doubleMatrix);
+    LinAlg::write_matrix(intStream, intMatrix);
+    LinAlg::write_matrix(emptyStream, LinAlg::Matrix<float>());
+    EXPECT_EQ(doubleStream.str().size(), 64 + doubleMatrix.vector_size() * sizeof(double));
+    EXPECT_EQ(doubleStream.str().substr(0, 4), "LAMX");
+    EXPECT_EQ(LinAlg::read_matrix<double>(doubleStream), doubleMatrix);
+    EXPECT_EQ(LinAlg::read_matrix<int>(intStream), intMatrix);
+    EXPECT_EQ(LinAlg::read_matrix<float>(emptyStream).vector_size(), 0);
+
+    std::stringstream viewStream;
+    LinAlg::write_matrix(viewStream, doubleMatrix.transposed());
+    LinAlg::Matrix<double> transposedMatrix = doubleMatrix;
+    transposedMatrix.transpose();
+    EXPECT_EQ(LinAlg::read_matrix<double>(viewStream), transposedMatrix);
+
+    // FOREIGN BYTE ORDER TEST
+    std::string bytes;
+    {
+        std::stringstream stream;
+        LinAlg::write_matrix(stream, intMatrix);
+        bytes = stream.str();
+    }
+    const bool littleEndian = bytes[7] == 1;
+    bytes[7] = littleEndian ? 2 : 1;
+    std::reverse(bytes.begin() + 4, bytes.begin() + 6);
+    std::reverse(bytes.begin() + 8, bytes.begin() + 12);
+    std::reverse(bytes.begin() + 12, bytes.begin() + 16);
+    for (std::size_t offset = 16; offset < 40; offset += 8) { std::reverse(bytes.begin() + offset, bytes.begin() + offset + 8); }
+    for (std::size_t offset = 64; offset < bytes.size(); offset += sizeof(int)) { std::reverse(bytes.begin() + offset, bytes.begin() + offset + sizeof(int)); }
+    std::stringstream foreignStream(bytes);
+    EXPECT_EQ(LinAlg::read_matrix<int>(foreignStream), intMatrix);
+
+    // FILE AND MAPPED MATRIX TEST
+    const std::string path = "LinearAlgebraTest.lamx", foreignPath = "LinearAlgebraTestForeign.lamx";
+    LinAlg::save_matrix(path, doubleMatrix);
+    EXPECT_EQ(LinAlg::load_matrix<double>(path), doubleMatrix);
+    {
+        LinAlg::MappedMatrix<double> mappedMatrix(path);
+        EXPECT_EQ(mappedMatrix.rows(), 5);
+        EXPECT_EQ(mappedMatrix.cols(), 7);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(mappedMatrix.data()) % 64, 0u);
+        EXPECT_EQ(mappedMatrix(2, 3), doubleMatrix(2, 3));
+        EXPECT_EQ(mappedMatrix.to_matrix(), doubleMatrix);
+        EXPECT_EQ(LinAlg::Matrix<double>(mappedMatrix.view() * 2.0), doubleMatrix * 2.0);
+        ASSERT_THROW(mappedMatrix.at(5, 0), std::out_of_range);
+
+        LinAlg::MappedMatrix<double> movedMatrix(std::move(mappedMatrix));
+        EXPECT_EQ(mappedMatrix.data(), nullptr);
+        EXPECT_EQ(movedMatrix.to_matrix(), doubleMatrix);
+    }
+    ASSERT_THROW(LinAlg::MappedMatrix<float> floatMatrix(path), std::runtime_error);
+    ASSERT_THROW(LinAlg::load_matrix<int>(path), std::runtime_error);
+    {
+        std::ofstream stream(foreignPath, std::ios::binary);
+        stream.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    }
+    EXPECT_EQ(LinAlg::load_matrix<int>(foreignPath), intMatrix);
+    ASSERT_THROW(LinAlg::MappedMatrix<int> foreignMatrix(foreignPath), std::runtime_error);
+    std::remove(path.c_str());
+    std::remove(foreignPath.c_str());
+    ASSERT_THROW(LinAlg::load_matrix<double>(path), std::runtime_error);
+    ASSERT_THROW(LinAlg::MappedMatrix<double> missingMatrix(path), std::runtime_error);
+
+    // INVALID FILE EXCEPTION THROWING TEST
+    std::stringstream magicStream("LAMY" + std::string(60, '\0'));
+    ASSERT_THROW(LinAlg::read_matrix<double>(magicStream), std::runtime_error);
+    std::stringstream truncatedStream;
+    LinAlg::write_matrix(truncatedStream, doubleMatrix);
+    const std::string truncated = truncatedStream.str().substr(0, 100);
+    std::stringstream shortStream(truncated), headerStream(truncated.substr(0, 30));
+    ASSERT_THROW(LinAlg::read_matrix<double>(shortStream), std::runtime_error);
+    ASSERT_THROW(LinAlg::read_matrix<double>(headerStream), std::runtime_error);
+}
+
+TEST(LinearAlgebraTest, TiledMatrix)
+{
+    LinAlg::Matrix<double> lhsMatrix(37, 50, LinAlg::uninitialized), rhsMatrix(50, 29, LinAlg::uninitialized);
+    unsigned int seed = 24u;
+    for (std::size_t i = 0; i < lhsMatrix.vector_size(); ++i) {
+        seed = seed * 1103515245u + 12345u;
+        lhsMatrix.data()[i] = ((seed >> 16) % 201) / 10.0 - 10.0;
+    }
+    for (std::size_t i = 0; i < rhsMatrix.vector_size(); ++i) {
+        seed = seed * 1103515245u + 12345u;
+        rhsMatrix.data()[i] = ((seed >> 16) % 201) / 10.0 - 10.0;
+    }
+    const std::string lhsPath = "LinearAlgebraTestLhs.lamx", rhsPath = "LinearAlgebraTestRhs.lamx";
+    const std::string productPath = "LinearAlgebraTestProduct.lamx", transposedPath = "LinearAlgebraTestTransposed.lamx";
+
+    // CREATE, TILE ACCESS AND REOPEN TEST
+    {
+        LinAlg::TiledMatrix<double> lhsTiled = LinAlg::TiledMatrix<double>::create(lhsPath, lhsMatrix, 16);
+        EXPECT_EQ(lhsTiled.rows(), 37);
+        EXPECT_EQ(lhsTiled.cols(), 50);
+        EXPECT_EQ(lhsTiled.tile_rows(), 3);
+        EXPECT_EQ(lhsTiled.tile_cols(), 4);
+        EXPECT_EQ(lhsTiled.tile_height(2), 5);
+        EXPECT_EQ(lhsTiled.tile_width(3), 2);
+        EXPECT_EQ(lhsTiled.tile(2, 3), LinAlg::Matrix<double>(lhsMatrix.block(32, 48, 5, 2)));
+        EXPECT_EQ(lhsTiled.to_matrix(), lhsMatrix);
+        ASSERT_THROW(lhsTiled.tile(3, 0), std::out_of_range);
+        ASSERT_THROW(lhsTiled.set_tile(0, 0, LinAlg::Matrix<double>(5, 2)), std::invalid_argument);
+
+        LinAlg::TiledMatrix<double> zeroTiled = LinAlg::TiledMatrix<double>::create(rhsPath, 20, 20, 8);
+        EXPECT_EQ(zeroTiled.to_matrix(), LinAlg::Matrix<double>(20, 20));
+        zeroTiled.set_tile(2, 1, LinAlg::Matrix<double>(4, 8, 3.0));
+        EXPECT_EQ(zeroTiled.to_matrix()(19, 15), 3.0);
+        EXPECT_EQ(zeroTiled.to_matrix()(19, 16), 0.0);
+    }
+    LinAlg::TiledMatrix<double> lhsTiled = LinAlg::TiledMatrix<double>::open(lhsPath);
+    LinAlg::TiledMatrix<double> rhsTiled = LinAlg::TiledMatrix<double>::create(rhsPath, rhsMatrix, 16);
+    EXPECT_EQ(lhsTiled.to_matrix(), lhsMatrix);
+
+    // STREAMING MULTIPLY AND TRANSPOSE TEST
+    LinAlg::TiledMatrix<double> productTiled = LinAlg::multiply(lhsTiled, rhsTiled, productPath);
+    LinAlg::Matrix<double> productMatrix = lhsMatrix * rhsMatrix;
+    LinAlg::Matrix<double> tiledProductMatrix = productTiled.to_matrix();
+    ASSERT_EQ(tiledProductMatrix.rows(), 37);
+    ASSERT_EQ(tiledProductMatrix.cols(), 29);
+    for (std::size_t i = 0; i < productMatrix.vector_size(); ++i) {
+        EXPECT_NEAR(tiledProductMatrix.data()[i], productMatrix.data()[i], 1e-9);
+    }
+    LinAlg::TiledMatrix<double> transposedTiled = LinAlg::transpose(lhsTiled, transposedPath);
+    LinAlg::Matrix<double> transposedMatrix = lhsMatrix;
+    transposedMatrix.transpose();
+    EXPECT_EQ(transposedTiled.to_matrix(), transposedMatrix);
+
+    // MULTIPLY OF EDGE TILES WRITTEN BY SET_TILE TEST
+    {
+        const std::string squarePath = "LinearAlgebraTestSquare.lamx", squaredPath = "LinearAlgebraTestSquared.lamx";
+        {
+            // Leaves stale values where the next tile buffers are allocated.
+            LinAlg::TiledMatrix<double>::tile_type dirty(16, 7.0);
+        }
+        LinAlg::Matrix<double> identity(3, 3);
+        identity.set_identity();
+        {
+            LinAlg::TiledMatrix<double> squareTiled = LinAlg::TiledMatrix<double>::create(squarePath, 3, 3, 4);
+            squareTiled.set_tile(0, 0, identity);
+            EXPECT_EQ(LinAlg::multiply(squareTiled, squareTiled, squaredPath).to_matrix(), identity);
+        }
+        {
+            LinAlg::TiledMatrix<double> edgeTiled = LinAlg::TiledMatrix<double>::create(squarePath, 37, 50, 16);
+            for (std::size_t tileRow = 0; tileRow < edgeTiled.tile_rows(); ++tileRow) {
+                for (std::size_t tileCol = 0; tileCol < edgeTiled.tile_cols(); ++tileCol) {
+                    edgeTiled.set_tile(tileRow, tileCol, LinAlg::Matrix<double>(lhsMatrix.block(tileRow * 16, tileCol * 16,
+                                                                                                edgeTiled.tile_height(tileRow), edgeTiled.tile_width(tileCol))));
+                }
+            }
+            LinAlg::Matrix<double> edgeProduct = LinAlg::multiply(edgeTiled, rhsTiled, squaredPath).to_matrix();
+            for (std::size_t i = 0; i < productMatrix.vector_size(); ++i) { EXPECT_NEAR(edgeProduct.data()[i], productMatrix.data()[i], 1e-9); }
+        }
+        std::remove(squarePath.c_str());
+        std::remove(squaredPath.c_str());
+    }
+
+    // INVALID ARGUMENTS AND LAYOUT EXCEPTION THROWING TEST
+    ASSERT_THROW(LinAlg::multiply(lhsTiled, lhsTiled, productPath), std::invalid_argument);
+    ASSERT_THROW(LinAlg::TiledMatrix<double>::create(productPath, 4, 4, 0), std::invalid_argument);
+    {
+        LinAlg::TiledMatrix<double> otherTiled = LinAlg::TiledMatrix<double>::create(productPath, 50, 10, 8);
+        ASSERT_THROW(LinAlg::multiply(lhsTiled, otherTiled, transposedPath), std::invalid_argument);
+    }
+    ASSERT_THROW(LinAlg::load_matrix<double>(lhsPath), std::runtime_error);
+    ASSERT_THROW(LinAlg::MappedMatrix<double> mappedMatrix(lhsPath), std::runtime_error);
+    ASSERT_THROW(LinAlg::TiledMatrix<float>::open(lhsPath), std::runtime_error);
+    LinAlg::save_matrix(productPath, lhsMatrix);
+    ASSERT_THROW(LinAlg::TiledMatrix<double>::open(productPath), std::runtime_error);
+
+    std::remove(lhsPath.c_str());
+    std::remove(rhsPath.c_str());
+    std::remove(productPath.c_str());
+    std::remove(transposedPath.c_str());
+    ASSERT_THROW(LinAlg::TiledMatrix<double>::open(productPath), std::runtime_error);
+}
+
+TEST(LinearAlgebraTest, MixedPrecision)
+{
+    // CONVERTING CONSTRUCTION AND ASSIGNMENT TEST
+    LinAlg::Matrix<double> doubleMatrix(9, 11, LinAlg::uninitialized);
+    unsigned int seed = 25u;
+    for (std::size_t i = 0; i < doubleMatrix.vector_size(); ++i) {
+        seed = seed * 1103515245u + 12345u;
+        doubleMatrix.data()[i] = ((seed >> 16) % 201) / 10.0 - 10.0 + 1e-9;
+    }
+    LinAlg::Matrix<float> floatMatrix(doubleMatrix);
+    LinAlg::Matrix<double> roundTripMatrix = floatMatrix;
+    ASSERT_EQ(floatMatrix.rows(), 9);
+    ASSERT_EQ(floatMatrix.cols(), 11);
+    for (std::size_t i = 0; i < doubleMatrix.vector_size(); ++i) {
+        EXPECT_EQ(floatMatrix.data()[i], static_cast<float>(doubleMatrix.data()[i]));
+        EXPECT_EQ(roundTripMatrix.data()[i], static_cast<double>(floatMatrix.data()[i]));
+    }
+    LinAlg::Matrix<int> intMatrix = { { 1, -2 }, { 3, 4 } };
+    LinAlg::Matrix<double> convertedMatrix(3, 3);
+    convertedMatrix = intMatrix;
+    EXPECT_EQ(convertedMatrix, (LinAlg::Matrix<double>{ { 1.0, -2.0 }, { 3.0, 4.0 } }));
+
+    // ITERATIVE REFINEMENT TEST
+    const std::size_t size = 120;
+    LinAlg::Matrix<double> systemMatrix(size, size, LinAlg::uninitialized);
+    for (std::size_t i = 0; i < systemMatrix.vector_size(); ++i) {
+        seed = seed * 1103515245u + 12345u;
+        systemMatrix.data()[i] = ((seed >> 16) % 201) / 10.0 - 10.0;
+    }
+    for (std::size_t i = 0; i < size; ++i) { systemMatrix(i, i) += 200.0; }
+    std::vector<double> bVector(size);
+    for (std::size_t i = 0; i < size; ++i) { bVector[i] = std::sin(static_cast<double>(i)); }
+
+    LinAlg::MixedPrecisionLUDecomposition<double> mixedDecomposition(systemMatrix);
+    EXPECT_EQ(mixedDecomposition.size(), size);
+    EXPECT_FALSE(mixedDecomposition.singular());
+    LinAlg::IterativeSettings<double> settings;
+    settings.iterations = 30;
+    settings.tolerance = 1e-15;
+    std::vector<double> xVector;
+    LinAlg::IterativeResult<double> result = mixedDecomposition.solve(bVector, xVector, settings);
+    EXPECT_TRUE(result.converged);
+    EXPECT_GE(result.iterations, 1u);
+    EXPECT_LE(result.residual, 1e-15);
+    const std::vector<double> luVector = LinAlg::solve_lu(systemMatrix, bVector);
+    for (std::size_t i = 0; i < size; ++i) { EXPECT_NEAR(xVector[i], luVector[i], 1e-14); }
+
+    const std::vector<double> mixedVector = LinAlg::solve_mixed_precision(systemMatrix, bVector);
+    for (std::size_t i = 0; i < size; ++i) { EXPECT_NEAR(mixedVector[i], luVector[i], 1e-14); }
+
+    // FULL PRECISION FALLBACK TEST
+    LinAlg::Matrix<double> hilbertMatrix(10, 10, LinAlg::uninitialized);
+    for (std::size_t i = 0; i < 10; ++i) {
+        for (std::size_t j = 0; j < 10; ++j) { hilbertMatrix(i, j) = 1.0 / static_cast<double>(i + j + 1); }
+    }
+    const std::vector<double> hilbertB(10, 1.0);
+    std::vector<double> hilbertX;
+    EXPECT_FALSE(LinAlg::MixedPrecisionLUDecomposition<double>(hilbertMatrix).solve(hilbertB, hilbertX, settings).converged);
+    const std::vector<double> fallbackVector = LinAlg::solve_mixed_precision(hilbertMatrix, hilbertB);
+    const std::vector<double> hilbertLU = LinAlg::solve_lu(hilbertMatrix, hilbertB);
+    for (std::size_t i = 0; i < 10; ++i) { EXPECT_EQ(fallbackVector[i], hilbertLU[i]); }
+
+    // INVALID ARGUMENTS EXCEPTION THROWING TEST
+    ASSERT_THROW(mixedDecomposition.solve(std::vector<double>(size + 1)), std::invalid_argument);
+    std::vector<double> wrongVector(3);
+    ASSERT_THROW(mixedDecomposition.solve(bVector, wrongVector, settings), std::invalid_argument);
+    ASSERT_THROW(LinAlg::MixedPrecisionLUDecomposition<double>(LinAlg::Matrix<double>(2, 3)), std::invalid_argument);
+    ASSERT_THROW(LinAlg::solve_mixed_precision(LinAlg::Matrix<double>(2, 2), std::vector<double>(2)), std::runtime_error);
+}
+
+TEST(LinearAlgebraTest, Strassen)
+{
+    const std::size_t savedCrossover = LinAlg::strassen_crossover();
+    unsigned int seed = 26u;
+
+    // RECURSION DEPTH TEST
+    EXPECT_EQ(LinAlg::Kernels::strassen_levels(64, 64, 64, 64), 0);
+    EXPECT_EQ(LinAlg::Kernels::strassen_levels(128, 128, 128, 64), 1);
+    EXPECT_EQ(LinAlg::Kernels::strassen_levels(129, 300, 400, 64), 2);
+    EXPECT_EQ(LinAlg::Kernels::strassen_levels(1024, 1024, 1024, 16), 6);
+
+    // POWER OF TWO AND PADDED SIZES TEST
+    const std::size_t shapes[][3] = { { 128, 128, 128 }, { 100, 75, 90 }, { 67, 131, 45 } };
+    for (const auto& shape : shapes) {
+        LinAlg::Matrix<double> lhsMatrix = random_matrix(seed, shape[0], shape[1]);
+        LinAlg::Matrix<double> rhsMatrix = random_matrix(seed, shape[1], shape[2]);
+        LinAlg::set_strassen_crossover(0);
+        LinAlg::Matrix<double> expectedMatrix = lhsMatrix * rhsMatrix;
+        LinAlg::set_strassen_crossover(16);
+        expect_near(lhsMatrix * rhsMatrix, expectedMatrix);
+        LinAlg::Matrix<double> transposedMatrix = lhsMatrix.transposed();
+        expect_near(transposedMatrix.transposed() * rhsMatrix, expectedMatrix);
+
+        // PARALLEL SUB-PRODUCTS TEST
+        {
+            LinAlg::ScopedExecutionPolicy scopedPolicy(std::make_shared<LinAlg::ThreadPool>(4));
+            expect_near(lhsMatrix * rhsMatrix, expectedMatrix);
+        }
+    }
+
+    // ELEMENT TYPE TEST
+    LinAlg::Matrix<double> lhsMatrix = random_matrix(seed, 96, 96);
+    LinAlg::Matrix<double> rhsMatrix = random_matrix(seed, 96, 96);
+    LinAlg::Matrix<float> floatLhsMatrix(lhsMatrix), floatRhsMatrix(rhsMatrix);
+    LinAlg::Matrix<float> floatMatrix = floatLhsMatrix * floatRhsMatrix;
+    LinAlg::set_strassen_crossover(0);
+    LinAlg::Matrix<double> expectedMatrix = lhsMatrix * rhsMatrix;
+    for (std::size_t i = 0; i < expectedMatrix.vector_size(); ++i) {
+        EXPECT_NEAR(floatMatrix.data()[i], expectedMatrix.data()[i], 0.1);
+    }
+
+    LinAlg::Matrix<int> intMatrix(64, 64);
+    for (std::size_t i = 0; i < intMatrix.vector_size(); ++i) { intMatrix.data()[i] = static_cast<int>(i % 7) - 3; }
+    const LinAlg::Matrix<int> intExpectedMatrix = intMatrix * intMatrix;
+    LinAlg::set_strassen_crossover(8);
+    EXPECT_EQ(intMatrix * intMatrix, intExpectedMatrix);
+
+    LinAlg::set_strassen_crossover(savedCrossover);
+    EXPECT_EQ(LinAlg::strassen_crossover(), savedCrossover);
+}
+
+TEST(LinearAlgebraTest, StructuredMatrices)
+{
+    unsigned int seed = 27u;
+    const std::size_t size = 37;
+    LinAlg::Matrix<double> denseMatrix(size, size, LinAlg::uninitialized);
+    for (std::size_t i = 0; i < denseMatrix.vector_size(); ++i) { denseMatrix.data()[i] = random_value(seed); }
+    LinAlg::Matrix<double> rhsMatrix(size, 5, LinAlg::uninitialized);
+    for (std::size_t i = 0; i < rhsMatrix.vector_size(); ++i) { rhsMatrix.data()[i] = random_value(seed); }
+    std::vector<double> xVector(size);
+    for (double& value : xVector) { value = random_value(seed); }
+
+    // DIAGONAL MATRIX TEST
+    LinAlg::DiagonalMatrix<double> diagonalMatrix(size);
+    for (std::size_t i = 0; i < size; ++i) { diagonalMatrix[i] = 1.0 + static_cast<double>(i % 5); }
+    LinAlg::Matrix<double> diagonalDense = diagonalMatrix.to_dense();
+    EXPECT_EQ(diagonalMatrix(3, 3), 4.0);
+    EXPECT_EQ(diagonalMatrix(3, 4), 0.0);
+    ASSERT_THROW(diagonalMatrix.at(size, 0), std::out_of_range);
+    expect_near(diagonalMatrix * rhsMatrix, diagonalDense * rhsMatrix);
+    expect_near(denseMatrix * diagonalMatrix, denseMatrix * diagonalDense);
+    expect_near(diagonalMatrix.solve(diagonalMatrix * rhsMatrix), rhsMatrix);
+    expect_near((diagonalMatrix * diagonalMatrix.inverse()).to_dense(), LinAlg::DiagonalMatrix<double>(size, 1.0).to_dense());
+    const std::vector<double> diagonalSolution = diagonalMatrix.solve(diagonalMatrix * xVector);
+    for (std::size_t i = 0; i < size; ++i) { EXPECT_NEAR(diagonalSolution[i], xVector[i], 1e-12); }
+    EXPECT_EQ((LinAlg::DiagonalMatrix<double>{ 2.0, -3.0, 0.5 }).determinant(), -3.0);
+    ASSERT_THROW((LinAlg::DiagonalMatrix<double>{ 1.0, 0.0 }).solve(std::vector<double>{ 1.0, 1.0 }), std::runtime_error);
+    ASSERT_THROW(diagonalMatrix * LinAlg::Matrix<double>(size + 1, 2), std::invalid_argument);
+
+    // BANDED MATRIX TEST
+    const LinAlg::BandedMatrix<double> bandedMatrix(2, 3, denseMatrix);
+    EXPECT_EQ(bandedMatrix.lower_bandwidth(), 2);
+    EXPECT_EQ(bandedMatrix.upper_bandwidth(), 3);
+    EXPECT_EQ(bandedMatrix.band().size(), size * 6);
+    const LinAlg::Matrix<double> bandedDense = bandedMatrix.to_dense();
+    for (std::size_t i = 0; i < size; ++i) {
+        for (std::size_t j = 0; j < size; ++j) {
+            EXPECT_EQ(bandedDense(i, j), (j + 2 >= i && j <= i + 3) ? denseMatrix(i, j) : 0.0);
+        }
+    }
+    expect_near(bandedMatrix * rhsMatrix, bandedDense * rhsMatrix);
+    expect_near(bandedMatrix * rhsMatrix.transposed().transposed(), bandedDense * rhsMatrix);
+    const std::vector<double> bandedProduct = bandedMatrix * xVector, denseProduct = bandedDense * xVector;
+    for (std::size_t i = 0; i < size; ++i) { EXPECT_NEAR(bandedProduct[i], denseProduct[i], 1e-9); }
+
+    const LinAlg::BandedLUDecomposition<double> bandedDecomposition(bandedMatrix);
+    EXPECT_FALSE(bandedDecomposition.singular());
+    const double bandedDeterminant = LinAlg::LUDecomposition<double>(bandedDense).determinant();
+    EXPECT_NEAR(bandedDecomposition.determinant() / bandedDeterminant, 1.0, 1e-9);
+    EXPECT_NEAR(bandedMatrix.determinant() / bandedDeterminant, 1.0, 1e-9);
+    expect_near(bandedDecomposition.solve(bandedDense * rhsMatrix), rhsMatrix);
+    const std::vector<double> bandedSolution = LinAlg::solve_banded(bandedMatrix, denseProduct);
+    for (std::size_t i = 0; i < size; ++i) { EXPECT_NEAR(bandedSolution[i], xVector[i], 1e-9); }
+
+    // A zero leading diagonal forces a row exchange.
+    const LinAlg::BandedMatrix<double> pivotingMatrix = LinAlg::BandedMatrix<double>::tridiagonal({ 1.0, 1.0 }, { 0.0, 2.0, 3.0 }, { 1.0, 1.0 });
+    EXPECT_EQ(pivotingMatrix.determinant(), -3.0);
+    const std::vector<double> pivotingSolution = LinAlg::solve_banded(pivotingMatrix, std::vector<double>{ 2.0, 8.0, 11.0 });
+    EXPECT_NEAR(pivotingSolution[0], 1.0, 1e-12);
+    EXPECT_NEAR(pivotingSolution[1], 2.0, 1e-12);
+    EXPECT_NEAR(pivotingSolution[2], 3.0, 1e-12);
+    ASSERT_THROW(LinAlg::BandedMatrix<double>(3, 1, 1).set(0, 2, 1.0), std::out_of_range);
+    ASSERT_THROW(LinAlg::solve_banded(LinAlg::BandedMatrix<double>(3, 1, 1), std::vector<double>(3, 1.0)), std::runtime_error);
+    ASSERT_THROW(LinAlg::BandedMatrix<double>::tridiagonal({ 1.0 }, { 1.0, 2.0, 3.0 }, { 1.0, 1.0 }), std::invalid_argument);
+
+    // Diagonally dominant second difference operator in O(n).
+    const std::size_t tridiagonalSize = 100000;
+    const LinAlg::BandedMatrix<double> tridiagonalMatrix = LinAlg::BandedMatrix<double>::tridiagonal(
+        std::vector<double>(tridiagonalSize - 1, -1.0), std::vector<double>(tridiagonalSize, 4.0), std::vector<double>(tridiagonalSize - 1, -1.0));
+    std::vector<double> tridiagonalExpected(tridiagonalSize);
+    for (std::size_t i = 0; i < tridiagonalSize; ++i) { tridiagonalExpected[i] = std::sin(static_cast<double>(i)); }
+    const std::vector<double> tridiagonalSolution = LinAlg::solve_banded(tridiagonalMatrix, tridiagonalMatrix * tridiagonalExpected);
+    double tridiagonalError = 0.0;
+    for (std::size_t i = 0; i < tridiagonalSize; ++i) { tridiagonalError = std::max(tridiagonalError, std::fabs(tridiagonalSolution[i] - tridiagonalExpected[i])); }
+    EXPECT_LT(tridiagonalError, 1e-12);
+
+    // TRIANGULAR MATRIX TEST
+    LinAlg::Matrix<double> conditionedMatrix(denseMatrix);
+    for (std::size_t i = 0; i < size; ++i) { conditionedMatrix(i, i) += 50.0; }
+    for (const LinAlg::Triangle triangle : { LinAlg::Triangle::lower, LinAlg::Triangle::upper }) {
+        const LinAlg::TriangularMatrix<double> triangularMatrix(triangle, conditionedMatrix);
+        EXPECT_EQ(triangularMatrix.packed().size(), size * (size + 1) / 2);
+        const LinAlg::Matrix<double> triangularDense = triangularMatrix.to_dense();
+        for (std::size_t i = 0; i < size; ++i) {
+            for (std::size_t j = 0; j < size; ++j) {
+                EXPECT_EQ(triangularDense(i, j), triangularMatrix.in_triangle(i, j) ? conditionedMatrix(i, j) : 0.0);
+            }
+        }
+        expect_near(triangularMatrix * rhsMatrix, triangularDense * rhsMatrix);
+        expect_near(triangularMatrix.transposed().to_dense(), triangularDense.transposed());
+        expect_near(triangularMatrix.solve(triangularDense * rhsMatrix), rhsMatrix);
+        const std::vector<double> triangularSolution = triangularMatrix.solve(triangularMatrix * xVector);
+        for (std::size_t i = 0; i < size; ++i) { EXPECT_NEAR(triangularSolution[i], xVector[i], 1e-9); }
+        double diagonalProduct = 1.0;
+        for (std::size_t i = 0; i < size; ++i) { diagonalProduct *= conditionedMatrix(i, i); }
+        EXPECT_NEAR(triangularMatrix.determinant() / diagonalProduct, 1.0, 1e-12);
+    }
+    ASSERT_THROW(LinAlg::TriangularMatrix<double>(LinAlg::Triangle::upper, 3).set(2, 1, 1.0), std::out_of_range);
+    ASSERT_THROW(LinAlg::TriangularMatrix<double>(LinAlg::Triangle::lower, 3, std::vector<double>(5)), std::invalid_argument);
+    ASSERT_THROW(LinAlg::TriangularMatrix<double>(LinAlg::Triangle::lower, 2).solve(std::vector<double>(2, 1.0)), std::runtime_error);
+
+    const LinAlg::LUDecomposition<double> luDecomposition(denseMatrix);
+    LinAlg::Matrix<double> permutedMatrix(denseMatrix);
+    for (std::size_t i = 0; i < size; ++i) { permutedMatrix.swap_row(i, luDecomposition.pivots()[i]); }
+    expect_near(luDecomposition.lower_triangular() * luDecomposition.upper_triangular().to_dense(), permutedMatrix);
+
+    // SYMMETRIC MATRIX TEST
+    const LinAlg::Matrix<double> spdMatrix = denseMatrix.transposed() * denseMatrix + LinAlg::DiagonalMatrix<double>(size, 1.0).to_dense();
+    LinAlg::SymmetricMatrix<double> symmetricMatrix(spdMatrix);
+    expect_near(symmetricMatrix.to_dense(), spdMatrix);
+    expect_near(symmetricMatrix * rhsMatrix, spdMatrix * rhsMatrix);
+    const std::vector<double> symmetricProduct = symmetricMatrix * xVector, spdProduct = spdMatrix * xVector;
+    for (std::size_t i = 0; i < size; ++i) { EXPECT_NEAR(symmetricProduct[i], spdProduct[i], 1e-9); }
+    const LinAlg::CholeskyDecomposition<double> choleskyDecomposition(symmetricMatrix);
+    const LinAlg::TriangularMatrix<double> choleskyFactor = choleskyDecomposition.lower_triangular();
+    expect_near(choleskyFactor * choleskyFactor.transposed().to_dense(), spdMatrix);
+    const std::vector<double> symmetricSolution = LinAlg::solve_ldlt(symmetricMatrix, symmetricProduct);
+    for (std::size_t i = 0; i < size; ++i) { EXPECT_NEAR(symmetricSolution[i], xVector[i], 1e-8); }
+    symmetricMatrix.set(0, 2, 7.0);
+    EXPECT_EQ(symmetricMatrix(2, 0), 7.0);
+    EXPECT_EQ(symmetricMatrix.at(0, 2), 7.0);
+}
+
+TEST(LinearAlgebraTest, QRDecomposition)
+{
+    unsigned int seed = 28u;
+
+    // FACTORIZATION TEST
+    const std::size_t shapes[3][2] = { { 150, 70 }, { 100, 100 }, { 70, 90 } };
+    for (const auto& shape : shapes) {
+        LinAlg::Matrix<double> matrix = random_matrix(seed, shape[0], shape[1]);
+        LinAlg::QRDecomposition<double> qr(matrix);
+        const std::size_t k = std::min(shape[0], shape[1]);
+        LinAlg::Matrix<double> q = qr.q();
+        LinAlg::Matrix<double> r = qr.r();
+        ASSERT_EQ(q.rows(), shape[0]);
+        ASSERT_EQ(q.cols(), k);
+        ASSERT_EQ(r.rows(), k);
+        for (std::size_t i = 1; i < k; ++i) {
+            for (std::size_t j = 0; j < i; ++j) { EXPECT_EQ(r(i, j), 0.0); }
+        }
+        expect_near(q * r, matrix);
+        LinAlg::Matrix<double> identityMatrix(k, k);
+        identityMatrix.set_identity();
+        expect_near(q.transposed() * q, identityMatrix);
+        EXPECT_EQ(qr.rank_deficient(), shape[0] < shape[1]);
+    }
+
+    // LEAST SQUARES TEST
+    const std::size_t rows = 150, cols = 37;
+    LinAlg::Matrix<double> matrix = random_matrix(seed, rows, cols);
+    LinAlg::Matrix<double> rhsMatrix = random_matrix(seed, rows, 3);
+    std::vector<double> rhsVector(rows);
+    for (std::size_t i = 0; i < rows; ++i) { rhsVector[i] = rhsMatrix(i, 0); }
+    LinAlg::Matrix<double> transposedMatrix(matrix.transposed());
+    std::vector<double> expectedVector = LinAlg::solve_cholesky(LinAlg::Matrix<double>(transposedMatrix * matrix), transposedMatrix * rhsVector);
+    LinAlg::QRDecomposition<double> qr(matrix);
+    std::vector<double> xVector = qr.solve(rhsVector);
+    ASSERT_EQ(xVector.size(), cols);
+    for (std::size_t i = 0; i < cols; ++i) { EXPECT_NEAR(xVector[i], expectedVector[i], 1e-9); }
+    std::vector<double> solvedVector = LinAlg::solve_least_squares(matrix, rhsVector);
+    for (std::size_t i = 0; i < cols; ++i) { EXPECT_NEAR(solvedVector[i], expectedVector[i], 1e-9); }
+    LinAlg::Matrix<double> xMatrix = qr.solve(rhsMatrix);
+    ASSERT_EQ(xMatrix.rows(), cols);
+    ASSERT_EQ(xMatrix.cols(), 3);
+    for (std::size_t i = 0; i < cols; ++i) { EXPECT_NEAR(xMatrix(i, 0), expectedVector[i], 1e-9); }
+    LinAlg::Matrix<double> appliedMatrix(rhsMatrix);
+    qr.apply_transpose(appliedMatrix);
+    qr.apply(appliedMatrix);
+    expect_near(appliedMatrix, rhsMatrix);
+
+    // TSQR TEST
+    {
+        LinAlg::ScopedExecutionPolicy scopedPolicy(std::make_shared<LinAlg::ThreadPool>(4));
+        LinAlg::TSQRDecomposition<double> tsqr(matrix, 40);
+        EXPECT_EQ(tsqr.block_count(), 3);
+        LinAlg::Matrix<double> tsqrR = tsqr.r();
+        LinAlg::Matrix<double> qrR = qr.r();
+        for (std::size_t i = 0; i < qrR.vector_size(); ++i) { EXPECT_NEAR(std::abs(tsqrR.data()[i]), std::abs(qrR.data()[i]), 1e-9); }
+        std::vector<double> tsqrVector = tsqr.solve(rhsVector);
+        for (std::size_t i = 0; i < cols; ++i) { EXPECT_NEAR(tsqrVector[i], expectedVector[i], 1e-9); }
+        expect_near(tsqr.solve(rhsMatrix), xMatrix);
+        std::vector<double> defaultVector = LinAlg::solve_least_squares_tsqr(matrix, rhsVector);
+        for (std::size_t i = 0; i < cols; ++i) { EXPECT_NEAR(defaultVector[i], expectedVector[i], 1e-9); }
+    }
+
+    // EXCEPTION TEST
+    LinAlg::Matrix<double> deficientMatrix(matrix);
+    for (std::size_t i = 0; i < rows; ++i) { deficientMatrix(i, 5) = 0.0; }
+    LinAlg::QRDecomposition<double> deficientQr(deficientMatrix);
+    EXPECT_TRUE(deficientQr.rank_deficient());
+    ASSERT_THROW(deficientQr.solve(rhsVector), std::runtime_error);
+    ASSERT_THROW(LinAlg::QRDecomposition<double>(random_matrix(seed, 70, 90)).solve(std::vector<double>(70)), std::runtime_error);
+    ASSERT_THROW(qr.solve(std::vector<double>(rows - 1)), std::invalid_argument);
+    std::vector<double> shortVector(cols);
+    ASSERT_THROW(qr.apply(shortVector), std::invalid_argument);
+    ASSERT_THROW(LinAlg::TSQRDecomposition<double>(LinAlg::Matrix<double>(20, 30)), std::invalid_argument);
+    ASSERT_THROW(LinAlg::QRDecomposition<int>(LinAlg::Matrix<int>(3, 3)), std::invalid_argument);
+}
+
+TEST(LinearAlgebraTest, EigenDecomposition)
+{
+    unsigned int seed = 29u;
+    auto identity = [](std::size_t size) {
+        LinAlg::Matrix<double> matrix(size, size);
+        matrix.set_identity();
+        return matrix;
+    };
+    auto diagonal = [](const std::vector<double>& values) {
+        LinAlg::Matrix<double> matrix(values.size(), values.size());
+        matrix.set_diag(values);
+        return matrix;
+    };
+
+    // SYMMETRIC EIGENDECOMPOSITION TEST
+    const LinAlg::Matrix<double> smallMatrix = { { 2.0, 1.0 }, { 1.0, 2.0 } };
+    LinAlg::SymmetricEigenDecomposition<double> smallEigen(smallMatrix);
+    EXPECT_NEAR(smallEigen.values()[0], 1.0, 1e-12);
+    EXPECT_NEAR(smallEigen.values()[1], 3.0, 1e-12);
+    const std::size_t size = 40;
+    LinAlg::Matrix<double> randomSquare = random_matrix(seed, size, size);
+    LinAlg::Matrix<double> symmetricMatrix = randomSquare + randomSquare.transposed();
+    LinAlg::SymmetricEigenDecomposition<double> eigen(symmetricMatrix);
+    ASSERT_EQ(eigen.size(), size);
+    EXPECT_TRUE(std::is_sorted(eigen.values().begin(), eigen.values().end()));
+    const LinAlg::Matrix<double>& eigenvectors = eigen.vectors();
+    expect_near(eigenvectors * diagonal(eigen.values()) * eigenvectors.transposed(), symmetricMatrix);
+    expect_near(eigenvectors.transposed() * eigenvectors, identity(size));
+    std::vector<double> values = LinAlg::eigenvalues_symmetric(symmetricMatrix);
+    for (std::size_t i = 0; i < size; ++i) { EXPECT_NEAR(values[i], eigen.values()[i], 1e-9); }
+    LinAlg::SymmetricMatrix<double> packedMatrix(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        for (std::size_t j = 0; j <= i; ++j) { packedMatrix.set(i, j, symmetricMatrix(i, j)); }
+    }
+    LinAlg::SymmetricEigenDecomposition<double> packedEigen(packedMatrix, false);
+    EXPECT_EQ(packedEigen.vectors().vector_size(), 0);
+    for (std::size_t i = 0; i < size; ++i) { EXPECT_NEAR(packedEigen.values()[i], eigen.values()[i], 1e-9); }
+
+    // SINGULAR VALUE DECOMPOSITION TEST
+    const std::size_t shapes[3][2] = { { 60, 25 }, { 30, 30 }, { 25, 60 } };
+    for (const auto& shape : shapes) {
+        LinAlg::Matrix<double> matrix = random_matrix(seed, shape[0], shape[1]);
+        LinAlg::SingularValueDecomposition<double> svd(matrix);
+        const std::size_t k = std::min(shape[0], shape[1]);
+        ASSERT_EQ(svd.values().size(), k);
+        ASSERT_EQ(svd.u().rows(), shape[0]);
+        ASSERT_EQ(svd.v().rows(), shape[1]);
+        EXPECT_TRUE(std::is_sorted(svd.values().rbegin(), svd.values().rend()));
+        EXPECT_GE(svd.values().back(), 0.0);
+        EXPECT_EQ(svd.rank(), k);
+        expect_near(svd.u() * diagonal(svd.values()) * svd.v().transposed(), matrix);
+        expect_near(svd.u().transposed() * svd.u(), identity(k));
+        expect_near(svd.v().transposed() * svd.v(), identity(k));
+    }
+    LinAlg::Matrix<double> tallMatrix = random_matrix(seed, 60, 25);
+    std::vector<double> rhsVector(60);
+    for (std::size_t i = 0; i < rhsVector.size(); ++i) { rhsVector[i] = static_cast<double>(i % 7) - 3.0; }
+    std::vector<double> svdSolution = LinAlg::SingularValueDecomposition<double>(tallMatrix).solve(rhsVector);
+    std::vector<double> qrSolution = LinAlg::solve_least_squares(tallMatrix, rhsVector);
+    for (std::size_t i = 0; i < qrSolution.size(); ++i) { EXPECT_NEAR(svdSolution[i], qrSolution[i], 1e-9); }
+    LinAlg::Matrix<double> lowRankMatrix = random_matrix(seed, 30, 4) * random_matrix(seed, 4, 20);
+    LinAlg::SingularValueDecomposition<double> lowRankSvd(lowRankMatrix);
+    EXPECT_EQ(lowRankSvd.rank(), 4);
+    expect_near(lowRankSvd.u().transposed() * lowRankSvd.u(), identity(20));
+
+    // LANCZOS TEST
+    LinAlg::Matrix<double> spikedMatrix(symmetricMatrix);
+    for (std::size_t i = 0; i < 4; ++i) { spikedMatrix(i, i) += 400.0 * static_cast<double>(4 - i); }
+    std::vector<double> spikedValues = LinAlg::eigenvalues_symmetric(spikedMatrix);
+    std::sort(spikedValues.begin(), spikedValues.end(), [](double lhs, double rhs) { return std::abs(lhs) > std::abs(rhs); });
+    LinAlg::PartialEigenResult<double> lanczos = LinAlg::lanczos_eigen(spikedMatrix, 4);
+    EXPECT_TRUE(lanczos.converged);
+    ASSERT_EQ(lanczos.vectors.rows(), size);
+    ASSERT_EQ(lanczos.vectors.cols(), 4);
+    for (std::size_t i = 0; i < 4; ++i) { EXPECT_NEAR(lanczos.values[i], spikedValues[i], 1e-8); }
+    LinAlg::Matrix<double> lanczosResidual = spikedMatrix * lanczos.vectors - lanczos.vectors * diagonal(lanczos.values);
+    for (std::size_t i = 0; i < lanczosResidual.vector_size(); ++i) { EXPECT_NEAR(lanczosResidual.data()[i], 0.0, 1e-6); }
+
+    const std::size_t laplacianSize = 50;
+    std::vector< LinAlg::Triplet<double> > triplets;
+    for (std::size_t i = 0; i < laplacianSize; ++i) {
+        triplets.push_back({ i, i, 2.0 });
+        if (i > 0) { triplets.push_back({ i, i - 1, -1.0 }); }
+        if (i + 1 < laplacianSize) { triplets.push_back({ i, i + 1, -1.0 }); }
+    }
+    LinAlg::SparseMatrix<double> laplacian(laplacianSize, laplacianSize, triplets);
+    LinAlg::IterativeSettings<double> settings;
+    settings.iterations = 10000;
+    LinAlg::PartialEigenResult<double> sparseLanczos = LinAlg::lanczos_eigen(laplacian, 3, settings);
+    EXPECT_TRUE(sparseLanczos.converged);
+    const double pi = std::acos(-1.0);
+    for (std::size_t i = 0; i < 3; ++i) {
+        EXPECT_NEAR(sparseLanczos.values[i], 2.0 + 2.0 * std::cos(pi * static_cast<double>(i + 1) / (laplacianSize + 1)), 1e-8);
+    }
+    settings.iterations = 7;
+    LinAlg::PartialEigenResult<double> limitedLanczos = LinAlg::lanczos_eigen(laplacian, 3, settings);
+    EXPECT_FALSE(limitedLanczos.converged);
+    EXPECT_EQ(limitedLanczos.iterations, 7u);
+    ASSERT_EQ(limitedLanczos.values.size(), 3);
+
+    LinAlg::Matrix<float> floatDiagonal(50, 50);
+    for (std::size_t i = 0; i < 50; ++i) { floatDiagonal(i, i) = static_cast<float>(i + 1); }
+    LinAlg::IterativeSettings<float> floatSettings;
+    for (float tolerance : { floatSettings.tolerance, 1e-10f }) {
+        floatSettings.tolerance = tolerance;
+        LinAlg::PartialEigenResult<float> floatLanczos = LinAlg::lanczos_eigen(floatDiagonal, 1, floatSettings);
+        EXPECT_TRUE(floatLanczos.converged);
+        EXPECT_LE(floatLanczos.iterations, floatSettings.iterations);
+        EXPECT_NEAR(floatLanczos.values[0], 50.0f, 1e-3f);
+    }
+
+    // TRUNCATED SVD TEST
+    LinAlg::Matrix<double> dataMatrix = random_matrix(seed, 200, 30);
+    LinAlg::SingularValueDecomposition<double> dataSvd(dataMatrix);
+    LinAlg::PartialSVDResult<double> truncated = LinAlg::truncated_svd(dataMatrix, 3);
+    LinAlg::PartialSVDResult<double> sparseTruncated = LinAlg::truncated_svd(LinAlg::SparseMatrix<double>(dataMatrix), 3);
+    LinAlg::Matrix<double> wideMatrix(dataMatrix.transposed());
+    LinAlg::PartialSVDResult<double> wideTruncated = LinAlg::truncated_svd(wideMatrix, 3);
+    LinAlg::PartialSVDResult<double> sparseWideTruncated = LinAlg::truncated_svd(LinAlg::SparseMatrix<double>(wideMatrix), 3);
+    EXPECT_TRUE(truncated.converged);
+    ASSERT_EQ(truncated.u.rows(), 200);
+    ASSERT_EQ(truncated.v.rows(), 30);
+    ASSERT_EQ(wideTruncated.u.rows(), 30);
+    ASSERT_EQ(wideTruncated.v.rows(), 200);
+    EXPECT_TRUE(sparseWideTruncated.converged);
+    ASSERT_EQ(sparseWideTruncated.u.rows(), 30);
+    ASSERT_EQ(sparseWideTruncated.v.rows(), 200);
+    for (std::size_t i = 0; i < 3; ++i) {
+        EXPECT_NEAR(truncated.values[i], dataSvd.values()[i], 1e-8);
+        EXPECT_NEAR(wideTruncated.values[i], dataSvd.values()[i], 1e-8);
+        EXPECT_NEAR(sparseTruncated.values[i], dataSvd.values()[i], 1e-8);
+        EXPECT_NEAR(sparseWideTruncated.values[i], dataSvd.values()[i], 1e-8);
+    }
+    LinAlg::Matrix<double> truncatedResidual = dataMatrix * truncated.v - truncated.u * diagonal(truncated.values);
+    for (std::size_t i = 0; i < truncatedResidual.vector_size(); ++i) { EXPECT_NEAR(truncatedResidual.data()[i], 0.0, 1e-6); }
+    LinAlg::Matrix<double> sparseWideResidual = wideMatrix * sparseWideTruncated.v - sparseWideTruncated.u * diagonal(sparseWideTruncated.values);
+    for (std::size_t i = 0; i < sparseWideResidual.vector_size(); ++i) { EXPECT_NEAR(sparseWideResidual.data()[i], 0.0, 1e-6); }
+
+    // EXCEPTION TEST
+    ASSERT_THROW(LinAlg::SymmetricEigenDecomposition<double>(random_matrix(seed, 3, 4)), std::invalid_argument);
+    ASSERT_THROW(LinAlg::SymmetricEigenDecomposition<int>(LinAlg::Matrix<int>(3, 3)), std::invalid_argument);
+    ASSERT_THROW(LinAlg::SingularValueDecomposition<int>(LinAlg::Matrix<int>(3, 3)), std::invalid_argument);
+    ASSERT_THROW(dataSvd.solve(std::vector<double>(30)), std::invalid_argument);
+    ASSERT_THROW(LinAlg::lanczos_eigen(random_matrix(seed, 3, 4), 1), std::invalid_argument);
+    ASSERT_THROW(LinAlg::lanczos_eigen(spikedMatrix, 0), std::invalid_argument);
+    ASSERT_THROW(LinAlg::truncated_svd(dataMatrix, 31), std::invalid_argument);
+}
+
+TEST(LinearAlgebraTest, TaskGraph)
+{
+    unsigned int seed = 31u;
+
+    const std::size_t count = 45;
+    std::vector< LinAlg::Matrix<double> > matrices, rightHandSides;
+    for (std::size_t index = 0; index < count; ++index) {
+        matrices.push_back(random_matrix(seed, 5, 5, 30.0));
+        rightHandSides.push_back(random_matrix(seed, 5, 3, 0.0));
+    }
+    const LinAlg::Matrix<double> large = random_matrix(seed, 80, 80, 0.0);
+
+    for (std::size_t threads : { 1u, 4u }) {
+        for (std::size_t batchSize : { 1u, 16u }) {
+            std::shared_ptr<LinAlg::ExecutionPolicy> policy = std::make_shared<LinAlg::ThreadPool>(threads);
+            LinAlg::TaskGraph<double> graph(policy, batchSize);
+            EXPECT_EQ(graph.batch_size(), batchSize);
+
+            // BATCHED PRODUCT AND SOLUTION DEPENDENCY CHAIN TEST
+            std::vector< LinAlg::MatrixFuture<double> > products, solutions, residuals;
+            for (std::size_t index = 0; index < count; ++index) {
+                const LinAlg::MatrixFuture<double> matrix = graph.value(matrices[index]);
+                products.push_back(graph.multiply(matrix, graph.value(rightHandSides[index])));
+                solutions.push_back(graph.solve(matrix, products.back()));
+                residuals.push_back(graph.submit([](const LinAlg::Matrix<double>& solution, const LinAlg::Matrix<double>& expected) {
+                    return solution - expected;
+                }, solutions.back(), graph.value(rightHandSides[index])));
+            }
+
+            // UNBATCHED LARGE PRODUCT TEST
+            const LinAlg::MatrixFuture<double> square = graph.submit([&large]() { return large * large; });
+            const LinAlg::MatrixFuture<double> cube = graph.multiply(square, graph.value(large));
+
+            for (std::size_t index = 0; index < count; ++index) {
+                expect_near(products[index].get(), matrices[index] * rightHandSides[index]);
+                expect_near(solutions[index].get(), rightHandSides[index]);
+                expect_near(residuals[index].get(), LinAlg::Matrix<double>(5, 3));
+                EXPECT_TRUE(residuals[index].ready());
+            }
+            expect_near(cube.get(), large * large * large);
+
+            // FAILED OPERATION PROPAGATION TEST
+            const LinAlg::MatrixFuture<double> singular = graph.value(LinAlg::Matrix<double>{ { 1.0, 2.0 }, { 2.0, 4.0 } });
+            const LinAlg::MatrixFuture<double> regular = graph.value(LinAlg::Matrix<double>{ { 2.0, 0.0 }, { 0.0, 4.0 } });
+            const LinAlg::MatrixFuture<double> b = graph.value(LinAlg::Matrix<double>{ { 2.0 }, { 4.0 } });
+            const LinAlg::MatrixFuture<double> failed = graph.solve(singular, b);
+            const LinAlg::MatrixFuture<double> solved = graph.solve(regular, b);
+            const LinAlg::MatrixFuture<double> dependent = graph.multiply(regular, failed);
+            const LinAlg::MatrixFuture<double> mismatched = graph.multiply(b, regular);
+            graph.wait();
+            EXPECT_TRUE(dependent.ready());
+            expect_near(solved.get(), LinAlg::Matrix<double>{ { 1.0 }, { 1.0 } });
+            ASSERT_THROW(failed.get(), std::runtime_error);
+            ASSERT_THROW(dependent.get(), std::runtime_error);
+            ASSERT_THROW(mismatched.get(), std::invalid_argument);
+        }
+    }
+
+    // INVALID FUTURE EXCEPTION THROWING TEST
+    LinAlg::TaskGraph<double> graph;
+    LinAlg::TaskGraph<double> otherGraph;
+    const LinAlg::MatrixFuture<double> other = otherGraph.value(matrices[0]);
+    EXPECT_FALSE(LinAlg::MatrixFuture<double>().valid());
+    ASSERT_THROW(LinAlg::MatrixFuture<double>().get(), std::invalid_argument);
+    ASSERT_THROW(graph.multiply(graph.value(matrices[0]), LinAlg::MatrixFuture<double>()), std::invalid_argument);
+    ASSERT_THROW(graph.multiply(graph.value(matrices[0]), other), std::invalid_argument);
+}
+
 int main(int argc, char** argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();